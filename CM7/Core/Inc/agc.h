@@ -0,0 +1,91 @@
+// agc.h
+#ifndef AGC_H
+#define AGC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define AGC_MIN_GAIN_DB -24.0f
+#define AGC_MAX_GAIN_DB 42.0f
+#define AGC_SILENCE_DBFS -200.0f // level reported for an all-zero block
+
+    typedef struct
+    {
+        uint8_t channels;       // interleaved channels, all scaled by the one gain
+        uint16_t block_rate;    // agc_process calls per second
+        float target_dbfs;      // block RMS the gain steers toward (0 dBFS: full-scale square)
+        float limit_dbfs;       // block peak ceiling after the gain
+        float gate_dbfs;        // quieter blocks hold the gain instead of raising the noise
+        float min_gain_db;      // AGC_MIN_GAIN_DB..AGC_MAX_GAIN_DB
+        float max_gain_db;
+        float initial_gain_db;  // gain after init and reset
+        float attack_db_per_s;  // fastest fall toward the target; peaks over limit_dbfs cut at once
+        float release_db_per_s; // fastest rise
+    } AgcConfig_t;
+
+    /**
+     * @brief Digital gain control after PDM decoding: block peak and RMS are measured on the
+     *        decoded input, the gain moves toward target_dbfs - RMS at the attack/release rates
+     *        and never lets the block peak pass limit_dbfs. The loop is feed-forward (the gain
+     *        never feeds its own measurement), so it cannot oscillate; its gain is ramped
+     *        sample by sample across the block unless the peak guard has to cut at once.
+     *
+     *        Levels and gains are Q16 dB; the per-block work is one pass over the samples plus
+     *        a fixed number of table lookups, so it fits the capture interrupt.
+     */
+    typedef struct
+    {
+        AgcConfig_t config;
+        int32_t target_q16; // config in Q16 dB, the rates per block
+        int32_t limit_q16;
+        int32_t gate_q16;
+        int32_t min_q16;
+        int32_t max_q16;
+        int32_t initial_q16;
+        int32_t attack_q16;
+        int32_t release_q16;
+        int32_t gain_q16;   // gain at the end of the last block, dB
+        int32_t linear_q16; // the same gain as a factor
+        int32_t level_q16;  // RMS of the last input block, dBFS
+        int32_t peak_q16;   // peak of the last input block, dBFS
+        uint32_t blocks;
+        uint32_t limited;   // blocks the peak guard cut
+    } Agc_t;
+
+    /**
+     * @return 0 if successful, -1 if the config is out of range
+     */
+    int agc_init(Agc_t *agc, const AgcConfig_t *config);
+
+    /**
+     * @brief Gain back to initial_gain_db, counters cleared.
+     */
+    void agc_reset(Agc_t *agc);
+
+    /**
+     * @brief Measures one block, updates the gain and applies it in place.
+     * @param pcm n_frames interleaved frames of config.channels samples
+     * @return the gain at the end of the block in Q8 dB, the value to log per block for
+     *         compensating dB features
+     */
+    int16_t agc_process(Agc_t *agc, int16_t *pcm, uint32_t n_frames);
+
+    /**
+     * @brief 10 log10(energy / n_samples / 32768^2) in Q16 dBFS, AGC_SILENCE_DBFS for 0.
+     */
+    int32_t agc_power_dbfs_q16(uint64_t energy, uint32_t n_samples);
+
+    /**
+     * @brief 2^16 * 10^(gain / 20) for a Q16 dB gain.
+     */
+    int32_t agc_db_to_linear_q16(int32_t gain_q16);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AGC_H
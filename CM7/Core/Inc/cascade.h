@@ -0,0 +1,79 @@
+// cascade.h
+#ifndef CASCADE_H
+#define CASCADE_H
+
+#include "cnn_inference.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Two-stage classifier: a tiny gate model screens every mel window and the full
+     *        classifier only runs when the gate's score for gate_class reaches the threshold.
+     * Both stages read the same int8 features produced from calculate_mel_spectrogram.
+     */
+    typedef struct
+    {
+        const CnnModel_t *gate;
+        const CnnModel_t *full;
+        void *gate_workspace;
+        void *full_workspace;
+        uint8_t gate_class; // gate output compared against the threshold
+        int32_t threshold;  // gate logit needed to wake the full classifier
+
+        // compute accounting since the last cascade_reset_stats
+        uint32_t windows;
+        uint32_t full_runs;
+        uint64_t macs;
+        float audio_seconds;
+    } Cascade_t;
+
+    /**
+     * @brief Workspace bytes needed by each stage for a window length.
+     */
+    uint32_t cascade_gate_workspace_size(const CnnModel_t *gate, uint16_t window);
+    uint32_t cascade_full_workspace_size(const CnnModel_t *full, uint16_t window);
+
+    /**
+     * @brief Binds both models and their workspaces.
+     * @return 0 if successful, -1 on failure
+     */
+    int cascade_init(Cascade_t *cascade, const CnnModel_t *gate, const CnnModel_t *full,
+                     void *gate_workspace, void *full_workspace, uint8_t gate_class,
+                     int32_t threshold);
+
+    /**
+     * @brief Tunes the early-exit threshold at run time.
+     */
+    void cascade_set_threshold(Cascade_t *cascade, int32_t threshold);
+
+    /**
+     * @brief Classifies one window, running the full model only when the gate fires.
+     * @param input int8 features laid out like the spectrogram (input[h * n_frames + t])
+     * @param n_frames Number of time columns in the window
+     * @param audio_seconds New audio covered by this window (hop time), for the compute rate
+     * @param logits Output of the full classifier (full->n_classes), untouched on early exit
+     * @param gate_score Optional output of the gate's score
+     * @return 1 if the full classifier ran, 0 on early exit, -1 on error
+     */
+    int cascade_classify(Cascade_t *cascade, const int8_t *input, uint16_t n_frames,
+                         float audio_seconds, int32_t *logits, int32_t *gate_score);
+
+    /**
+     * @brief Average multiply-accumulates spent per second of audio since the last reset.
+     */
+    float cascade_macs_per_second(const Cascade_t *cascade);
+
+    /**
+     * @brief Clears the compute accounting.
+     */
+    void cascade_reset_stats(Cascade_t *cascade);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CASCADE_H
@@ -0,0 +1,151 @@
+// cnn_inference.h
+#ifndef CNN_INFERENCE_H
+#define CNN_INFERENCE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define CNN_MAX_LAYERS 8
+#define CNN_MAX_CLASSES 8
+#define CNN_MAX_KERNEL_W 8
+
+    /**
+     * @brief int8 convolution over a (freq x time) feature map.
+     *
+     * The time axis is 'valid' with stride 1, so an output column only depends on the k_w most
+     * recent input columns. The frequency axis uses 'same' padding with an optional stride.
+     * Weights are stored [out_ch][k_w][k_h][in_ch], activations column by column as [h][ch].
+     */
+    typedef struct
+    {
+        uint16_t in_h;  // input rows (mel bands for the first layer)
+        uint16_t in_ch; // input channels (1 for the first layer)
+        uint16_t out_ch;
+        uint8_t k_h;      // kernel height (frequency)
+        uint8_t k_w;      // kernel width (time)
+        uint8_t stride_h; // frequency stride
+        uint8_t relu;     // clamp negative outputs to zero
+        const int8_t *weights;
+        const int32_t *bias;
+        int32_t out_multiplier; // requantization: out = (acc * out_multiplier) >> out_shift
+        uint8_t out_shift;
+    } CnnConvLayer_t;
+
+    /**
+     * @brief Stack of conv layers followed by global average pooling over time and a dense layer.
+     * fc_weights is [n_classes][out_h * out_ch] of the last conv layer.
+     */
+    typedef struct
+    {
+        uint8_t n_layers;
+        CnnConvLayer_t layers[CNN_MAX_LAYERS];
+        uint16_t n_classes;
+        const int8_t *fc_weights;
+        const int32_t *fc_bias;
+    } CnnModel_t;
+
+    /**
+     * @brief Optional hook that returns where a layer's weights should be read from.
+     * Lets a weight store substitute an SRAM copy for weights that live in external flash.
+     */
+    typedef const int8_t *(*CnnWeightFetch_t)(uint8_t layer, const int8_t *weights,
+                                              uint32_t size);
+
+    /**
+     * @brief Streaming inference state, one per model.
+     * Each layer keeps a ring of its last k_w input columns; the last layer's outputs are kept
+     * for the pooling window together with their running sum.
+     */
+    typedef struct
+    {
+        const CnnModel_t *model;
+        uint16_t window;    // input columns covered by one classification
+        uint16_t pool_cols; // last layer columns covered by one classification
+        uint16_t head[CNN_MAX_LAYERS + 1];   // next ring slot to write
+        uint16_t filled[CNN_MAX_LAYERS + 1]; // valid columns in the ring
+        int8_t *ring[CNN_MAX_LAYERS + 1];
+        int8_t *scratch[2];
+        int32_t *pool_sum;
+    } CnnStream_t;
+
+    /**
+     * @brief Output rows of a layer for the model (freq axis after stride).
+     */
+    uint16_t cnn_layer_out_h(const CnnConvLayer_t *layer);
+
+    /**
+     * @brief Multiply-accumulates needed for one classification of a full window.
+     */
+    uint32_t cnn_window_macs(const CnnModel_t *model, uint16_t window);
+
+    /**
+     * @brief Multiply-accumulates needed per pushed column in streaming mode.
+     */
+    uint32_t cnn_stream_macs(const CnnModel_t *model);
+
+    /**
+     * @brief Installs a weight fetch hook used by all models (NULL to read weights in place).
+     */
+    void cnn_set_weight_fetch(CnnWeightFetch_t fetch);
+
+    /**
+     * @brief Workspace bytes needed by cnn_infer_window.
+     * @return size in bytes, or 0 if the window is shorter than the model's receptive field
+     */
+    uint32_t cnn_window_workspace_size(const CnnModel_t *model, uint16_t window);
+
+    /**
+     * @brief Classifies one window of input features.
+     * @param model Model description
+     * @param input int8 features laid out like the spectrogram (input[h * n_frames + t])
+     * @param n_frames Number of time columns in the window
+     * @param workspace Scratch memory of cnn_window_workspace_size bytes (4-byte aligned)
+     * @param logits Output class scores (model->n_classes)
+     * @return 0 if successful, -1 on failure
+     */
+    int cnn_infer_window(const CnnModel_t *model, const int8_t *input, uint16_t n_frames,
+                         void *workspace, int32_t *logits);
+
+    /**
+     * @brief Workspace bytes needed by a streaming state for the given window length.
+     * @return size in bytes, or 0 if the window is shorter than the model's receptive field
+     */
+    uint32_t cnn_stream_workspace_size(const CnnModel_t *model, uint16_t window);
+
+    /**
+     * @brief Binds a streaming state to a model and workspace and resets it.
+     * @return 0 if successful, -1 on failure
+     */
+    int cnn_stream_init(CnnStream_t *stream, const CnnModel_t *model, uint16_t window,
+                        void *workspace, uint32_t workspace_size);
+
+    /**
+     * @brief Forgets all past columns, e.g. after a gap in the audio.
+     */
+    void cnn_stream_reset(CnnStream_t *stream);
+
+    /**
+     * @brief Pushes one new feature column and updates only the activations it affects.
+     * @param column int8 features of the newest frame (in_h of the first layer)
+     * @param logits Output class scores, written once a full window has been seen
+     * @return 1 if logits were written, 0 while the window is still filling, -1 on error
+     *
+     * Once primed, the logits are bit-identical to cnn_infer_window on the last window columns.
+     */
+    int cnn_stream_push(CnnStream_t *stream, const int8_t *column, int32_t *logits);
+
+    /**
+     * @brief Quantizes float features to the model input: q = round(x / scale) + zero_point.
+     */
+    void cnn_quantize_input(const float *input, int8_t *output, uint32_t size, float scale,
+                            int8_t zero_point);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CNN_INFERENCE_H
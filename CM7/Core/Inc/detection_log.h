@@ -0,0 +1,181 @@
+// detection_log.h
+#ifndef DETECTION_LOG_H
+#define DETECTION_LOG_H
+
+#include "nor_flash.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// 1: main mounts the log in the top of the QSPI flash and services it every loop pass
+#ifndef USE_DETECTION_LOG
+#define USE_DETECTION_LOG 0
+#endif
+
+// class scores kept per detection
+#define DETECTION_LOG_N_SCORES 12
+// bytes of one record and of the sector header slot
+#define DETECTION_LOG_SLOT 32u
+#define DETECTION_LOG_MAX_SECTORS 64
+#define DETECTION_LOG_MAX_PAGE 512u
+// erased sectors kept ahead of the write head
+#define DETECTION_LOG_SPARE_SECTORS 2
+
+// top 8 MB of the dual MT25TL01G, above the model weights (see STM32H747XIHX_FLASH.ld)
+#define DETECTION_LOG_QSPI_OFFSET 0x07800000u
+#define DETECTION_LOG_QSPI_BYTES 0x00800000u
+
+    /**
+     * @brief One detection. sequence, magic and crc are filled in by detection_log_append.
+     */
+    typedef struct
+    {
+        uint32_t sequence;  // record number, increases across power cycles
+        uint32_t timestamp; // caller's clock (RTC seconds or HAL_GetTick ms)
+        uint32_t clip_ref;  // caller's reference to the audio, e.g. SDRAM archive offset
+        int16_t spl_cdb;    // sound pressure level in 0.01 dB
+        uint16_t magic;
+        int8_t scores[DETECTION_LOG_N_SCORES];
+        uint32_t crc;
+    } DetectionRecord_t;
+
+    typedef enum
+    {
+        DLOG_SECTOR_DIRTY = 0, // unknown contents, erased before use
+        DLOG_SECTOR_READY,     // erased, header with the erase count programmed
+        DLOG_SECTOR_USED,      // opened with a sequence number, holds records
+    } DetectionLogSectorState_t;
+
+    typedef struct
+    {
+        uint8_t state;
+        uint32_t sequence;    // order in which USED sectors were opened
+        uint32_t erase_count; // wear, carried across erases in the sector header
+    } DetectionLogSector_t;
+
+    typedef struct
+    {
+        uint32_t appended;
+        uint32_t dropped;        // no erased sector or both page buffers full
+        uint32_t pages_programmed;
+        uint32_t bytes_programmed;
+        uint32_t erases;
+        uint32_t reclaimed;      // USED sectors erased, their records are gone
+        uint32_t torn_records;   // slots that failed the CRC during mount or a read
+        uint32_t flash_errors;
+        uint32_t reads;          // flash reads since mount, the mount's own cost right after it
+    } DetectionLogStats_t;
+
+    /**
+     * @brief Append-only log of fixed-size records on a ring of NOR sectors. Records are batched
+     *        into page-sized programs, sectors are erased ahead of the write head from
+     *        detection_log_service, the oldest sector is reclaimed when the ring is full (so
+     *        every sector is erased once per lap) and mount finds the head in O(sectors).
+     * Each sector starts with a header slot: the erase count is programmed right after the
+     * erase, the sector sequence when the sector is opened, both with their own CRC.
+     */
+    typedef struct
+    {
+        const NorFlash_t *flash;
+        uint32_t base; // device offset of the first sector
+        uint16_t n_sectors;
+        uint16_t slots_per_page;
+        uint32_t slots_per_sector;
+
+        DetectionLogSector_t sectors[DETECTION_LOG_MAX_SECTORS];
+        uint16_t head;      // sector receiving records
+        uint32_t head_slot; // next free slot of the head, slots_per_sector when full
+        uint32_t next_sector_seq;
+        uint32_t next_record_seq;
+        uint32_t durable_seq; // records below this sequence are programmed
+        int32_t erasing;      // sector erased in the background, -1 if none
+
+        // page being filled and a completed page waiting for detection_log_service
+        uint8_t pages[2][DETECTION_LOG_MAX_PAGE];
+        uint8_t fill;
+        uint8_t fill_active;
+        uint32_t fill_addr;
+        uint32_t fill_used;       // bytes of the page holding data
+        uint32_t fill_programmed; // bytes of the page already on flash
+        uint32_t fill_last_seq;
+        uint8_t pending;
+        uint32_t pending_addr;
+        uint32_t pending_from;
+        uint32_t pending_last_seq;
+
+        DetectionLogStats_t stats;
+    } DetectionLog_t;
+
+    /**
+     * @brief Walks the records on flash from the oldest to the newest.
+     */
+    typedef struct
+    {
+        uint16_t sector; // ring position, counts up to n_sectors
+        uint16_t first;  // oldest USED sector
+        uint32_t slot;
+        uint32_t page_addr;
+        uint8_t page[DETECTION_LOG_MAX_PAGE];
+    } DetectionLogIter_t;
+
+    /**
+     * @brief Scans the sector headers of the region and recovers the write position: the
+     *        newest USED sector by sequence, then the first erased page by binary search and
+     *        the last written slot of the page before it. Torn records are skipped, never
+     *        overwritten.
+     * @param base Device offset of the region, sector aligned
+     * @param n_sectors Sectors in the region, at least DETECTION_LOG_SPARE_SECTORS + 2
+     * @return 0 if successful, -1 on a bad geometry or a flash error
+     */
+    int detection_log_mount(DetectionLog_t *log, const NorFlash_t *flash, uint32_t base,
+                            uint16_t n_sectors);
+
+    /**
+     * @brief Copies a record into the RAM page buffer, no flash access. Dropped (and counted)
+     *        when the next sector is not erased yet or both page buffers wait for service.
+     * @param record Caller's fields; sequence, magic and crc are written back
+     * @return 0 if successful, -1 if the record was dropped
+     */
+    int detection_log_append(DetectionLog_t *log, DetectionRecord_t *record);
+
+    /**
+     * @brief Background step for the main loop: completes a finished erase, programs full
+     *        pages and starts the next erase when fewer than DETECTION_LOG_SPARE_SECTORS
+     *        sectors ahead of the head are erased. Never waits for an erase.
+     * @return 0 if successful, -1 on a flash error
+     */
+    int detection_log_service(DetectionLog_t *log);
+
+    /**
+     * @brief Programs every record still in RAM, the last page partially. Waits for a running
+     *        erase. Call before a planned power-down.
+     * @return 0 if successful, -1 on a flash error
+     */
+    int detection_log_flush(DetectionLog_t *log);
+
+    /**
+     * @brief Non-zero while a background erase runs. The board's weights share the QSPI
+     *        chips, so streamed or in-place weights must not be read until it returns 0.
+     */
+    int detection_log_busy(const DetectionLog_t *log);
+
+    /**
+     * @brief Starts a walk at the oldest record on flash; flush first to include RAM records.
+     */
+    void detection_log_iter_begin(const DetectionLog_t *log, DetectionLogIter_t *it);
+
+    /**
+     * @brief Next valid record of the walk, torn slots skipped.
+     * @return 1 if a record was read, 0 at the end, -1 on a flash error
+     */
+    int detection_log_iter_next(DetectionLog_t *log, DetectionLogIter_t *it,
+                                DetectionRecord_t *record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DETECTION_LOG_H
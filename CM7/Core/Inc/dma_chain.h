@@ -0,0 +1,70 @@
+// dma_chain.h
+#ifndef DMA_CHAIN_H
+#define DMA_CHAIN_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DMA_CHAIN_MAX_SEGMENTS 8
+// one MDMA block moves at most 64 KB (17-bit BNDT), longer copies are split
+#define DMA_CHAIN_MAX_BLOCK 65536u
+
+    typedef void (*DmaChainCallback_t)(void *ctx);
+
+    /**
+     * @brief One linked-list node: a contiguous copy with a single beat width.
+     */
+    typedef struct
+    {
+        uintptr_t src;
+        uintptr_t dst;
+        uint32_t len;
+        uint8_t width;           // bytes per beat: 1, 2 or 4
+        DmaChainCallback_t done; // called once this segment and every one before it landed
+        void *ctx;
+    } DmaSegment_t;
+
+    /**
+     * @brief Ordered copies executed back to back, e.g. D3 SRAM -> AXI SRAM -> SDRAM.
+     * A segment may read what an earlier segment of the same chain wrote.
+     */
+    typedef struct
+    {
+        DmaSegment_t segments[DMA_CHAIN_MAX_SEGMENTS];
+        uint8_t n_segments;
+    } DmaChain_t;
+
+    /**
+     * @brief Empties a chain.
+     */
+    void dma_chain_reset(DmaChain_t *chain);
+
+    /**
+     * @brief Appends a copy, split into blocks of at most DMA_CHAIN_MAX_BLOCK bytes. The beat
+     *        width is the widest that divides both addresses and the length.
+     * @param done Optional callback, runs after the last block of this copy
+     * @return 0 if successful, -1 if the chain has no room or the copy is empty
+     */
+    int dma_chain_add(DmaChain_t *chain, const void *src, void *dst, uint32_t len,
+                      DmaChainCallback_t done, void *ctx);
+
+    /**
+     * @brief Total bytes moved by the chain.
+     */
+    uint32_t dma_chain_bytes(const DmaChain_t *chain);
+
+    /**
+     * @brief Software DMA: executes the chain with the CPU in segment order, callbacks included.
+     *        Host stand-in for the MDMA service and a fallback when the channel is busy.
+     */
+    void dma_chain_run_software(const DmaChain_t *chain);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DMA_CHAIN_H
@@ -0,0 +1,53 @@
+// frame_prep.h
+#ifndef FRAME_PREP_H
+#define FRAME_PREP_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// int16 PCM full scale, folded into the window table instead of a divide per sample
+#define FRAME_PREP_PCM_SCALE (1.0f / 32768.0f)
+
+    /**
+     * @brief Multiplies a window by FRAME_PREP_PCM_SCALE in place, giving the table
+     *        frame_prep_f32 expects. Scaling by a power of two is exact, so the frames match
+     *        (pcm / 32768.0f) * window bit for bit.
+     */
+    void frame_prep_scale_window(float *window, uint32_t n);
+
+    /**
+     * @brief Converts a pre-scaled float window to the Q15 table of frame_prep_q15
+     *        (window * 32768 rounded, 1.0 saturated to 32767).
+     */
+    void frame_prep_window_q15(const float *scaled_window, int16_t *window_q15, uint32_t n);
+
+    /**
+     * @brief One windowed float frame: frame[i] = pcm[i] * window[i] for the samples present,
+     *        zeros after. The in-range body runs eight samples per iteration without a bounds
+     *        check; the padded tail is a single fill.
+     * @param pcm First sample of the frame
+     * @param available Samples readable from pcm, may be less than n at the end of a buffer
+     * @param window Window pre-scaled by frame_prep_scale_window
+     * @param frame Output, n floats
+     * @param n Frame length
+     */
+    void frame_prep_f32(const int16_t *pcm, uint32_t available, const float *window, float *frame,
+                        uint32_t n);
+
+    /**
+     * @brief Q15 variant for a fixed-point FFT: frame[i] = (pcm[i] * window_q15[i]) >> 15,
+     *        rounded. With the DSP extension samples go in 32-bit pairs through dual 16-bit
+     *        multiplies (the M7 allows them unaligned).
+     */
+    void frame_prep_q15(const int16_t *pcm, uint32_t available, const int16_t *window_q15,
+                        int16_t *frame, uint32_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_PREP_H
@@ -0,0 +1,71 @@
+// golden_check.h
+#ifndef GOLDEN_CHECK_H
+#define GOLDEN_CHECK_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// 1: main() checks the DSP path against the golden vectors at boot and prints the result (ITM)
+#ifndef USE_GOLDEN_CHECK
+#define USE_GOLDEN_CHECK 0
+#endif
+
+// per-stage tolerances against the float64 reference of tools/golden_gen.py
+#define GOLDEN_TOL_BAND_BIN 0         // band edges, in FFT bins
+#define GOLDEN_TOL_BAND_WEIGHT 1e-4f  // band weight sum and peak
+#define GOLDEN_TOL_MEL_DB 0.05f       // calculate_mel_spectrogram, dB
+#define GOLDEN_TOL_NORMALIZED 1e-3f   // normalize_spectrogram, [0, 1]
+#define GOLDEN_TOL_Q8 1               // calculate_mel_spectrogram_q8, int8 steps
+
+// feature pass budget per frame in profiler_now ticks: core cycles on target, ns on host
+#ifndef GOLDEN_BUDGET_TICKS_PER_FRAME
+#if defined(__arm__)
+#define GOLDEN_BUDGET_TICKS_PER_FRAME 100000u
+#else
+#define GOLDEN_BUDGET_TICKS_PER_FRAME 50000u
+#endif
+#endif
+// timed repetitions of each path, the fastest one is compared with the budget
+#define GOLDEN_PERF_RUNS 16
+
+    /**
+     * @brief Reference outline of one triangular band: nonzero bin span, weight sum and peak.
+     */
+    typedef struct
+    {
+        uint16_t first_bin;
+        uint16_t last_bin;
+        float sum;
+        float peak;
+    } GoldenBand_t;
+
+    /**
+     * @brief One reference input and its expected output after each stage.
+     */
+    typedef struct
+    {
+        const char *name;
+        const int16_t *pcm;      // GOLDEN_N_SAMPLES
+        const float *mel_db;     // n_mels x n_frames, calculate_mel_spectrogram
+        const float *normalized; // n_mels x n_frames, normalize_spectrogram
+        const int8_t *q8;        // n_mels x n_frames, calculate_mel_spectrogram_q8
+    } GoldenVector_t;
+
+    /**
+     * @brief Runs every golden vector through the filterbank, float, normalize and fused int8
+     *        paths, checks each stage against its tolerance and the feature pass against
+     *        GOLDEN_BUDGET_TICKS_PER_FRAME, and prints one line per check via printf.
+     *        Re-initializes the mel engine with its own buffers, so run it before the pipeline.
+     * @return number of failed checks, 0 if everything passed
+     */
+    int golden_check_run(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GOLDEN_CHECK_H
@@ -0,0 +1,1044 @@
+// golden_vectors.h
+// generated by tools/golden_gen.py from its float64 reference, do not edit
+#ifndef GOLDEN_VECTORS_H
+#define GOLDEN_VECTORS_H
+
+#include "golden_check.h"
+#include <stdint.h>
+
+#define GOLDEN_SAMPLE_RATE 16000
+#define GOLDEN_FFT_SIZE 512
+#define GOLDEN_HOP_LENGTH 256
+#define GOLDEN_N_MELS 64
+#define GOLDEN_N_FRAMES 8
+#define GOLDEN_N_SAMPLES 2304
+#define GOLDEN_F_MIN 0.0f
+#define GOLDEN_F_MAX 8000.0f
+#define GOLDEN_Q_SCALE (1.0f / 255.0f)
+#define GOLDEN_Q_ZERO_POINT (-128)
+#define GOLDEN_DB_FLOOR (-80.0f)
+#define GOLDEN_DB_CEIL (60.0f)
+
+static const GoldenBand_t golden_bands[GOLDEN_N_MELS] = {
+    {0, 0, 0.999999f, 0.999999f},
+    {1, 1, 0.999999f, 0.999999f},
+    {2, 2, 0.999999f, 0.999999f},
+    {3, 3, 0.999999f, 0.999999f},
+    {4, 4, 0.999999f, 0.999999f},
+    {5, 5, 0.999999f, 0.999999f},
+    {6, 7, 1.49999925f, 0.9999995f},
+    {7, 8, 1.49999875f, 0.999999f},
+    {9, 9, 0.999999f, 0.999999f},
+    {10, 10, 0.999999f, 0.999999f},
+    {11, 12, 1.49999925f, 0.9999995f},
+    {12, 13, 1.49999875f, 0.999999f},
+    {14, 15, 1.49999925f, 0.9999995f},
+    {15, 16, 1.49999875f, 0.999999f},
+    {17, 18, 1.49999925f, 0.9999995f},
+    {18, 19, 1.49999875f, 0.999999f},
+    {20, 21, 1.49999925f, 0.9999995f},
+    {21, 23, 1.999999f, 0.9999995f},
+    {23, 25, 1.999999f, 0.9999995f},
+    {25, 27, 1.999999f, 0.9999995f},
+    {27, 29, 1.999999f, 0.9999995f},
+    {29, 31, 1.999999f, 0.9999995f},
+    {31, 33, 1.999999f, 0.9999995f},
+    {33, 35, 1.999999f, 0.9999995f},
+    {35, 37, 1.999999f, 0.9999995f},
+    {37, 40, 2.49999908f, 0.999999667f},
+    {39, 42, 2.49999892f, 0.9999995f},
+    {42, 45, 2.49999908f, 0.999999667f},
+    {44, 48, 2.999999f, 0.999999667f},
+    {47, 51, 2.999999f, 0.999999667f},
+    {50, 54, 2.999999f, 0.999999667f},
+    {53, 57, 2.999999f, 0.999999667f},
+    {56, 60, 2.999999f, 0.999999667f},
+    {59, 63, 2.999999f, 0.999999667f},
+    {62, 67, 3.49999904f, 0.99999975f},
+    {65, 70, 3.49999896f, 0.999999667f},
+    {69, 74, 3.49999904f, 0.99999975f},
+    {72, 78, 3.999999f, 0.99999975f},
+    {76, 82, 3.999999f, 0.99999975f},
+    {80, 86, 3.999999f, 0.99999975f},
+    {84, 90, 3.999999f, 0.99999975f},
+    {88, 95, 4.49999903f, 0.9999998f},
+    {92, 99, 4.49999898f, 0.99999975f},
+    {97, 104, 4.49999903f, 0.9999998f},
+    {101, 109, 4.999999f, 0.9999998f},
+    {106, 115, 5.49999902f, 0.999999833f},
+    {111, 120, 5.49999898f, 0.9999998f},
+    {117, 126, 5.49999902f, 0.999999833f},
+    {122, 132, 5.999999f, 0.999999833f},
+    {128, 138, 5.999999f, 0.999999833f},
+    {134, 144, 5.999999f, 0.999999833f},
+    {140, 151, 6.49999901f, 0.999999857f},
+    {146, 158, 6.999999f, 0.999999857f},
+    {153, 165, 6.999999f, 0.999999857f},
+    {160, 172, 6.999999f, 0.999999857f},
+    {167, 180, 7.49999901f, 0.999999875f},
+    {174, 188, 7.999999f, 0.999999875f},
+    {182, 197, 8.49999901f, 0.999999889f},
+    {190, 205, 8.49999899f, 0.999999875f},
+    {199, 215, 8.99999901f, 0.9999999f},
+    {207, 224, 9.49999899f, 0.999999889f},
+    {217, 234, 9.49999901f, 0.9999999f},
+    {226, 244, 9.999999f, 0.9999999f},
+    {236, 255, 10.499999f, 0.999999909f},
+};
+
+static const int16_t golden_pcm_tone_1k[2304] = {
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+    0, 3061, 5657, 7391, 8000, 7391, 5657, 3061, 0, -3061, -5657, -7391, -8000, -7391, -5657, -3061,
+};
+
+static const float golden_mel_db_tone_1k[512] = {
+    -59.9976595f, -59.9976595f, -59.9976595f, -59.9976595f, -59.9976595f, -59.9976595f, -59.9976595f, -59.9976595f,
+    -59.9974101f, -59.9974101f, -59.9974101f, -59.9974101f, -59.9974101f, -59.9974101f, -59.9974101f, -59.9974101f,
+    -59.9966505f, -59.9966505f, -59.9966505f, -59.9966505f, -59.9966505f, -59.9966505f, -59.9966505f, -59.9966505f,
+    -59.995345f, -59.995345f, -59.995345f, -59.995345f, -59.995345f, -59.995345f, -59.995345f, -59.995345f,
+    -59.9934312f, -59.9934312f, -59.9934312f, -59.9934312f, -59.9934312f, -59.9934312f, -59.9934312f, -59.9934312f,
+    -59.9908155f, -59.9908155f, -59.9908155f, -59.9908155f, -59.9908155f, -59.9908155f, -59.9908155f, -59.9908155f,
+    -59.9788312f, -59.9788312f, -59.9788312f, -59.9788312f, -59.9788312f, -59.9788312f, -59.9788312f, -59.9788312f,
+    -59.9686547f, -59.9686547f, -59.9686547f, -59.9686547f, -59.9686547f, -59.9686547f, -59.9686547f, -59.9686547f,
+    -59.9698404f, -59.9698404f, -59.9698404f, -59.9698404f, -59.9698404f, -59.9698404f, -59.9698404f, -59.9698404f,
+    -59.9604587f, -59.9604587f, -59.9604587f, -59.9604587f, -59.9604587f, -59.9604587f, -59.9604587f, -59.9604587f,
+    -59.9150728f, -59.9150728f, -59.9150728f, -59.9150728f, -59.9150728f, -59.9150728f, -59.9150728f, -59.9150728f,
+    -59.8794282f, -59.8794282f, -59.8794282f, -59.8794282f, -59.8794282f, -59.8794282f, -59.8794282f, -59.8794282f,
+    -59.8120829f, -59.8120829f, -59.8120829f, -59.8120829f, -59.8120829f, -59.8120829f, -59.8120829f, -59.8120829f,
+    -59.7298444f, -59.7298444f, -59.7298444f, -59.7298444f, -59.7298444f, -59.7298444f, -59.7298444f, -59.7298444f,
+    -59.5659512f, -59.5659512f, -59.5659512f, -59.5659512f, -59.5659512f, -59.5659512f, -59.5659512f, -59.5659512f,
+    -59.3545499f, -59.3545499f, -59.3545499f, -59.3545499f, -59.3545499f, -59.3545499f, -59.3545499f, -59.3545499f,
+    -58.9060228f, -58.9060228f, -58.9060228f, -58.9060228f, -58.9060228f, -58.9060228f, -58.9060228f, -58.9060228f,
+    -57.5473902f, -57.5473902f, -57.5473902f, -57.5473902f, -57.5473902f, -57.5473902f, -57.5473902f, -57.5473902f,
+    -55.2530502f, -55.2530502f, -55.2530502f, -55.2530502f, -55.2530502f, -55.2530502f, -55.2530502f, -55.2530502f,
+    -50.9591316f, -50.9591316f, -50.9591316f, -50.9591316f, -50.9591316f, -50.9591316f, -50.9591316f, -50.9591316f,
+    -43.0077664f, -43.0077664f, -43.0077664f, -43.0077664f, -43.0077664f, -43.0077664f, -43.0077664f, -43.0077664f,
+    20.8744946f, 20.8744946f, 20.8744946f, 20.8744946f, 20.8744946f, 20.8744946f, 20.8744946f, 20.8744946f,
+    30.8541509f, 30.8541509f, 30.8541509f, 30.8541509f, 30.8541509f, 30.8541509f, 30.8541509f, 30.8541509f,
+    20.8744941f, 20.8744941f, 20.8744941f, 20.8744941f, 20.8744941f, 20.8744941f, 20.8744941f, 20.8744941f,
+    -43.0026085f, -43.0026085f, -43.0026085f, -43.0026085f, -43.0026085f, -43.0026085f, -43.0026085f, -43.0026085f,
+    -50.6394708f, -50.6394708f, -50.6394708f, -50.6394708f, -50.6394708f, -50.6394708f, -50.6394708f, -50.6394708f,
+    -55.3668623f, -55.3668623f, -55.3668623f, -55.3668623f, -55.3668623f, -55.3668623f, -55.3668623f, -55.3668623f,
+    -57.9731553f, -57.9731553f, -57.9731553f, -57.9731553f, -57.9731553f, -57.9731553f, -57.9731553f, -57.9731553f,
+    -58.8604268f, -58.8604268f, -58.8604268f, -58.8604268f, -58.8604268f, -58.8604268f, -58.8604268f, -58.8604268f,
+    -59.4638884f, -59.4638884f, -59.4638884f, -59.4638884f, -59.4638884f, -59.4638884f, -59.4638884f, -59.4638884f,
+    -59.7227749f, -59.7227749f, -59.7227749f, -59.7227749f, -59.7227749f, -59.7227749f, -59.7227749f, -59.7227749f,
+    -59.8448209f, -59.8448209f, -59.8448209f, -59.8448209f, -59.8448209f, -59.8448209f, -59.8448209f, -59.8448209f,
+    -59.9074045f, -59.9074045f, -59.9074045f, -59.9074045f, -59.9074045f, -59.9074045f, -59.9074045f, -59.9074045f,
+    -59.9418241f, -59.9418241f, -59.9418241f, -59.9418241f, -59.9418241f, -59.9418241f, -59.9418241f, -59.9418241f,
+    -59.9572517f, -59.9572517f, -59.9572517f, -59.9572517f, -59.9572517f, -59.9572517f, -59.9572517f, -59.9572517f,
+    -59.9720599f, -59.9720599f, -59.9720599f, -59.9720599f, -59.9720599f, -59.9720599f, -59.9720599f, -59.9720599f,
+    -59.9817939f, -59.9817939f, -59.9817939f, -59.9817939f, -59.9817939f, -59.9817939f, -59.9817939f, -59.9817939f,
+    -59.9858964f, -59.9858964f, -59.9858964f, -59.9858964f, -59.9858964f, -59.9858964f, -59.9858964f, -59.9858964f,
+    -59.990502f, -59.990502f, -59.990502f, -59.990502f, -59.990502f, -59.990502f, -59.990502f, -59.990502f,
+    -59.9934113f, -59.9934113f, -59.9934113f, -59.9934113f, -59.9934113f, -59.9934113f, -59.9934113f, -59.9934113f,
+    -59.9953151f, -59.9953151f, -59.9953151f, -59.9953151f, -59.9953151f, -59.9953151f, -59.9953151f, -59.9953151f,
+    -59.9087599f, -59.9087599f, -59.9087599f, -59.9087599f, -59.9087599f, -59.9087599f, -59.9087599f, -59.9087599f,
+    -58.1776245f, -58.1776245f, -58.1776245f, -58.1776245f, -58.1776245f, -58.1776245f, -58.1776245f, -58.1776245f,
+    -59.8893962f, -59.8893962f, -59.8893962f, -59.8893962f, -59.8893962f, -59.8893962f, -59.8893962f, -59.8893962f,
+    -59.9983886f, -59.9983886f, -59.9983886f, -59.9983886f, -59.9983886f, -59.9983886f, -59.9983886f, -59.9983886f,
+    -59.9987151f, -59.9987151f, -59.9987151f, -59.9987151f, -59.9987151f, -59.9987151f, -59.9987151f, -59.9987151f,
+    -59.999053f, -59.999053f, -59.999053f, -59.999053f, -59.999053f, -59.999053f, -59.999053f, -59.999053f,
+    -59.9993019f, -59.9993019f, -59.9993019f, -59.9993019f, -59.9993019f, -59.9993019f, -59.9993019f, -59.9993019f,
+    -59.9994275f, -59.9994275f, -59.9994275f, -59.9994275f, -59.9994275f, -59.9994275f, -59.9994275f, -59.9994275f,
+    -59.99957f, -59.99957f, -59.99957f, -59.99957f, -59.99957f, -59.99957f, -59.99957f, -59.99957f,
+    -59.9996719f, -59.9996719f, -59.9996719f, -59.9996719f, -59.9996719f, -59.9996719f, -59.9996719f, -59.9996719f,
+    -59.9997286f, -59.9997286f, -59.9997286f, -59.9997286f, -59.9997286f, -59.9997286f, -59.9997286f, -59.9997286f,
+    -59.9997819f, -59.9997819f, -59.9997819f, -59.9997819f, -59.9997819f, -59.9997819f, -59.9997819f, -59.9997819f,
+    -56.3281618f, -56.3281618f, -56.3281618f, -56.3281618f, -56.3281618f, -56.3281618f, -56.3281618f, -56.3281618f,
+    -59.1309796f, -59.1309796f, -59.1309796f, -59.1309796f, -59.1309796f, -59.1309796f, -59.1309796f, -59.1309796f,
+    -59.9998866f, -59.9998866f, -59.9998866f, -59.9998866f, -59.9998866f, -59.9998866f, -59.9998866f, -59.9998866f,
+    -59.9999035f, -59.9999035f, -59.9999035f, -59.9999035f, -59.9999035f, -59.9999035f, -59.9999035f, -59.9999035f,
+    -59.9999185f, -59.9999185f, -59.9999185f, -59.9999185f, -59.9999185f, -59.9999185f, -59.9999185f, -59.9999185f,
+    -59.999934f, -59.999934f, -59.999934f, -59.999934f, -59.999934f, -59.999934f, -59.999934f, -59.999934f,
+    -59.999943f, -59.999943f, -59.999943f, -59.999943f, -59.999943f, -59.999943f, -59.999943f, -59.999943f,
+    -59.7340344f, -59.7340344f, -59.7340344f, -59.7340344f, -59.7340344f, -59.7340344f, -59.7340344f, -59.7340344f,
+    -58.2242081f, -58.2242081f, -58.2242081f, -58.2242081f, -58.2242081f, -58.2242081f, -58.2242081f, -58.2242081f,
+    -59.9999598f, -59.9999598f, -59.9999598f, -59.9999598f, -59.9999598f, -59.9999598f, -59.9999598f, -59.9999598f,
+    -59.9999605f, -59.9999605f, -59.9999605f, -59.9999605f, -59.9999605f, -59.9999605f, -59.9999605f, -59.9999605f,
+};
+
+static const float golden_normalized_tone_1k[512] = {
+    2.53262002e-05f, 2.53262002e-05f, 2.53262002e-05f, 2.53262002e-05f, 2.53262002e-05f, 2.53262002e-05f, 2.53262002e-05f, 2.53262002e-05f,
+    2.80706249e-05f, 2.80706249e-05f, 2.80706249e-05f, 2.80706249e-05f, 2.80706249e-05f, 2.80706249e-05f, 2.80706249e-05f, 2.80706249e-05f,
+    3.64315332e-05f, 3.64315332e-05f, 3.64315332e-05f, 3.64315332e-05f, 3.64315332e-05f, 3.64315332e-05f, 3.64315332e-05f, 3.64315332e-05f,
+    5.08011668e-05f, 5.08011668e-05f, 5.08011668e-05f, 5.08011668e-05f, 5.08011668e-05f, 5.08011668e-05f, 5.08011668e-05f, 5.08011668e-05f,
+    7.18654078e-05f, 7.18654078e-05f, 7.18654078e-05f, 7.18654078e-05f, 7.18654078e-05f, 7.18654078e-05f, 7.18654078e-05f, 7.18654078e-05f,
+    0.000100655715f, 0.000100655715f, 0.000100655715f, 0.000100655715f, 0.000100655715f, 0.000100655715f, 0.000100655715f, 0.000100655715f,
+    0.000232562337f, 0.000232562337f, 0.000232562337f, 0.000232562337f, 0.000232562337f, 0.000232562337f, 0.000232562337f, 0.000232562337f,
+    0.00034457178f, 0.00034457178f, 0.00034457178f, 0.00034457178f, 0.00034457178f, 0.00034457178f, 0.00034457178f, 0.00034457178f,
+    0.000331520714f, 0.000331520714f, 0.000331520714f, 0.000331520714f, 0.000331520714f, 0.000331520714f, 0.000331520714f, 0.000331520714f,
+    0.000434782243f, 0.000434782243f, 0.000434782243f, 0.000434782243f, 0.000434782243f, 0.000434782243f, 0.000434782243f, 0.000434782243f,
+    0.000934329065f, 0.000934329065f, 0.000934329065f, 0.000934329065f, 0.000934329065f, 0.000934329065f, 0.000934329065f, 0.000934329065f,
+    0.00132665689f, 0.00132665689f, 0.00132665689f, 0.00132665689f, 0.00132665689f, 0.00132665689f, 0.00132665689f, 0.00132665689f,
+    0.00206790394f, 0.00206790394f, 0.00206790394f, 0.00206790394f, 0.00206790394f, 0.00206790394f, 0.00206790394f, 0.00206790394f,
+    0.00297307488f, 0.00297307488f, 0.00297307488f, 0.00297307488f, 0.00297307488f, 0.00297307488f, 0.00297307488f, 0.00297307488f,
+    0.00477699068f, 0.00477699068f, 0.00477699068f, 0.00477699068f, 0.00477699068f, 0.00477699068f, 0.00477699068f, 0.00477699068f,
+    0.00710381254f, 0.00710381254f, 0.00710381254f, 0.00710381254f, 0.00710381254f, 0.00710381254f, 0.00710381254f, 0.00710381254f,
+    0.0120405963f, 0.0120405963f, 0.0120405963f, 0.0120405963f, 0.0120405963f, 0.0120405963f, 0.0120405963f, 0.0120405963f,
+    0.0269945982f, 0.0269945982f, 0.0269945982f, 0.0269945982f, 0.0269945982f, 0.0269945982f, 0.0269945982f, 0.0269945982f,
+    0.0522476111f, 0.0522476111f, 0.0522476111f, 0.0522476111f, 0.0522476111f, 0.0522476111f, 0.0522476111f, 0.0522476111f,
+    0.0995092981f, 0.0995092981f, 0.0995092981f, 0.0995092981f, 0.0995092981f, 0.0995092981f, 0.0995092981f, 0.0995092981f,
+    0.187027244f, 0.187027244f, 0.187027244f, 0.187027244f, 0.187027244f, 0.187027244f, 0.187027244f, 0.187027244f,
+    0.890157351f, 0.890157351f, 0.890157351f, 0.890157351f, 0.890157351f, 0.890157351f, 0.890157351f, 0.890157351f,
+    1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f,
+    0.890157346f, 0.890157346f, 0.890157346f, 0.890157346f, 0.890157346f, 0.890157346f, 0.890157346f, 0.890157346f,
+    0.187084015f, 0.187084015f, 0.187084015f, 0.187084015f, 0.187084015f, 0.187084015f, 0.187084015f, 0.187084015f,
+    0.103027694f, 0.103027694f, 0.103027694f, 0.103027694f, 0.103027694f, 0.103027694f, 0.103027694f, 0.103027694f,
+    0.0509949203f, 0.0509949203f, 0.0509949203f, 0.0509949203f, 0.0509949203f, 0.0509949203f, 0.0509949203f, 0.0509949203f,
+    0.0223083487f, 0.0223083487f, 0.0223083487f, 0.0223083487f, 0.0223083487f, 0.0223083487f, 0.0223083487f, 0.0223083487f,
+    0.0125424551f, 0.0125424551f, 0.0125424551f, 0.0125424551f, 0.0125424551f, 0.0125424551f, 0.0125424551f, 0.0125424551f,
+    0.0059003614f, 0.0059003614f, 0.0059003614f, 0.0059003614f, 0.0059003614f, 0.0059003614f, 0.0059003614f, 0.0059003614f,
+    0.00305088629f, 0.00305088629f, 0.00305088629f, 0.00305088629f, 0.00305088629f, 0.00305088629f, 0.00305088629f, 0.00305088629f,
+    0.00170756828f, 0.00170756828f, 0.00170756828f, 0.00170756828f, 0.00170756828f, 0.00170756828f, 0.00170756828f, 0.00170756828f,
+    0.00101873159f, 0.00101873159f, 0.00101873159f, 0.00101873159f, 0.00101873159f, 0.00101873159f, 0.00101873159f, 0.00101873159f,
+    0.00063988717f, 0.00063988717f, 0.00063988717f, 0.00063988717f, 0.00063988717f, 0.00063988717f, 0.00063988717f, 0.00063988717f,
+    0.000470080248f, 0.000470080248f, 0.000470080248f, 0.000470080248f, 0.000470080248f, 0.000470080248f, 0.000470080248f, 0.000470080248f,
+    0.000307091636f, 0.000307091636f, 0.000307091636f, 0.000307091636f, 0.000307091636f, 0.000307091636f, 0.000307091636f, 0.000307091636f,
+    0.000199952856f, 0.000199952856f, 0.000199952856f, 0.000199952856f, 0.000199952856f, 0.000199952856f, 0.000199952856f, 0.000199952856f,
+    0.000154798023f, 0.000154798023f, 0.000154798023f, 0.000154798023f, 0.000154798023f, 0.000154798023f, 0.000154798023f, 0.000154798023f,
+    0.000104105658f, 0.000104105658f, 0.000104105658f, 0.000104105658f, 0.000104105658f, 0.000104105658f, 0.000104105658f, 0.000104105658f,
+    7.20844804e-05f, 7.20844804e-05f, 7.20844804e-05f, 7.20844804e-05f, 7.20844804e-05f, 7.20844804e-05f, 7.20844804e-05f, 7.20844804e-05f,
+    5.11299134e-05f, 5.11299134e-05f, 5.11299134e-05f, 5.11299134e-05f, 5.11299134e-05f, 5.11299134e-05f, 5.11299134e-05f, 5.11299134e-05f,
+    0.00100381351f, 0.00100381351f, 0.00100381351f, 0.00100381351f, 0.00100381351f, 0.00100381351f, 0.00100381351f, 0.00100381351f,
+    0.0200578259f, 0.0200578259f, 0.0200578259f, 0.0200578259f, 0.0200578259f, 0.0200578259f, 0.0200578259f, 0.0200578259f,
+    0.00121694301f, 0.00121694301f, 0.00121694301f, 0.00121694301f, 0.00121694301f, 0.00121694301f, 0.00121694301f, 0.00121694301f,
+    1.73012803e-05f, 1.73012803e-05f, 1.73012803e-05f, 1.73012803e-05f, 1.73012803e-05f, 1.73012803e-05f, 1.73012803e-05f, 1.73012803e-05f,
+    1.37067001e-05f, 1.37067001e-05f, 1.37067001e-05f, 1.37067001e-05f, 1.37067001e-05f, 1.37067001e-05f, 1.37067001e-05f, 1.37067001e-05f,
+    9.98851934e-06f, 9.98851934e-06f, 9.98851934e-06f, 9.98851934e-06f, 9.98851934e-06f, 9.98851934e-06f, 9.98851934e-06f, 9.98851934e-06f,
+    7.24874773e-06f, 7.24874773e-06f, 7.24874773e-06f, 7.24874773e-06f, 7.24874773e-06f, 7.24874773e-06f, 7.24874773e-06f, 7.24874773e-06f,
+    5.86576503e-06f, 5.86576503e-06f, 5.86576503e-06f, 5.86576503e-06f, 5.86576503e-06f, 5.86576503e-06f, 5.86576503e-06f, 5.86576503e-06f,
+    4.29704359e-06f, 4.29704359e-06f, 4.29704359e-06f, 4.29704359e-06f, 4.29704359e-06f, 4.29704359e-06f, 4.29704359e-06f, 4.29704359e-06f,
+    3.17641815e-06f, 3.17641815e-06f, 3.17641815e-06f, 3.17641815e-06f, 3.17641815e-06f, 3.17641815e-06f, 3.17641815e-06f, 3.17641815e-06f,
+    2.55196764e-06f, 2.55196764e-06f, 2.55196764e-06f, 2.55196764e-06f, 2.55196764e-06f, 2.55196764e-06f, 2.55196764e-06f, 2.55196764e-06f,
+    1.96549575e-06f, 1.96549575e-06f, 1.96549575e-06f, 1.96549575e-06f, 1.96549575e-06f, 1.96549575e-06f, 1.96549575e-06f, 1.96549575e-06f,
+    0.0404142271f, 0.0404142271f, 0.0404142271f, 0.0404142271f, 0.0404142271f, 0.0404142271f, 0.0404142271f, 0.0404142271f,
+    0.00956457429f, 0.00956457429f, 0.00956457429f, 0.00956457429f, 0.00956457429f, 0.00956457429f, 0.00956457429f, 0.00956457429f,
+    8.12376347e-07f, 8.12376347e-07f, 8.12376347e-07f, 8.12376347e-07f, 8.12376347e-07f, 8.12376347e-07f, 8.12376347e-07f, 8.12376347e-07f,
+    6.27268763e-07f, 6.27268763e-07f, 6.27268763e-07f, 6.27268763e-07f, 6.27268763e-07f, 6.27268763e-07f, 6.27268763e-07f, 6.27268763e-07f,
+    4.61516604e-07f, 4.61516604e-07f, 4.61516604e-07f, 4.61516604e-07f, 4.61516604e-07f, 4.61516604e-07f, 4.61516604e-07f, 4.61516604e-07f,
+    2.90964592e-07f, 2.90964592e-07f, 2.90964592e-07f, 2.90964592e-07f, 2.90964592e-07f, 2.90964592e-07f, 2.90964592e-07f, 2.90964592e-07f,
+    1.91804327e-07f, 1.91804327e-07f, 1.91804327e-07f, 1.91804327e-07f, 1.91804327e-07f, 1.91804327e-07f, 1.91804327e-07f, 1.91804327e-07f,
+    0.00292695616f, 0.00292695616f, 0.00292695616f, 0.00292695616f, 0.00292695616f, 0.00292695616f, 0.00292695616f, 0.00292695616f,
+    0.0195450967f, 0.0195450967f, 0.0195450967f, 0.0195450967f, 0.0195450967f, 0.0195450967f, 0.0195450967f, 0.0195450967f,
+    7.32849395e-09f, 7.32849395e-09f, 7.32849395e-09f, 7.32849395e-09f, 7.32849395e-09f, 7.32849395e-09f, 7.32849395e-09f, 7.32849395e-09f,
+    0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+};
+
+static const int8_t golden_q8_tone_1k[512] = {
+    -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92,
+    -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92,
+    -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92,
+    -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92,
+    -92, -92, -92, -92, -92, -92, -92, -92, -91, -91, -91, -91, -91, -91, -91, -91,
+    -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91,
+    -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91,
+    -91, -91, -91, -91, -91, -91, -91, -91, -90, -90, -90, -90, -90, -90, -90, -90,
+    -90, -90, -90, -90, -90, -90, -90, -90, -87, -87, -87, -87, -87, -87, -87, -87,
+    -83, -83, -83, -83, -83, -83, -83, -83, -75, -75, -75, -75, -75, -75, -75, -75,
+    -61, -61, -61, -61, -61, -61, -61, -61, 56, 56, 56, 56, 56, 56, 56, 56,
+    74, 74, 74, 74, 74, 74, 74, 74, 56, 56, 56, 56, 56, 56, 56, 56,
+    -61, -61, -61, -61, -61, -61, -61, -61, -75, -75, -75, -75, -75, -75, -75, -75,
+    -83, -83, -83, -83, -83, -83, -83, -83, -88, -88, -88, -88, -88, -88, -88, -88,
+    -89, -89, -89, -89, -89, -89, -89, -89, -91, -91, -91, -91, -91, -91, -91, -91,
+    -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91,
+    -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91, -91,
+    -91, -91, -91, -91, -91, -91, -91, -91, -92, -92, -92, -92, -92, -92, -92, -92,
+    -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92,
+    -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92,
+    -92, -92, -92, -92, -92, -92, -92, -92, -91, -91, -91, -91, -91, -91, -91, -91,
+    -88, -88, -88, -88, -88, -88, -88, -88, -91, -91, -91, -91, -91, -91, -91, -91,
+    -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92,
+    -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92,
+    -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92,
+    -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92,
+    -92, -92, -92, -92, -92, -92, -92, -92, -85, -85, -85, -85, -85, -85, -85, -85,
+    -90, -90, -90, -90, -90, -90, -90, -90, -92, -92, -92, -92, -92, -92, -92, -92,
+    -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92,
+    -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92,
+    -91, -91, -91, -91, -91, -91, -91, -91, -88, -88, -88, -88, -88, -88, -88, -88,
+    -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92, -92,
+};
+
+static const int16_t golden_pcm_chirp_noise[2304] = {
+    -270, 340, 954, 1635, 1438, 2230, 3099, 3314, 3181, 4217, 4190, 4706, 5183, 5703, 5311, 6255,
+    6263, 5796, 6186, 6003, 5594, 5336, 5099, 5093, 4582, 4803, 4251, 3570, 2932, 2872, 2462, 1067,
+    582, 585, -691, -1194, -1934, -2030, -2761, -3501, -3775, -4228, -5476, -5591, -5531, -6244, -5997, -6322,
+    -5800, -5325, -5598, -5545, -4132, -4329, -3101, -3249, -2151, -1725, -618, -22, 1488, 1874, 2372, 3565,
+    4408, 5127, 4669, 5072, 6332, 6282, 5947, 5772, 5820, 5755, 5030, 4178, 3401, 2337, 2254, 1188,
+    139, -862, -1826, -3207, -3646, -4230, -4459, -5578, -5479, -6191, -5573, -5409, -5631, -5172, -4644, -4240,
+    -2725, -1687, -987, 120, 1519, 1967, 2634, 3852, 4905, 4896, 5527, 5669, 5723, 6084, 5425, 4970,
+    4186, 3706, 2176, 890, 451, -973, -2177, -3387, -4140, -5381, -5099, -5558, -6503, -6184, -5439, -5401,
+    -4044, -3158, -2069, -878, -69, 1838, 3281, 4105, 4747, 5725, 5682, 6139, 6362, 5288, 5134, 4052,
+    2972, 1301, -121, -901, -1908, -3862, -4917, -4766, -6043, -6172, -6121, -5581, -4570, -4050, -2979, -1806,
+    199, 1580, 2757, 3903, 4765, 5072, 6148, 5541, 6020, 5140, 4144, 2806, 1654, -293, -1319, -3046,
+    -4227, -4950, -5448, -5686, -5389, -5091, -4755, -3056, -2443, -363, 570, 2097, 3543, 5174, 5451, 6152,
+    6243, 5302, 4830, 3171, 1933, -240, -1318, -3120, -4266, -5623, -6348, -6391, -5278, -5064, -3712, -2378,
+    -951, 938, 3028, 3567, 4862, 6074, 5990, 5697, 5215, 4165, 2228, 758, -1488, -2725, -4624, -4800,
+    -6038, -6166, -5753, -4959, -3449, -1640, 729, 2345, 3325, 5204, 5878, 6039, 5537, 5132, 3402, 1866,
+    -260, -1980, -3436, -4698, -5838, -5774, -5544, -4642, -3093, -1339, 789, 2502, 4319, 4969, 5910, 5710,
+    5106, 4239, 2595, 942, -1112, -3278, -4110, -5991, -5695, -6118, -4440, -3407, -1814, 855, 2407, 4510,
+    5612, 5855, 5685, 5362, 3807, 1143, -292, -2584, -3874, -5774, -6154, -5566, -4336, -3108, -956, 861,
+    3230, 4497, 5658, 5656, 5828, 4702, 3010, 498, -1812, -3395, -5485, -6413, -5664, -4661, -3795, -1498,
+    912, 2521, 4822, 5518, 6377, 5895, 4135, 2024, 88, -2016, -4454, -5875, -6377, -5511, -4016, -2063,
+    -110, 2243, 4371, 5104, 6342, 5871, 4525, 2013, 238, -2792, -4675, -5912, -5640, -5840, -4075, -1300,
+    1072, 3351, 4978, 5895, 6149, 4925, 2882, 912, -1840, -3578, -5731, -5664, -5473, -4508, -2147, 714,
+    2930, 4410, 5762, 6157, 4928, 3417, 964, -1969, -4167, -5965, -6321, -4965, -3393, -1359, 1052, 4250,
+    5280, 6508, 5893, 3670, 1363, -1354, -3612, -5588, -6015, -5321, -4372, -1309, 1522, 3175, 5312, 5771,
+    5447, 3879, 1066, -980, -3651, -5368, -6129, -5220, -3324, -1122, 2423, 4475, 5622, 6410, 5137, 2796,
+    -439, -2274, -5150, -5674, -5506, -4681, -2154, 630, 3368, 5370, 5917, 5285, 3417, 955, -2844, -4193,
+    -6245, -5577, -4417, -1965, 1303, 4200, 6048, 6208, 4571, 3155, 387, -2554, -5588, -5636, -4926, -3355,
+    -928, 2025, 4730, 6153, 5371, 4362, 1726, -1973, -4183, -5321, -6284, -3906, -1883, 1751, 4199, 5531,
+    6265, 4459, 1870, -848, -3681, -5467, -5574, -4775, -1880, 1512, 4199, 6067, 5886, 4752, 2036, -902,
+    -4547, -5933, -6320, -4143, -1546, 1978, 4304, 5436, 5863, 3407, 1156, -2004, -4979, -6141, -5414, -2806,
+    117, 3225, 5734, 5721, 5316, 2385, -728, -3784, -5681, -5311, -4423, -748, 2013, 5283, 5852, 5646,
+    3217, -161, -4009, -5489, -5754, -4218, -1539, 2127, 5143, 6382, 5601, 3371, -439, -3514, -5499, -5670,
+    -3619, -1091, 1983, 4601, 6000, 4748, 2598, -915, -4317, -5730, -5111, -3422, -422, 3609, 6038, 5446,
+    4284, 1139, -3056, -5388, -5487, -4184, -1846, 1464, 4642, 5653, 4908, 2517, -849, -4220, -6159, -5825,
+    -3314, 877, 4426, 5864, 5079, 3487, -139, -3559, -5465, -5446, -3597, -351, 3961, 6112, 6015, 3978,
+    -193, -3997, -5234, -5890, -3556, -180, 3186, 5554, 5778, 3744, 50, -3482, -5449, -5607, -2870, 286,
+    4274, 6080, 4839, 2133, -1495, -4969, -6363, -5514, -2194, 2148, 5178, 6435, 4273, 1194, -2277, -5159,
+    -5389, -4458, -274, 3315, 5978, 5581, 3523, -1073, -4716, -6411, -5515, -2363, 1836, 4959, 6118, 4628,
+    241, -3568, -5511, -5982, -3267, 1096, 4799, 6391, 5305, 1953, -2097, -5167, -5722, -3782, -336, 3814,
+    5945, 5170, 2007, -1833, -5041, -5945, -4249, -631, 3336, 5981, 4803, 1724, -1731, -5398, -5969, -3410,
+    486, 3645, 6270, 5364, 2303, -2130, -5015, -5645, -3783, 354, 4910, 5997, 4437, 1134, -3040, -5857,
+    -5536, -2345, 1623, 5420, 5644, 4124, -288, -4800, -5855, -4528, -642, 3005, 5311, 5530, 2355, -2440,
+    -5906, -5232, -3212, 1339, 4372, 6378, 3852, -685, -4709, -5637, -4588, -648, 3690, 6175, 5098, 1382,
+    -2869, -6021, -5663, -2497, 1908, 5301, 5642, 2458, -2034, -4766, -5902, -3544, 897, 4485, 6358, 3727,
+    -1048, -4559, -5903, -3644, 321, 4427, 5843, 3889, -26, -4256, -6087, -4357, -277, 4482, 5872, 4020,
+    -5, -4013, -5637, -4470, -114, 4516, 6458, 3811, -214, -4207, -5720, -4184, 397, 4754, 5839, 3535,
+    -1149, -4299, -5757, -3620, 1614, 4655, 5404, 3514, -2181, -5691, -6018, -2822, 1801, 5952, 5212, 2161,
+    -2927, -5315, -5305, -1190, 3793, 5491, 4452, 744, -4273, -5536, -3973, 540, 4542, 5574, 2780, -1476,
+    -4994, -5594, -2064, 2986, 5505, 4954, 482, -4345, -6277, -4320, 266, 5237, 5995, 3292, -1513, -5438,
+    -5782, -1842, 3145, 5692, 4136, -386, -4905, -6406, -3815, 1775, 5196, 5709, 1382, -3009, -6371, -4644,
+    -89, 4947, 5914, 2790, -1813, -5178, -5781, -967, 3724, 6446, 4101, -1160, -5081, -5958, -2676, 2475,
+    6273, 4777, 479, -4546, -5459, -3248, 1884, 5405, 4735, 114, -4249, -5912, -3360, 1649, 5986, 5011,
+    1181, -4020, -6483, -3278, 1755, 5547, 4705, 1213, -4486, -5627, -2629, 1643, 6007, 4875, 181, -4225,
+    -5904, -2886, 2335, 5640, 4814, -263, -4774, -5730, -2350, 2925, 6009, 4106, -1374, -5586, -4867, -702,
+    3966, 6161, 3492, -2526, -5735, -4203, 547, 5297, 5904, 2044, -3390, -6108, -3225, 2047, 5829, 5259,
+    -25, -5056, -5850, -1944, 3757, 5731, 3742, -1873, -5284, -5186, 520, 4863, 5853, 1666, -4125, -5793,
+    -3154, 2552, 6384, 4120, -1516, -5964, -5345, -113, 4714, 6017, 1397, -3567, -6383, -2948, 2345, 6082,
+    4481, -822, -5098, -5374, 451, 4552, 5638, 1173, -3877, -5572, -1887, 3510, 6361, 3371, -2548, -5590,
+    -3966, 1655, 5524, 5287, -99, -5589, -4844, -374, 5210, 5774, 1780, -3692, -5539, -2618, 3174, 5582,
+    2658, -3095, -5909, -3302, 1974, 5897, 3555, -1615, -6087, -4344, 1525, 5373, 5251, -975, -5106, -5596,
+    -306, 4753, 5124, -40, -5287, -5570, -340, 5051, 5971, 837, -4245, -6232, -1688, 4065, 5779, 1381,
+    -3705, -5612, -2021, 4185, 5792, 2288, -4353, -6009, -2191, 3997, 5511, 2143, -3646, -5766, -1742, 4382,
+    5552, 2020, -4045, -5510, -1903, 4404, 5896, 1267, -3993, -5882, -1294, 4149, 5221, 1307, -4138, -5227,
+    -754, 4607, 4992, 526, -4597, -5635, 183, 5102, 5291, -1121, -5388, -4684, 973, 5451, 3875, -2087,
+    -6055, -3723, 2163, 6385, 3625, -2597, -5672, -2499, 3682, 5583, 2029, -4177, -6052, -446, 5226, 5577,
+    -63, -5499, -4955, 845, 5542, 3830, -2030, -5740, -3711, 3366, 5643, 2391, -4273, -5474, -1784, 4290,
+    5043, 589, -4864, -4564, 1415, 5574, 4207, -2490, -5541, -2765, 3743, 6219, 1853, -5134, -5192, 3,
+    5575, 4137, -1462, -5685, -3343, 3015, 5902, 2153, -4728, -5545, -592, 5691, 5142, -869, -6365, -4025,
+    2862, 5956, 1922, -4818, -5384, -664, 5485, 4904, -1172, -6174, -2844, 3114, 6321, 888, -4681, -4969,
+    872, 6076, 3800, -2565, -5512, -1780, 4265, 5157, -593, -5910, -4426, 2525, 5989, 2662, -4609, -5731,
+    446, 5055, 3853, -2154, -6063, -2472, 3943, 5855, -42, -5630, -4524, 2752, 5675, 2070, -4897, -5042,
+    696, 6042, 3928, -3279, -6246, -923, 5472, 4581, -1986, -5476, -2168, 3762, 5581, 149, -5163, -3465,
+    3032, 5602, 1216, -4900, -4765, 1798, 5865, 2254, -3748, -5806, 345, 6024, 2983, -3258, -5902, -189,
+    5727, 4073, -2912, -6118, -1051, 4782, 4937, -1326, -6336, -2455, 4921, 5327, -1061, -5791, -2771, 4582,
+    5205, -168, -6103, -3584, 3746, 5799, -565, -6274, -3710, 3366, 5199, 170, -5234, -3170, 3666, 5554,
+    405, -5493, -3678, 3876, 5890, -278, -5897, -3236, 4162, 5244, -304, -5430, -2880, 4370, 5990, -1034,
+    -6258, -3286, 4072, 4952, -1576, -5719, -2257, 4732, 4902, -1546, -6054, -1602, 4634, 4589, -2270, -6172,
+    -674, 5433, 3538, -3455, -5268, -157, 5858, 2694, -4106, -4724, 1577, 5760, 1734, -5224, -4547, 2563,
+    5470, 377, -5140, -3501, 4083, 5747, -1492, -5719, -2429, 5214, 4264, -2589, -5866, -336, 5448, 3279,
+    -4382, -5163, 1301, 6455, 1672, -4952, -3829, 2870, 5394, -997, -6117, -1785, 4589, 4734, -3060, -5905,
+    44, 6071, 2572, -4719, -5275, 2555, 6001, 588, -5686, -3124, 4108, 5408, -1763, -6052, -63, 5390,
+    3235, -4181, -4591, 2103, 5490, 89, -5994, -2449, 4249, 4912, -2645, -5690, 86, 5706, 2490, -4889,
+    -4079, 3054, 5204, -1071, -5688, -653, 5871, 3003, -4449, -5044, 2137, 6006, -188, -6141, -1996, 5304,
+    4561, -3805, -5462, 1239, 6418, 909, -5323, -3162, 4421, 4348, -3597, -5530, 1319, 6022, 423, -5419,
+    -2754, 4369, 4011, -3495, -5626, 803, 5888, 208, -5417, -2847, 5365, 4603, -3116, -5299, 2029, 6437,
+    190, -5943, -2321, 5020, 3799, -4743, -4528, 3243, 5232, -1505, -6423, -205, 5631, 1945, -5665, -3376,
+    3628, 4526, -3228, -5315, 947, 6432, 916, -5715, -1709, 5669, 3355, -4030, -4805, 3542, 5776, -1875,
+    -5617, 624, 6254, 916, -5986, -2256, 4853, 4001, -4587, -4667, 3164, 5094, -2228, -6139, 191, 5788,
+    722, -5744, -2458, 5709, 3160, -4650, -4652, 4211, 5413, -3059, -5635, 1518, 5729, -148, -5626, -449,
+    5881, 1846, -5442, -3093, 5142, 3852, -4303, -4889, 4071, 5400, -2959, -5297, 1977, 6295, -521, -6320,
+    -229, 6248, 1231, -6050, -2294, 5671, 2275, -4926, -2866, 4991, 4280, -4230, -4750, 3123, 5357, -2684,
+    -5222, 2185, 5575, -1901, -5507, 1172, 5679, -427, -5657, -524, 6251, 1084, -6166, -1367, 5596, 2298,
+    -5579, -2966, 5162, 3496, -4666, -3794, 4878, 4533, -3894, -4512, 3882, 4533, -3189, -4781, 2858, 5651,
+    -2525, -4977, 2436, 5051, -2590, -5519, 1579, 5585, -1514, -5431, 1136, 6277, -726, -5649, 652, 5642,
+    -1073, -5908, 235, 6088, -761, -6334, 181, 5855, -271, -6173, 461, 6139, 270, -6159, 414, 6031,
+    488, -6461, 264, 6296, -304, -6192, 178, 6356, -611, -6125, 35, 5800, -728, -5795, 219, 5532,
+    -408, -6322, 983, 6042, -794, -5536, 1204, 5623, -1421, -5465, 1753, 5710, -2347, -5935, 2536, 5200,
+    -2728, -4870, 3022, 4735, -3327, -5154, 4032, 4349, -3803, -4108, 4724, 3703, -4766, -2787, 5354, 3117,
+    -4978, -2488, 5138, 1856, -6239, -1588, 6303, 584, -5566, 494, 5980, -1223, -6174, 1055, 5967, -2370,
+    -5855, 2713, 5118, -3333, -5031, 4315, 3872, -4891, -3811, 5271, 2573, -5090, -2178, 5555, 1082, -5507,
+    224, 6355, -755, -5820, 2374, 5396, -2982, -5349, 3284, 4725, -4663, -3352, 4712, 2956, -6008, -1913,
+    5390, 496, -5765, 407, 5939, -1529, -5283, 2393, 4939, -4188, -3821, 5059, 2749, -5625, -2148, 5351,
+    1228, -6436, 495, 5776, -1976, -5950, 3650, 4938, -4156, -3317, 5358, 2722, -5867, -674, 5724, -93,
+    -5624, 1763, 5672, -3197, -4816, 4528, 3743, -5255, -2353, 6124, 191, -5647, 736, 5432, -2615, -5055,
+    3649, 3984, -4950, -2217, 5569, 1011, -6501, 700, 5806, -3062, -5215, 4654, 3432, -5312, -1879, 5877,
+    -239, -6393, 1576, 5769, -3873, -4237, 4813, 2311, -5948, -414, 5747, -1384, -6000, 3238, 4586, -4992,
+    -2445, 5312, 1233, -6180, 705, 5993, -3132, -4538, 4990, 2550, -5410, -572, 5744, -1096, -5475, 3756,
+    3600, -4902, -2213, 5567, -486, -6220, 2236, 5235, -4681, -3043, 5770, 1236, -6146, 1608, 5980, -3248,
+    -4474, 4751, 2125, -6217, 154, 5744, -2700, -4513, 4565, 2231, -5735, -520, 5389, -2355, -5008, 4943,
+    2430, -6176, -288, 5544, -2262, -5018, 4662, 2674, -5533, -555, 6042, -2809, -4777, 4093, 3090, -5435,
+    287, 5392, -2472, -4088, 4455, 2690, -6086, 659, 6135, -3707, -4238, 4892, 1165, -6244, 1751, 5054,
+    -4571, -3011, 5425, 625, -5495, 2722, 4058, -5183, -1902, 6296, -1328, -5782, 3948, 3187, -5269, -270,
+    5931, -2358, -4393, 4783, 1986, -6118, 1666, 5532, -4411, -2859, 6331, -760, -5435, 2997, 4018, -5039,
+    -1037, 5750, -2194, -4779, 5083, 2056, -6439, 1992, 4669, -4207, -1859, 6333, -926, -5775, 3742, 3238,
+    -5715, 809, 5159, -4312, -2745, 5905, -53, -5970, 3292, 3668, -5291, 441, 5974, -3616, -3292, 6123,
+    -125, -5837, 3676, 3728, -5820, -32, 5734, -3346, -2866, 5500, -455, -5339, 3971, 2626, -5604, 438,
+    4956, -4119, -3020, 6039, -1103, -5491, 4292, 2580, -6366, 1321, 4932, -5187, -1126, 6303, -2294, -4707,
+    5835, 791, -5924, 3590, 3510, -5588, 89, 5230, -4182, -2737, 5811, -2087, -5218, 4765, 825, -6075,
+    2426, 4325, -6009, 546, 5238, -4067, -3049, 6130, -1917, -4546, 5398, 1279, -5678, 2875, 3254, -6154,
+    996, 5560, -4464, -1652, 6069, -2812, -4205, 5367, -113, -5300, 4749, 2485, -5977, 2753, 3994, -5376,
+    203, 5701, -4602, -2328, 5664, -2138, -4544, 5502, -242, -5751, 4157, 1471, -5870, 2779, 3326, -5302,
+    690, 5183, -4644, -1441, 5524, -3408, -2883, 5563, -1386, -5037, 5236, -3, -5658, 4406, 1785, -5933,
+    2965, 3288, -6290, 1433, 5089, -5072, -845, 5725, -4010, -1707, 5544, -2631, -3958, 5767, -1588, -4142,
+    5037, -173, -5437, 4674, 1558, -6035, 3954, 3058, -6503, 1976, 3427, -5423, 1353, 5280, -5510, -313,
+    5757, -4691, -1333, 5602, -3355, -2879, 6282, -3432, -3664, 5510, -1824, -4340, 6040, -1142, -5151, 5532,
+    -37, -5652, 5009, 603, -6013, 4368, 1310, -5922, 3318, 2319, -5815, 2837, 3256, -6301, 2126, 3268,
+    -6224, 1271, 4312, -6243, 1444, 4358, -5256, 979, 4555, -5575, -20, 5234, -5524, -528, 5527, -4915,
+    -493, 5673, -4587, -1152, 6129, -4166, -1042, 6121, -4561, -1626, 5387, -4562, -1630, 5870, -4333, -1596,
+    6360, -3648, -2153, 6220, -3567, -2110, 6171, -3651, -1874, 6243, -4398, -1641, 5701, -3928, -2060, 5852,
+    -3764, -1669, 5547, -4237, -1235, 5443, -4447, -766, 5321, -4865, -1061, 5178, -4513, -456, 5587, -4973,
+    -470, 4786, -5337, 733, 4923, -5436, 814, 4505, -6050, 1365, 3986, -5984, 2097, 3486, -6095, 3381,
+    2519, -6055, 3550, 2506, -6164, 3677, 1241, -6111, 4504, 411, -5232, 5178, -568, -4274, 5249, -1639,
+    -3693, 5740, -2526, -2772, 6058, -3343, -1898, 6102, -4529, -722, 5844, -5364, -158, 5274, -5573, 1728,
+    4276, -6019, 2893, 3386, -6473, 3285, 1924, -6077, 4901, 350, -5235, 5186, -942, -4537, 6255, -2695,
+    -2800, 6203, -4475, -936, 5940, -4983, -170, 5210, -6109, 1878, 3282, -6076, 3708, 1888, -5536, 4551,
+    -506, -4373, 5542, -2098, -3535, 6435, -3461, -1853, 5787, -5097, 173, 4613, -5484, 2072, 3437, -5674,
+    4332, 957, -5634, 4927, -1112, -4439, 5698, -3247, -1907, 5298, -4799, 103, 4247, -5397, 2410, 2894,
+    -6078, 4154, 809, -4497, 5932, -2611, -3165, 5750, -4155, -433, 5046, -5194, 2300, 2778, -5697, 4459,
+    749, -4624, 5596, -1514, -3203, 6449, -4013, -194, 4718, -5716, 2120, 2959, -5385, 4665, -5, -5129,
+    5741, -2838, -2512, 5964, -4786, 767, 3749, -5561, 4134, 1141, -5183, 5939, -1961, -3303, 5815, -4240,
+    208, 4518, -5522, 3073, 1599, -5889, 5000, -1207, -3048, 5694, -4576, 37, 4662, -6385, 3262, 1971,
+    -5517, 5236, -1974, -2692, 5958, -5132, -13, 4261, -6258, 3385, 499, -5290, 5658, -3022, -2398, 5226,
+    -5231, 1726, 2982, -6009, 4916, -1185, -3911, 6368, -4649, 22, 4967, -6056, 3748, 1201, -5281, 5827,
+    -2984, -1541, 5444, -5706, 2458, 2833, -5309, 4964, -2098, -3008, 5927, -5048, 1460, 3376, -5607, 4361,
+};
+
+static const float golden_mel_db_chirp_noise[512] = {
+    -16.7627058f, -11.1809936f, -15.7691795f, -20.133058f, -59.7262224f, -34.6223549f, -16.0293705f, -14.3353313f,
+    -15.8832128f, -11.1007985f, -13.1509724f, -27.7243743f, -26.3296679f, -18.6445882f, -25.0396828f, -14.5022361f,
+    -20.6975299f, -13.8246039f, -13.6506414f, -20.7346282f, -24.9879358f, -21.7685789f, -15.4598789f, -21.0149912f,
+    -16.9254352f, -16.7713818f, -18.3108408f, -19.3374086f, -28.2963851f, -21.648944f, -15.6530314f, -21.6419683f,
+    -35.7174506f, -27.9205802f, -18.3595292f, -19.031032f, -21.0636113f, -26.7301912f, -18.1923625f, -19.2160062f,
+    -22.5342877f, -24.4841722f, -18.1396646f, -30.3962861f, -25.0191871f, -21.3336221f, -18.6159343f, -17.0353125f,
+    -14.6740983f, -20.2362028f, -20.0581117f, -15.3515744f, -21.7055905f, -18.0501444f, -19.3364463f, -10.231452f,
+    -9.92321825f, -15.099994f, -20.1343357f, -14.2535263f, -23.3300504f, -23.4439384f, -15.8930272f, -11.8202048f,
+    -5.91585429f, -15.4583014f, -16.6357006f, -13.8053665f, -19.0176421f, -19.861112f, -28.2286289f, -24.2857242f,
+    -4.80326049f, -18.1629406f, -14.2950411f, -18.3293611f, -29.3975755f, -22.7858771f, -17.9277638f, -29.0311651f,
+    1.93305358f, -26.6203926f, -21.6881344f, -17.6261851f, -18.8466532f, -13.0769307f, -27.5705964f, -18.1117852f,
+    5.53312892f, -27.3995659f, -15.1266383f, -16.5154055f, -24.582804f, -12.8568593f, -14.5906605f, -17.3551078f,
+    9.87396843f, -19.1484969f, -17.9017776f, -11.297036f, -13.2312204f, -17.3443272f, -13.4685144f, -21.117964f,
+    11.6234882f, -11.874779f, -16.1844634f, -13.5601396f, -12.4611584f, -17.5838899f, -21.2961798f, -23.0834153f,
+    13.9417415f, -15.4414681f, -17.1186642f, -18.9477879f, -10.739324f, -16.2373073f, -14.4330696f, -16.4255182f,
+    15.4375375f, -10.9442148f, -12.3407468f, -19.081489f, -16.6334667f, -15.0690818f, -13.2964632f, -18.5939856f,
+    16.9179691f, -21.0862197f, -21.9424169f, -18.4648192f, -14.7987342f, -14.0378587f, -19.9628955f, -32.5053077f,
+    19.0686201f, -10.1431512f, -11.5867452f, -14.7274486f, -14.1887275f, -18.191109f, -17.6375032f, -13.6106369f,
+    19.8091733f, -10.3066109f, -16.2984778f, -16.1708014f, -14.8802434f, -10.4274317f, -16.2574108f, -18.1391468f,
+    20.3965437f, -14.0626222f, -15.8953612f, -15.0401449f, -21.8839993f, -10.803664f, -14.8702203f, -15.7844223f,
+    20.3235537f, -8.14223355f, -18.4425848f, -13.0498954f, -27.520216f, -20.1962995f, -13.21475f, -19.5954563f,
+    19.784681f, -1.22860243f, -20.1312219f, -18.2802661f, -25.3309513f, -17.5935593f, -17.9702922f, -19.6260795f,
+    18.9354422f, 4.34454484f, -14.0216645f, -18.5797418f, -17.8999479f, -16.7797674f, -28.5859073f, -13.2516337f,
+    17.7362764f, 9.52068436f, -15.1485739f, -15.2405998f, -14.1918518f, -21.3309259f, -25.1788469f, -13.840988f,
+    15.7229375f, 12.8037961f, -14.3271188f, -16.5574753f, -10.8642375f, -23.3167035f, -13.1270147f, -15.7043089f,
+    13.6360434f, 16.7612598f, -11.0434197f, -14.6545942f, -9.4026871f, -13.7458905f, -14.3067814f, -12.5509113f,
+    9.21404923f, 19.042638f, -12.2691926f, -14.7439799f, -11.8775967f, -10.40262f, -25.1364281f, -12.6951495f,
+    2.12188473f, 20.4797619f, -9.64224299f, -11.7609938f, -15.250941f, -16.3092841f, -19.5805382f, -14.6693044f,
+    -4.42048944f, 21.9270248f, -8.96200976f, -10.5090969f, -18.8502104f, -10.9308888f, -16.6554973f, -18.6876021f,
+    -11.9175288f, 21.8194449f, -3.72077073f, -8.71697962f, -17.3606461f, -14.912721f, -20.72734f, -16.3916096f,
+    -15.2493556f, 20.9362358f, 5.63245582f, -7.39269784f, -15.3498196f, -12.3856018f, -14.7892005f, -13.3648307f,
+    -16.8018634f, 19.0412508f, 12.3148831f, -14.4035135f, -9.40769882f, -13.194486f, -13.5718372f, -13.5095712f,
+    -11.602919f, 15.6898628f, 16.7192023f, -12.6203333f, -14.1394552f, -12.6274441f, -14.7667239f, -15.7147002f,
+    -12.0290002f, 10.3326087f, 19.5968565f, -12.0767244f, -13.8595156f, -13.2152035f, -12.2447594f, -15.924557f,
+    -14.099941f, 3.1423925f, 21.9390666f, -12.8489192f, -11.0567872f, -14.2295613f, -13.1924207f, -13.5837254f,
+    -16.5156067f, -7.22864472f, 22.668238f, -7.7144481f, -13.9849507f, -15.155975f, -13.2997203f, -10.1365008f,
+    -15.585891f, -10.2347457f, 22.0139562f, 3.05789052f, -14.7430297f, -13.13502f, -15.7184891f, -12.655084f,
+    -13.2580111f, -13.5246229f, 20.5535677f, 12.958058f, -14.5537679f, -12.80527f, -17.3531423f, -13.8717328f,
+    -12.3901117f, -8.1691036f, 16.3262686f, 18.6208815f, -18.1089998f, -10.917992f, -13.0458517f, -12.7135289f,
+    -11.5959532f, -12.3606155f, 8.86054365f, 21.7642177f, -10.2463157f, -14.5831206f, -12.8195589f, -15.6444649f,
+    -16.1163922f, -8.23138199f, -2.99289923f, 22.988694f, -6.97813546f, -14.2939807f, -13.3671054f, -14.8825709f,
+    -13.0069613f, -9.42814339f, -13.3803913f, 23.1622184f, 4.23292664f, -10.8396499f, -7.8379081f, -14.5536283f,
+    -15.6607513f, -9.66359514f, -14.4770078f, 20.9162213f, 13.946491f, -14.0230397f, -9.1821889f, -13.201443f,
+    -16.3509497f, -14.6493951f, -13.2432296f, 15.6255247f, 19.9675029f, -15.4275213f, -11.3021395f, -14.9885389f,
+    -13.2245095f, -13.543277f, -15.4051467f, 6.88545943f, 23.3724329f, -12.1074766f, -10.1843867f, -12.8694355f,
+    -11.7691667f, -10.7821223f, -11.573227f, -6.0193109f, 24.2221664f, 2.17508508f, -13.2280458f, -11.8215396f,
+    -10.998651f, -11.5523297f, -12.9913391f, -10.4559217f, 22.1792953f, 14.5473239f, -9.80325398f, -12.0773556f,
+    -8.35284622f, -11.8196109f, -13.5058407f, -12.3276781f, 16.0262673f, 21.3850769f, -9.18161012f, -13.0737118f,
+    -10.0946914f, -9.90771759f, -8.35187357f, -13.2512553f, 4.9497388f, 24.5424271f, -5.98062147f, -11.6707227f,
+    -11.2075955f, -11.8773983f, -7.39655212f, -11.3153362f, -8.80718467f, 24.1145276f, 8.73737222f, -8.7335587f,
+    -13.2263289f, -8.38807982f, -8.46561282f, -8.57808677f, -8.39946715f, 20.1042775f, 19.0315311f, -12.4155261f,
+    -9.14675105f, -8.99512962f, -11.470493f, -8.72939742f, -9.63686856f, 10.9688781f, 24.1907146f, -8.45508912f,
+    -11.0169622f, -6.7681112f, -11.2071089f, -12.1374559f, -12.9504352f, -5.59530969f, 25.0942738f, 7.00344068f,
+    -9.19353459f, -10.767583f, -11.4056456f, -13.9132322f, -12.3156645f, -11.4401781f, 21.329273f, 19.2667812f,
+    -9.71727303f, -9.06762537f, -7.96542915f, -10.8990561f, -13.6087216f, -8.73338572f, 11.262053f, 24.6025478f,
+    -8.61232554f, -11.4959981f, -8.33940671f, -11.3458075f, -10.4842396f, -6.64504088f, -5.32195722f, 25.2024064f,
+    -10.5304684f, -10.1865765f, -8.85456379f, -13.561008f, -8.65313344f, -10.8888038f, -7.45122234f, 20.5493995f,
+    -11.0227439f, -11.0390654f, -9.15881873f, -11.8945615f, -10.4794708f, -9.92154154f, -5.57122131f, 7.26740567f,
+    -12.0930882f, -8.94884681f, -8.73022779f, -12.0254916f, -9.90190122f, -10.059204f, -6.91783962f, -9.73049935f,
+    -10.242032f, -9.09185943f, -9.79396478f, -9.31582804f, -7.86714722f, -11.4793501f, -7.90349886f, -9.78579332f,
+    -7.47437742f, -7.75953038f, -8.74319181f, -7.83826496f, -9.34724893f, -10.2663524f, -10.4786696f, -8.25256668f,
+    -8.17576252f, -8.93047127f, -9.66718715f, -6.71648614f, -8.05995637f, -7.9497028f, -7.20277899f, -8.11871464f,
+    -7.61881388f, -8.82188179f, -9.85904536f, -5.15407525f, -7.33650043f, -6.44970469f, -7.2646835f, -7.65210455f,
+    -6.68892107f, -8.55837391f, -6.97534743f, -4.45318301f, -7.40142942f, -7.40817224f, -6.92276413f, -6.89231112f,
+};
+
+static const float golden_normalized_chirp_noise[512] = {
+    0.505877903f, 0.57160029f, 0.51757627f, 0.466193379f, 0.0f, 0.295587812f, 0.514512627f, 0.534459248f,
+    0.516233574f, 0.572544554f, 0.548404592f, 0.376808722f, 0.393230822f, 0.483719504f, 0.408419871f, 0.532494013f,
+    0.459546953f, 0.540472856f, 0.542521193f, 0.459110135f, 0.409029171f, 0.446935787f, 0.521218159f, 0.455808975f,
+    0.50396183f, 0.505775747f, 0.487649244f, 0.475561827f, 0.370073529f, 0.448344438f, 0.518943867f, 0.448426575f,
+    0.282693506f, 0.374498478f, 0.487075958f, 0.479169287f, 0.455236493f, 0.388514823f, 0.489044278f, 0.47699129f,
+    0.437919878f, 0.414960782f, 0.489664774f, 0.34534805f, 0.408661199f, 0.452057226f, 0.484056892f, 0.50266807f,
+    0.530470405f, 0.464978891f, 0.467075841f, 0.5224934f, 0.447677449f, 0.490718838f, 0.475573157f, 0.582780756f,
+    0.586410082f, 0.525455657f, 0.466178335f, 0.53542247f, 0.428550096f, 0.427209111f, 0.516118014f, 0.564073838f,
+    0.63359516f, 0.521236733f, 0.507373337f, 0.540699369f, 0.479326947f, 0.469395432f, 0.37087133f, 0.417297427f,
+    0.646695498f, 0.489390709f, 0.53493365f, 0.487431175f, 0.35710746f, 0.434957515f, 0.49215982f, 0.361421793f,
+    0.726012852f, 0.389807657f, 0.447882988f, 0.495710786f, 0.481340271f, 0.549276403f, 0.378619395f, 0.489993043f,
+    0.768402272f, 0.380633209f, 0.525141931f, 0.508789764f, 0.413799433f, 0.551867653f, 0.531452851f, 0.498902611f,
+    0.819513889f, 0.477786184f, 0.492465796f, 0.570233938f, 0.547459705f, 0.499029548f, 0.544665664f, 0.454596512f,
+    0.840113771f, 0.56343125f, 0.512686471f, 0.543586815f, 0.556526871f, 0.496208794f, 0.452498093f, 0.431454123f,
+    0.86741026f, 0.521434939f, 0.501686638f, 0.480149452f, 0.576800769f, 0.512064256f, 0.53330842f, 0.509848149f,
+    0.885022647f, 0.574388264f, 0.557944668f, 0.478575176f, 0.50739964f, 0.525819635f, 0.546691497f, 0.484315329f,
+    0.902454126f, 0.454970288f, 0.444888915f, 0.485836211f, 0.529002868f, 0.537961867f, 0.468196973f, 0.32051518f,
+    0.927777166f, 0.583820461f, 0.566822729f, 0.529842227f, 0.536185449f, 0.489059037f, 0.49557752f, 0.54299223f,
+    0.936496878f, 0.58189579f, 0.511343998f, 0.512847335f, 0.528043131f, 0.580473174f, 0.511827546f, 0.489670871f,
+    0.943412925f, 0.537670287f, 0.516090532f, 0.526160356f, 0.445576759f, 0.576043193f, 0.528161149f, 0.517396792f,
+    0.942553498f, 0.607380451f, 0.486098012f, 0.549594732f, 0.379212603f, 0.465448736f, 0.547653636f, 0.47252342f,
+    0.936208491f, 0.688785641f, 0.466214998f, 0.488009248f, 0.404990303f, 0.496094941f, 0.491659065f, 0.472162844f,
+    0.926209051f, 0.754407179f, 0.538152548f, 0.484483044f, 0.49248734f, 0.505677009f, 0.366664522f, 0.547219346f,
+    0.912089362f, 0.815354113f, 0.524883648f, 0.523800081f, 0.536148661f, 0.452088972f, 0.40678127f, 0.54027994f,
+    0.888383117f, 0.854011416f, 0.534555947f, 0.508294408f, 0.575329963f, 0.42870725f, 0.548686684f, 0.518340095f,
+    0.863810789f, 0.900608938f, 0.573220167f, 0.530700058f, 0.592539124f, 0.541399674f, 0.534795412f, 0.555470067f,
+    0.811743609f, 0.927471237f, 0.55878719f, 0.529647578f, 0.563398072f, 0.580765322f, 0.407280734f, 0.55377172f,
+    0.728236262f, 0.944392786f, 0.589718451f, 0.564771024f, 0.523678317f, 0.511216758f, 0.472699075f, 0.530526851f,
+    0.651202472f, 0.961433717f, 0.59772792f, 0.579511599f, 0.481298387f, 0.574545172f, 0.50714024f, 0.483213034f,
+    0.562927888f, 0.960167007f, 0.659441374f, 0.60061305f, 0.498837399f, 0.527660721f, 0.459195951f, 0.510247409f,
+    0.523696985f, 0.94976758f, 0.769571806f, 0.616205929f, 0.522514062f, 0.557416519f, 0.529115124f, 0.545886497f,
+    0.505416838f, 0.927454903f, 0.848254664f, 0.533656431f, 0.592480113f, 0.547892237f, 0.54344908f, 0.544182237f,
+    0.56663229f, 0.887993675f, 0.900113729f, 0.554652651f, 0.536765609f, 0.554568925f, 0.529379777f, 0.518217741f,
+    0.561615358f, 0.824914191f, 0.933996934f, 0.561053425f, 0.540061785f, 0.547648297f, 0.559074881f, 0.515746764f,
+    0.537230873f, 0.740252325f, 0.961575503f, 0.551961145f, 0.573062769f, 0.535704647f, 0.547916555f, 0.543309101f,
+    0.508787394f, 0.618137587f, 0.9701612f, 0.61241745f, 0.538584838f, 0.524796503f, 0.546653146f, 0.583898767f,
+    0.519734418f, 0.582741974f, 0.962457298f, 0.739257349f, 0.529658766f, 0.548592425f, 0.518173129f, 0.554243476f,
+    0.547144255f, 0.544005009f, 0.945261819f, 0.855827787f, 0.531887247f, 0.552475097f, 0.498925753f, 0.539917932f,
+    0.557363416f, 0.607064067f, 0.895487095f, 0.922505227f, 0.49002584f, 0.574697027f, 0.549642345f, 0.553555311f,
+    0.566714309f, 0.557710723f, 0.807581225f, 0.959516729f, 0.582605741f, 0.531541631f, 0.55230685f, 0.519044734f,
+    0.513487982f, 0.606330765f, 0.668011765f, 0.973934439f, 0.621087232f, 0.534946135f, 0.545859714f, 0.528015725f,
+    0.550100264f, 0.592239387f, 0.545703278f, 0.975977618f, 0.75309292f, 0.575619473f, 0.610963759f, 0.53188889f,
+    0.518852968f, 0.589467038f, 0.532791065f, 0.949531918f, 0.867466183f, 0.538136355f, 0.595135401f, 0.547810321f,
+    0.510726163f, 0.530761276f, 0.547318301f, 0.88723612f, 0.938361144f, 0.521599157f, 0.570173846f, 0.526767995f,
+    0.547538722f, 0.543785365f, 0.521862608f, 0.784325413f, 0.978452808f, 0.56069133f, 0.583334929f, 0.551719575f,
+    0.564674791f, 0.576296837f, 0.566981902f, 0.632377f, 0.988458074f, 0.728862674f, 0.547497084f, 0.564058122f,
+    0.573747299f, 0.567227959f, 0.550284209f, 0.580137715f, 0.964404099f, 0.874540745f, 0.587822612f, 0.561045992f,
+    0.604900573f, 0.564080831f, 0.544226163f, 0.558098547f, 0.891954701f, 0.955052501f, 0.595142216f, 0.549314304f,
+    0.584391055f, 0.586592596f, 0.604912025f, 0.547223802f, 0.761533091f, 0.992229013f, 0.632832553f, 0.565833929f,
+    0.571287064f, 0.563400408f, 0.616160546f, 0.57001846f, 0.599550923f, 0.98719067f, 0.806130932f, 0.600417838f,
+    0.5475173f, 0.604485711f, 0.603572792f, 0.602248457f, 0.60435163f, 0.93997161f, 0.927340458f, 0.557064173f,
+    0.595552667f, 0.597337948f, 0.568191552f, 0.600466836f, 0.589781733f, 0.832406003f, 0.988087741f, 0.603696704f,
+    0.573531693f, 0.623560182f, 0.571292793f, 0.560338336f, 0.550765836f, 0.637369442f, 0.998726783f, 0.785714594f,
+    0.59500181f, 0.576468031f, 0.568955104f, 0.539429294f, 0.558240002f, 0.568548498f, 0.954395433f, 0.930110432f,
+    0.588835003f, 0.59648434f, 0.609462251f, 0.574919989f, 0.543014781f, 0.600419875f, 0.835858019f, 0.99293691f,
+    0.601845309f, 0.56789124f, 0.605058817f, 0.569659673f, 0.579804284f, 0.625009285f, 0.640588056f, 1.0f,
+    0.579259958f, 0.583309146f, 0.598993053f, 0.54357659f, 0.601364813f, 0.575040706f, 0.615516827f, 0.94521274f,
+    0.573463615f, 0.573271436f, 0.595410575f, 0.563198318f, 0.579860434f, 0.586429825f, 0.637653073f, 0.788822674f,
+    0.560860747f, 0.597882909f, 0.600457059f, 0.56165667f, 0.586661081f, 0.584808905f, 0.621797191f, 0.588679268f,
+    0.58265618f, 0.596198993f, 0.587931989f, 0.593561854f, 0.610619481f, 0.568087264f, 0.610191455f, 0.588028205f,
+    0.615244185f, 0.611886625f, 0.600304413f, 0.610959558f, 0.593191886f, 0.582369817f, 0.579869869f, 0.606081324f,
+    0.606985661f, 0.598099273f, 0.589424744f, 0.624168046f, 0.608349231f, 0.609647422f, 0.618442146f, 0.607657377f,
+    0.613543504f, 0.59937787f, 0.587165692f, 0.642564798f, 0.61686763f, 0.627309289f, 0.617713245f, 0.61315152f,
+    0.624492614f, 0.602480568f, 0.62112006f, 0.650817518f, 0.616103118f, 0.616023724f, 0.621739207f, 0.622097778f,
+};
+
+static const int8_t golden_q8_chirp_noise[512] = {
+    -13, -3, -11, -19, -91, -45, -11, -8, -11, -3, -6, -33, -30, -16, -28, -9,
+    -20, -7, -7, -20, -28, -22, -10, -21, -13, -13, -16, -18, -34, -22, -11, -22,
+    -47, -33, -16, -17, -21, -31, -15, -17, -23, -27, -15, -38, -28, -21, -16, -13,
+    -9, -19, -19, -10, -22, -15, -18, -1, 0, -10, -19, -8, -25, -25, -11, -4,
+    7, -10, -13, -7, -17, -18, -34, -27, 9, -15, -8, -16, -36, -24, -15, -35,
+    21, -31, -22, -14, -17, -6, -33, -15, 28, -32, -10, -12, -27, -6, -9, -14,
+    36, -17, -15, -3, -6, -14, -7, -21, 39, -4, -12, -7, -5, -14, -21, -24,
+    43, -10, -13, -17, -2, -12, -9, -12, 46, -2, -5, -17, -13, -10, -7, -16,
+    49, -21, -22, -16, -9, -8, -19, -41, 52, -1, -3, -9, -8, -15, -14, -7,
+    54, -1, -12, -12, -9, -1, -12, -15, 55, -8, -11, -10, -22, -2, -9, -11,
+    55, 3, -16, -6, -32, -19, -6, -18, 54, 15, -19, -16, -28, -14, -15, -18,
+    52, 26, -8, -16, -15, -13, -34, -6, 50, 35, -10, -10, -8, -21, -28, -7,
+    46, 41, -8, -12, -2, -25, -6, -11, 43, 48, -2, -9, 1, -7, -8, -5,
+    34, 52, -5, -9, -4, -1, -28, -5, 22, 55, 0, -4, -10, -12, -18, -9,
+    10, 58, 1, -1, -17, -2, -13, -16, -4, 57, 11, 2, -14, -9, -20, -12,
+    -10, 56, 28, 4, -10, -5, -9, -7, -13, 52, 40, -9, 1, -6, -7, -7,
+    -3, 46, 48, -5, -8, -5, -9, -11, -4, 37, 53, -4, -8, -6, -5, -11,
+    -8, 23, 58, -6, -2, -8, -6, -7, -12, 5, 59, 4, -8, -10, -7, -1,
+    -11, -1, 58, 23, -9, -6, -11, -5, -6, -7, 55, 41, -9, -6, -14, -8,
+    -5, 3, 47, 52, -15, -2, -6, -5, -3, -5, 34, 57, -1, -9, -6, -11,
+    -12, 3, 12, 60, 5, -8, -7, -9, -6, 1, -7, 60, 25, -2, 3, -9,
+    -11, 0, -9, 56, 43, -8, 1, -6, -12, -9, -6, 46, 54, -10, -3, -10,
+    -6, -7, -10, 30, 60, -4, -1, -6, -4, -2, -3, 7, 62, 22, -6, -4,
+    -2, -3, -6, -1, 58, 44, 0, -4, 3, -4, -7, -5, 47, 57, 1, -6,
+    -1, 0, 3, -6, 27, 62, 7, -4, -3, -4, 4, -3, 2, 62, 34, 2,
+    -6, 2, 2, 2, 2, 54, 52, -5, 1, 1, -3, 2, 0, 38, 62, 2,
+    -2, 5, -3, -4, -6, 8, 63, 30, 1, -2, -3, -8, -5, -3, 57, 53,
+    0, 1, 3, -2, -7, 2, 38, 63, 2, -3, 3, -3, -1, 6, 8, 64,
+    -1, -1, 2, -7, 2, -2, 4, 55, -2, -2, 1, -4, -1, 0, 8, 31,
+    -4, 1, 2, -4, 0, -1, 5, 0, -1, 1, 0, 1, 3, -3, 3, 0,
+    4, 4, 2, 3, 1, -1, -1, 3, 3, 1, 0, 5, 3, 3, 5, 3,
+    4, 2, 0, 8, 4, 6, 4, 4, 6, 2, 5, 10, 4, 4, 5, 5,
+};
+
+static const int16_t golden_pcm_quiet[2304] = {
+    -3, -1, -3, 1, 1, -4, -3, -1, 0, 1, 1, -4, 0, 2, -1, -1,
+    -4, -2, 3, -1, 3, 1, 1, -1, -3, -3, -3, -3, -4, -2, 0, -2,
+    -2, 0, 2, -1, -2, 2, 2, 2, 1, 2, 1, 3, -2, -3, 3, 3,
+    3, -3, 0, 3, -4, -4, 0, -1, -2, 0, 1, 2, -1, 3, -3, 2,
+    -4, 0, 1, -2, 2, -1, -3, 3, -4, 1, 3, -4, 3, -4, 3, 0,
+    -1, 1, 1, 1, 2, 0, 1, -4, -1, 3, -1, 3, 0, -3, 3, 3,
+    2, -2, -2, -1, -3, 2, -1, 0, 0, 1, 0, -1, -1, 1, -4, -2,
+    0, 2, -1, -4, 0, 2, -4, 1, 0, -1, 2, 2, 1, 1, -1, 0,
+    2, 2, 1, 1, -1, 2, -4, -2, -4, -2, -3, 2, -2, -2, 0, 3,
+    2, 3, 2, -2, -4, 1, 2, -2, 3, 2, -4, -3, 0, 1, -3, -4,
+    -4, 3, -3, 1, 3, 3, 1, 3, 0, -1, 1, 0, 2, 3, 0, -1,
+    -4, -3, 2, -2, 3, 1, 1, -3, 0, 0, -1, -1, 2, -2, -2, -3,
+    1, 3, -3, -2, 1, 2, -3, 2, -1, -1, 2, 1, 0, -1, 1, -2,
+    -2, -3, 0, 1, -2, -2, -1, -3, -3, 0, 0, 1, -1, 1, 1, -4,
+    -1, 2, 3, 3, 0, -1, 2, 2, -1, -3, 1, -4, -2, -1, 2, -2,
+    -2, -2, 3, -1, 3, -1, -4, -1, 0, -1, 0, -4, -2, 0, -3, -1,
+    -1, -4, 1, 2, 1, -3, -4, 3, 3, 0, 3, -4, 1, -1, -4, -3,
+    -4, -4, -2, 3, -3, -2, -4, 2, 0, -2, -4, 3, 1, 0, -3, 1,
+    -4, 3, 2, 0, -2, 1, 1, -4, -1, 0, 1, -4, 2, 2, 0, 0,
+    3, -3, 0, -1, -3, 1, 3, -2, -1, 3, -2, 2, 2, -2, 3, 3,
+    -4, 2, 1, 3, 2, -4, 0, -2, 3, 3, 1, 2, 2, 0, -3, 3,
+    0, -2, 3, 2, 1, -3, 1, 1, 2, 0, 2, -1, -3, -4, -2, 0,
+    1, -3, 1, 3, 2, 0, -4, -3, 1, -4, -4, 3, 2, 2, 1, 2,
+    -2, -3, -1, 1, 3, -1, -2, 3, 3, 3, 2, 2, -3, 2, -2, 3,
+    0, 0, -3, 2, 3, 3, 1, 2, 1, 1, -1, 2, -2, -2, -2, 1,
+    0, 1, -2, -3, -4, 1, -2, 0, -4, 1, -3, -4, 2, 2, -1, -4,
+    1, 2, 1, 3, 2, -4, -3, 0, 3, 0, -3, -1, 2, 1, -2, -4,
+    -1, 2, 0, 0, 0, -4, -2, 1, -2, 2, 3, -1, 1, 0, 3, -2,
+    -1, -1, -1, 2, 1, -3, 1, 0, -4, 0, 3, -1, -4, -1, 1, -3,
+    -4, 0, 0, -2, 1, 1, -2, 0, 0, 2, -4, 2, 3, 2, 2, 0,
+    0, -2, 3, -1, -1, -3, -1, -4, 3, -1, -4, -2, 2, 2, -4, -1,
+    -2, 3, -1, -4, 0, -4, -1, -4, 2, 2, 0, 0, 0, -3, -4, 3,
+    -2, -1, 0, 0, -1, 2, -4, -4, 3, -2, -3, -4, 3, 3, 3, -4,
+    -3, -2, -2, 0, 0, -3, -3, 1, 2, 2, -3, 3, -4, 1, -4, 0,
+    -2, 1, 3, 0, 3, 0, -1, 2, 1, -4, 0, 1, 1, 2, 0, -1,
+    -2, 1, -1, 3, 3, -3, -1, -4, -4, 3, 0, 3, 0, 0, -1, -3,
+    -2, -4, -2, 2, 1, 3, 0, -4, 0, 3, -4, 0, -3, -4, 2, 0,
+    -1, 1, -4, 0, 0, 1, 3, -1, -1, -3, -4, -4, 2, 2, -4, -4,
+    1, 1, -1, 3, 3, 3, -4, 3, 1, 3, -4, 3, 3, -1, 1, 1,
+    3, -1, -1, 1, 2, 0, -3, 1, -4, -4, -1, 2, 0, -4, -4, 1,
+    -2, 2, 1, 1, 3, 2, -1, -2, -3, 1, -2, 2, -2, -2, -1, 3,
+    0, 0, 3, -3, 2, -4, 0, 1, 0, 0, -3, -4, 0, 3, -4, -4,
+    -4, 1, 1, -4, -3, -3, 0, -4, -2, -2, -3, 1, -4, 3, 0, -2,
+    -2, 1, 1, 1, -1, -1, -4, -2, 3, -2, 1, 0, 1, 3, -2, 3,
+    2, 1, 2, -1, -3, -4, 1, -4, 2, -2, -1, -4, 3, -1, -4, 2,
+    1, -2, -4, 0, 3, 2, -1, -1, -1, 1, -4, 3, -3, -3, -3, -4,
+    -3, -2, 1, -3, 2, 1, -2, -4, -1, -4, 0, 3, 2, 1, 2, -1,
+    -2, -3, -2, 3, -1, -2, -2, 0, 3, -1, -1, -4, -2, 3, 1, -3,
+    0, 2, 3, 2, 0, 0, -4, 1, -4, -2, -2, 3, -4, -1, -2, 3,
+    2, -3, 2, -3, 1, -1, -3, 1, 0, 2, 1, 3, 0, -4, -2, 2,
+    0, -4, -4, -2, 3, 1, 3, 2, -3, 1, -2, 0, 0, -2, 3, -2,
+    -1, -3, 3, -3, 2, -4, 3, -2, 2, 3, -1, -4, -3, -3, 1, 0,
+    -2, 1, 1, 0, 1, -2, -3, 3, -2, -4, -2, -4, 2, 1, 3, -1,
+    -1, -4, -4, 1, 3, -2, 0, -3, 1, -3, 0, 1, -3, 2, -3, 3,
+    -1, -3, 0, 3, -2, -4, -1, 1, 3, 3, 2, -3, -2, 1, -4, 3,
+    -3, 3, 0, 3, 1, 1, 1, 1, -1, 3, -1, 1, -3, 0, 1, 0,
+    -1, 1, -3, 2, -4, 2, -2, 1, -4, 0, 1, -1, 2, -1, -4, 0,
+    -1, 3, 1, 3, -4, 3, 2, 0, 2, 0, 3, 3, -3, -1, 3, 2,
+    3, 3, -3, 3, 1, 2, 2, -2, -4, 1, -1, -2, 3, 3, -2, -4,
+    -1, -4, -4, 0, -3, -2, 2, 3, 3, 0, 1, 0, -1, 1, 0, -4,
+    -2, 3, -1, 3, 1, 0, -1, -4, 3, 1, -3, -1, 1, 1, 3, -4,
+    1, 2, 3, -3, 0, -2, -4, 1, -3, 1, 1, 2, 3, -4, 3, 1,
+    1, 2, -2, -4, -4, -4, 0, -1, 0, -3, -3, 1, -4, -1, -4, -4,
+    -3, -2, 2, 2, -3, 1, 3, 2, 1, -1, -2, -2, -3, -2, -3, 3,
+    -1, 0, 1, -1, 1, 0, -2, 0, 2, 3, 1, -1, -2, -1, -3, 0,
+    -1, -3, -4, 1, -4, 1, -4, 3, -2, 1, 1, 0, 2, 3, 3, -3,
+    -1, 0, -2, 0, 2, -1, -1, 3, -1, 2, -4, 1, 3, 2, 3, -3,
+    -4, 3, -1, 3, -1, 0, 0, -4, -3, -3, -3, 2, -2, -3, 3, 1,
+    3, 3, 2, -3, 0, 1, 0, 1, -4, -1, -2, -3, -4, 1, 0, -3,
+    -3, 3, -4, -3, 0, -3, 1, 1, -4, -4, -3, 3, 1, 0, 1, -2,
+    -1, -3, -4, -4, -1, -1, -3, -2, -4, -3, -3, 0, 1, 3, -4, -3,
+    -1, -4, 1, -4, -3, 2, 2, 2, 0, 3, 3, -2, 1, 1, -3, -1,
+    2, 1, 1, -2, 3, -2, -2, 1, 3, 1, 1, 2, -1, -3, -3, -1,
+    0, 3, 1, 0, -1, 2, 3, 2, -2, -3, 1, -1, -1, 2, -2, -3,
+    0, 3, 0, -3, 2, -3, -4, -4, 3, -2, -2, 2, -4, 3, 0, -4,
+    -3, -2, 1, 1, 0, 3, 3, -1, 2, 1, -4, -3, -2, -3, 2, -2,
+    0, 0, -2, -4, 1, -3, 2, -1, -3, -4, -2, -2, 3, 1, -1, 0,
+    1, -2, -2, 3, -4, -2, -3, -4, -1, -4, 3, -2, 0, 1, -3, -4,
+    2, -1, 3, 2, 3, 2, -1, 3, 2, -2, -3, 0, 3, -2, 2, -4,
+    -1, 1, 3, 1, -2, -1, -2, 0, -2, -3, -2, -3, 1, -1, 0, -3,
+    2, -4, -3, -3, -3, -4, 1, -1, 2, -2, -4, -1, 0, -4, 1, 1,
+    2, 0, -3, 2, -2, 3, -4, 3, 2, 2, -4, 3, -1, 0, -4, 1,
+    0, -2, 2, -2, -4, 3, 3, -4, -4, 1, 2, 1, -2, 0, 0, 0,
+    0, -4, 1, -4, -1, 3, 0, 3, 2, -4, 2, -3, 0, -3, -3, -2,
+    0, -3, 2, -2, 1, -4, 0, -1, -4, 1, -2, 2, 1, 0, 2, 2,
+    -3, -1, -4, 1, 3, 3, -2, 2, -2, 2, 3, 1, 3, -4, 1, 3,
+    -3, 1, -4, 3, 3, -3, -1, 0, 0, -4, -1, 2, -1, 0, 1, -2,
+    -3, 3, -4, -4, 2, 0, 2, 2, -4, -2, -4, -1, 0, 3, 0, -3,
+    2, 3, -2, 2, -4, 0, 1, -3, -3, -2, -2, -1, 1, 2, -4, -3,
+    1, 3, -4, 1, -1, -4, -4, -2, 2, 0, -1, -1, 3, -4, -3, 3,
+    2, 2, 0, 1, -3, 0, -2, -3, -2, -2, 1, -2, -3, -1, -1, -3,
+    -3, 2, 3, -3, 3, 1, -2, 0, -2, -3, 1, -2, -4, 2, -4, 1,
+    -4, 3, 1, 1, 3, -4, -4, 3, -3, 2, 2, 0, -3, -1, -1, -2,
+    -2, -3, -3, 1, -3, -3, 2, 0, 2, -4, -4, -2, 2, -2, 3, -4,
+    3, -2, 0, -2, 2, -3, 1, 0, 3, 1, -1, -3, -4, 1, -2, -1,
+    0, 0, 1, -2, -1, 1, -2, 1, 1, -4, -1, 0, -1, 1, -4, 0,
+    -4, -1, -3, 2, 2, 0, -1, -3, 1, 3, 2, 1, -3, 1, 2, -2,
+    -2, 1, -4, -2, 2, 0, 3, 1, 0, -1, 3, 0, -4, -1, 1, 3,
+    -1, 1, 1, -4, -2, 1, -1, 2, -1, 1, 0, 0, -2, 2, 2, 0,
+    1, -3, -4, -2, -3, -1, 2, 3, -3, 3, -2, 3, -2, -1, -1, -1,
+    1, 2, 2, 3, 2, -4, -1, 0, -4, 2, -2, 0, -4, -1, 2, 3,
+    -4, -4, -2, -3, 0, 0, -1, -3, 2, 3, -4, 2, -1, 3, -4, -1,
+    -1, -3, 0, -1, -3, 2, -2, -2, -3, 2, 0, 1, -2, 2, 3, -3,
+    -3, -4, 0, 1, -3, -4, 0, 1, -1, -1, 3, 3, 0, -2, -4, 0,
+    3, 1, -4, -4, 3, 2, -2, 3, 1, 1, 2, -2, -4, 0, -1, 1,
+    -2, -2, 2, -4, 0, 2, -2, 3, 2, -3, -3, 2, 3, 0, 0, 2,
+    -4, -4, -2, -2, -3, -2, 0, -1, 2, -4, 2, -1, 0, 1, -4, -3,
+    -4, 2, 0, 1, 3, 1, 3, -4, 1, -3, 2, 1, -2, 1, -2, 1,
+    -1, -4, -1, 1, 3, 0, -4, 0, -2, -3, 3, 3, -4, 0, -3, -4,
+    -3, 1, 2, -3, -3, -3, 3, 2, 1, -4, 3, 0, -4, -1, -3, -1,
+    2, 2, -2, -2, -1, 0, 1, -4, -3, 1, -4, -1, 3, 2, -1, 3,
+    -4, -3, -2, -2, -4, 3, -2, 3, -2, -1, 1, -4, 3, -2, 1, -4,
+    2, -4, -4, -2, 3, -3, -1, 2, 2, 3, 1, -4, 3, 0, 0, -4,
+    1, 1, 2, -4, -1, 3, 3, 3, 3, 2, -2, 0, -4, 2, 2, 2,
+    1, -4, 2, 3, -3, -4, -4, -3, -3, -4, 0, 3, 0, 3, 1, 2,
+    3, -1, -2, 0, -2, 0, -1, 2, 3, 3, 2, 3, -2, -3, 2, 1,
+    3, -4, 1, 1, 0, 1, -3, -3, -1, -2, -3, -1, 2, 2, -1, 0,
+    -1, 3, 0, -2, -4, 0, -3, 3, -2, 1, 0, -3, 2, -2, -3, 3,
+    0, -4, 1, -1, 3, -1, 2, -3, -2, 2, 0, -3, 1, 3, 3, -1,
+    -4, 1, -1, 1, 2, 1, -2, -4, -2, 1, 0, 0, -4, -2, 1, -2,
+    3, 0, -3, -4, -2, 0, -2, 3, 1, -2, 3, -4, -2, 2, 1, 2,
+    -4, -2, 3, 1, -1, -1, 1, -1, 3, -3, -3, -3, -2, 2, 0, 2,
+    2, 3, -4, 1, 1, 1, -4, 0, -4, 3, -1, 3, -4, 2, -2, 3,
+    -3, 0, 2, -3, -4, -1, -4, 3, 2, -4, -1, -3, -1, -2, 1, -1,
+    -2, 0, 1, 2, -3, -4, -4, 3, -3, 0, 0, -3, -4, -3, 1, 1,
+    1, -3, -4, -1, 3, 1, 2, 0, 2, -1, 2, 3, 3, -3, -4, -4,
+    3, -3, -4, 1, -2, -3, -3, -3, -2, 0, -3, -4, -2, -4, -2, -2,
+    1, -4, 1, 2, 1, -1, -3, -4, 1, -1, -2, 1, 2, 1, -2, -2,
+    1, -2, 0, -2, -2, -1, 3, 2, 3, 2, 3, -2, -3, -3, -3, 2,
+    -2, -4, 0, 3, -1, -1, -3, -1, 1, -2, -1, -1, -4, 3, 1, -4,
+    1, 1, -2, 0, -4, -3, 3, 3, -4, -4, 2, 1, 0, -2, -1, -3,
+    2, -4, 1, 1, -1, 0, -1, -2, 0, -1, -2, 3, 3, 1, -3, -4,
+    3, -3, 0, 0, -3, 0, 3, -4, 3, -2, -2, -3, 0, 3, 2, -2,
+    1, -1, -4, 3, 3, -4, 1, 1, -2, -1, -1, -1, 0, 0, 3, 3,
+    -2, -1, 0, 1, 2, -1, -4, -3, 1, -2, 0, -4, -2, -2, 2, -4,
+    -4, -4, 1, 3, -1, 1, 2, 2, -2, -2, 3, -4, 0, -3, -1, -2,
+    -2, 0, -1, 0, 0, 2, 2, 2, 3, -2, -4, 2, 3, 2, 1, -1,
+    -2, -2, 0, -3, 0, -2, -2, 2, 0, -4, -3, 0, 0, 3, -3, 1,
+    2, 1, 1, 3, 3, -4, 2, 0, 1, -4, 3, 2, 3, -2, -1, -4,
+    -1, 0, 1, -2, -4, -3, 0, 2, -4, -3, 0, 0, -4, 2, -2, 1,
+    -4, 1, -1, 2, -3, 3, 3, 3, -1, -3, 2, -2, 3, 2, -4, 2,
+    -2, -4, -3, 3, 3, 3, -1, 2, 1, -1, 0, -4, -4, 3, 1, 1,
+    2, 3, -4, -3, 3, -3, 0, 2, 3, 0, 2, -4, -1, 1, 3, -1,
+    3, -2, -4, -2, 3, 0, -4, -4, -2, -1, -3, -3, 0, -3, -3, -3,
+};
+
+static const float golden_mel_db_quiet[512] = {
+    -52.851847f, -50.0151644f, -48.6466147f, -49.5808245f, -46.9342514f, -47.3597763f, -49.2492347f, -46.4930481f,
+    -54.0686784f, -52.9671114f, -51.3218189f, -52.6161821f, -52.4879957f, -52.6733062f, -54.4404502f, -49.8487334f,
+    -54.3295938f, -56.9136614f, -58.4140015f, -57.5822804f, -58.7495125f, -57.0650824f, -56.537828f, -56.8857213f,
+    -54.75594f, -58.8277196f, -58.1595521f, -57.6045297f, -57.3214691f, -57.0471593f, -56.7153016f, -58.4570119f,
+    -56.6996522f, -59.6389194f, -58.3480685f, -53.4815127f, -59.7507519f, -58.6432013f, -56.7057692f, -58.7315545f,
+    -58.4720626f, -58.9203911f, -58.4398009f, -54.4703321f, -56.4659467f, -57.7495779f, -58.8872414f, -59.7273324f,
+    -55.6114462f, -54.4110638f, -56.2475954f, -55.769915f, -56.2555556f, -59.3493945f, -58.7422971f, -58.4946702f,
+    -56.1567804f, -56.9075913f, -57.3622746f, -58.4668879f, -55.393002f, -59.6676638f, -58.978729f, -56.4927957f,
+    -59.104351f, -56.601361f, -55.6151758f, -55.8618463f, -53.708052f, -59.4891017f, -59.3356958f, -56.2435431f,
+    -56.271569f, -59.5810619f, -56.9881754f, -57.2176545f, -53.4157228f, -59.1059594f, -58.752266f, -55.5744772f,
+    -58.0896126f, -55.5785015f, -56.2688644f, -53.6345065f, -56.2415447f, -57.8100668f, -53.6622754f, -54.0300763f,
+    -58.5292532f, -58.3479489f, -56.9408228f, -57.6098406f, -55.8620718f, -56.5701645f, -54.9670672f, -54.4217446f,
+    -57.3814986f, -54.765142f, -56.9470739f, -55.2595839f, -54.9111285f, -57.7353002f, -58.3789204f, -56.5013892f,
+    -55.5941233f, -55.4096338f, -57.4350325f, -53.2704232f, -57.0775049f, -56.8462967f, -55.9020351f, -56.7360356f,
+    -55.4535151f, -55.8221976f, -59.6150225f, -56.9655786f, -58.0103121f, -58.0460588f, -55.2712075f, -58.6991631f,
+    -54.609889f, -55.4130089f, -58.4184436f, -55.8671992f, -56.3441416f, -58.8888172f, -57.4542794f, -56.8988111f,
+    -58.1045095f, -57.4412494f, -57.5264752f, -57.0654402f, -56.1974133f, -59.1948388f, -58.5252654f, -54.4846118f,
+    -55.7528f, -58.0495313f, -55.2861034f, -58.8245927f, -55.3583873f, -56.280058f, -58.3040754f, -54.7221094f,
+    -55.9318822f, -58.5748262f, -52.5526133f, -53.4073716f, -56.662412f, -55.6749699f, -56.567023f, -55.8129192f,
+    -51.1744967f, -58.50358f, -55.3623969f, -49.5359343f, -58.2675743f, -55.8424015f, -58.3042932f, -56.7460746f,
+    -54.0239971f, -59.189092f, -59.2676985f, -53.1568243f, -57.545477f, -56.7489332f, -56.3134471f, -56.2852738f,
+    -57.0001206f, -56.7769078f, -58.1799758f, -58.0989592f, -55.993066f, -52.5234337f, -53.291774f, -56.4231793f,
+    -57.3054802f, -57.9058205f, -56.9512658f, -58.7631348f, -58.6650025f, -54.7853565f, -53.4964397f, -58.365209f,
+    -58.2305358f, -54.1589363f, -56.2476456f, -57.207642f, -55.4398734f, -57.7456277f, -57.4042386f, -58.0745961f,
+    -58.9108102f, -57.8571457f, -57.7236023f, -54.1420379f, -56.3626291f, -58.3154245f, -56.8704264f, -58.010083f,
+    -57.9474984f, -56.538223f, -52.7301657f, -53.8236125f, -57.3232536f, -58.3396276f, -53.3239161f, -57.647219f,
+    -52.0309468f, -55.3890074f, -54.4056229f, -50.5159781f, -55.5123608f, -56.6600381f, -52.3061439f, -55.0803181f,
+    -55.9612478f, -53.1961054f, -53.2877454f, -50.9236766f, -51.2922576f, -55.1743419f, -50.4913751f, -52.1482643f,
+    -53.9179911f, -52.5203411f, -52.1176302f, -55.0316884f, -53.0661082f, -52.0637593f, -49.8238863f, -51.9626813f,
+    -55.6138894f, -54.3849339f, -53.1145984f, -54.0369811f, -53.4434353f, -53.8253978f, -52.3377378f, -53.3420966f,
+    -56.359885f, -55.2557697f, -53.758535f, -55.3220748f, -54.4746802f, -55.04051f, -55.702234f, -55.7449632f,
+    -53.9475654f, -53.1295482f, -52.8223225f, -55.0275357f, -53.0522099f, -54.3078576f, -56.0535364f, -56.8443709f,
+    -53.8364646f, -53.7112719f, -56.7362408f, -55.7713998f, -52.6053852f, -52.1001531f, -56.6659112f, -55.9197926f,
+    -57.9131027f, -53.556827f, -55.2865716f, -54.316958f, -54.7629106f, -55.4069028f, -53.2205961f, -53.8376461f,
+    -51.8750174f, -51.5235833f, -55.6510971f, -55.4014195f, -55.859482f, -55.0671287f, -55.781756f, -54.2757603f,
+    -54.2250556f, -57.2319578f, -52.9633418f, -52.9684854f, -52.6598066f, -53.8911782f, -52.9787725f, -55.9747655f,
+    -55.1005949f, -54.0440452f, -53.6466049f, -52.2748964f, -54.2631796f, -53.1114221f, -51.0811612f, -53.3105562f,
+    -52.7522513f, -53.0003908f, -50.5219776f, -52.866233f, -54.1449244f, -52.2441824f, -51.348892f, -53.9609215f,
+    -53.559103f, -52.2148075f, -52.7788559f, -55.0772486f, -55.8741452f, -52.4345682f, -51.8210722f, -52.9512465f,
+    -55.4786336f, -52.7057788f, -55.2828406f, -53.6167852f, -54.3751359f, -52.5267834f, -55.6912816f, -49.2680467f,
+    -54.412879f, -51.5658457f, -51.9772207f, -50.7328457f, -52.9882021f, -54.9209875f, -52.7307931f, -51.3341909f,
+    -51.8254381f, -51.326273f, -50.9112781f, -54.1002771f, -52.505962f, -52.0714841f, -52.8626743f, -52.1774299f,
+    -50.097528f, -49.8363997f, -52.7603271f, -52.4781827f, -51.6864228f, -53.6086764f, -54.7417923f, -53.5092158f,
+    -51.186466f, -54.3109692f, -51.2185201f, -51.3238406f, -52.2870263f, -53.5523786f, -55.8808393f, -51.5498947f,
+    -51.0920294f, -49.0512958f, -50.1313245f, -52.827402f, -53.85516f, -54.865653f, -51.1089179f, -52.2306681f,
+    -54.3999858f, -52.4281851f, -50.9683461f, -51.5628802f, -53.0732461f, -52.2575166f, -48.432217f, -48.2865293f,
+    -54.1724064f, -54.8706637f, -52.045945f, -53.9419948f, -51.8813251f, -50.1386607f, -48.7419205f, -50.7919245f,
+    -50.8645535f, -53.0091738f, -52.3270462f, -53.1654293f, -51.7490533f, -50.9565404f, -50.6448972f, -50.6623812f,
+    -50.2284554f, -50.0408008f, -52.5434029f, -54.3422355f, -52.6281674f, -52.5341881f, -54.0017382f, -50.9666303f,
+    -51.3655165f, -48.5245094f, -50.5841326f, -54.387083f, -52.9389648f, -54.8379728f, -52.4613379f, -52.3195534f,
+    -51.1912537f, -52.0429968f, -53.939638f, -53.0066315f, -51.6608134f, -52.1155884f, -52.1349538f, -54.5086021f,
+    -49.3272383f, -50.692821f, -51.9337098f, -52.2201935f, -49.6603161f, -51.9644375f, -51.9917532f, -52.3113945f,
+    -52.3715333f, -51.0788706f, -52.1021446f, -50.6376217f, -50.6498044f, -51.7319053f, -49.4833005f, -51.5289433f,
+    -51.0174014f, -51.0259715f, -54.5995087f, -51.2891205f, -51.7724042f, -51.3528508f, -53.0110518f, -51.4215221f,
+    -52.0376425f, -50.7877809f, -51.0725089f, -52.6228819f, -51.762054f, -49.8518635f, -52.4388233f, -50.6788958f,
+    -50.5945195f, -51.0698137f, -52.8737231f, -52.6757353f, -51.8196588f, -53.8379214f, -49.8991625f, -49.9611052f,
+    -49.7506564f, -52.2832702f, -54.1647357f, -51.2077676f, -50.1602036f, -49.0108559f, -51.5110727f, -49.8902757f,
+    -50.7382077f, -51.5796584f, -51.7919923f, -50.2148923f, -50.6159798f, -52.1393519f, -49.7087131f, -49.4635043f,
+    -51.6831242f, -52.2030403f, -49.2962269f, -49.6763523f, -47.8373892f, -49.0701815f, -49.2938059f, -51.0589548f,
+    -53.2277533f, -51.3920217f, -51.0479494f, -47.9325699f, -50.0121533f, -51.2957155f, -52.7151952f, -54.00227f,
+    -52.5725537f, -51.9612581f, -49.9177083f, -51.4344692f, -50.483734f, -51.1835959f, -50.2800771f, -53.1415224f,
+    -53.3043745f, -49.4981192f, -47.7800275f, -50.3970562f, -50.0634235f, -49.2376974f, -48.5856706f, -52.8480508f,
+    -50.676076f, -47.8157708f, -48.0723409f, -50.6275114f, -50.4913624f, -51.076035f, -49.7660885f, -50.0338018f,
+    -48.9764632f, -51.4149602f, -48.9021273f, -52.2435095f, -47.7230647f, -48.3928158f, -48.0622901f, -49.475024f,
+};
+
+static const float golden_normalized_quiet[512] = {
+    0.520369515f, 0.734334366f, 0.837561118f, 0.767095692f, 0.96672099f, 0.934624566f, 0.792106795f, 1.0f,
+    0.42858655f, 0.511675375f, 0.635776235f, 0.538145213f, 0.547814036f, 0.533836468f, 0.4005446f, 0.746887896f,
+    0.408906265f, 0.21399562f, 0.100828203f, 0.163563127f, 0.0755213257f, 0.202574261f, 0.242343924f, 0.216103077f,
+    0.376747889f, 0.0696223367f, 0.12002077f, 0.161884911f, 0.183235563f, 0.203926156f, 0.228957473f, 0.0975840151f,
+    0.230137871f, 0.00843528391f, 0.105801387f, 0.47287519f, 0.0f, 0.0835401507f, 0.229676481f, 0.0768758614f,
+    0.0964487728f, 0.0626323233f, 0.0988822041f, 0.398290676f, 0.24776577f, 0.15094424f, 0.065132734f, 0.00176647917f,
+    0.312218898f, 0.402761153f, 0.264235539f, 0.300265939f, 0.263635121f, 0.030273525f, 0.0760655675f, 0.0947435365f,
+    0.27108552f, 0.214453474f, 0.180157691f, 0.0968390926f, 0.328695673f, 0.00626715842f, 0.0582320255f, 0.245740611f,
+    0.0487566244f, 0.237551762f, 0.311937589f, 0.293331763f, 0.455787819f, 0.0197357075f, 0.0313067861f, 0.264541193f,
+    0.262427261f, 0.0127993538f, 0.208375187f, 0.191066073f, 0.477837581f, 0.0486353094f, 0.0753136406f, 0.315007396f,
+    0.125296154f, 0.314703852f, 0.262631262f, 0.461335202f, 0.264691929f, 0.146381688f, 0.45924065f, 0.431498218f,
+    0.0921350161f, 0.105810405f, 0.211946895f, 0.161484322f, 0.293314755f, 0.23990485f, 0.360823017f, 0.401955528f,
+    0.178707665f, 0.376053804f, 0.211475386f, 0.338759119f, 0.365042353f, 0.152021178f, 0.103474289f, 0.245092418f,
+    0.313525532f, 0.327441172f, 0.174669721f, 0.488797217f, 0.201637254f, 0.219076795f, 0.290300405f, 0.227393545f,
+    0.324131305f, 0.296322377f, 0.0102377762f, 0.210079617f, 0.131277623f, 0.128581322f, 0.337882371f, 0.0793190777f,
+    0.387764198f, 0.327186601f, 0.100493144f, 0.292928006f, 0.256953265f, 0.0650138752f, 0.173217971f, 0.215115744f,
+    0.124172511f, 0.174200795f, 0.167772394f, 0.202547274f, 0.268020667f, 0.0419313266f, 0.0924358039f, 0.397213592f,
+    0.301556892f, 0.128319399f, 0.336758808f, 0.0698581932f, 0.331306585f, 0.261786955f, 0.109119689f, 0.379299654f,
+    0.288049107f, 0.0886975413f, 0.542940068f, 0.478467494f, 0.232946816f, 0.307427444f, 0.2401418f, 0.297022229f,
+    0.646888429f, 0.0940714844f, 0.331004156f, 0.770481657f, 0.111872884f, 0.29479844f, 0.109103263f, 0.226636326f,
+    0.431956761f, 0.0423647928f, 0.0364356796f, 0.497365738f, 0.166339129f, 0.226420707f, 0.259268485f, 0.26139354f,
+    0.207474184f, 0.224310646f, 0.118480253f, 0.124591158f, 0.283434141f, 0.545141025f, 0.487186772f, 0.250991623f,
+    0.184441574f, 0.139159198f, 0.211159198f, 0.0744938281f, 0.0818957368f, 0.374529065f, 0.471749283f, 0.104508515f,
+    0.114666625f, 0.421778588f, 0.264231754f, 0.191821297f, 0.325160266f, 0.151242195f, 0.176992441f, 0.126428818f,
+    0.0633549912f, 0.142830634f, 0.152903519f, 0.423053204f, 0.255558793f, 0.108263649f, 0.217256742f, 0.131294904f,
+    0.136015525f, 0.242314127f, 0.529547678f, 0.44707134f, 0.183100963f, 0.106438062f, 0.484762365f, 0.158664951f,
+    0.582288249f, 0.328996984f, 0.403171555f, 0.69655907f, 0.3196927f, 0.233125874f, 0.561530722f, 0.352280749f,
+    0.285834124f, 0.494402851f, 0.487490641f, 0.665807255f, 0.638005985f, 0.345188733f, 0.698414821f, 0.573439245f,
+    0.439952565f, 0.545374288f, 0.575749907f, 0.355948778f, 0.504208254f, 0.579813272f, 0.748762061f, 0.587437366f,
+    0.312034618f, 0.404732075f, 0.500550746f, 0.43097741f, 0.475747284f, 0.446936677f, 0.559147662f, 0.483391048f,
+    0.25576578f, 0.339046813f, 0.451979993f, 0.33404556f, 0.39796271f, 0.355283391f, 0.305370972f, 0.302148002f,
+    0.437721845f, 0.499423111f, 0.522596486f, 0.356262007f, 0.505256574f, 0.41054578f, 0.278872989f, 0.219222049f,
+    0.446101934f, 0.45554495f, 0.227378067f, 0.30015395f, 0.538959596f, 0.57706817f, 0.232682884f, 0.288961001f,
+    0.138609915f, 0.467194394f, 0.336723495f, 0.409859351f, 0.376222111f, 0.32764717f, 0.492555567f, 0.44601282f,
+    0.594049663f, 0.620557586f, 0.309228118f, 0.328060763f, 0.293510097f, 0.353275593f, 0.299372802f, 0.412966806f,
+    0.416791356f, 0.18998721f, 0.511959702f, 0.511571735f, 0.53485471f, 0.441975004f, 0.510795798f, 0.284814512f,
+    0.350751315f, 0.430444578f, 0.460422644f, 0.563887657f, 0.413915745f, 0.500790329f, 0.653928529f, 0.485770068f,
+    0.527881805f, 0.509165175f, 0.696106539f, 0.519284412f, 0.422835481f, 0.56620435f, 0.633734172f, 0.436714416f,
+    0.467022725f, 0.568420031f, 0.525875078f, 0.352512276f, 0.292404081f, 0.551843954f, 0.598118637f, 0.512872029f,
+    0.322236671f, 0.531387124f, 0.33700491f, 0.462671878f, 0.405471122f, 0.544888363f, 0.30619709f, 0.790687841f,
+    0.402624237f, 0.61736982f, 0.586340694f, 0.680201214f, 0.510084548f, 0.364298711f, 0.529500351f, 0.634843039f,
+    0.597789323f, 0.635440274f, 0.666742445f, 0.42620313f, 0.546458875f, 0.579230606f, 0.519552838f, 0.571239343f,
+    0.728121855f, 0.747818205f, 0.527272664f, 0.548554208f, 0.608274952f, 0.463283508f, 0.37781502f, 0.470785605f,
+    0.64598561f, 0.410311079f, 0.643567846f, 0.635623747f, 0.562972726f, 0.467529926f, 0.29189916f, 0.618572972f,
+    0.653108763f, 0.807036898f, 0.725572665f, 0.52221335f, 0.444691779f, 0.368472473f, 0.651834899f, 0.5672237f,
+    0.403596748f, 0.552325419f, 0.662437923f, 0.617593503f, 0.503669861f, 0.565198576f, 0.853732673f, 0.864721587f,
+    0.42076257f, 0.368094527f, 0.581156964f, 0.438142023f, 0.593573891f, 0.72501931f, 0.830372409f, 0.675745027f,
+    0.670266783f, 0.508502693f, 0.559954107f, 0.49671668f, 0.60355087f, 0.663328406f, 0.686834976f, 0.685516196f,
+    0.718246288f, 0.732400667f, 0.543634791f, 0.407952727f, 0.537241188f, 0.544329842f, 0.433635702f, 0.662567348f,
+    0.632480217f, 0.846771257f, 0.691418319f, 0.404569976f, 0.513798407f, 0.370560332f, 0.549824774f, 0.560519277f,
+    0.645624485f, 0.581379344f, 0.438319785f, 0.508694454f, 0.610206609f, 0.575903913f, 0.574443228f, 0.395404056f,
+    0.786223149f, 0.683220192f, 0.589622622f, 0.568013779f, 0.761099809f, 0.5873049f, 0.585244536f, 0.561134682f,
+    0.556598543f, 0.654101301f, 0.576917949f, 0.687383755f, 0.68646484f, 0.604844302f, 0.774451714f, 0.620153288f,
+    0.658737792f, 0.658091371f, 0.388547168f, 0.638242604f, 0.601789558f, 0.633435569f, 0.50836104f, 0.628255836f,
+    0.581783205f, 0.676057571f, 0.654581154f, 0.53763986f, 0.602570254f, 0.746651801f, 0.551523002f, 0.68427054f,
+    0.690634861f, 0.654784442f, 0.518719447f, 0.533653243f, 0.59822525f, 0.44599205f, 0.743084143f, 0.738411939f,
+    0.754285636f, 0.563256035f, 0.421341157f, 0.644378881f, 0.723394376f, 0.810087192f, 0.621501234f, 0.743754451f,
+    0.679796769f, 0.616327955f, 0.60031207f, 0.719269326f, 0.689016157f, 0.574111487f, 0.757449326f, 0.775944898f,
+    0.608523757f, 0.569307606f, 0.788562268f, 0.75989023f, 0.898599253f, 0.805612392f, 0.788744881f, 0.65560351f,
+    0.492015712f, 0.630480993f, 0.656433621f, 0.891419975f, 0.734561485f, 0.637745158f, 0.530676868f, 0.433595587f,
+    0.54143601f, 0.587544716f, 0.741685267f, 0.627279267f, 0.698991169f, 0.646202099f, 0.714352574f, 0.49851993f,
+    0.486236344f, 0.77333397f, 0.902925922f, 0.705529095f, 0.730694286f, 0.792977028f, 0.842158002f, 0.520655856f,
+    0.684483229f, 0.900229882f, 0.88087735f, 0.68814635f, 0.698415777f, 0.654315185f, 0.753121621f, 0.732928591f,
+    0.812681354f, 0.628750787f, 0.818288357f, 0.566255099f, 0.907222503f, 0.856704623f, 0.881635466f, 0.775075996f,
+};
+
+static const int8_t golden_q8_quiet[512] = {
+    -79, -73, -71, -73, -68, -69, -72, -67, -81, -79, -76, -78, -78, -78, -81, -73,
+    -81, -86, -89, -87, -89, -86, -85, -86, -82, -89, -88, -87, -87, -86, -86, -89,
+    -86, -91, -89, -80, -91, -89, -86, -89, -89, -90, -89, -81, -85, -87, -90, -91,
+    -84, -81, -85, -84, -85, -90, -89, -89, -85, -86, -87, -89, -83, -91, -90, -85,
+    -90, -85, -84, -84, -80, -91, -90, -85, -85, -91, -86, -87, -80, -90, -89, -84,
+    -88, -84, -85, -80, -85, -88, -80, -81, -89, -89, -86, -87, -84, -85, -82, -81,
+    -87, -82, -86, -83, -82, -87, -89, -85, -84, -83, -87, -79, -86, -86, -84, -86,
+    -83, -84, -91, -86, -88, -88, -83, -89, -82, -83, -89, -84, -85, -90, -87, -86,
+    -88, -87, -87, -86, -85, -90, -89, -82, -84, -88, -83, -89, -83, -85, -88, -82,
+    -84, -89, -78, -80, -85, -84, -85, -84, -75, -89, -83, -73, -88, -84, -88, -86,
+    -81, -90, -90, -79, -87, -86, -85, -85, -86, -86, -88, -88, -84, -78, -79, -85,
+    -87, -88, -86, -89, -89, -82, -80, -89, -88, -81, -85, -86, -83, -87, -87, -88,
+    -90, -88, -87, -81, -85, -89, -86, -88, -88, -85, -78, -80, -87, -89, -79, -87,
+    -77, -83, -81, -74, -83, -85, -78, -83, -84, -79, -79, -75, -76, -83, -74, -77,
+    -80, -78, -77, -83, -79, -77, -73, -77, -84, -81, -79, -81, -80, -80, -78, -79,
+    -85, -83, -80, -83, -82, -83, -84, -84, -81, -79, -78, -83, -79, -81, -84, -86,
+    -80, -80, -86, -84, -78, -77, -85, -84, -88, -80, -83, -81, -82, -83, -79, -80,
+    -77, -76, -84, -83, -84, -83, -84, -81, -81, -87, -79, -79, -78, -80, -79, -84,
+    -83, -81, -80, -78, -81, -79, -75, -79, -78, -79, -74, -79, -81, -77, -76, -81,
+    -80, -77, -78, -83, -84, -78, -77, -79, -83, -78, -83, -80, -81, -78, -84, -72,
+    -81, -76, -77, -75, -79, -82, -78, -76, -77, -76, -75, -81, -78, -77, -79, -77,
+    -74, -73, -78, -78, -76, -80, -82, -80, -76, -81, -76, -76, -78, -80, -84, -76,
+    -75, -72, -74, -79, -80, -82, -75, -77, -81, -78, -75, -76, -79, -77, -71, -70,
+    -81, -82, -77, -81, -77, -74, -71, -75, -75, -79, -78, -79, -77, -75, -75, -75,
+    -74, -73, -78, -81, -78, -78, -81, -75, -76, -71, -74, -81, -79, -82, -78, -78,
+    -76, -77, -81, -79, -76, -77, -77, -82, -72, -75, -77, -77, -73, -77, -77, -78,
+    -78, -75, -77, -75, -75, -77, -72, -76, -75, -75, -82, -76, -77, -76, -79, -76,
+    -77, -75, -75, -78, -77, -73, -78, -75, -74, -75, -79, -78, -77, -80, -73, -73,
+    -73, -78, -81, -76, -74, -72, -76, -73, -75, -76, -77, -74, -74, -77, -73, -72,
+    -76, -77, -72, -73, -69, -72, -72, -75, -79, -76, -75, -70, -73, -76, -78, -81,
+    -78, -77, -73, -76, -74, -76, -74, -79, -79, -72, -69, -74, -73, -72, -71, -79,
+    -75, -69, -70, -75, -74, -75, -73, -73, -71, -76, -71, -77, -69, -70, -70, -72,
+};
+
+#define GOLDEN_N_VECTORS 3
+static const GoldenVector_t golden_vectors[GOLDEN_N_VECTORS] = {
+    {"tone_1k", golden_pcm_tone_1k, golden_mel_db_tone_1k, golden_normalized_tone_1k, golden_q8_tone_1k},
+    {"chirp_noise", golden_pcm_chirp_noise, golden_mel_db_chirp_noise, golden_normalized_chirp_noise, golden_q8_chirp_noise},
+    {"quiet", golden_pcm_quiet, golden_mel_db_quiet, golden_normalized_quiet, golden_q8_quiet},
+};
+
+#endif // GOLDEN_VECTORS_H
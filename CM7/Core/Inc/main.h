@@ -28,11 +28,26 @@ extern "C"
 #endif
 
 /* Includes ------------------------------------------------------------------*/
+#include "agc.h"
+#include "cnn_inference.h"
+#include "detection_log.h"
+#include "dma_chain.h"
+#include "golden_check.h"
+#include "mdma_transfer.h"
 #include "mel_filterbank.h"
 #include "mel_spectrogram.h"
+#include "mem_placement.h"
+#include "pdm_decimator.h"
+#include "pipeline_arena.h"
+#include "profiler.h"
+#include "qspi_nor.h"
+#include "stack_monitor.h"
+#include "stereo_beam.h"
 #include "stm32h747i_discovery_audio.h"
+#include "stm32h747i_discovery_qspi.h"
 #include "stm32h747i_discovery_sdram.h"
 #include "stm32h7xx_hal.h"
+#include "trace.h"
 
 #include <stdint.h>
 #include <string.h>
@@ -112,5 +127,6 @@ extern "C"
     void Error_Handler(void);
     void SDRAM_demo(void);
     void SDRAM_DMA_demo(void);
+    void AudioRecord_Init(void);
     void AudioRecord(void);
 #endif /* __MAIN_H */
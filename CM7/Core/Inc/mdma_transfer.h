@@ -0,0 +1,50 @@
+// mdma_transfer.h
+#ifndef MDMA_TRANSFER_H
+#define MDMA_TRANSFER_H
+
+#include "dma_chain.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// channel 0 belongs to the weight store (weight_store.c)
+#define MDMA_TRANSFER_CHANNEL MDMA_Channel1
+#define MDMA_TRANSFER_IRQ_PRIORITY 0x0F
+
+    /**
+     * @brief Enables the MDMA clock and interrupt for the transfer channel.
+     * @return 0 if successful, -1 on failure
+     */
+    int mdma_transfer_init(void);
+
+    /**
+     * @brief Starts a chain as one MDMA linked list. The chain is copied, so it may live on the
+     *        caller's stack. Sources in cacheable memory must be cleaned by the caller and
+     *        destinations invalidated before the CPU reads them.
+     * @return 0 if started, -1 if a chain is still running or the list could not be built
+     */
+    int mdma_transfer_submit(const DmaChain_t *chain);
+
+    /**
+     * @brief 1 while a submitted chain has not completed.
+     */
+    uint8_t mdma_transfer_busy(void);
+
+    /**
+     * @brief Chains that ended with a bus error or failed to start.
+     */
+    uint32_t mdma_transfer_errors(void);
+
+    /**
+     * @brief To be called from MDMA_IRQHandler.
+     */
+    void mdma_transfer_irq(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MDMA_TRANSFER_H
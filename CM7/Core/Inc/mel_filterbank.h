@@ -8,6 +8,17 @@ extern "C"
 {
 #endif
 
+// nonzero weights of a sparse bank: triangles overlap pairwise, so each bin is in at most two
+#define MEL_SPARSE_WEIGHTS(n_fft) (2u * ((n_fft) / 2 + 1))
+
+    /// @brief one triangular band: weights[offset .. offset + n_bins) apply to bins first_bin..
+    typedef struct
+    {
+        uint16_t first_bin;
+        uint16_t n_bins;
+        uint16_t offset;
+    } MelBand_t;
+
     /// @brief startup populate a (n_mels × (n_fft/2 + 1)) filterbank matrix
     /// @param filterbank output filterbank matrix
     /// @param n_mels
@@ -18,6 +29,24 @@ extern "C"
     void create_mel_filterbank(float *filterbank, uint16_t n_mels, uint16_t n_fft,
                                float sample_rate, float f_min, float f_max);
 
+    /// @brief number of weights create_sparse_mel_filterbank writes for these parameters
+    /// @return exact count, at most MEL_SPARSE_WEIGHTS(n_fft)
+    uint32_t sparse_mel_filterbank_size(uint16_t n_mels, uint16_t n_fft, float sample_rate,
+                                        float f_min, float f_max);
+
+    /// @brief startup populate a sparse filterbank, only the nonzero span of each band is stored
+    /// @param bands n_mels band descriptors
+    /// @param weights packed band weights, MEL_SPARSE_WEIGHTS(n_fft) floats
+    /// @param n_mels
+    /// @param n_fft
+    /// @param sample_rate
+    /// @param f_min
+    /// @param f_max
+    /// @return number of weights written
+    uint32_t create_sparse_mel_filterbank(MelBand_t *bands, float *weights, uint16_t n_mels,
+                                          uint16_t n_fft, float sample_rate, float f_min,
+                                          float f_max);
+
 #ifdef __cplusplus
 }
 #endif
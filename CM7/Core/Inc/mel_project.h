@@ -0,0 +1,48 @@
+// mel_project.h
+#ifndef MEL_PROJECT_H
+#define MEL_PROJECT_H
+
+#include "mel_filterbank.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Sparse filterbank x power spectra: energy[f * n_mels + m] is the dot product of
+     *        band m's weights with its span of spectrum f. Each weight is loaded once per four
+     *        frames, and every frame sums its bins in band order, so the result matches a
+     *        per-band scalar loop bit for bit.
+     * @param bands n_mels band descriptors of create_sparse_mel_filterbank
+     * @param weights Packed band weights
+     * @param power n_frames spectra, power_stride floats apart
+     * @param energy Out: n_frames columns of n_mels energies, may alias power only if it
+     *        does not overlap any spectrum still being read
+     */
+    void mel_project_f32(const MelBand_t *bands, const float *weights, uint16_t n_mels,
+                         const float *power, uint32_t power_stride, uint16_t n_frames,
+                         float *energy);
+
+    /**
+     * @brief Converts packed float weights to Q15 for mel_project_q15 (1.0 saturates to 32767).
+     */
+    void mel_weights_to_q15(const float *weights, int16_t *weights_q15, uint32_t n);
+
+    /**
+     * @brief Q15 variant for a fixed-point spectrum: the Q30 products of each band are summed
+     *        in 64 bits and rounded back to Q15. The result is kept in 32 bits because a band
+     *        sum may exceed 1.0. With the DSP extension two bins go through one __smlald.
+     * @param power_q15 n_frames Q15 spectra, power_stride samples apart
+     * @param energy Out: n_frames columns of n_mels Q15 energies
+     */
+    void mel_project_q15(const MelBand_t *bands, const int16_t *weights_q15, uint16_t n_mels,
+                         const int16_t *power_q15, uint32_t power_stride, uint16_t n_frames,
+                         int32_t *energy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEL_PROJECT_H
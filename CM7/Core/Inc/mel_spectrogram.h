@@ -2,11 +2,30 @@
 #ifndef MEL_SPECTROGRAM_H
 #define MEL_SPECTROGRAM_H
 
+#include "mfcc.h"
+#include "noise_floor.h"
 #include <stdint.h>
 
 #define MAX_FFT_SIZE 2048
 #define MAX_MEL_BANDS 128
 
+// frames whose power spectra are projected onto the mel bands together, so each filterbank
+// weight is loaded once per batch; MEL_MAX_BATCH bounds the scratch
+#ifndef MEL_DEFAULT_BATCH
+#define MEL_DEFAULT_BATCH 4
+#endif
+#ifndef MEL_MAX_BATCH
+#define MEL_MAX_BATCH MEL_DEFAULT_BATCH
+#endif
+
+// persistent engine state: Hann window + packed sparse filterbank weights
+// (n_mels is kept for callers, the sparse bank is bounded by the FFT size alone)
+#define MEL_STATE_BYTES(fft_size, n_mels)                                                          \
+    (((uint32_t)(fft_size) + 2u * ((fft_size) / 2 + 1)) * sizeof(float))
+// per-call scratch: FFT buffer + one power spectrum per batched frame
+#define MEL_SCRATCH_BYTES(fft_size)                                                                \
+    (((uint32_t)(fft_size) + MEL_MAX_BATCH * ((fft_size) / 2 + 1)) * sizeof(float))
+
 typedef struct
 {
     uint32_t sample_rate;
@@ -15,15 +34,67 @@ typedef struct
     uint16_t n_mels;
     float f_min;
     float f_max;
+    uint16_t batch; // frames per mel projection, 1..MEL_MAX_BATCH; 0 selects MEL_DEFAULT_BATCH
 } MelSpectrogramConfig_t;
 
+// model input quantization for the fused int8 path
+typedef struct
+{
+    float scale;        // model input scale
+    int8_t zero_point;  // model input zero point
+    float db_floor;     // dB mapped to 0 before quantization
+    float db_ceil;      // dB mapped to 1 before quantization
+} MelQuantParams_t;
+
+/**
+ * @brief Exact memory the engine needs for a config; MEL_STATE_BYTES and MEL_SCRATCH_BYTES are
+ *        the compile-time upper bounds of the same figures.
+ * @param config Configuration the engine will be initialized with
+ * @param state_bytes Out: window + sparse filterbank, may be NULL
+ * @param scratch_bytes Out: FFT buffer + the batch's power spectra, may be NULL
+ * @return 0 if successful, -1 if the config is out of range
+ */
+int mel_spectrogram_workspace_size(const MelSpectrogramConfig_t *config, uint32_t *state_bytes,
+                                   uint32_t *scratch_bytes);
+
+/**
+ * @brief Supplies the engine's memory, must be called before mel_spectrogram_init.
+ *        Host builds keep one engine per thread, so each thread supplies its own.
+ * @param state Persistent state, kept for as long as the engine is used
+ * @param state_bytes Size of state, at least the workspace query's state_bytes
+ * @param scratch Per-call scratch, only live during calculate_mel_spectrogram
+ * @param scratch_bytes Size of scratch, at least the workspace query's scratch_bytes
+ */
+void mel_spectrogram_set_memory(float *state, uint32_t state_bytes, float *scratch,
+                                uint32_t scratch_bytes);
+
 /**
  * @brief Initializes FFT, window, and mel filterbank.
  * @param config Pointer to configuration struct
- * @return 0 if successful, -1 on failure
+ * @return 0 if successful, -1 on failure or if the supplied memory is too small
  */
 int mel_spectrogram_init(MelSpectrogramConfig_t *config);
 
+/**
+ * @brief Attaches a noise tracker to the band energies of every calculate_* call: each batch is
+ * tracked in frame order and, if the tracker's over_subtraction is set, floor-subtracted before
+ * the log. The tracker keeps its state across calls, so consecutive calls should cover
+ * consecutive audio. mel_spectrogram_init detaches it.
+ * @param nf Tracker with n_bands equal to config.n_mels, NULL detaches
+ * @return 0 if successful, -1 if the band count does not match
+ */
+int mel_spectrogram_set_noise_floor(NoiseFloor_t *nf);
+
+/**
+ * @brief Removes a capture gain (the AGC's) from the band energies of every calculate_* call,
+ * before the noise tracker and the log, so the features keep the level of the unamplified input.
+ * mel_spectrogram_init detaches it.
+ * @param gain Gain in dB per STFT frame of the calculate_* input, caller-owned and read at every
+ * call; frames past n_frames use the last entry. NULL detaches.
+ * @return 0 if successful, -1 for a table without entries
+ */
+int mel_spectrogram_set_gain_db(const float *gain, uint16_t n_frames);
+
 /**
  * @brief Computes a mel spectrogram from a PCM buffer.
  * @param pcm_data Input PCM samples (int16_t)
@@ -35,6 +106,36 @@ int mel_spectrogram_init(MelSpectrogramConfig_t *config);
 int calculate_mel_spectrogram(const int16_t *pcm_data, uint32_t pcm_size, float *spectrogram,
                               uint16_t spec_cols_max);
 
+/**
+ * @brief Computes the mel spectrogram straight into the model's int8 input tensor.
+ * Log, clamp to [db_floor, db_ceil], normalize and quantize are fused into one pass per column,
+ * so no float spectrogram is stored. The range is fixed instead of the per-window min/max of
+ * normalize_spectrogram.
+ * @param pcm_data Input PCM samples (int16_t)
+ * @param pcm_size Number of samples
+ * @param output int8 output (size = config.n_mels × num_frames, same layout as the float path)
+ * @param spec_cols_max Max number of time frames (columns)
+ * @param quant Model input scale/zero-point and dB range
+ * @return number of time frames calculated, or -1 on error
+ */
+int calculate_mel_spectrogram_q8(const int16_t *pcm_data, uint32_t pcm_size, int8_t *output,
+                                 uint16_t spec_cols_max, const MelQuantParams_t *quant);
+
+/**
+ * @brief Computes MFCCs (and deltas, per the stage's config) from a PCM buffer: the mel
+ * spectrogram path up to the dB step, then one mfcc_push per column and a final flush, so the
+ * deltas of the last columns repeat the last frame. The stage is reset first.
+ * @param pcm_data Input PCM samples (int16_t)
+ * @param pcm_size Number of samples
+ * @param mfcc Stage initialized with n_mels equal to the engine's
+ * @param features Output (size = mfcc_n_features × num_frames, feature-major like the
+ *        spectrogram)
+ * @param spec_cols_max Max number of time frames (columns)
+ * @return number of time frames calculated, or -1 on error
+ */
+int calculate_mfcc(const int16_t *pcm_data, uint32_t pcm_size, Mfcc_t *mfcc, float *features,
+                   uint16_t spec_cols_max);
+
 /**
  * @brief Normalizes spectrogram in-place to [0, 1] range
  */
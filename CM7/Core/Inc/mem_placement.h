@@ -0,0 +1,25 @@
+// mem_placement.h
+#ifndef MEM_PLACEMENT_H
+#define MEM_PLACEMENT_H
+
+// 1: hot DSP/ISR code runs from ITCM and its buffers live in DTCM
+// 0: everything stays in flash / AXI SRAM, the baseline for cycle comparisons
+#ifndef USE_TCM_PLACEMENT
+#define USE_TCM_PLACEMENT 1
+#endif
+
+#if USE_TCM_PLACEMENT && defined(__arm__)
+// copied from flash to ITCM by the startup code; calls to and from flash go through linker
+// veneers, noinline keeps the body from being folded back into a flash caller
+#define ITCM_FUNC __attribute__((section(".itcm_text"), noinline))
+// initialized data copied from flash to DTCM by the startup code
+#define DTCM_DATA __attribute__((section(".dtcm_data")))
+// uninitialized DTCM, not cleared by the startup code
+#define DTCM_BSS __attribute__((section(".dtcm_bss")))
+#else
+#define ITCM_FUNC
+#define DTCM_DATA
+#define DTCM_BSS
+#endif
+
+#endif // MEM_PLACEMENT_H
@@ -0,0 +1,85 @@
+// mfcc.h
+#ifndef MFCC_H
+#define MFCC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define MFCC_MAX_COEFFS 40
+#define MFCC_MAX_DELTA_ORDER 2
+#define MFCC_MAX_DELTA_WIDTH 4
+// coefficients + deltas + delta-deltas of one output column
+#define MFCC_MAX_FEATURES (MFCC_MAX_COEFFS * (MFCC_MAX_DELTA_ORDER + 1))
+
+    typedef struct
+    {
+        uint16_t n_mels;     // length of the log-mel column fed in
+        uint16_t n_mfcc;     // cepstral coefficients kept, c0 included
+        uint8_t delta_order; // 0: coefficients only, 1: + deltas, 2: + delta-deltas
+        uint8_t delta_width; // N of the regression d_t = sum n (c_t+n - c_t-n) / 2 sum n^2
+        float lifter;        // sinusoidal lifter L (1 + L/2 sin(pi (k + 1) / L)), 0 disables
+    } MfccConfig_t;
+
+    /**
+     * @brief Streaming MFCC state. The orthonormal DCT-II rows are pre-multiplied by the lifter,
+     * so a column costs one n_mfcc x n_mels product; a ring of the last 2 * order * width + 1
+     * cepstra supplies the deltas. Edges repeat the first and last column, as HTK does.
+     */
+    typedef struct
+    {
+        MfccConfig_t config;
+        float *dct;       // n_mfcc x n_mels, lifter folded in
+        float *ring;      // ring_len cepstra of n_mfcc
+        uint16_t ring_len;
+        uint16_t latency; // columns between a push and the output it completes
+        uint32_t pushed;  // columns pushed since the last reset
+        uint32_t emitted; // columns output since the last reset
+    } Mfcc_t;
+
+    /**
+     * @brief Features per output column: n_mfcc * (delta_order + 1).
+     */
+    uint16_t mfcc_n_features(const MfccConfig_t *config);
+
+    /**
+     * @brief Workspace bytes for a config (DCT matrix + cepstrum ring).
+     * @return size in bytes, or 0 if the config is out of range
+     */
+    uint32_t mfcc_workspace_size(const MfccConfig_t *config);
+
+    /**
+     * @brief Builds the liftered DCT in the workspace and resets the stream.
+     * @return 0 if successful, -1 on failure
+     */
+    int mfcc_init(Mfcc_t *mfcc, const MfccConfig_t *config, float *workspace,
+                  uint32_t workspace_size);
+
+    /**
+     * @brief Forgets all past columns, e.g. at the start of a new window or after a gap.
+     */
+    void mfcc_reset(Mfcc_t *mfcc);
+
+    /**
+     * @brief Pushes one log-mel column (dB, n_mels values).
+     * @param features Out: coefficients, then deltas, then delta-deltas of the column pushed
+     *        latency columns earlier
+     * @return 1 if features were written, 0 while the delta history is filling
+     */
+    int mfcc_push(Mfcc_t *mfcc, const float *log_mel, float *features);
+
+    /**
+     * @brief Emits the columns still held back by the delta latency, repeating the last column
+     *        past the end. Call until it returns 0; the stream then needs mfcc_reset.
+     * @return 1 if features were written, 0 once every pushed column has been output
+     */
+    int mfcc_flush(Mfcc_t *mfcc, float *features);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MFCC_H
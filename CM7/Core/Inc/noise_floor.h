@@ -0,0 +1,111 @@
+// noise_floor.h
+#ifndef NOISE_FLOOR_H
+#define NOISE_FLOOR_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define NOISE_MAX_SUBWINDOWS 8
+
+    typedef struct
+    {
+        uint16_t n_bands;        // values per column (mel bands)
+        uint16_t window_frames;  // minimum search window D, a multiple of n_subwindows
+        uint8_t n_subwindows;    // U, 1..NOISE_MAX_SUBWINDOWS; the floor rises after D frames
+        float smoothing;         // alpha of the per-band power smoothing P = a P + (1 - a) X
+        float bias;              // minimum -> mean noise power, about 1.5 for alpha 0.9
+        float over_subtraction;  // X - o * floor; 0 only tracks the floor
+        float spectral_floor;    // beta, subtraction keeps at least beta * X
+    } NoiseFloorConfig_t;
+
+    /**
+     * @brief Minimum-statistics noise tracker over band energies. Each band's smoothed power
+     *        is minimized over D frames in U sub-windows, so the floor follows a rising noise
+     *        level within D frames and a falling one at once, while calls shorter than D frames
+     *        never lift it. The floor optionally drives spectral subtraction. State is
+     *        (4 + U) words per band.
+     */
+    typedef struct
+    {
+        NoiseFloorConfig_t config;
+        float *smoothed;  // n_bands
+        float *sub_min;   // running minimum of the current sub-window
+        float *past_min;  // minimum of the last U completed sub-windows
+        float *floor;     // n_bands, bias * min; the exported estimate
+        float *history;   // U x n_bands sub-window minima
+        uint16_t sub_len; // D / U
+        uint16_t sub_count;
+        uint8_t sub_next; // history slot written at the next sub-window boundary
+        uint32_t frames;  // columns since the last reset
+    } NoiseFloor_t;
+
+    /**
+     * @brief Fixed-point tracker for the Q15 energies of mel_project_q15. Same algorithm and
+     *        layout, with the config's gains converted to Q15 once at init.
+     */
+    typedef struct
+    {
+        NoiseFloorConfig_t config;
+        int32_t *smoothed;
+        int32_t *sub_min;
+        int32_t *past_min;
+        int32_t *floor;
+        int32_t *history;
+        uint16_t sub_len;
+        uint16_t sub_count;
+        uint8_t sub_next;
+        uint32_t frames;
+        int32_t alpha_q15; // smoothing
+        int32_t bias_q15;  // may exceed 1.0
+        int32_t over_q15;  // may exceed 1.0
+        int32_t beta_q15;  // spectral floor
+    } NoiseFloorQ15_t;
+
+    /**
+     * @brief Workspace bytes for a config, the same for both trackers.
+     * @return size in bytes, or 0 if the config is out of range
+     */
+    uint32_t noise_floor_workspace_size(const NoiseFloorConfig_t *config);
+
+    /**
+     * @brief Binds the workspace and resets the tracker.
+     * @return 0 if successful, -1 on failure
+     */
+    int noise_floor_init(NoiseFloor_t *nf, const NoiseFloorConfig_t *config, float *workspace,
+                         uint32_t workspace_size);
+    int noise_floor_init_q15(NoiseFloorQ15_t *nf, const NoiseFloorConfig_t *config,
+                             int32_t *workspace, uint32_t workspace_size);
+
+    /**
+     * @brief Forgets the noise history; the next column seeds the floor.
+     */
+    void noise_floor_reset(NoiseFloor_t *nf);
+    void noise_floor_reset_q15(NoiseFloorQ15_t *nf);
+
+    /**
+     * @brief Tracks n_frames columns in order and, with over_subtraction set, subtracts the
+     *        updated floor from each in place. Bands are processed four at a time.
+     * @param energy n_frames columns of n_bands linear energies, energy[f * n_bands + m]
+     */
+    void noise_floor_update_f32(NoiseFloor_t *nf, float *energy, uint16_t n_frames);
+
+    /**
+     * @brief Q15 variant of noise_floor_update_f32 on non-negative Q15 energies.
+     */
+    void noise_floor_update_q15(NoiseFloorQ15_t *nf, int32_t *energy, uint16_t n_frames);
+
+    /**
+     * @brief Floor level in dB: 10 log10 of the band-averaged floor energy, clamped at -80 dB
+     *        like the spectrogram, as the reference for relative detection thresholds.
+     */
+    float noise_floor_level_db(const NoiseFloor_t *nf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NOISE_FLOOR_H
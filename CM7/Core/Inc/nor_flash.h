@@ -0,0 +1,52 @@
+// nor_flash.h
+#ifndef NOR_FLASH_H
+#define NOR_FLASH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief NOR flash device as the log sees it: erase sets a whole sector to 0xFF, program
+     *        only clears bits and never crosses a page boundary. Implemented by qspi_nor.c on
+     *        the board and by the RAM simulator of the host tools.
+     * Addresses are byte offsets from the start of the device, not memory-mapped addresses.
+     */
+    typedef struct
+    {
+        uint32_t page_size;   // largest single program, a power of two
+        uint32_t sector_size; // erase granularity, a multiple of page_size
+        uint32_t size;        // device bytes
+        void *ctx;
+
+        /**
+         * @return 0 if successful, -1 on failure or while busy
+         */
+        int (*read)(void *ctx, uint32_t addr, void *dst, uint32_t len);
+
+        /**
+         * @brief Programs len bytes inside one page and waits for completion.
+         * @return 0 if successful, -1 on failure or while busy
+         */
+        int (*program)(void *ctx, uint32_t addr, const void *src, uint32_t len);
+
+        /**
+         * @brief Starts erasing the sector holding addr and returns without waiting.
+         * @return 0 if the erase was started, -1 on failure or while busy
+         */
+        int (*erase)(void *ctx, uint32_t addr);
+
+        /**
+         * @brief Non-zero while an erase runs; reads and programs fail until it finishes.
+         */
+        int (*busy)(void *ctx);
+    } NorFlash_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NOR_FLASH_H
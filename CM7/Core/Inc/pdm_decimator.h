@@ -0,0 +1,104 @@
+// pdm_decimator.h
+#ifndef PDM_DECIMATOR_H
+#define PDM_DECIMATOR_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define PDM_MAX_CHANNELS 4
+#define PDM_MAX_DECIMATION 128
+#define PDM_MIN_CIC_ORDER 2
+#define PDM_MAX_CIC_ORDER 5
+#define PDM_FIR_TAPS 48       // compensating low-pass at twice the output rate
+// the FIR's transition is centred on the output Nyquist frequency: flat up to PDM_PASSBAND of
+// the output rate, and images from PDM_STOPBAND up, which fold back below PDM_PASSBAND, removed
+#define PDM_PASSBAND 0.40f
+#define PDM_STOPBAND 0.60f
+#define PDM_HP_ALPHA_LIBRARY (2122358088.0f / 2147483648.0f) // the BSP's high_pass_tap
+
+    typedef struct
+    {
+        uint16_t decimation;  // PDM bits per PCM sample, a multiple of 16 up to PDM_MAX_DECIMATION
+        uint8_t channels;     // microphones interleaved byte by byte, 1..PDM_MAX_CHANNELS
+        uint8_t cic_order;    // PDM_MIN_CIC_ORDER..PDM_MAX_CIC_ORDER
+        uint8_t msb_first;    // 1: bit 7 of each byte is the earliest
+        uint16_t max_samples; // PCM samples per channel per call
+        float gain_db;        // 0 dB decodes a full-scale PDM signal to full-scale PCM
+        float hp_alpha;       // DC-blocker pole, 0 disables it
+    } PdmConfig_t;
+
+    /**
+     * @brief Open PDM-to-PCM decoder: a CIC filter decimating to twice the output rate, a
+     *        compensating FIR decimating by 2 and a one-pole DC blocker, in integer arithmetic
+     *        throughout so every build decodes the same bits to the same samples.
+     *
+     *        The CIC runs as an FIR of its sinc^N kernel on the packed bit stream: one 256-entry
+     *        table per kernel byte holds the kernel sum of every bit pattern (1 -> +1,
+     *        0 -> -1), so an intermediate sample costs one lookup per kernel byte instead of
+     *        N integrator and comb updates per bit.
+     */
+    typedef struct
+    {
+        PdmConfig_t config;
+        int32_t *lut;           // cic_bytes tables of 256 kernel sums
+        int16_t *fir;           // PDM_FIR_TAPS taps, scaled by 2^fir_shift
+        uint8_t *bytes;         // per channel: kernel history + max_samples * decimation / 8
+        int16_t *mid;           // per channel: FIR history + 2 * max_samples CIC outputs
+        int32_t hp_in[PDM_MAX_CHANNELS];
+        int32_t hp_out[PDM_MAX_CHANNELS];
+        uint16_t cic_ratio;     // bits per CIC output, decimation / 2
+        uint16_t cic_len;       // kernel length in bits, cic_order * (cic_ratio - 1) + 1
+        uint8_t cic_bytes;      // kernel span in bytes
+        uint8_t cic_shift;      // CIC output >> cic_shift fits int16
+        uint8_t fir_shift;      // FIR sum >> fir_shift is the PCM sample
+        int32_t hp_alpha_q31;
+        uint32_t samples;       // PCM samples decoded per channel since the last reset
+    } PdmDecimator_t;
+
+    /**
+     * @brief Workspace bytes for a config (tables, taps and per-channel histories).
+     * @return size in bytes, or 0 if the config is out of range
+     */
+    uint32_t pdm_workspace_size(const PdmConfig_t *config);
+
+    /**
+     * @brief Binds the workspace, builds the CIC tables and designs the compensating FIR.
+     * @param workspace 4-byte aligned
+     * @return 0 if successful, -1 on failure
+     */
+    int pdm_init(PdmDecimator_t *dec, const PdmConfig_t *config, void *workspace,
+                 uint32_t workspace_size);
+
+    /**
+     * @brief Clears the filter histories: the stream restarts from silence (alternating bits).
+     */
+    void pdm_reset(PdmDecimator_t *dec);
+
+    /**
+     * @brief Decodes n_samples PCM samples per channel.
+     * @param pdm n_samples * decimation / 8 bytes per channel, channel c of byte i at
+     *        pdm[i * channels + c]
+     * @param pcm Out: channel c of sample i at pcm[i * channels + c], the layout
+     *        BSP_AUDIO_IN_PDMToPCM writes
+     * @return 0 if successful, -1 if n_samples exceeds max_samples
+     */
+    int pdm_process(PdmDecimator_t *dec, const uint8_t *pdm, uint16_t n_samples, int16_t *pcm);
+
+    /**
+     * @brief Counts the 1 bits of each channel, 64 stream bits per popcount when the channel
+     *        count divides 8. A working microphone stays near half ones; a stuck data line or
+     *        a missing clock reads all zeros or all ones.
+     * @param n_bytes bytes per channel
+     * @param ones Out: channels counts
+     */
+    void pdm_count_ones(const uint8_t *pdm, uint32_t n_bytes, uint8_t channels, uint32_t *ones);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PDM_DECIMATOR_H
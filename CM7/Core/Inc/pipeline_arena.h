@@ -0,0 +1,55 @@
+// pipeline_arena.h
+#ifndef PIPELINE_ARENA_H
+#define PIPELINE_ARENA_H
+
+#include "mel_spectrogram.h"
+#include "tensor_arena.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// size of the shared arena placed in DTCM (see .dtcm_bss in the linker script)
+#define PIPELINE_ARENA_SIZE (48 * 1024)
+
+    // pipeline steps, tensors are live over a range of these
+    enum
+    {
+        STEP_INIT = 0,
+        STEP_STFT,
+        STEP_NORMALIZE,
+        STEP_QUANTIZE,
+        STEP_INFERENCE,
+    };
+
+    // buffers of one capture-to-classification pass
+    enum
+    {
+        TENSOR_MEL_STATE = 0, // window + filterbank, lives across passes
+        TENSOR_DSP_SCRATCH,   // FFT buffer + power spectrum
+        TENSOR_MEL_OUTPUT,    // float dB mel matrix (empty on the fused int8 path)
+        TENSOR_MODEL_INPUT,   // int8 features for the classifier
+        TENSOR_CNN_WORKSPACE, // classifier activations
+        PIPELINE_N_TENSORS,
+    };
+
+    /**
+     * @brief Describes and plans the pipeline buffers for a mel config.
+     * @param config Mel spectrogram configuration
+     * @param n_frames Columns of the mel window handed to the classifier
+     * @param cnn_workspace Bytes of classifier activations (cnn_window_workspace_size)
+     * @param fused_quant Nonzero when features go straight to int8 (no float mel output)
+     * @param tensors Output table of PIPELINE_N_TENSORS entries with their offsets
+     * @return peak arena bytes
+     */
+    uint32_t pipeline_arena_plan(const MelSpectrogramConfig_t *config, uint16_t n_frames,
+                                 uint32_t cnn_workspace, uint8_t fused_quant,
+                                 ArenaTensor_t *tensors);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PIPELINE_ARENA_H
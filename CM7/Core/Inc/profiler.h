@@ -0,0 +1,125 @@
+// profiler.h
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// 0 compiles every PROF_* marker out; profiler_now() stays available for one-off timings
+#ifndef USE_PROFILER
+#define USE_PROFILER 1
+#endif
+
+// period of profiler_poll dumps
+#ifndef PROFILER_DUMP_PERIOD_MS
+#define PROFILER_DUMP_PERIOD_MS 5000u
+#endif
+
+// histogram: PROF_SUB_BINS linear bins per power of two, from 2^PROF_MIN_OCTAVE ticks up
+#define PROF_MIN_OCTAVE 4
+#define PROF_OCTAVES 24
+#define PROF_SUB_BINS 4
+#define PROF_HIST_BINS (PROF_OCTAVES * PROF_SUB_BINS)
+
+    // pipeline stages with a row in the stats table
+    typedef enum
+    {
+        PROF_PDM_DECODE = 0,
+        PROF_WINDOW,
+        PROF_FFT,
+        PROF_POWER,
+        PROF_MEL,
+        PROF_LOG,
+        PROF_NORMALIZE,
+        PROF_QUANTIZE,
+        PROF_INFERENCE,
+        PROF_MFCC,
+        PROF_NOISE,
+        PROF_BEAM,
+        PROF_PDM_LIBRARY,
+        PROF_AGC,
+        PROF_N_STAGES
+    } ProfStage_t;
+
+    typedef struct
+    {
+        uint32_t count;
+        uint32_t min;
+        uint32_t max;
+        uint64_t total;
+        uint16_t hist[PROF_HIST_BINS]; // saturating counts
+    } ProfStats_t;
+
+#if USE_PROFILER
+// scoped markers, a stage's BEGIN and END must sit in the same block
+#define PROF_BEGIN(stage) const uint32_t prof_start_##stage = profiler_now()
+#define PROF_END(stage) profiler_end((stage), prof_start_##stage)
+#else
+#define PROF_BEGIN(stage) ((void)0)
+#define PROF_END(stage) ((void)0)
+#endif
+
+    /**
+     * @brief Starts the tick source (DWT CYCCNT on target, CLOCK_MONOTONIC ns on host) and
+     *        clears the table.
+     */
+    void profiler_init(void);
+
+    /**
+     * @brief Current tick count, wraps at 2^32.
+     */
+    uint32_t profiler_now(void);
+
+    /**
+     * @brief Ticks per microsecond of profiler_now (core MHz on target, 1000 on host).
+     */
+    uint32_t profiler_ticks_per_us(void);
+
+    /**
+     * @brief Adds one measurement of a stage to the table.
+     */
+    void profiler_record(ProfStage_t stage, uint32_t ticks);
+
+    /**
+     * @brief Records a stage that began at start (a profiler_now value) and, with USE_TRACE,
+     *        emits its span on the ITM stage port.
+     */
+    void profiler_end(ProfStage_t stage, uint32_t start);
+
+    /**
+     * @brief Statistics of one stage, NULL for an unknown stage.
+     */
+    const ProfStats_t *profiler_stats(ProfStage_t stage);
+
+    /**
+     * @brief Tick value below which the given fraction of a stage's samples fall, from the
+     *        histogram (upper edge of the bin, so within 1/PROF_SUB_BINS of an octave).
+     * @param permille 500 for the median, 990 for p99
+     */
+    uint32_t profiler_percentile(ProfStage_t stage, uint16_t permille);
+
+    /**
+     * @brief Prints min/mean/max/p50/p90/p99 of every stage that has samples via printf (ITM).
+     */
+    void profiler_dump(void);
+
+    /**
+     * @brief Dumps when PROFILER_DUMP_PERIOD_MS have passed since the last dump. Call from the
+     *        main loop at least every few seconds (CYCCNT wraps after ~10 s at 400 MHz).
+     */
+    void profiler_poll(void);
+
+    /**
+     * @brief Clears every stage.
+     */
+    void profiler_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,26 @@
+// qspi_nor.h
+#ifndef QSPI_NOR_H
+#define QSPI_NOR_H
+
+#include "nor_flash.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief NorFlash_t over the board's dual MT25TL01G through the QSPI BSP in indirect mode.
+     *        Geometry comes from BSP_QSPI_GetInfo (dual-flash: 512 B pages, 128 KB sectors).
+     * @param memory_mapped Non-zero when weight_store_init already put the flash in
+     *        memory-mapped mode: every operation then leaves it for the indirect commands and
+     *        restores it once the flash is idle again
+     * @return 0 if successful, -1 on failure
+     */
+    int qspi_nor_init(NorFlash_t *flash, int memory_mapped);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // QSPI_NOR_H
@@ -0,0 +1,50 @@
+// stack_monitor.h
+#ifndef STACK_MONITOR_H
+#define STACK_MONITOR_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// fill pattern of unused stack words
+#define STACK_MONITOR_PAINT 0xA5A5A5A5u
+// deepest stack the target paint covers, clipped to the top of the heap reservation
+#ifndef STACK_MONITOR_PAINT_BYTES
+#define STACK_MONITOR_PAINT_BYTES (16 * 1024)
+#endif
+
+    typedef void (*StackMonitorFn_t)(void *arg);
+
+    /**
+     * @brief Paints the unused part of the main stack below the current stack pointer.
+     *        Call once early in main, before the code being measured.
+     */
+    void stack_monitor_paint(void);
+
+    /**
+     * @brief High-water mark of the main stack: bytes below _estack touched since the paint.
+     */
+    uint32_t stack_monitor_peak(void);
+
+    /**
+     * @brief Stack bytes reserved by the linker script (_Min_Stack_Size), 0 on the host.
+     */
+    uint32_t stack_monitor_reserved(void);
+
+    /**
+     * @brief Runs fn(arg) on a freshly painted stack of stack_size bytes and measures how deep
+     *        it went. Host builds use a pthread; the target build calls fn on the main stack and
+     *        reports the main stack high-water mark.
+     * @param peak Out: bytes of stack fn used, excluding the thread start-up overhead
+     * @return 0 if successful, -1 on failure
+     */
+    int stack_monitor_run(StackMonitorFn_t fn, void *arg, uint32_t stack_size, uint32_t *peak);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STACK_MONITOR_H
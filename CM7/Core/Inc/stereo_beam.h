@@ -0,0 +1,129 @@
+// stereo_beam.h
+#ifndef STEREO_BEAM_H
+#define STEREO_BEAM_H
+
+#include "arm_math.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define BEAM_MAX_BLOCK 1024 // samples per channel per block, the GCC-PHAT FFT size
+#define BEAM_MAX_LAGS 129   // delays scanned by the direction search
+#define BEAM_SPEED_OF_SOUND 343.0f
+
+// beam_process_* budget per block in profiler_now ticks: core cycles on target, ns on host
+// (a 512-sample block is 32 ms of audio at 16 kHz)
+#ifndef BEAM_BUDGET_TICKS_PER_BLOCK
+#if defined(__arm__)
+#define BEAM_BUDGET_TICKS_PER_BLOCK 400000u
+#else
+#define BEAM_BUDGET_TICKS_PER_BLOCK 200000u
+#endif
+#endif
+
+    typedef struct
+    {
+        uint32_t sample_rate;
+        uint16_t block;       // samples per channel per call, a power of two 64..BEAM_MAX_BLOCK
+        float mic_spacing;    // metres between the two microphones
+        uint8_t lag_steps;    // delays scanned per sample, the resolution of the estimate
+        float f_min;          // band of the GCC-PHAT sum, Hz
+        float f_max;
+        float min_confidence; // below it a block keeps the previous steering
+        float smoothing;      // one-pole weight of the previous delay, 0..1
+    } BeamConfig_t;
+
+    /**
+     * @brief Two-microphone front end: a GCC-PHAT search per block finds the inter-microphone
+     *        delay of the dominant source, and delay-and-sum steers toward it. The right
+     *        channel is shifted by a cubic Lagrange fractional delay and averaged with the
+     *        left, so a coherent source adds in phase and uncorrelated noise does not (up to
+     *        3 dB SNR gain). The output lags the input by a fixed latency samples.
+     */
+    typedef struct
+    {
+        BeamConfig_t config;
+        arm_rfft_fast_instance_f32 fft;
+        float *window;      // Hann, block
+        float *spectrum_l;  // block, packed RFFT
+        float *spectrum_r;  // block
+        int16_t *left;      // history + block, deinterleaved samples
+        int16_t *right;     // history + block
+        uint16_t history;   // samples kept from the previous block
+        uint16_t latency;   // output delay, samples
+        uint16_t n_lags;    // delays scanned, centered on 0
+        uint16_t bin_lo;    // bins of the GCC-PHAT sum
+        uint16_t bin_hi;
+        float max_lag;      // largest physical delay, samples
+        float delay;        // steering delay of the right channel, samples (> 0: right lags)
+        float confidence;   // PHAT peak of the last block, 0..1
+        float angle;        // arrival angle from broadside, degrees (> 0: toward the left mic)
+        uint32_t blocks;
+    } Beam_t;
+
+    /**
+     * @brief Workspace bytes for a config (window, two spectra, two sample histories).
+     * @return size in bytes, or 0 if the config is out of range
+     */
+    uint32_t beam_workspace_size(const BeamConfig_t *config);
+
+    /**
+     * @brief Binds the workspace, builds the window and FFT, and resets the steering.
+     * @return 0 if successful, -1 on failure
+     */
+    int beam_init(Beam_t *bf, const BeamConfig_t *config, void *workspace,
+                  uint32_t workspace_size);
+
+    /**
+     * @brief Clears the sample history and steers to broadside.
+     */
+    void beam_reset(Beam_t *bf);
+
+    /**
+     * @brief Splits interleaved L/R frames. With the DSP extension two frames are repacked
+     *        per pair of 32-bit loads.
+     */
+    void beam_deinterleave(const int16_t *stereo, uint32_t n_frames, int16_t *left,
+                           int16_t *right);
+
+    /**
+     * @brief GCC-PHAT over one block: the phase-only cross spectrum of the windowed channels,
+     *        inverse-transformed at the n_lags physically possible delays only. Updates delay
+     *        (smoothed), confidence and angle.
+     * @param left block samples
+     * @param right block samples
+     * @return the raw delay of this block in samples
+     */
+    float beam_estimate(Beam_t *bf, const int16_t *left, const int16_t *right);
+
+    /**
+     * @brief Delay-and-sum: out[t] = (left[t] + right(t + delay)) / 2, right(x) interpolated
+     *        from right[floor(x) - 1 .. floor(x) + 2], which must be readable. Q14 taps, two per
+     *        __smlad with the DSP extension; rounded and saturated.
+     */
+    void beam_steer_q15(const int16_t *left, const int16_t *right, uint32_t n, float delay,
+                        int16_t *out);
+
+    /**
+     * @brief Float variant of beam_steer_q15, output in PCM units.
+     */
+    void beam_steer_f32(const int16_t *left, const int16_t *right, uint32_t n, float delay,
+                        float *out);
+
+    /**
+     * @brief One block: deinterleave, estimate, steer.
+     * @param stereo block interleaved L/R frames
+     * @param mono Out: block steered samples, latency samples behind the input
+     * @return 0 if successful, -1 on error
+     */
+    int beam_process_q15(Beam_t *bf, const int16_t *stereo, int16_t *mono);
+    int beam_process_f32(Beam_t *bf, const int16_t *stereo, float *mono);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STEREO_BEAM_H
@@ -0,0 +1,48 @@
+// tensor_arena.h
+#ifndef TENSOR_ARENA_H
+#define TENSOR_ARENA_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define ARENA_ALIGNMENT 8u
+
+    /**
+     * @brief One buffer in the arena and the pipeline steps during which it holds live data.
+     * Two tensors may share bytes when their [first, last] step ranges do not intersect.
+     */
+    typedef struct
+    {
+        const char *name;
+        uint32_t size;
+        uint8_t first; // first step that writes or reads it
+        uint8_t last;  // last step that reads it
+        uint32_t offset;
+    } ArenaTensor_t;
+
+    /**
+     * @brief Assigns offsets so that tensors with overlapping lifetimes never overlap in memory.
+     * Greedy: largest tensor first, each in the first gap that clears its live neighbours.
+     * @return peak arena bytes needed by the plan
+     */
+    uint32_t arena_plan(ArenaTensor_t *tensors, uint8_t n_tensors);
+
+    /**
+     * @brief Bytes needed if every tensor had its own buffer.
+     */
+    uint32_t arena_unshared_size(const ArenaTensor_t *tensors, uint8_t n_tensors);
+
+    /**
+     * @brief Prints offsets, lifetimes, peak footprint and bytes reclaimed by sharing.
+     */
+    void arena_print(const ArenaTensor_t *tensors, uint8_t n_tensors, uint32_t peak);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TENSOR_ARENA_H
@@ -0,0 +1,76 @@
+// trace.h
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// 0 compiles every TRACE_* marker out
+#ifndef USE_TRACE
+#define USE_TRACE 1
+#endif
+
+// ITM stimulus ports; port 0 stays the printf text console (_write in main.c)
+#define TRACE_PORT_STAGE 1 // pipeline stage spans, one record per profiled stage run
+#define TRACE_PORT_VALUE 2 // sampled values (queue depths, scores, counters)
+#define TRACE_PORT_MARK 3  // instantaneous events
+
+// first byte of every record, lets the decoder resync after a partial record
+#define TRACE_MAGIC 0xA5u
+// words per record: header, timestamp, payload
+#define TRACE_RECORD_WORDS 3
+// FIFO polls allowed for the 2nd and 3rd word before the record is abandoned
+#define TRACE_WORD_SPINS 64
+
+    typedef enum
+    {
+        TRACE_TYPE_SPAN = 1, // timestamp = start, payload = duration in ticks
+        TRACE_TYPE_VALUE,    // payload = value
+        TRACE_TYPE_MARK,     // payload = free-form argument
+    } TraceType_t;
+
+    // value and mark ids, spans use ProfStage_t ids
+    enum
+    {
+        TRACE_ID_ARCHIVE_DROP = 0,
+        TRACE_ID_N_FRAMES,
+        TRACE_ID_GATE_SCORE,
+        TRACE_ID_AGC_GAIN, // Q8 dB after each capture block
+    };
+
+#if USE_TRACE
+#define TRACE_VALUE(id, value) trace_event(TRACE_PORT_VALUE, TRACE_TYPE_VALUE, (id), (value))
+#define TRACE_MARK(id, arg) trace_event(TRACE_PORT_MARK, TRACE_TYPE_MARK, (id), (arg))
+#else
+#define TRACE_VALUE(id, value) ((void)0)
+#define TRACE_MARK(id, arg) ((void)0)
+#endif
+
+    /**
+     * @brief Writes one binary record to an ITM stimulus port without blocking. Records are
+     *        header (magic, type, id, 8-bit per-port sequence), timestamp, payload. A record is
+     *        dropped, and counted, when the port's FIFO is not ready. Safe from interrupts.
+     *        Nothing is written while no debugger has enabled the ITM port; host builds
+     *        only compile the call.
+     */
+    void trace_event(uint8_t port, TraceType_t type, uint8_t id, uint32_t payload);
+
+    /**
+     * @brief Span record of a stage that started at start and lasted ticks.
+     */
+    void trace_span(uint8_t id, uint32_t start, uint32_t ticks);
+
+    /**
+     * @brief Records dropped because the ITM FIFO was busy.
+     */
+    uint32_t trace_drops(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRACE_H
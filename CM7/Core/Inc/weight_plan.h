@@ -0,0 +1,85 @@
+// weight_plan.h
+#ifndef WEIGHT_PLAN_H
+#define WEIGHT_PLAN_H
+
+#include "cnn_inference.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// defaults for the 400 MHz M7 reading the dual MT25TL01G in quad DTR memory-mapped mode
+#define WEIGHT_PLAN_XIP_BYTES_PER_CYCLE 0.25f // core load through D-cache line fills
+#define WEIGHT_PLAN_DMA_BYTES_PER_CYCLE 0.40f // MDMA QSPI -> TCM/AXI burst copy
+#define WEIGHT_PLAN_DCACHE_BYTES 16384u       // M7 D-cache, layers above this miss every pass
+#define WEIGHT_PLAN_CYCLES_PER_MAC 1.0f
+
+    typedef enum
+    {
+        WEIGHT_XIP = 0,  // read in place from QSPI through the cache
+        WEIGHT_RESIDENT, // copied once to SRAM at boot
+        WEIGHT_STREAMED, // MDMA-prefetched into a staging buffer during the previous layer
+    } WeightPlacement_t;
+
+    typedef struct
+    {
+        uint32_t size;           // weight bytes
+        uint32_t passes;         // full passes over the weights per inference
+        uint32_t compute_cycles; // layer compute per inference, excluding weight stalls
+    } WeightLayerInfo_t;
+
+    typedef struct
+    {
+        uint32_t sram_budget;  // bytes reserved for resident layers
+        uint32_t staging_size; // bytes of each of the two prefetch buffers (0 disables streaming)
+        float xip_bytes_per_cycle;
+        float dma_bytes_per_cycle;
+        uint32_t dcache_bytes;
+    } WeightPlanParams_t;
+
+    typedef struct
+    {
+        uint8_t n_layers;
+        uint8_t placement[CNN_MAX_LAYERS];
+        uint32_t sram_offset[CNN_MAX_LAYERS]; // offset in the resident pool
+        uint32_t stall_cycles[CNN_MAX_LAYERS];
+        uint32_t sram_used;
+        uint32_t total_stall_cycles;
+        uint32_t total_compute_cycles;
+    } WeightPlan_t;
+
+    /**
+     * @brief Fills params with the WEIGHT_PLAN_* defaults.
+     */
+    void weight_plan_default_params(WeightPlanParams_t *params, uint32_t sram_budget,
+                                    uint32_t staging_size);
+
+    /**
+     * @brief Derives per-layer weight sizes, passes and compute from a model.
+     * @param window Input columns per inference, or 0 for one streaming push
+     * @return number of layers described, or -1 on failure
+     */
+    int weight_plan_describe_model(const CnnModel_t *model, uint16_t window,
+                                   WeightLayerInfo_t *layers);
+
+    /**
+     * @brief Places the layers with the most weight reads per byte in SRAM, streams the rest
+     *        through the staging buffers when they fit and leaves the remainder in QSPI.
+     * @return 0 if successful, -1 on failure
+     */
+    int weight_plan_build(const WeightLayerInfo_t *layers, uint8_t n_layers,
+                          const WeightPlanParams_t *params, WeightPlan_t *plan);
+
+    /**
+     * @brief Prints the placement table and the expected stall budget per inference.
+     */
+    void weight_plan_print(const WeightLayerInfo_t *layers, const WeightPlan_t *plan,
+                           uint32_t core_hz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WEIGHT_PLAN_H
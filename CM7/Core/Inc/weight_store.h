@@ -0,0 +1,51 @@
+// weight_store.h
+#ifndef WEIGHT_STORE_H
+#define WEIGHT_STORE_H
+
+#include "cnn_inference.h"
+#include "weight_plan.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define QSPI_WEIGHTS_BASE 0x90000000u
+
+// places a weight array in the memory-mapped QSPI flash (programmed with the external loader)
+#define QSPI_WEIGHTS __attribute__((section(".qspi_weights"), aligned(4)))
+
+    /**
+     * @brief Puts the QSPI flash in memory-mapped mode, copies the plan's resident layers into
+     *        sram_pool and installs the fetch hook on the CNN engine.
+     * @param model Model whose weights live in QSPI
+     * @param plan Placement from weight_plan_build for this model
+     * @param sram_pool Resident layer storage, at least plan->sram_used bytes
+     * @param staging Two prefetch buffers of staging_size bytes each (DTCM or AXI SRAM)
+     * @return 0 if successful, -1 on failure
+     */
+    int weight_store_init(const CnnModel_t *model, const WeightPlan_t *plan, uint8_t *sram_pool,
+                          uint8_t *staging, uint32_t staging_size);
+
+    /**
+     * @brief CnnWeightFetch_t hook: returns the resident, prefetched or in-place weights of a
+     *        layer and starts the MDMA prefetch of the next streamed layer.
+     */
+    const int8_t *weight_store_fetch(uint8_t layer, const int8_t *weights, uint32_t size);
+
+    /**
+     * @brief Number of fetches that had to wait for an unfinished prefetch.
+     */
+    uint32_t weight_store_stalls(void);
+
+    /**
+     * @brief Number of streamed layers that ran from QSPI in place because their copy failed.
+     */
+    uint32_t weight_store_fallbacks(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WEIGHT_STORE_H
@@ -0,0 +1,178 @@
+// agc.c
+#include "agc.h"
+#include "mem_placement.h"
+#include <math.h>
+#include <stdint.h>
+
+#define DB_PER_LOG2_POWER_Q16 197283 // 10 log10(2) in Q16
+#define DB_PER_LOG2_AMPL_Q16 394566  // 20 log10(2)
+#define LOG2_PER_DB_AMPL_Q16 10885   // 1 / (20 log10(2))
+
+// 2^16 log2(1 + i / 32)
+static const int32_t log2_table[33] = {
+    0,     2909,  5732,  8473,  11136, 13727, 16248, 18704, 21098, 23433, 25711,
+    27936, 30109, 32234, 34312, 36346, 38336, 40286, 42196, 44068, 45904, 47705,
+    49472, 51207, 52911, 54584, 56229, 57845, 59434, 60997, 62534, 64047, 65536};
+
+// 2^15 2^(i / 32)
+static const int32_t pow2_table[33] = {
+    32768, 33486, 34219, 34968, 35734, 36516, 37316, 38133, 38968, 39821, 40693,
+    41584, 42495, 43425, 44376, 45348, 46341, 47356, 48393, 49452, 50535, 51642,
+    52773, 53928, 55109, 56316, 57549, 58809, 60097, 61413, 62757, 64132, 65536};
+
+static int32_t to_q16(float v)
+{
+    return (int32_t)lrintf(v * 65536.0f);
+}
+
+// log2(x) in Q16 for x > 0: the leading one's position plus the interpolated mantissa
+static int32_t log2_q16(uint64_t x)
+{
+    const int32_t e = 63 - __builtin_clzll(x);
+    // the 21 bits below the leading one: 5 table index bits, 16 interpolation bits
+    uint32_t m = (e >= 21) ? (uint32_t)(x >> (e - 21)) : (uint32_t)(x << (21 - e));
+    m &= 0x1FFFFFu;
+    const uint32_t i = m >> 16, f = m & 0xFFFFu;
+    const int32_t step = log2_table[i + 1] - log2_table[i];
+    return e * 65536 + log2_table[i] + (int32_t)(((int64_t)step * f) >> 16);
+}
+
+int32_t agc_power_dbfs_q16(uint64_t energy, uint32_t n_samples)
+{
+    if (energy == 0 || n_samples == 0)
+        return to_q16(AGC_SILENCE_DBFS);
+    // mean square over a full-scale square wave's 2^30
+    const int64_t l = (int64_t)log2_q16(energy) - log2_q16(n_samples) - 30 * 65536;
+    return (int32_t)((l * DB_PER_LOG2_POWER_Q16) >> 16);
+}
+
+// 20 log10(peak / 32768) in Q16
+static int32_t peak_dbfs_q16(uint32_t peak)
+{
+    if (peak == 0)
+        return to_q16(AGC_SILENCE_DBFS);
+    const int64_t l = (int64_t)log2_q16(peak) - 15 * 65536;
+    return (int32_t)((l * DB_PER_LOG2_AMPL_Q16) >> 16);
+}
+
+int32_t agc_db_to_linear_q16(int32_t gain_q16)
+{
+    const int32_t l = (int32_t)(((int64_t)gain_q16 * LOG2_PER_DB_AMPL_Q16) >> 16);
+    const int32_t e = l >> 16; // floor, also below 0 dB
+    const uint32_t f = (uint32_t)l & 0xFFFFu;
+    const uint32_t i = f >> 11, r = f & 0x7FFu;
+    const int32_t m = pow2_table[i] + (((pow2_table[i + 1] - pow2_table[i]) * (int32_t)r) >> 11);
+    // m is 2^(frac) in Q15
+    return (e >= -1) ? (m << (e + 1)) : (m >> (-e - 1));
+}
+
+int agc_init(Agc_t *agc, const AgcConfig_t *config)
+{
+    if (!agc || !config || config->channels == 0 || config->block_rate == 0)
+        return -1;
+    if (!(config->min_gain_db >= AGC_MIN_GAIN_DB && config->max_gain_db <= AGC_MAX_GAIN_DB &&
+          config->min_gain_db <= config->initial_gain_db &&
+          config->initial_gain_db <= config->max_gain_db))
+        return -1;
+    if (!(config->attack_db_per_s > 0.0f && config->release_db_per_s > 0.0f) ||
+        !(config->target_dbfs < config->limit_dbfs && config->limit_dbfs <= 0.0f) ||
+        !(config->gate_dbfs > AGC_SILENCE_DBFS))
+        return -1;
+
+    agc->config = *config;
+    agc->target_q16 = to_q16(config->target_dbfs);
+    agc->limit_q16 = to_q16(config->limit_dbfs);
+    agc->gate_q16 = to_q16(config->gate_dbfs);
+    agc->min_q16 = to_q16(config->min_gain_db);
+    agc->max_q16 = to_q16(config->max_gain_db);
+    agc->initial_q16 = to_q16(config->initial_gain_db);
+    // at least one Q16 step per block, or the gain would never move
+    agc->attack_q16 = to_q16(config->attack_db_per_s / config->block_rate);
+    agc->release_q16 = to_q16(config->release_db_per_s / config->block_rate);
+    agc->attack_q16 = (agc->attack_q16 > 0) ? agc->attack_q16 : 1;
+    agc->release_q16 = (agc->release_q16 > 0) ? agc->release_q16 : 1;
+    agc_reset(agc);
+    return 0;
+}
+
+void agc_reset(Agc_t *agc)
+{
+    agc->gain_q16 = agc->initial_q16;
+    agc->linear_q16 = agc_db_to_linear_q16(agc->initial_q16);
+    agc->level_q16 = to_q16(AGC_SILENCE_DBFS);
+    agc->peak_q16 = to_q16(AGC_SILENCE_DBFS);
+    agc->blocks = 0;
+    agc->limited = 0;
+}
+
+static inline int16_t apply_gain(int16_t x, int32_t linear_q16)
+{
+    const int64_t y = ((int64_t)x * linear_q16 + 0x8000) >> 16;
+    return (int16_t)((y > 32767) ? 32767 : (y < -32768) ? -32768 : y);
+}
+
+ITCM_FUNC int16_t agc_process(Agc_t *agc, int16_t *pcm, uint32_t n_frames)
+{
+    const uint8_t channels = agc->config.channels;
+    const uint32_t n = n_frames * channels;
+
+    // block statistics of the decoded input
+    uint32_t peak = 0;
+    uint64_t energy = 0;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        const int32_t x = pcm[i];
+        const uint32_t a = (uint32_t)((x < 0) ? -x : x);
+        peak = (a > peak) ? a : peak;
+        energy += (uint32_t)(x * x);
+    }
+    agc->level_q16 = agc_power_dbfs_q16(energy, n);
+    agc->peak_q16 = peak_dbfs_q16(peak);
+
+    // toward target - level, rate-limited; held through quiet blocks
+    const int32_t gain = agc->gain_q16;
+    int32_t desired = (agc->level_q16 < agc->gate_q16) ? gain : agc->target_q16 - agc->level_q16;
+    desired = (desired < agc->min_q16) ? agc->min_q16 : desired;
+    desired = (desired > agc->max_q16) ? agc->max_q16 : desired;
+    int32_t next = (desired > gain) ? ((desired - gain > agc->release_q16) ? gain + agc->release_q16
+                                                                          : desired)
+                                    : ((gain - desired > agc->attack_q16) ? gain - agc->attack_q16
+                                                                          : desired);
+
+    // peak guard: the gain may not end above the ceiling, and when the last block's gain is
+    // already over it a ramp could put the loudest sample past the limit, so the whole block
+    // takes the new gain at once
+    int cut = 0;
+    if (peak > 0)
+    {
+        const int32_t ceiling = agc->limit_q16 - agc->peak_q16;
+        if (next > ceiling)
+            next = (ceiling > agc->min_q16) ? ceiling : agc->min_q16;
+        cut = gain > ceiling && next < gain;
+    }
+
+    const int32_t linear = agc_db_to_linear_q16(next);
+    if (cut || n_frames == 0)
+    {
+        agc->limited += cut;
+        for (uint32_t i = 0; i < n; ++i)
+            pcm[i] = apply_gain(pcm[i], linear);
+    }
+    else
+    {
+        // linear ramp from the previous block's factor, the same factor on every channel
+        const int32_t step = (linear - agc->linear_q16) / (int32_t)n_frames;
+        int32_t g = agc->linear_q16;
+        for (uint32_t t = 0; t < n_frames; ++t)
+        {
+            g = (t + 1 == n_frames) ? linear : g + step;
+            for (uint8_t c = 0; c < channels; ++c)
+                pcm[t * channels + c] = apply_gain(pcm[t * channels + c], g);
+        }
+    }
+
+    agc->gain_q16 = next;
+    agc->linear_q16 = linear;
+    agc->blocks++;
+    return (int16_t)((next + 128) >> 8);
+}
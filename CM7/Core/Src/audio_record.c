@@ -1,5 +1,6 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
+#include <stdio.h>
 
 /* Private typedef -----------------------------------------------------------*/
 
@@ -7,6 +8,7 @@
 /* Audio frequency */
 extern AUDIO_ErrorTypeDef AUDIO_Start(uint32_t audio_start_address, uint32_t audio_file_size);
 #define AUDIO_FREQUENCY 16000U
+#define AUDIO_CHANNELS 2 // both microphones, interleaved
 #define AUDIO_IN_PDM_BUFFER_SIZE (uint32_t)(128 * AUDIO_FREQUENCY / 16000 * 2)
 #define AUDIO_NB_BLOCKS ((uint32_t)4)
 #define AUDIO_BLOCK_SIZE ((uint32_t)0xFFFE)
@@ -15,8 +17,74 @@ extern AUDIO_ErrorTypeDef AUDIO_Start(uint32_t audio_start_address, uint32_t aud
 #define FFT_SIZE 512
 #define HOP_LENGTH 256
 #define MEL_BANDS 64
+#define MEL_FRAMES 64
 #define PCM_SCALING (1.0f / 32768.0f)
 
+// classifier input quantization, maps the [0, 1] normalized spectrogram onto int8
+#define MODEL_INPUT_SCALE (1.0f / 255.0f)
+#define MODEL_INPUT_ZERO_POINT (-128)
+// 1: fused log/normalize/quantize over a fixed dB range straight into the int8 input
+// 0: float dB matrix + per-window min/max normalize (what the current model was trained on)
+#ifndef USE_FUSED_MEL_QUANT
+#define USE_FUSED_MEL_QUANT 0
+#endif
+#define MODEL_INPUT_DB_FLOOR (-80.0f)
+#define MODEL_INPUT_DB_CEIL (60.0f)
+// activations reserved for the classifier until the model is linked in
+#define CNN_WORKSPACE_BYTES (32 * 1024)
+// 1: every capture block's raw PDM and PCM are copied to SDRAM rings by the MDMA
+#ifndef USE_SDRAM_ARCHIVE
+#define USE_SDRAM_ARCHIVE 1
+#endif
+#define ARCHIVE_RING_BYTES AUDIO_REC_TOTAL_SIZE
+// 1: minimum-statistics noise floor on the mel bands, subtracted before the log
+// (changes the features the current model was trained on, so off by default)
+#ifndef USE_NOISE_FLOOR
+#define USE_NOISE_FLOOR 0
+#endif
+#define NOISE_WINDOW_FRAMES 96 // 1.5 s of hops, gathered over several AudioRecord windows
+#define NOISE_SUBWINDOWS 4
+// 1: the open decimator (pdm_decimator.c) decodes the microphones; profile builds also run
+//    libPDMFilter on every block so the two show up side by side as pdm_decode/pdm_library
+// 0: libPDMFilter through BSP_AUDIO_IN_PDMToPCM
+#ifndef USE_OPEN_PDM
+#define USE_OPEN_PDM 0
+#endif
+#define PDM_SAMPLES_PER_BLOCK (AUDIO_FREQUENCY / 1000) // per channel per half buffer, 1 ms
+#define PDM_DECIMATION 64     // 1.024 MHz PDM clock
+#define PDM_CIC_ORDER 5       // one above the microphones' fourth-order modulators
+#define PDM_GAIN_DB 24.0f     // the BSP's mic_gain for the library; compare levels on target
+#define PDM_WORKSPACE_BYTES (21 * 1024) // pdm_workspace_size of the config below, 20.7 KB
+// 1: a feed-forward AGC levels every decoded block in the capture interrupt; its per-block gain
+//    is logged and taken back out of the mel band energies, so the features keep the level of
+//    the fixed-gain decoder while the PCM (playback, archive, beam) is leveled
+//    (the per-frame correction does not undo the ramps within a block or the peak guard's
+//    clipping, so the features drift from what the current model was trained on: off by default)
+#ifndef USE_AGC
+#define USE_AGC 0
+#endif
+#define AGC_LOG_BLOCKS (BUFFER_SIZE / (2 * PDM_SAMPLES_PER_BLOCK)) // capture blocks in PCMBuffer
+// the open decoder runs this much under PDM_GAIN_DB so the AGC can also cut without clipping
+// in the decoder; libPDMFilter keeps the BSP's gain and the AGC only adds or removes from there
+#if USE_OPEN_PDM && USE_AGC
+#define AGC_HEADROOM_DB 12.0f
+#else
+#define AGC_HEADROOM_DB 0.0f
+#endif
+// 1: PCMBuffer holds interleaved L/R frames from the two microphones; they are steered toward
+//    the dominant source and summed into one channel before the mel stage
+//    (2048 mono samples, 7 frames instead of 15 over the raw buffer: changes the features the
+//    current model was trained on, so off by default)
+// 0: the interleaved buffer goes to the mel stage as is
+#ifndef USE_STEREO_BEAM
+#define USE_STEREO_BEAM 0
+#endif
+#define BEAM_BLOCK 512         // frames per direction estimate, 32 ms
+#define BEAM_MIC_SPACING 0.02f // metres; set to the measured spacing of the board's microphones
+#define BEAM_FRAMES (BUFFER_SIZE / 2)
+// window, two spectra and the sample histories of beam_workspace_size, with room for the lags
+#define BEAM_WORKSPACE_BYTES (3 * BEAM_BLOCK * 4 + 2 * (BEAM_BLOCK + 64) * 2)
+
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* Define record Buf at D3SRAM @0x38000000 since the BDMA for SAI4 use only this memory */
@@ -29,6 +97,8 @@ ALIGN_32BYTES(uint16_t recordPDMBuf[AUDIO_IN_PDM_BUFFER_SIZE]);
 #elif defined(__GNUC__) /* !< GNU Compiler */
 ALIGN_32BYTES(uint16_t recordPDMBuf[AUDIO_IN_PDM_BUFFER_SIZE]) __attribute__((section(".RAM_D3")));
 #endif
+/* DSP scratch, mel output and classifier buffers share one DTCM arena by lifetime */
+ALIGN_32BYTES(static uint8_t tensor_arena[PIPELINE_ARENA_SIZE]) DTCM_BSS;
 static uint32_t AudioFreq[9] = {8000, 11025, 16000, 22050, 32000, 44100, 48000, 96000, 192000};
 ALIGN_32BYTES(uint16_t PCMBuffer[2 * BUFFER_SIZE]);
 ALIGN_32BYTES(uint16_t PlaybackBuffer[2 * BUFFER_SIZE]);
@@ -42,6 +112,38 @@ BSP_AUDIO_Init_t AudioOutInit;
 /* Pointer to record_data */
 uint32_t playbackPtr;
 uint32_t AudioBufferOffset;
+#if USE_OPEN_PDM
+/* Open PDM decoder: its tables are read on every capture interrupt */
+static PdmDecimator_t pdm_decimator;
+ALIGN_32BYTES(static uint8_t pdm_workspace[PDM_WORKSPACE_BYTES]) DTCM_BSS;
+#if USE_PROFILER
+static int16_t pdm_library_pcm[2 * PDM_SAMPLES_PER_BLOCK];
+#endif
+#endif
+#if USE_AGC
+/* Gain control state and the gain of each capture block of PCMBuffer, Q8 dB */
+static Agc_t agc;
+static volatile int16_t agc_gain_log[AGC_LOG_BLOCKS];
+static float agc_frame_db[MEL_FRAMES];
+#endif
+#if USE_STEREO_BEAM
+/* Beamformer state and the steered mono signal fed to the mel stage */
+static Beam_t beam;
+ALIGN_32BYTES(static uint8_t beam_workspace[BEAM_WORKSPACE_BYTES]) DTCM_BSS;
+static int16_t beam_mono[BEAM_FRAMES];
+#endif
+#if USE_NOISE_FLOOR
+/* Noise tracker state, kept across windows */
+static NoiseFloor_t noise_floor;
+static float noise_workspace[MEL_BANDS * (4 + NOISE_SUBWINDOWS)] DTCM_BSS;
+#endif
+#if USE_SDRAM_ARCHIVE
+/* Write offsets of the SDRAM archive rings and blocks that landed or were dropped */
+static uint32_t pdm_archive_offset;
+static uint32_t pcm_archive_offset;
+static volatile uint32_t archived_blocks;
+static volatile uint32_t archive_drops;
+#endif
 /* Private function prototypes -----------------------------------------------*/
 typedef enum
 {
@@ -50,6 +152,114 @@ typedef enum
     BUFFER_OFFSET_FULL,
 } BUFFER_StateTypeDef;
 /* Private functions ---------------------------------------------------------*/
+#if USE_SDRAM_ARCHIVE
+static void archive_block_done(void *ctx)
+{
+    (void)ctx;
+    archived_blocks++;
+}
+
+// queues D3 PDM -> SDRAM and AXI PCM -> SDRAM as one MDMA chain, no CPU copy
+// a block is dropped, not copied by the CPU, if the previous chain is still running
+static void archive_block(const uint16_t *pdm, uint32_t pdm_bytes, const uint16_t *pcm,
+                          uint32_t pcm_bytes)
+{
+    DmaChain_t chain;
+
+    if (pdm_archive_offset + pdm_bytes > ARCHIVE_RING_BYTES)
+        pdm_archive_offset = 0;
+    if (pcm_archive_offset + pcm_bytes > ARCHIVE_RING_BYTES)
+        pcm_archive_offset = 0;
+
+    dma_chain_reset(&chain);
+    dma_chain_add(&chain, pdm, (void *)(AUDIO_RECPDM_START_ADDR + pdm_archive_offset), pdm_bytes,
+                  NULL, NULL);
+    dma_chain_add(&chain, pcm, (void *)(AUDIO_REC_START_ADDR + pcm_archive_offset), pcm_bytes,
+                  archive_block_done, NULL);
+
+    if (mdma_transfer_submit(&chain) != 0)
+    {
+        archive_drops++;
+        TRACE_MARK(TRACE_ID_ARCHIVE_DROP, archive_drops);
+        return;
+    }
+    pdm_archive_offset += pdm_bytes;
+    pcm_archive_offset += pcm_bytes;
+}
+#endif
+
+/**
+ * @brief One-time setup of the capture state that outlives an AudioRecord call: the capture
+ *        interrupts keep using it between calls, so it is never torn down or re-initialized.
+ */
+void AudioRecord_Init(void)
+{
+#if USE_SDRAM_ARCHIVE
+    /* SDRAM archive rings and the MDMA service that fills them */
+    if (BSP_SDRAM_Init(0) != BSP_ERROR_NONE || mdma_transfer_init() != 0)
+        Error_Handler();
+#endif
+
+#if USE_OPEN_PDM
+    /* Open PDM decoder, its filter state running across every capture interrupt */
+    const PdmConfig_t pdm_config = {.decimation = PDM_DECIMATION,
+                                    .channels = AUDIO_CHANNELS,
+                                    .cic_order = PDM_CIC_ORDER,
+                                    .msb_first = 1, // as the BSP configures the library
+                                    .max_samples = PDM_SAMPLES_PER_BLOCK,
+                                    .gain_db = PDM_GAIN_DB - AGC_HEADROOM_DB,
+                                    .hp_alpha = PDM_HP_ALPHA_LIBRARY};
+    if (pdm_init(&pdm_decimator, &pdm_config, pdm_workspace, sizeof(pdm_workspace)) != 0)
+        Error_Handler();
+#endif
+
+#if USE_AGC
+    /* Gain control, running in every capture interrupt from the first recording on; it starts
+       at the decoder's fixed gain and its 1 ms blocks make the rates per 1000 calls */
+    const AgcConfig_t agc_config = {.channels = AUDIO_CHANNELS,
+                                    .block_rate = AUDIO_FREQUENCY / PDM_SAMPLES_PER_BLOCK,
+                                    .target_dbfs = -30.0f,
+                                    .limit_dbfs = -1.0f,
+                                    .gate_dbfs = -70.0f,
+                                    .min_gain_db = -12.0f,
+                                    .max_gain_db = 30.0f,
+                                    .initial_gain_db = AGC_HEADROOM_DB,
+                                    .attack_db_per_s = 30.0f,
+                                    .release_db_per_s = 6.0f};
+    if (agc_init(&agc, &agc_config) != 0)
+        Error_Handler();
+    for (uint32_t b = 0; b < AGC_LOG_BLOCKS; ++b)
+        agc_gain_log[b] = (int16_t)(AGC_HEADROOM_DB * 256.0f);
+#endif
+
+#if USE_NOISE_FLOOR
+    /* Noise tracker, fed by every window's frames; AudioRecord only re-attaches it */
+    const NoiseFloorConfig_t noise_config = {.n_bands = MEL_BANDS,
+                                             .window_frames = NOISE_WINDOW_FRAMES,
+                                             .n_subwindows = NOISE_SUBWINDOWS,
+                                             .smoothing = 0.9f,
+                                             .bias = 1.5f,
+                                             .over_subtraction = 1.0f,
+                                             .spectral_floor = 0.05f};
+    if (noise_floor_init(&noise_floor, &noise_config, noise_workspace, sizeof(noise_workspace)))
+        Error_Handler();
+#endif
+
+#if USE_STEREO_BEAM
+    /* Beamformer, its smoothed direction carried from one window to the next */
+    const BeamConfig_t beam_config = {.sample_rate = AUDIO_FREQUENCY,
+                                      .block = BEAM_BLOCK,
+                                      .mic_spacing = BEAM_MIC_SPACING,
+                                      .lag_steps = 16,
+                                      .f_min = 300.0f,
+                                      .f_max = 7000.0f,
+                                      .min_confidence = 0.05f,
+                                      .smoothing = 0.5f};
+    if (beam_init(&beam, &beam_config, beam_workspace, sizeof(beam_workspace)) != 0)
+        Error_Handler();
+#endif
+}
+
 /**
  * @brief Test Audio record.
  *   The main objective of this test is to check the hardware connection of the
@@ -59,7 +269,7 @@ typedef enum
  */
 void AudioRecord(void)
 {
-    uint32_t channel_nbr = 2;
+    uint32_t channel_nbr = AUDIO_CHANNELS;
 
 
     AudioFreq_ptr = AudioFreq + 2; /* AUDIO_FREQUENCY_16K; */
@@ -107,30 +317,168 @@ void AudioRecord(void)
                                      .f_min = 0.0f,
                                      .f_max = 8000.0f};
 
-    mel_spectrogram_init(&config);
+    // place every buffer of this pass from the liveness plan
+    ArenaTensor_t tensors[PIPELINE_N_TENSORS];
+    if (pipeline_arena_plan(&config, MEL_FRAMES, CNN_WORKSPACE_BYTES, USE_FUSED_MEL_QUANT,
+                            tensors) > PIPELINE_ARENA_SIZE)
+        Error_Handler();
+
+    mel_spectrogram_set_memory((float *)&tensor_arena[tensors[TENSOR_MEL_STATE].offset],
+                               tensors[TENSOR_MEL_STATE].size,
+                               (float *)&tensor_arena[tensors[TENSOR_DSP_SCRATCH].offset],
+                               tensors[TENSOR_DSP_SCRATCH].size);
+    if (mel_spectrogram_init(&config) != 0)
+        Error_Handler();
+
+#if USE_NOISE_FLOOR
+    // mel_spectrogram_init detached the tracker; its floor carries over from earlier windows
+    if (mel_spectrogram_set_noise_floor(&noise_floor) != 0)
+        Error_Handler();
+#endif
+
+#if USE_STEREO_BEAM
+    // two channels -> one steered channel, block by block
+    uint32_t beam_start = profiler_now();
+    for (uint32_t b = 0; b < BEAM_FRAMES / BEAM_BLOCK; ++b)
+        beam_process_q15(&beam, (const int16_t *)PCMBuffer + 2 * b * BEAM_BLOCK,
+                         beam_mono + b * BEAM_BLOCK);
+    uint32_t beam_cycles = (profiler_now() - beam_start) / (BEAM_FRAMES / BEAM_BLOCK);
+    const int16_t *mel_input = beam_mono;
+    const uint32_t mel_input_size = BEAM_FRAMES;
+#else
+    const int16_t *mel_input = (const int16_t *)PCMBuffer;
+    const uint32_t mel_input_size = BUFFER_SIZE;
+#endif
 
+#if USE_AGC
+    // each STFT frame gets the mean gain of the capture blocks it spans, less the headroom the
+    // decoder gave up; the beamformed signal has one sample per stereo frame, the raw buffer two
+    const uint32_t block_samples = PDM_SAMPLES_PER_BLOCK * (USE_STEREO_BEAM ? 1 : 2);
+    uint16_t agc_frames = 0;
+    for (uint32_t f = 0; f < MEL_FRAMES && f * HOP_LENGTH + FFT_SIZE <= mel_input_size; ++f)
+    {
+        const uint32_t first = f * HOP_LENGTH / block_samples;
+        const uint32_t last = (f * HOP_LENGTH + FFT_SIZE - 1) / block_samples;
+        int32_t sum = 0;
+        for (uint32_t b = first; b <= last; ++b)
+            sum += agc_gain_log[b];
+        agc_frame_db[f] = sum / (256.0f * (last - first + 1)) - AGC_HEADROOM_DB;
+        agc_frames = (uint16_t)(f + 1);
+    }
+    if (agc_frames > 0 && mel_spectrogram_set_gain_db(agc_frame_db, agc_frames) != 0)
+        Error_Handler();
+#endif
+
+    uint32_t start = profiler_now();
+
+    int8_t *model_input = (int8_t *)&tensor_arena[tensors[TENSOR_MODEL_INPUT].offset];
+
+#if USE_FUSED_MEL_QUANT
+    const MelQuantParams_t quant = {.scale = MODEL_INPUT_SCALE,
+                                    .zero_point = MODEL_INPUT_ZERO_POINT,
+                                    .db_floor = MODEL_INPUT_DB_FLOOR,
+                                    .db_ceil = MODEL_INPUT_DB_CEIL};
+
+    // call DSP pipeline for PCMBuffer -> int8 model input
+    int n_frames = calculate_mel_spectrogram_q8(mel_input, mel_input_size, model_input,
+                                                MEL_FRAMES, &quant);
+#else
     // output spectrogram buffer
     // n_mels x n_frames
-    static float mel_spec[64 * 64];
+    float *mel_spec = (float *)&tensor_arena[tensors[TENSOR_MEL_OUTPUT].offset];
     // zero out mel spectrogram buffer
-    memset(mel_spec, 0, sizeof(mel_spec));
+    memset(mel_spec, 0, tensors[TENSOR_MEL_OUTPUT].size);
 
     // call DSP pipeline for PCMBuffer -> mel_spec
-    int n_frames = calculate_mel_spectrogram((const int16_t *)PCMBuffer, BUFFER_SIZE, mel_spec,
-                                             64); // max columns
+    int n_frames = calculate_mel_spectrogram(mel_input, mel_input_size, mel_spec,
+                                             MEL_FRAMES); // max columns
 
     // normalize to [0, 1]
     normalize_spectrogram(mel_spec, config.n_mels, n_frames);
 
+    // int8 model input, may reuse bytes of buffers that are dead by now
+    PROF_BEGIN(PROF_QUANTIZE);
+    cnn_quantize_input(mel_spec, model_input, config.n_mels * n_frames, MODEL_INPUT_SCALE,
+                       MODEL_INPUT_ZERO_POINT);
+    PROF_END(PROF_QUANTIZE);
+#endif
+
+    uint32_t cycles = profiler_now() - start;
+    TRACE_VALUE(TRACE_ID_N_FRAMES, n_frames);
+    if (n_frames > 0)
+        printf("features: %d frames, %lu cycles/frame (%s placement)\r\n", n_frames,
+               (unsigned long)(cycles / n_frames), USE_TCM_PLACEMENT ? "tcm" : "flash/axi");
+#if USE_STEREO_BEAM
+    printf("beam: %d deg, confidence %d%%, %lu cycles/block, budget %lu%s\r\n", (int)beam.angle,
+           (int)(beam.confidence * 100.0f), (unsigned long)beam_cycles,
+           (unsigned long)BEAM_BUDGET_TICKS_PER_BLOCK,
+           beam_cycles > BEAM_BUDGET_TICKS_PER_BLOCK ? " EXCEEDED" : "");
+#endif
+#if USE_AGC
+    // one consistent copy: the capture interrupt updates the state every millisecond
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    const Agc_t agc_now = agc;
+    __set_PRIMASK(primask);
+    printf("agc: %d dB gain, input %d dBFS rms / %d dBFS peak, %lu of %lu blocks limited\r\n",
+           (int)((agc_now.gain_q16 + 32768) >> 16), (int)(agc_now.level_q16 >> 16),
+           (int)(agc_now.peak_q16 >> 16), (unsigned long)agc_now.limited,
+           (unsigned long)agc_now.blocks);
+#endif
+#if USE_NOISE_FLOOR
+    printf("noise floor: %d dB\r\n", (int)noise_floor_level_db(&noise_floor));
+#endif
+#if USE_SDRAM_ARCHIVE
+    printf("archive: %lu blocks in SDRAM, %lu dropped, %lu mdma errors\r\n",
+           (unsigned long)archived_blocks, (unsigned long)archive_drops,
+           (unsigned long)mdma_transfer_errors());
+#endif
+    // a stuck data line or a missing clock reads 0 % or 100 %
+    uint32_t pdm_ones[2];
+    pdm_count_ones((const uint8_t *)recordPDMBuf, AUDIO_IN_PDM_BUFFER_SIZE, 2, pdm_ones);
+    printf("pdm: %lu%% / %lu%% ones\r\n",
+           (unsigned long)(pdm_ones[0] * 100u / (8u * AUDIO_IN_PDM_BUFFER_SIZE)),
+           (unsigned long)(pdm_ones[1] * 100u / (8u * AUDIO_IN_PDM_BUFFER_SIZE)));
+    printf("stack: peak %lu of %lu reserved bytes\r\n", (unsigned long)stack_monitor_peak(),
+           (unsigned long)stack_monitor_reserved());
+
     // DO STUFF FOR ML INFERENCE
 }
 
+/**
+ * @brief Decodes one PDM half buffer (1 ms of both microphones) into interleaved PCM and,
+ *        with USE_AGC, levels it and logs the block's gain.
+ */
+ITCM_FUNC static void decode_pdm(uint32_t Instance, uint16_t *pdm, uint16_t *pcm)
+{
+    PROF_BEGIN(PROF_PDM_DECODE);
+#if USE_OPEN_PDM
+    pdm_process(&pdm_decimator, (const uint8_t *)pdm, PDM_SAMPLES_PER_BLOCK, (int16_t *)pcm);
+#else
+    BSP_AUDIO_IN_PDMToPCM(Instance, pdm, pcm);
+#endif
+    PROF_END(PROF_PDM_DECODE);
+#if USE_AGC
+    PROF_BEGIN(PROF_AGC);
+    const int16_t gain = agc_process(&agc, (int16_t *)pcm, PDM_SAMPLES_PER_BLOCK);
+    agc_gain_log[(uint32_t)(pcm - PCMBuffer) / (2 * PDM_SAMPLES_PER_BLOCK)] = gain;
+    PROF_END(PROF_AGC);
+    TRACE_VALUE(TRACE_ID_AGC_GAIN, gain);
+#endif
+#if USE_OPEN_PDM && USE_PROFILER
+    // the library on the same block, output discarded: the on-target benchmark
+    PROF_BEGIN(PROF_PDM_LIBRARY);
+    BSP_AUDIO_IN_PDMToPCM(Instance, pdm, (uint16_t *)pdm_library_pcm);
+    PROF_END(PROF_PDM_LIBRARY);
+#endif
+}
+
 /**
  * @brief Calculates the remaining file size and new position of the pointer.
  * @param  None
  * @retval None
  */
-void BSP_AUDIO_IN_TransferComplete_CallBack(uint32_t Instance)
+ITCM_FUNC void BSP_AUDIO_IN_TransferComplete_CallBack(uint32_t Instance)
 {
     if (Instance == 1U)
     {
@@ -138,12 +486,16 @@ void BSP_AUDIO_IN_TransferComplete_CallBack(uint32_t Instance)
         SCB_InvalidateDCache_by_Addr((uint32_t *)&recordPDMBuf[AUDIO_IN_PDM_BUFFER_SIZE / 2],
                                      AUDIO_IN_PDM_BUFFER_SIZE * 2);
 
-        BSP_AUDIO_IN_PDMToPCM(Instance, (uint16_t *)&recordPDMBuf[AUDIO_IN_PDM_BUFFER_SIZE / 2],
-                              &PCMBuffer[playbackPtr]);
+        decode_pdm(Instance, &recordPDMBuf[AUDIO_IN_PDM_BUFFER_SIZE / 2], &PCMBuffer[playbackPtr]);
 
         /* Clean Data Cache to update the content of the SRAM */
         SCB_CleanDCache_by_Addr((uint32_t *)&PCMBuffer[playbackPtr], AUDIO_IN_PDM_BUFFER_SIZE / 4);
 
+#if USE_SDRAM_ARCHIVE
+        archive_block(&recordPDMBuf[AUDIO_IN_PDM_BUFFER_SIZE / 2], AUDIO_IN_PDM_BUFFER_SIZE,
+                      &PCMBuffer[playbackPtr], AUDIO_IN_PDM_BUFFER_SIZE / 4);
+#endif
+
         playbackPtr += AUDIO_IN_PDM_BUFFER_SIZE / 4 / 2;
         if (playbackPtr >= BUFFER_SIZE)
             playbackPtr = 0;
@@ -159,18 +511,23 @@ void BSP_AUDIO_IN_TransferComplete_CallBack(uint32_t Instance)
  * @param  None
  * @retval None
  */
-void BSP_AUDIO_IN_HalfTransfer_CallBack(uint32_t Instance)
+ITCM_FUNC void BSP_AUDIO_IN_HalfTransfer_CallBack(uint32_t Instance)
 {
     if (Instance == 1U)
     {
         /* Invalidate Data Cache to get the updated content of the SRAM*/
         SCB_InvalidateDCache_by_Addr((uint32_t *)&recordPDMBuf[0], AUDIO_IN_PDM_BUFFER_SIZE * 2);
 
-        BSP_AUDIO_IN_PDMToPCM(Instance, (uint16_t *)&recordPDMBuf[0], &PCMBuffer[playbackPtr]);
+        decode_pdm(Instance, &recordPDMBuf[0], &PCMBuffer[playbackPtr]);
 
         /* Clean Data Cache to update the content of the SRAM */
         SCB_CleanDCache_by_Addr((uint32_t *)&PCMBuffer[playbackPtr], AUDIO_IN_PDM_BUFFER_SIZE / 4);
 
+#if USE_SDRAM_ARCHIVE
+        archive_block(&recordPDMBuf[0], AUDIO_IN_PDM_BUFFER_SIZE, &PCMBuffer[playbackPtr],
+                      AUDIO_IN_PDM_BUFFER_SIZE / 4);
+#endif
+
         playbackPtr += AUDIO_IN_PDM_BUFFER_SIZE / 4 / 2;
         if (playbackPtr >= BUFFER_SIZE)
         {
@@ -0,0 +1,88 @@
+// cascade.c
+#include "cascade.h"
+#include "trace.h"
+#include <stdint.h>
+#include <string.h>
+
+uint32_t cascade_gate_workspace_size(const CnnModel_t *gate, uint16_t window)
+{
+    return cnn_window_workspace_size(gate, window);
+}
+
+uint32_t cascade_full_workspace_size(const CnnModel_t *full, uint16_t window)
+{
+    return cnn_window_workspace_size(full, window);
+}
+
+int cascade_init(Cascade_t *cascade, const CnnModel_t *gate, const CnnModel_t *full,
+                 void *gate_workspace, void *full_workspace, uint8_t gate_class,
+                 int32_t threshold)
+{
+    if (!cascade || !gate || !full || !gate_workspace || !full_workspace ||
+        gate_class >= gate->n_classes)
+        return -1;
+
+    memset(cascade, 0, sizeof(Cascade_t));
+    cascade->gate = gate;
+    cascade->full = full;
+    cascade->gate_workspace = gate_workspace;
+    cascade->full_workspace = full_workspace;
+    cascade->gate_class = gate_class;
+    cascade->threshold = threshold;
+    return 0;
+}
+
+void cascade_set_threshold(Cascade_t *cascade, int32_t threshold)
+{
+    cascade->threshold = threshold;
+}
+
+int cascade_classify(Cascade_t *cascade, const int8_t *input, uint16_t n_frames,
+                     float audio_seconds, int32_t *logits, int32_t *gate_score)
+{
+    int32_t gate_logits[CNN_MAX_CLASSES];
+
+    if (!cascade || !input || !logits)
+        return -1;
+
+    // stage 1: every window
+    if (cnn_infer_window(cascade->gate, input, n_frames, cascade->gate_workspace, gate_logits) !=
+        0)
+        return -1;
+
+    cascade->windows++;
+    cascade->macs += cnn_window_macs(cascade->gate, n_frames);
+    cascade->audio_seconds += audio_seconds;
+
+    int32_t score = gate_logits[cascade->gate_class];
+    if (gate_score)
+        *gate_score = score;
+    TRACE_VALUE(TRACE_ID_GATE_SCORE, (uint32_t)score);
+
+    // early exit on silence, wind and anything else the gate rejects
+    if (score < cascade->threshold)
+        return 0;
+
+    // stage 2: only on gate hits
+    if (cnn_infer_window(cascade->full, input, n_frames, cascade->full_workspace, logits) != 0)
+        return -1;
+
+    cascade->full_runs++;
+    cascade->macs += cnn_window_macs(cascade->full, n_frames);
+    return 1;
+}
+
+float cascade_macs_per_second(const Cascade_t *cascade)
+{
+    if (cascade->audio_seconds <= 0.0f)
+        return 0.0f;
+    return (float)cascade->macs / cascade->audio_seconds;
+}
+
+void cascade_reset_stats(Cascade_t *cascade)
+{
+    cascade->windows = 0;
+    cascade->full_runs = 0;
+    cascade->macs = 0;
+    cascade->audio_seconds = 0.0f;
+}
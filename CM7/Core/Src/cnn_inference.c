@@ -0,0 +1,381 @@
+// cnn_inference.c
+#include "cnn_inference.h"
+#include <stdint.h>
+#include <string.h>
+
+static CnnWeightFetch_t weight_fetch = 0;
+
+uint16_t cnn_layer_out_h(const CnnConvLayer_t *layer)
+{
+    return (layer->in_h + layer->stride_h - 1) / layer->stride_h;
+}
+
+// bytes of one activation column entering layer l (l == n_layers is the last layer's output)
+static uint32_t column_bytes(const CnnModel_t *model, uint8_t l)
+{
+    if (l < model->n_layers)
+        return (uint32_t)model->layers[l].in_h * model->layers[l].in_ch;
+
+    const CnnConvLayer_t *last = &model->layers[model->n_layers - 1];
+    return (uint32_t)cnn_layer_out_h(last) * last->out_ch;
+}
+
+static uint32_t max_column_bytes(const CnnModel_t *model)
+{
+    uint32_t max = 0;
+    for (uint8_t l = 0; l <= model->n_layers; ++l)
+    {
+        uint32_t bytes = column_bytes(model, l);
+        if (bytes > max)
+            max = bytes;
+    }
+    return max;
+}
+
+// last layer columns produced by a window, 0 if the window is too short
+static uint16_t pooled_columns(const CnnModel_t *model, uint16_t window)
+{
+    uint32_t receptive = 1;
+    for (uint8_t l = 0; l < model->n_layers; ++l)
+        receptive += model->layers[l].k_w - 1;
+
+    return (window >= receptive) ? (uint16_t)(window - receptive + 1) : 0;
+}
+
+static int model_valid(const CnnModel_t *model)
+{
+    if (!model || model->n_layers == 0 || model->n_layers > CNN_MAX_LAYERS ||
+        model->n_classes == 0 || model->n_classes > CNN_MAX_CLASSES ||
+        model->layers[0].in_ch != 1 || !model->fc_weights)
+        return 0;
+
+    for (uint8_t l = 0; l < model->n_layers; ++l)
+    {
+        const CnnConvLayer_t *layer = &model->layers[l];
+        if (layer->k_w == 0 || layer->k_w > CNN_MAX_KERNEL_W || layer->k_h == 0 ||
+            layer->stride_h == 0 || !layer->weights)
+            return 0;
+        // each layer must consume exactly what the previous one produced
+        if (l > 0 && (layer->in_h != cnn_layer_out_h(&model->layers[l - 1]) ||
+                      layer->in_ch != model->layers[l - 1].out_ch))
+            return 0;
+    }
+    return 1;
+}
+
+static uint32_t layer_column_macs(const CnnConvLayer_t *layer)
+{
+    return (uint32_t)cnn_layer_out_h(layer) * layer->out_ch * layer->k_h * layer->k_w *
+           layer->in_ch;
+}
+
+uint32_t cnn_window_macs(const CnnModel_t *model, uint16_t window)
+{
+    uint32_t macs = 0;
+    uint16_t cols = window;
+
+    for (uint8_t l = 0; l < model->n_layers; ++l)
+    {
+        if (cols < model->layers[l].k_w)
+            return 0;
+        cols -= model->layers[l].k_w - 1;
+        macs += cols * layer_column_macs(&model->layers[l]);
+    }
+    return macs + model->n_classes * column_bytes(model, model->n_layers);
+}
+
+uint32_t cnn_stream_macs(const CnnModel_t *model)
+{
+    uint32_t macs = 0;
+    for (uint8_t l = 0; l < model->n_layers; ++l)
+        macs += layer_column_macs(&model->layers[l]);
+
+    return macs + model->n_classes * column_bytes(model, model->n_layers);
+}
+
+void cnn_set_weight_fetch(CnnWeightFetch_t fetch) { weight_fetch = fetch; }
+
+static const int8_t *layer_weights(const CnnModel_t *model, uint8_t l)
+{
+    const CnnConvLayer_t *layer = &model->layers[l];
+    if (!weight_fetch)
+        return layer->weights;
+
+    uint32_t size = (uint32_t)layer->out_ch * layer->k_w * layer->k_h * layer->in_ch;
+    return weight_fetch(l, layer->weights, size);
+}
+
+static int8_t requantize(int32_t acc, const CnnConvLayer_t *layer)
+{
+    int64_t scaled = (int64_t)acc * layer->out_multiplier;
+    if (layer->out_shift > 0)
+        scaled = (scaled + ((int64_t)1 << (layer->out_shift - 1))) >> layer->out_shift;
+
+    int32_t lo = layer->relu ? 0 : -128;
+    if (scaled < lo)
+        return (int8_t)lo;
+    if (scaled > 127)
+        return 127;
+    return (int8_t)scaled;
+}
+
+// computes one output column from the k_w most recent input columns (oldest first)
+// both inference modes go through here, which is what keeps them bit-exact
+static void conv_column(const CnnConvLayer_t *layer, const int8_t *weights,
+                        const int8_t *const *in_cols, int8_t *out)
+{
+    const uint16_t out_h = cnn_layer_out_h(layer);
+    const int16_t pad = (layer->k_h - 1) / 2;
+    const uint32_t w_stride_oc = (uint32_t)layer->k_w * layer->k_h * layer->in_ch;
+
+    for (uint16_t oh = 0; oh < out_h; ++oh)
+    {
+        int16_t ih0 = (int16_t)(oh * layer->stride_h) - pad;
+
+        for (uint16_t oc = 0; oc < layer->out_ch; ++oc)
+        {
+            int32_t acc = layer->bias ? layer->bias[oc] : 0;
+            const int8_t *w_oc = weights + oc * w_stride_oc;
+
+            for (uint8_t kw = 0; kw < layer->k_w; ++kw)
+            {
+                const int8_t *col = in_cols[kw];
+                const int8_t *w_kw = w_oc + (uint32_t)kw * layer->k_h * layer->in_ch;
+
+                for (uint8_t kh = 0; kh < layer->k_h; ++kh)
+                {
+                    int16_t ih = ih0 + kh;
+                    if (ih < 0 || ih >= (int16_t)layer->in_h)
+                        continue;
+
+                    const int8_t *x = col + (uint32_t)ih * layer->in_ch;
+                    const int8_t *w = w_kw + (uint32_t)kh * layer->in_ch;
+                    for (uint16_t ic = 0; ic < layer->in_ch; ++ic)
+                        acc += (int32_t)w[ic] * x[ic];
+                }
+            }
+            out[(uint32_t)oh * layer->out_ch + oc] = requantize(acc, layer);
+        }
+    }
+}
+
+// dense layer over the time-summed last layer outputs
+static void classify(const CnnModel_t *model, const int32_t *pool_sum, int32_t *logits)
+{
+    const uint32_t features = column_bytes(model, model->n_layers);
+
+    for (uint16_t c = 0; c < model->n_classes; ++c)
+    {
+        int64_t acc = model->fc_bias ? model->fc_bias[c] : 0;
+        const int8_t *w = model->fc_weights + c * features;
+        for (uint32_t j = 0; j < features; ++j)
+            acc += (int64_t)w[j] * pool_sum[j];
+
+        if (acc > INT32_MAX)
+            acc = INT32_MAX;
+        else if (acc < INT32_MIN)
+            acc = INT32_MIN;
+        logits[c] = (int32_t)acc;
+    }
+}
+
+uint32_t cnn_window_workspace_size(const CnnModel_t *model, uint16_t window)
+{
+    if (!model_valid(model) || pooled_columns(model, window) == 0)
+        return 0;
+
+    // pooled sums + two ping-pong feature maps of window columns
+    uint32_t sums = column_bytes(model, model->n_layers) * sizeof(int32_t);
+    uint32_t map = ((uint32_t)window * max_column_bytes(model) + 3u) & ~3u;
+    return sums + 2 * map;
+}
+
+int cnn_infer_window(const CnnModel_t *model, const int8_t *input, uint16_t n_frames,
+                     void *workspace, int32_t *logits)
+{
+    if (!input || !workspace || !logits)
+        return -1;
+
+    uint32_t ws_size = cnn_window_workspace_size(model, n_frames);
+    if (ws_size == 0)
+        return -1;
+
+    const uint32_t features = column_bytes(model, model->n_layers);
+    const uint32_t map_bytes = (ws_size - features * sizeof(int32_t)) / 2;
+    int32_t *pool_sum = (int32_t *)workspace;
+    int8_t *src = (int8_t *)workspace + features * sizeof(int32_t);
+    int8_t *dst = src + map_bytes;
+
+    // transpose [h][t] features into contiguous columns
+    const uint16_t in_h = model->layers[0].in_h;
+    for (uint16_t t = 0; t < n_frames; ++t)
+        for (uint16_t h = 0; h < in_h; ++h)
+            src[(uint32_t)t * in_h + h] = input[(uint32_t)h * n_frames + t];
+
+    uint16_t cols = n_frames;
+    for (uint8_t l = 0; l < model->n_layers; ++l)
+    {
+        const CnnConvLayer_t *layer = &model->layers[l];
+        const int8_t *weights = layer_weights(model, l);
+        const uint32_t in_bytes = column_bytes(model, l);
+        const uint32_t out_bytes = column_bytes(model, l + 1);
+        const int8_t *in_cols[CNN_MAX_KERNEL_W];
+
+        cols -= layer->k_w - 1;
+        for (uint16_t t = 0; t < cols; ++t)
+        {
+            for (uint8_t kw = 0; kw < layer->k_w; ++kw)
+                in_cols[kw] = src + (uint32_t)(t + kw) * in_bytes;
+            conv_column(layer, weights, in_cols, dst + (uint32_t)t * out_bytes);
+        }
+
+        int8_t *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    // global average pooling, the 1/cols factor is folded into fc_weights
+    memset(pool_sum, 0, features * sizeof(int32_t));
+    for (uint16_t t = 0; t < cols; ++t)
+        for (uint32_t j = 0; j < features; ++j)
+            pool_sum[j] += src[(uint32_t)t * features + j];
+
+    classify(model, pool_sum, logits);
+    return 0;
+}
+
+// ring length of each stage: k_w input columns per layer, pool_cols for the last output
+static uint16_t ring_length(const CnnModel_t *model, uint8_t l, uint16_t pool_cols)
+{
+    return (l < model->n_layers) ? model->layers[l].k_w : pool_cols;
+}
+
+uint32_t cnn_stream_workspace_size(const CnnModel_t *model, uint16_t window)
+{
+    if (!model_valid(model))
+        return 0;
+
+    uint16_t pool_cols = pooled_columns(model, window);
+    if (pool_cols == 0)
+        return 0;
+
+    uint32_t size = column_bytes(model, model->n_layers) * sizeof(int32_t);
+    for (uint8_t l = 0; l <= model->n_layers; ++l)
+        size += ring_length(model, l, pool_cols) * column_bytes(model, l);
+
+    return size + 2 * max_column_bytes(model);
+}
+
+int cnn_stream_init(CnnStream_t *stream, const CnnModel_t *model, uint16_t window,
+                    void *workspace, uint32_t workspace_size)
+{
+    if (!stream || !workspace)
+        return -1;
+
+    uint32_t needed = cnn_stream_workspace_size(model, window);
+    if (needed == 0 || workspace_size < needed)
+        return -1;
+
+    memset(stream, 0, sizeof(CnnStream_t));
+    stream->model = model;
+    stream->window = window;
+    stream->pool_cols = pooled_columns(model, window);
+
+    // carve the workspace: pool sums first to keep them aligned
+    uint8_t *p = (uint8_t *)workspace;
+    stream->pool_sum = (int32_t *)p;
+    p += column_bytes(model, model->n_layers) * sizeof(int32_t);
+
+    for (uint8_t l = 0; l <= model->n_layers; ++l)
+    {
+        stream->ring[l] = (int8_t *)p;
+        p += ring_length(model, l, stream->pool_cols) * column_bytes(model, l);
+    }
+    stream->scratch[0] = (int8_t *)p;
+    stream->scratch[1] = (int8_t *)p + max_column_bytes(model);
+
+    cnn_stream_reset(stream);
+    return 0;
+}
+
+void cnn_stream_reset(CnnStream_t *stream)
+{
+    memset(stream->head, 0, sizeof(stream->head));
+    memset(stream->filled, 0, sizeof(stream->filled));
+    memset(stream->pool_sum, 0,
+           column_bytes(stream->model, stream->model->n_layers) * sizeof(int32_t));
+}
+
+int cnn_stream_push(CnnStream_t *stream, const int8_t *column, int32_t *logits)
+{
+    if (!stream || !stream->model || !column || !logits)
+        return -1;
+
+    const CnnModel_t *model = stream->model;
+    const int8_t *in = column;
+    const int8_t *in_cols[CNN_MAX_KERNEL_W];
+
+    for (uint8_t l = 0; l < model->n_layers; ++l)
+    {
+        const CnnConvLayer_t *layer = &model->layers[l];
+        const uint32_t bytes = column_bytes(model, l);
+        const uint16_t len = layer->k_w;
+
+        // store the new input column, the slot after it then holds the oldest one
+        memcpy(stream->ring[l] + stream->head[l] * bytes, in, bytes);
+        stream->head[l] = (stream->head[l] + 1) % len;
+        if (stream->filled[l] < len)
+            stream->filled[l]++;
+
+        if (stream->filled[l] < len)
+            return 0;
+
+        for (uint8_t kw = 0; kw < len; ++kw)
+            in_cols[kw] = stream->ring[l] + ((stream->head[l] + kw) % len) * bytes;
+
+        int8_t *out = stream->scratch[l & 1];
+        conv_column(layer, layer_weights(model, l), in_cols, out);
+        in = out;
+    }
+
+    // slide the pooling window: drop the evicted column, add the new one
+    const uint8_t last = model->n_layers;
+    const uint32_t features = column_bytes(model, last);
+    const uint16_t len = stream->pool_cols;
+    int8_t *slot = stream->ring[last] + stream->head[last] * features;
+
+    if (stream->filled[last] == len)
+        for (uint32_t j = 0; j < features; ++j)
+            stream->pool_sum[j] -= slot[j];
+
+    memcpy(slot, in, features);
+    for (uint32_t j = 0; j < features; ++j)
+        stream->pool_sum[j] += slot[j];
+
+    stream->head[last] = (stream->head[last] + 1) % len;
+    if (stream->filled[last] < len)
+        stream->filled[last]++;
+
+    if (stream->filled[last] < len)
+        return 0;
+
+    classify(model, stream->pool_sum, logits);
+    return 1;
+}
+
+void cnn_quantize_input(const float *input, int8_t *output, uint32_t size, float scale,
+                        int8_t zero_point)
+{
+    const float inv_scale = 1.0f / scale;
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        float v = input[i] * inv_scale;
+        int32_t q = (int32_t)(v >= 0.0f ? v + 0.5f : v - 0.5f) + zero_point;
+        if (q < -128)
+            q = -128;
+        else if (q > 127)
+            q = 127;
+        output[i] = (int8_t)q;
+    }
+}
@@ -0,0 +1,479 @@
+// detection_log.c
+#include "detection_log.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define DLOG_MAGIC 0x474F4C44u // "DLOG"
+#define DLOG_VERSION 1u
+#define DLOG_RECORD_MAGIC 0xD37Eu
+// the open fields follow the erase fields inside the header slot
+#define DLOG_OPEN_OFFSET 16u
+
+// slot 0 of every sector
+typedef struct
+{
+    // programmed right after the erase
+    uint32_t magic;
+    uint16_t version;
+    uint16_t slot_size;
+    uint32_t erase_count;
+    uint32_t erase_crc;
+    // programmed when the sector becomes the head
+    uint32_t sequence;
+    uint32_t first_record;
+    uint32_t open_crc;
+    uint32_t reserved;
+} SectorHeader_t;
+
+_Static_assert(sizeof(DetectionRecord_t) == DETECTION_LOG_SLOT, "record layout");
+_Static_assert(sizeof(SectorHeader_t) == DETECTION_LOG_SLOT, "sector header layout");
+_Static_assert(offsetof(SectorHeader_t, sequence) == DLOG_OPEN_OFFSET, "open fields offset");
+
+// CRC-32 (IEEE), one nibble per step to keep the table at 16 words
+static uint32_t crc32(const void *data, uint32_t len)
+{
+    static const uint32_t table[16] = {
+        0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu, 0x76DC4190u, 0x6B6B51F4u,
+        0x4DB26158u, 0x5005713Cu, 0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+        0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu,
+    };
+    const uint8_t *p = data;
+    uint32_t crc = 0xFFFFFFFFu;
+
+    for (uint32_t i = 0; i < len; ++i)
+    {
+        crc ^= p[i];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+static int is_erased(const void *data, uint32_t len)
+{
+    const uint8_t *p = data;
+    for (uint32_t i = 0; i < len; ++i)
+        if (p[i] != 0xFF)
+            return 0;
+    return 1;
+}
+
+static int record_valid(const DetectionRecord_t *r)
+{
+    return r->magic == DLOG_RECORD_MAGIC && r->crc == crc32(r, offsetof(DetectionRecord_t, crc));
+}
+
+static uint32_t sector_addr(const DetectionLog_t *log, uint16_t s)
+{
+    return log->base + (uint32_t)s * log->flash->sector_size;
+}
+
+static void wait_idle(const DetectionLog_t *log)
+{
+    while (log->flash->busy(log->flash->ctx))
+        ;
+}
+
+static int flash_read(DetectionLog_t *log, uint32_t addr, void *dst, uint32_t len)
+{
+    log->stats.reads++;
+    if (log->flash->read(log->flash->ctx, addr, dst, len) != 0)
+    {
+        log->stats.flash_errors++;
+        return -1;
+    }
+    return 0;
+}
+
+// bytes [from, to) of a page buffer; every record up to last_seq is durable afterwards
+static int program_range(DetectionLog_t *log, uint32_t page_addr, const uint8_t *page,
+                         uint32_t from, uint32_t to, uint32_t last_seq)
+{
+    if (from >= to)
+        return 0;
+    if (log->flash->program(log->flash->ctx, page_addr + from, page + from, to - from) != 0)
+    {
+        log->stats.flash_errors++;
+        return -1;
+    }
+    log->stats.pages_programmed++;
+    log->stats.bytes_programmed += to - from;
+    log->durable_seq = last_seq + 1;
+    return 0;
+}
+
+// classifies a sector from its header slot
+static void read_sector_state(DetectionLog_t *log, uint16_t s, const SectorHeader_t *h,
+                              int *erase_known)
+{
+    DetectionLogSector_t *sector = &log->sectors[s];
+
+    sector->state = DLOG_SECTOR_DIRTY;
+    *erase_known = 0;
+    if (h->magic != DLOG_MAGIC || h->version != DLOG_VERSION ||
+        h->slot_size != DETECTION_LOG_SLOT ||
+        h->erase_crc != crc32(h, offsetof(SectorHeader_t, erase_crc)))
+        return; // erase cut short, or never formatted
+
+    sector->erase_count = h->erase_count;
+    *erase_known = 1;
+
+    const uint8_t *open = (const uint8_t *)h + DLOG_OPEN_OFFSET;
+    if (is_erased(open, DETECTION_LOG_SLOT - DLOG_OPEN_OFFSET))
+        sector->state = DLOG_SECTOR_READY;
+    else if (h->open_crc == crc32(open, offsetof(SectorHeader_t, open_crc) - DLOG_OPEN_OFFSET))
+    {
+        sector->state = DLOG_SECTOR_USED;
+        sector->sequence = h->sequence;
+    }
+}
+
+// write position and next record number of the head from its last written page
+static int locate_head(DetectionLog_t *log, uint32_t first_record)
+{
+    const uint32_t page_size = log->flash->page_size;
+    const uint32_t base = sector_addr(log, log->head);
+    uint8_t *page = log->pages[0];
+
+    // written pages are a prefix of the sector; page 0 always holds the header
+    uint32_t lo = 1, hi = log->flash->sector_size / page_size;
+    while (lo < hi)
+    {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (flash_read(log, base + mid * page_size, page, page_size) != 0)
+            return -1;
+        if (is_erased(page, page_size))
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+
+    // slots after the last non-erased one are free, a torn slot in between is skipped
+    uint32_t last_page = lo - 1;
+    if (flash_read(log, base + last_page * page_size, page, page_size) != 0)
+        return -1;
+    uint32_t used = log->slots_per_page;
+    while (used > 0 && is_erased(page + (used - 1) * DETECTION_LOG_SLOT, DETECTION_LOG_SLOT))
+        used--;
+    log->head_slot = last_page * log->slots_per_page + used;
+
+    if (used < log->slots_per_page)
+    {
+        // keep appending into the partly written page
+        log->fill = 0;
+        log->fill_active = 1;
+        log->fill_addr = base + last_page * page_size;
+        log->fill_used = log->fill_programmed = used * DETECTION_LOG_SLOT;
+    }
+
+    // newest valid record, usually the slot right before the write position
+    log->next_record_seq = first_record;
+    for (uint32_t slot = log->head_slot; slot-- > 1;)
+    {
+        DetectionRecord_t r;
+        if (flash_read(log, base + slot * DETECTION_LOG_SLOT, &r, sizeof(r)) != 0)
+            return -1;
+        if (record_valid(&r))
+        {
+            log->next_record_seq = r.sequence + 1;
+            break;
+        }
+        if (!is_erased(&r, sizeof(r)))
+            log->stats.torn_records++;
+    }
+    log->fill_last_seq = log->next_record_seq - 1;
+    return 0;
+}
+
+int detection_log_mount(DetectionLog_t *log, const NorFlash_t *flash, uint32_t base,
+                        uint16_t n_sectors)
+{
+    if (!log || !flash || n_sectors < DETECTION_LOG_SPARE_SECTORS + 2 ||
+        n_sectors > DETECTION_LOG_MAX_SECTORS || flash->page_size > DETECTION_LOG_MAX_PAGE ||
+        flash->page_size < DETECTION_LOG_SLOT || flash->page_size % DETECTION_LOG_SLOT ||
+        flash->sector_size % flash->page_size || base % flash->sector_size ||
+        base + (uint64_t)n_sectors * flash->sector_size > flash->size)
+        return -1;
+
+    memset(log, 0, sizeof(*log));
+    log->flash = flash;
+    log->base = base;
+    log->n_sectors = n_sectors;
+    log->slots_per_page = (uint16_t)(flash->page_size / DETECTION_LOG_SLOT);
+    log->slots_per_sector = flash->sector_size / DETECTION_LOG_SLOT;
+    log->erasing = -1;
+
+    wait_idle(log);
+
+    // one header slot per sector
+    int32_t head = -1, first_ready = -1;
+    uint32_t max_erase = 0;
+    uint8_t erase_known[DETECTION_LOG_MAX_SECTORS];
+    SectorHeader_t h;
+    for (uint16_t s = 0; s < n_sectors; ++s)
+    {
+        int known;
+        if (flash_read(log, sector_addr(log, s), &h, sizeof(h)) != 0)
+            return -1;
+        read_sector_state(log, s, &h, &known);
+        erase_known[s] = (uint8_t)known;
+        if (known && log->sectors[s].erase_count > max_erase)
+            max_erase = log->sectors[s].erase_count;
+
+        if (log->sectors[s].state == DLOG_SECTOR_USED &&
+            (head < 0 || log->sectors[s].sequence > log->sectors[head].sequence))
+            head = s;
+        if (log->sectors[s].state == DLOG_SECTOR_READY && first_ready < 0)
+            first_ready = s;
+    }
+    // a header lost with an interrupted erase takes the worst known wear
+    for (uint16_t s = 0; s < n_sectors; ++s)
+        if (!erase_known[s])
+            log->sectors[s].erase_count = max_erase;
+
+    if (head < 0)
+    {
+        // empty log: the first append opens the first erased sector (or sector 0)
+        log->head = (uint16_t)(((first_ready < 0 ? 0 : first_ready) + n_sectors - 1) % n_sectors);
+        log->head_slot = log->slots_per_sector;
+        return 0;
+    }
+
+    log->head = (uint16_t)head;
+    log->next_sector_seq = log->sectors[head].sequence + 1;
+    if (flash_read(log, sector_addr(log, log->head), &h, sizeof(h)) != 0 ||
+        locate_head(log, h.first_record) != 0)
+        return -1;
+    log->durable_seq = log->next_record_seq;
+    return 0;
+}
+
+static int drop(DetectionLog_t *log)
+{
+    log->stats.dropped++;
+    return -1;
+}
+
+int detection_log_append(DetectionLog_t *log, DetectionRecord_t *record)
+{
+    const uint32_t page_size = log->flash->page_size;
+
+    if (log->fill_active && log->fill_used == page_size)
+    {
+        // the full page waits for detection_log_service in the second buffer
+        if (log->pending)
+            return drop(log);
+        log->pending = 1;
+        log->pending_addr = log->fill_addr;
+        log->pending_from = log->fill_programmed;
+        log->pending_last_seq = log->fill_last_seq;
+        log->fill ^= 1u;
+        log->fill_active = 0;
+    }
+
+    uint8_t *page = log->pages[log->fill];
+    if (!log->fill_active)
+    {
+        memset(page, 0xFF, page_size);
+        if (log->head_slot == log->slots_per_sector)
+        {
+            uint16_t next = (uint16_t)((log->head + 1u) % log->n_sectors);
+            if (log->sectors[next].state != DLOG_SECTOR_READY)
+                return drop(log);
+
+            // open the sector; the fields go out with its first page
+            SectorHeader_t *h = (SectorHeader_t *)page;
+            h->sequence = log->next_sector_seq;
+            h->first_record = log->next_record_seq;
+            h->open_crc = crc32(page + DLOG_OPEN_OFFSET,
+                                offsetof(SectorHeader_t, open_crc) - DLOG_OPEN_OFFSET);
+
+            log->sectors[next].state = DLOG_SECTOR_USED;
+            log->sectors[next].sequence = log->next_sector_seq++;
+            log->head = next;
+            log->head_slot = 1;
+            log->fill_addr = sector_addr(log, next);
+            log->fill_used = DETECTION_LOG_SLOT;
+            log->fill_programmed = DLOG_OPEN_OFFSET;
+        }
+        else
+        {
+            log->fill_addr = sector_addr(log, log->head) +
+                             log->head_slot / log->slots_per_page * page_size;
+            log->fill_used = log->fill_programmed = 0;
+        }
+        log->fill_active = 1;
+    }
+
+    record->sequence = log->next_record_seq++;
+    record->magic = DLOG_RECORD_MAGIC;
+    record->crc = crc32(record, offsetof(DetectionRecord_t, crc));
+    memcpy(page + log->fill_used, record, DETECTION_LOG_SLOT);
+    log->fill_used += DETECTION_LOG_SLOT;
+    log->fill_last_seq = record->sequence;
+    log->head_slot++;
+    log->stats.appended++;
+    return 0;
+}
+
+// programs the erase fields of a sector whose background erase completed
+static int finish_erase(DetectionLog_t *log)
+{
+    DetectionLogSector_t *sector = &log->sectors[log->erasing];
+    SectorHeader_t h;
+
+    memset(&h, 0xFF, sizeof(h));
+    h.magic = DLOG_MAGIC;
+    h.version = DLOG_VERSION;
+    h.slot_size = DETECTION_LOG_SLOT;
+    h.erase_count = sector->erase_count + 1;
+    h.erase_crc = crc32(&h, offsetof(SectorHeader_t, erase_crc));
+    if (log->flash->program(log->flash->ctx, sector_addr(log, (uint16_t)log->erasing), &h,
+                            DLOG_OPEN_OFFSET) != 0)
+    {
+        log->stats.flash_errors++;
+        return -1;
+    }
+
+    sector->erase_count++;
+    sector->state = DLOG_SECTOR_READY;
+    log->erasing = -1;
+    log->stats.erases++;
+    return 0;
+}
+
+// erases the first non-erased sector ahead of the head, the oldest one once the ring is full
+static int start_erase(DetectionLog_t *log)
+{
+    uint16_t ready = 0;
+
+    for (uint16_t i = 1; i < log->n_sectors; ++i)
+    {
+        uint16_t s = (uint16_t)((log->head + i) % log->n_sectors);
+        if (log->sectors[s].state == DLOG_SECTOR_READY)
+        {
+            if (++ready >= DETECTION_LOG_SPARE_SECTORS)
+                return 0;
+            continue;
+        }
+
+        if (log->sectors[s].state == DLOG_SECTOR_USED)
+            log->stats.reclaimed++;
+        log->sectors[s].state = DLOG_SECTOR_DIRTY;
+        if (log->flash->erase(log->flash->ctx, sector_addr(log, s)) != 0)
+        {
+            log->stats.flash_errors++;
+            return -1;
+        }
+        log->erasing = s;
+        return 0;
+    }
+    return 0;
+}
+
+// full page parked by detection_log_append
+static int program_pending(DetectionLog_t *log)
+{
+    if (!log->pending)
+        return 0;
+    if (program_range(log, log->pending_addr, log->pages[log->fill ^ 1u], log->pending_from,
+                      log->flash->page_size, log->pending_last_seq) != 0)
+        return -1;
+    log->pending = 0;
+    return 0;
+}
+
+// fill page up to its last record; a full page is released for the next one
+static int program_fill(DetectionLog_t *log)
+{
+    if (!log->fill_active)
+        return 0;
+    if (program_range(log, log->fill_addr, log->pages[log->fill], log->fill_programmed,
+                      log->fill_used, log->fill_last_seq) != 0)
+        return -1;
+    log->fill_programmed = log->fill_used;
+    if (log->fill_used == log->flash->page_size)
+        log->fill_active = 0;
+    return 0;
+}
+
+int detection_log_service(DetectionLog_t *log)
+{
+    if (log->flash->busy(log->flash->ctx))
+        return 0;
+    if (log->erasing >= 0 && finish_erase(log) != 0)
+        return -1;
+    if (program_pending(log) != 0)
+        return -1;
+    // only whole pages here, a partial page keeps collecting records
+    if (log->fill_active && log->fill_used == log->flash->page_size && program_fill(log) != 0)
+        return -1;
+    return start_erase(log);
+}
+
+int detection_log_flush(DetectionLog_t *log)
+{
+    wait_idle(log);
+    if (log->erasing >= 0 && finish_erase(log) != 0)
+        return -1;
+    if (program_pending(log) != 0)
+        return -1;
+    return program_fill(log);
+}
+
+int detection_log_busy(const DetectionLog_t *log) { return log->flash->busy(log->flash->ctx); }
+
+void detection_log_iter_begin(const DetectionLog_t *log, DetectionLogIter_t *it)
+{
+    int32_t oldest = -1;
+
+    for (uint16_t s = 0; s < log->n_sectors; ++s)
+        if (log->sectors[s].state == DLOG_SECTOR_USED &&
+            (oldest < 0 || log->sectors[s].sequence < log->sectors[oldest].sequence))
+            oldest = s;
+
+    it->first = (uint16_t)(oldest < 0 ? 0 : oldest);
+    it->sector = (uint16_t)(oldest < 0 ? log->n_sectors : 0);
+    it->slot = 1;
+    it->page_addr = UINT32_MAX;
+}
+
+int detection_log_iter_next(DetectionLog_t *log, DetectionLogIter_t *it,
+                            DetectionRecord_t *record)
+{
+    const uint32_t page_size = log->flash->page_size;
+
+    while (it->sector < log->n_sectors)
+    {
+        uint16_t s = (uint16_t)((it->first + it->sector) % log->n_sectors);
+        uint32_t end = (s == log->head) ? log->head_slot : log->slots_per_sector;
+
+        while (log->sectors[s].state == DLOG_SECTOR_USED && it->slot < end)
+        {
+            uint32_t addr = sector_addr(log, s) + it->slot * DETECTION_LOG_SLOT;
+            uint32_t page_addr = addr & ~(page_size - 1u);
+            if (page_addr != it->page_addr)
+            {
+                wait_idle(log);
+                if (flash_read(log, page_addr, it->page, page_size) != 0)
+                    return -1;
+                it->page_addr = page_addr;
+            }
+            const uint8_t *slot = it->page + (addr - page_addr);
+            it->slot++;
+
+            // records still in RAM read as erased
+            if (is_erased(slot, DETECTION_LOG_SLOT))
+                continue;
+            memcpy(record, slot, DETECTION_LOG_SLOT);
+            if (record_valid(record))
+                return 1;
+            log->stats.torn_records++;
+        }
+
+        it->sector = (s == log->head) ? log->n_sectors : (uint16_t)(it->sector + 1u);
+        it->slot = 1;
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+// dma_chain.c
+#include "dma_chain.h"
+#include <stdint.h>
+#include <string.h>
+
+void dma_chain_reset(DmaChain_t *chain) { chain->n_segments = 0; }
+
+static uint8_t beat_width(uintptr_t src, uintptr_t dst, uint32_t len)
+{
+    uintptr_t bits = src | dst | len;
+    if ((bits & 3u) == 0)
+        return 4;
+    if ((bits & 1u) == 0)
+        return 2;
+    return 1;
+}
+
+int dma_chain_add(DmaChain_t *chain, const void *src, void *dst, uint32_t len,
+                  DmaChainCallback_t done, void *ctx)
+{
+    if (!chain || !src || !dst || len == 0)
+        return -1;
+
+    uint32_t blocks = (len + DMA_CHAIN_MAX_BLOCK - 1) / DMA_CHAIN_MAX_BLOCK;
+    if (chain->n_segments + blocks > DMA_CHAIN_MAX_SEGMENTS)
+        return -1;
+
+    uintptr_t s = (uintptr_t)src;
+    uintptr_t d = (uintptr_t)dst;
+    while (len > 0)
+    {
+        uint32_t n = (len > DMA_CHAIN_MAX_BLOCK) ? DMA_CHAIN_MAX_BLOCK : len;
+        DmaSegment_t *seg = &chain->segments[chain->n_segments++];
+
+        seg->src = s;
+        seg->dst = d;
+        seg->len = n;
+        seg->width = beat_width(s, d, n);
+        // only the last block of the copy reports completion
+        seg->done = (n == len) ? done : NULL;
+        seg->ctx = ctx;
+
+        s += n;
+        d += n;
+        len -= n;
+    }
+    return 0;
+}
+
+uint32_t dma_chain_bytes(const DmaChain_t *chain)
+{
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < chain->n_segments; ++i)
+        total += chain->segments[i].len;
+    return total;
+}
+
+void dma_chain_run_software(const DmaChain_t *chain)
+{
+    for (uint8_t i = 0; i < chain->n_segments; ++i)
+    {
+        const DmaSegment_t *seg = &chain->segments[i];
+        memmove((void *)seg->dst, (const void *)seg->src, seg->len);
+        if (seg->done)
+            seg->done(seg->ctx);
+    }
+}
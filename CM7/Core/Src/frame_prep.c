@@ -0,0 +1,108 @@
+// frame_prep.c
+#include "frame_prep.h"
+#include "mem_placement.h"
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#endif
+
+#define Q15_ROUND 0x4000
+
+void frame_prep_scale_window(float *window, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i)
+        window[i] *= FRAME_PREP_PCM_SCALE;
+}
+
+void frame_prep_window_q15(const float *scaled_window, int16_t *window_q15, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        float q = scaled_window[i] * 32768.0f * 32768.0f;
+        if (q >= 32767.0f)
+            window_q15[i] = 32767;
+        else if (q <= -32768.0f)
+            window_q15[i] = -32768;
+        else
+            window_q15[i] = (int16_t)(q >= 0.0f ? q + 0.5f : q - 0.5f);
+    }
+}
+
+// called once per frame from the ITCM mel path
+ITCM_FUNC void frame_prep_f32(const int16_t *pcm, uint32_t available, const float *window,
+                              float *frame, uint32_t n)
+{
+    const uint32_t body = available < n ? available : n;
+    uint32_t i = 0;
+
+    // independent loads and multiplies, the M7 dual-issues them; no per-sample branch
+    for (; i + 8 <= body; i += 8)
+    {
+        float x0 = (float)pcm[i], x1 = (float)pcm[i + 1];
+        float x2 = (float)pcm[i + 2], x3 = (float)pcm[i + 3];
+        float x4 = (float)pcm[i + 4], x5 = (float)pcm[i + 5];
+        float x6 = (float)pcm[i + 6], x7 = (float)pcm[i + 7];
+        frame[i] = x0 * window[i];
+        frame[i + 1] = x1 * window[i + 1];
+        frame[i + 2] = x2 * window[i + 2];
+        frame[i + 3] = x3 * window[i + 3];
+        frame[i + 4] = x4 * window[i + 4];
+        frame[i + 5] = x5 * window[i + 5];
+        frame[i + 6] = x6 * window[i + 6];
+        frame[i + 7] = x7 * window[i + 7];
+    }
+    for (; i < body; ++i)
+        frame[i] = (float)pcm[i] * window[i];
+
+    if (body < n)
+        memset(frame + body, 0, (n - body) * sizeof(float));
+}
+
+#if defined(__ARM_FEATURE_DSP)
+// two samples per 32-bit word; the M7 takes unaligned word accesses to normal memory
+static inline uint32_t load_pair(const int16_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void store_pair(int16_t *p, uint32_t v) { memcpy(p, &v, sizeof(v)); }
+
+// |pcm * window| <= 32768 * 32767, so the rounded Q15 result always fits 16 bits
+static inline uint32_t mul_pair(uint32_t x, uint32_t w)
+{
+    int32_t lo = __smulbb(x, w);
+    int32_t hi = __smultt(x, w);
+    return ((uint32_t)((lo + Q15_ROUND) >> 15) & 0xFFFFu) |
+           ((uint32_t)((hi + Q15_ROUND) >> 15) << 16);
+}
+#endif
+
+void frame_prep_q15(const int16_t *pcm, uint32_t available, const int16_t *window_q15,
+                    int16_t *frame, uint32_t n)
+{
+    const uint32_t body = available < n ? available : n;
+    uint32_t i = 0;
+
+#if defined(__ARM_FEATURE_DSP)
+    // dual 16-bit multiplies, eight samples per iteration
+    for (; i + 8 <= body; i += 8)
+    {
+        uint32_t x0 = load_pair(pcm + i), x1 = load_pair(pcm + i + 2);
+        uint32_t x2 = load_pair(pcm + i + 4), x3 = load_pair(pcm + i + 6);
+        store_pair(frame + i, mul_pair(x0, load_pair(window_q15 + i)));
+        store_pair(frame + i + 2, mul_pair(x1, load_pair(window_q15 + i + 2)));
+        store_pair(frame + i + 4, mul_pair(x2, load_pair(window_q15 + i + 4)));
+        store_pair(frame + i + 6, mul_pair(x3, load_pair(window_q15 + i + 6)));
+    }
+#endif
+    // the whole body off-target, where the compiler vectorizes the plain loop
+    for (; i < body; ++i)
+        frame[i] = (int16_t)(((int32_t)pcm[i] * window_q15[i] + Q15_ROUND) >> 15);
+
+    if (body < n)
+        memset(frame + body, 0, (n - body) * sizeof(int16_t));
+}
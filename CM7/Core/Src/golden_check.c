@@ -0,0 +1,186 @@
+// golden_check.c
+#include "golden_check.h"
+#include "golden_vectors.h"
+#include "mel_filterbank.h"
+#include "mel_spectrogram.h"
+#include "profiler.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define GOLDEN_ELEMENTS (GOLDEN_N_MELS * GOLDEN_N_FRAMES)
+
+// engine memory and outputs for the golden config, nothing on the stack
+static float state[MEL_STATE_BYTES(GOLDEN_FFT_SIZE, GOLDEN_N_MELS) / sizeof(float)];
+static float scratch[MEL_SCRATCH_BYTES(GOLDEN_FFT_SIZE) / sizeof(float)];
+static float spectrogram[GOLDEN_ELEMENTS];
+static int8_t quantized[GOLDEN_ELEMENTS];
+static MelBand_t bands[GOLDEN_N_MELS];
+static float weights[MEL_SPARSE_WEIGHTS(GOLDEN_FFT_SIZE)];
+
+static const MelSpectrogramConfig_t golden_config = {.sample_rate = GOLDEN_SAMPLE_RATE,
+                                                     .fft_size = GOLDEN_FFT_SIZE,
+                                                     .hop_length = GOLDEN_HOP_LENGTH,
+                                                     .n_mels = GOLDEN_N_MELS,
+                                                     .f_min = GOLDEN_F_MIN,
+                                                     .f_max = GOLDEN_F_MAX};
+static const MelQuantParams_t golden_quant = {GOLDEN_Q_SCALE, GOLDEN_Q_ZERO_POINT,
+                                              GOLDEN_DB_FLOOR, GOLDEN_DB_CEIL};
+
+// one result line, 1 if the stage is out of tolerance
+static int report(const char *vector, const char *stage, float error, float tolerance)
+{
+    int fail = !(error <= tolerance);
+    printf("golden %-12s %-11s max err %10.6f, tol %10.6f  %s\r\n", vector, stage, error,
+           tolerance, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+static float max_abs_error(const float *a, const float *b, uint32_t n)
+{
+    float worst = 0.0f;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        float e = fabsf(a[i] - b[i]);
+        if (!(e <= worst)) // NaN counts as the worst error
+            worst = e;
+    }
+    return worst;
+}
+
+// sparse bank against the reference band outlines: edges exact, sum and peak within tolerance
+static int check_filterbank(void)
+{
+    float edge_error = 0.0f;
+    float weight_error = 0.0f;
+
+    create_sparse_mel_filterbank(bands, weights, GOLDEN_N_MELS, GOLDEN_FFT_SIZE,
+                                 GOLDEN_SAMPLE_RATE, GOLDEN_F_MIN, GOLDEN_F_MAX);
+
+    for (uint16_t m = 0; m < GOLDEN_N_MELS; ++m)
+    {
+        const GoldenBand_t *ref = &golden_bands[m];
+        const float *w = weights + bands[m].offset;
+        int32_t first = -1, last = -1;
+        float sum = 0.0f, peak = 0.0f;
+
+        for (uint16_t k = 0; k < bands[m].n_bins; ++k)
+        {
+            if (w[k] == 0.0f)
+                continue;
+            if (first < 0)
+                first = bands[m].first_bin + k;
+            last = bands[m].first_bin + k;
+            sum += w[k];
+            if (w[k] > peak)
+                peak = w[k];
+        }
+        if (first < 0)
+            first = last = 0;
+
+        float de = fabsf((float)(first - ref->first_bin)) + fabsf((float)(last - ref->last_bin));
+        float dw = fmaxf(fabsf(sum - ref->sum), fabsf(peak - ref->peak));
+        if (de > edge_error)
+            edge_error = de;
+        if (dw > weight_error)
+            weight_error = dw;
+    }
+
+    return report("filterbank", "band edges", edge_error, GOLDEN_TOL_BAND_BIN) +
+           report("filterbank", "weights", weight_error, GOLDEN_TOL_BAND_WEIGHT);
+}
+
+static int check_vector(const GoldenVector_t *v)
+{
+    int failures = 0;
+
+    int n = calculate_mel_spectrogram(v->pcm, GOLDEN_N_SAMPLES, spectrogram, GOLDEN_N_FRAMES);
+    failures += report(v->name, "mel dB",
+                       n == GOLDEN_N_FRAMES
+                           ? max_abs_error(spectrogram, v->mel_db, GOLDEN_ELEMENTS)
+                           : INFINITY,
+                       GOLDEN_TOL_MEL_DB);
+
+    normalize_spectrogram(spectrogram, GOLDEN_N_MELS, GOLDEN_N_FRAMES);
+    failures += report(v->name, "normalized",
+                       max_abs_error(spectrogram, v->normalized, GOLDEN_ELEMENTS),
+                       GOLDEN_TOL_NORMALIZED);
+
+    n = calculate_mel_spectrogram_q8(v->pcm, GOLDEN_N_SAMPLES, quantized, GOLDEN_N_FRAMES,
+                                     &golden_quant);
+    int32_t q_error = (n == GOLDEN_N_FRAMES) ? 0 : 256;
+    for (uint32_t i = 0; i < GOLDEN_ELEMENTS; ++i)
+    {
+        int32_t e = quantized[i] - v->q8[i];
+        if (e < 0)
+            e = -e;
+        if (e > q_error)
+            q_error = e;
+    }
+    failures += report(v->name, "q8", (float)q_error, (float)GOLDEN_TOL_Q8);
+
+    return failures;
+}
+
+// fastest of GOLDEN_PERF_RUNS passes, per frame; float path includes normalize like AudioRecord
+static uint32_t ticks_per_frame(const int16_t *pcm, int fused)
+{
+    uint32_t best = UINT32_MAX;
+
+    for (uint16_t run = 0; run < GOLDEN_PERF_RUNS; ++run)
+    {
+        uint32_t start = profiler_now();
+        if (fused)
+        {
+            calculate_mel_spectrogram_q8(pcm, GOLDEN_N_SAMPLES, quantized, GOLDEN_N_FRAMES,
+                                         &golden_quant);
+        }
+        else
+        {
+            calculate_mel_spectrogram(pcm, GOLDEN_N_SAMPLES, spectrogram, GOLDEN_N_FRAMES);
+            normalize_spectrogram(spectrogram, GOLDEN_N_MELS, GOLDEN_N_FRAMES);
+        }
+        uint32_t ticks = (profiler_now() - start) / GOLDEN_N_FRAMES;
+        if (ticks < best)
+            best = ticks;
+    }
+    return best;
+}
+
+static int check_budget(void)
+{
+    int failures = 0;
+    const int16_t *pcm = golden_vectors[0].pcm;
+
+    for (int fused = 0; fused <= 1; ++fused)
+    {
+        uint32_t ticks = ticks_per_frame(pcm, fused);
+        int fail = ticks > GOLDEN_BUDGET_TICKS_PER_FRAME;
+        printf("golden %-12s %-11s %7lu ticks/frame, budget %7lu  %s\r\n", "perf",
+               fused ? "q8" : "float", (unsigned long)ticks,
+               (unsigned long)GOLDEN_BUDGET_TICKS_PER_FRAME, fail ? "FAIL" : "ok");
+        failures += fail;
+    }
+    return failures;
+}
+
+int golden_check_run(void)
+{
+    MelSpectrogramConfig_t config = golden_config;
+    int failures = 0;
+
+    mel_spectrogram_set_memory(state, sizeof(state), scratch, sizeof(scratch));
+    if (mel_spectrogram_init(&config) != 0)
+    {
+        printf("golden: mel engine init failed\r\n");
+        return 1;
+    }
+
+    failures += check_filterbank();
+    for (uint8_t i = 0; i < GOLDEN_N_VECTORS; ++i)
+        failures += check_vector(&golden_vectors[i]);
+    failures += check_budget();
+
+    printf("golden: %d check%s failed\r\n", failures, failures == 1 ? "" : "s");
+    return failures;
+}
@@ -25,6 +25,12 @@ SAI_HandleTypeDef hsai_BlockA4;
 DMA_HandleTypeDef hdma_sai4_a;
 UART_HandleTypeDef huart1; // For printf statements for debugging
 
+#if USE_DETECTION_LOG
+/* Detection log in the top of the QSPI flash */
+static NorFlash_t qspi_flash;
+static DetectionLog_t detection_log;
+#endif
+
 /* Function prototypes */
 static void SystemClock_Config(void);
 static void MPU_Config(void);
@@ -87,6 +93,8 @@ int _write(int file, char *ptr, int len)
  */
 int main(void)
 {
+    /* Fill the unused main stack so its high-water mark can be read later */
+    stack_monitor_paint();
 
     // memset(audio_buffer, 0xAA, sizeof(audio_buffer)); // Initialize buffer with known pattern
 
@@ -119,6 +127,24 @@ int main(void)
     /* Configure the system clock to 400 MHz */
     SystemClock_Config();
 
+    /* Cycle counter and per-stage timing table */
+    profiler_init();
+
+#if USE_GOLDEN_CHECK
+    /* Golden-vector accuracy and per-frame budget of the DSP path, results over ITM */
+    golden_check_run();
+#endif
+
+#if USE_DETECTION_LOG
+    /* Recover the write position from the sector headers */
+    if (qspi_nor_init(&qspi_flash, 0) != 0 ||
+        detection_log_mount(&detection_log, &qspi_flash, DETECTION_LOG_QSPI_OFFSET,
+                            DETECTION_LOG_QSPI_BYTES / qspi_flash.sector_size) != 0)
+        Error_Handler();
+    printf("log: sector %u slot %lu, next record %lu, %lu mount reads\r\n", detection_log.head,
+           (unsigned long)detection_log.head_slot, (unsigned long)detection_log.next_record_seq,
+           (unsigned long)detection_log.stats.reads);
+#endif
 
     /* When system initialization is finished, Cortex-M7 will release Cortex-M4 by means of
     HSEM notification */
@@ -135,10 +161,17 @@ int main(void)
         Error_Handler();
     }
 
+    /* Capture state shared with the audio interrupts, set up once */
+    AudioRecord_Init();
+
     /* Main application loop */
     while (1)
     {
         AudioRecord();
+        profiler_poll();
+#if USE_DETECTION_LOG
+        detection_log_service(&detection_log);
+#endif
         // printf("Audio Buffer Data:\r\n");
         // for (int i = 0; i < 10; i++)
         // {
@@ -0,0 +1,162 @@
+// mdma_transfer.c
+#include "mdma_transfer.h"
+#include "main.h"
+#include <stdint.h>
+#include <string.h>
+
+static MDMA_HandleTypeDef hmdma_transfer;
+// list items are fetched by the MDMA from memory, cleaned out of the cache before each start
+ALIGN_32BYTES(static MDMA_LinkNodeTypeDef transfer_nodes[DMA_CHAIN_MAX_SEGMENTS]);
+
+static DmaChain_t active_chain;
+static volatile uint8_t next_segment; // first segment whose callback has not run yet
+static volatile uint8_t transfer_busy;
+static uint32_t error_count;
+
+static void segment_init(const DmaSegment_t *seg, MDMA_InitTypeDef *init)
+{
+    // bursts only when both sides sit on 128-byte (one buffer transfer) boundaries
+    uint8_t burst = seg->width == 4 && ((seg->src | seg->dst) & 127u) == 0;
+
+    init->Request = MDMA_REQUEST_SW;
+    init->TransferTriggerMode = MDMA_FULL_TRANSFER; // one request runs the whole list
+    init->Priority = MDMA_PRIORITY_MEDIUM;
+    init->Endianness = MDMA_LITTLE_ENDIANNESS_PRESERVE;
+    init->DataAlignment = MDMA_DATAALIGN_PACKENABLE;
+    init->BufferTransferLength = 128;
+    init->SourceBurst = burst ? MDMA_SOURCE_BURST_32BEATS : MDMA_SOURCE_BURST_SINGLE;
+    init->DestBurst = burst ? MDMA_DEST_BURST_32BEATS : MDMA_DEST_BURST_SINGLE;
+    init->SourceBlockAddressOffset = 0;
+    init->DestBlockAddressOffset = 0;
+
+    switch (seg->width)
+    {
+    case 4:
+        init->SourceInc = MDMA_SRC_INC_WORD;
+        init->DestinationInc = MDMA_DEST_INC_WORD;
+        init->SourceDataSize = MDMA_SRC_DATASIZE_WORD;
+        init->DestDataSize = MDMA_DEST_DATASIZE_WORD;
+        break;
+    case 2:
+        init->SourceInc = MDMA_SRC_INC_HALFWORD;
+        init->DestinationInc = MDMA_DEST_INC_HALFWORD;
+        init->SourceDataSize = MDMA_SRC_DATASIZE_HALFWORD;
+        init->DestDataSize = MDMA_DEST_DATASIZE_HALFWORD;
+        break;
+    default:
+        init->SourceInc = MDMA_SRC_INC_BYTE;
+        init->DestinationInc = MDMA_DEST_INC_BYTE;
+        init->SourceDataSize = MDMA_SRC_DATASIZE_BYTE;
+        init->DestDataSize = MDMA_DEST_DATASIZE_BYTE;
+        break;
+    }
+}
+
+// runs the callbacks of every segment up to and including last
+static void complete_segments(uint8_t last)
+{
+    while (next_segment <= last && next_segment < active_chain.n_segments)
+    {
+        const DmaSegment_t *seg = &active_chain.segments[next_segment++];
+        if (seg->done)
+            seg->done(seg->ctx);
+    }
+}
+
+// each list item is one block, so block completions arrive in segment order
+static void block_done(MDMA_HandleTypeDef *hmdma)
+{
+    (void)hmdma;
+    complete_segments(next_segment);
+}
+
+static void chain_done(MDMA_HandleTypeDef *hmdma)
+{
+    (void)hmdma;
+    complete_segments(active_chain.n_segments - 1);
+    transfer_busy = 0;
+}
+
+static void chain_error(MDMA_HandleTypeDef *hmdma)
+{
+    (void)hmdma;
+    error_count++;
+    transfer_busy = 0;
+}
+
+int mdma_transfer_init(void)
+{
+    __HAL_RCC_MDMA_CLK_ENABLE();
+
+    hmdma_transfer.Instance = MDMA_TRANSFER_CHANNEL;
+    transfer_busy = 0;
+    error_count = 0;
+
+    HAL_NVIC_SetPriority(MDMA_IRQn, MDMA_TRANSFER_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(MDMA_IRQn);
+    return 0;
+}
+
+// programs active_chain: the channel registers hold the first segment, the rest follow as list
+// items
+static int start_chain(void)
+{
+    const DmaSegment_t *first = &active_chain.segments[0];
+
+    HAL_MDMA_DeInit(&hmdma_transfer); // also drops the previous list
+    hmdma_transfer.Instance = MDMA_TRANSFER_CHANNEL;
+    segment_init(first, &hmdma_transfer.Init);
+    if (HAL_MDMA_Init(&hmdma_transfer) != HAL_OK)
+        return -1;
+
+    hmdma_transfer.XferBlockCpltCallback = block_done;
+    hmdma_transfer.XferCpltCallback = chain_done;
+    hmdma_transfer.XferErrorCallback = chain_error;
+
+    for (uint8_t i = 1; i < active_chain.n_segments; ++i)
+    {
+        const DmaSegment_t *seg = &active_chain.segments[i];
+        MDMA_LinkNodeConfTypeDef node;
+
+        memset(&node, 0, sizeof(node));
+        segment_init(seg, &node.Init);
+        node.SrcAddress = (uint32_t)seg->src;
+        node.DstAddress = (uint32_t)seg->dst;
+        node.BlockDataLength = seg->len;
+        node.BlockCount = 1;
+
+        if (HAL_MDMA_LinkedList_CreateNode(&transfer_nodes[i - 1], &node) != HAL_OK ||
+            HAL_MDMA_LinkedList_AddNode(&hmdma_transfer, &transfer_nodes[i - 1], NULL) != HAL_OK)
+            return -1;
+    }
+    SCB_CleanDCache_by_Addr((uint32_t *)transfer_nodes, sizeof(transfer_nodes));
+
+    if (HAL_MDMA_Start_IT(&hmdma_transfer, (uint32_t)first->src, (uint32_t)first->dst, first->len,
+                          1) != HAL_OK)
+        return -1;
+    return 0;
+}
+
+int mdma_transfer_submit(const DmaChain_t *chain)
+{
+    if (!chain || chain->n_segments == 0 || transfer_busy)
+        return -1;
+
+    transfer_busy = 1;
+    memcpy(&active_chain, chain, sizeof(DmaChain_t));
+    next_segment = 0;
+
+    if (start_chain() != 0)
+    {
+        error_count++;
+        transfer_busy = 0;
+        return -1;
+    }
+    return 0;
+}
+
+uint8_t mdma_transfer_busy(void) { return transfer_busy; }
+
+uint32_t mdma_transfer_errors(void) { return error_count; }
+
+ITCM_FUNC void mdma_transfer_irq(void) { HAL_MDMA_IRQHandler(&hmdma_transfer); }
@@ -29,6 +29,43 @@ static float mel_to_hz(float mel) {
 }
 */
 
+// mel spaced triangle corners, evaluated on demand so no per-band table sits on the stack
+typedef struct
+{
+    float mel_min;
+    float mel_step;
+    float sample_rate;
+    uint16_t n_fft;
+} MelCorners_t;
+
+static void mel_corners_init(MelCorners_t *c, uint16_t n_mels, uint16_t n_fft, float sample_rate,
+                             float f_min, float f_max)
+{
+    float mel_min = hz_to_mel(f_min);
+    float mel_max = hz_to_mel(f_max);
+
+    c->mel_min = mel_min;
+    c->mel_step = (mel_max - mel_min) / (n_mels + 1);
+    c->sample_rate = sample_rate;
+    c->n_fft = n_fft;
+}
+
+// FFT bin of corner i (0 .. n_mels + 1)
+static uint16_t mel_corner_bin(const MelCorners_t *c, uint16_t i)
+{
+    float hz = mel_to_hz(c->mel_min + i * c->mel_step);
+    return (uint16_t)((hz / c->sample_rate) * c->n_fft);
+}
+
+// weight of bin k in the triangle (left, center, right)
+static float triangle_weight(uint16_t k, uint16_t left, uint16_t center, uint16_t right)
+{
+    // denominators prevent division by zero
+    if (k < center)
+        return (k - left) / (center - left + 1e-6f);
+    return (right - k) / (right - center + 1e-6f);
+}
+
 // main function to create filterbank
 void create_mel_filterbank(float *filterbank, uint16_t n_mels, uint16_t n_fft, float sample_rate,
                            float f_min, float f_max)
@@ -38,40 +75,82 @@ void create_mel_filterbank(float *filterbank, uint16_t n_mels, uint16_t n_fft, f
     // zero out the filterbank output
     memset(filterbank, 0, sizeof(float) * n_mels * fft_bins);
 
-    float mel_min = hz_to_mel(f_min);
-    float mel_max = hz_to_mel(f_max);
-    float mel_step = (mel_max - mel_min) / (n_mels + 1);
+    MelCorners_t corners;
+    mel_corners_init(&corners, n_mels, n_fft, sample_rate, f_min, f_max);
 
-    float mel_points[MAX_MEL_BANDS + 2]; // Fixed size array (e.g., 130 max)
-    float bin_points[MAX_MEL_BANDS + 2];
+    // create triangular filters
+    uint16_t left = mel_corner_bin(&corners, 0);
+    uint16_t center = mel_corner_bin(&corners, 1);
+    for (uint16_t m = 0; m < n_mels; ++m)
+    {
+        uint16_t right = mel_corner_bin(&corners, m + 2);
+
+        // fill the filterbank for this mel band
+        for (uint16_t k = left; k < right && k < fft_bins; ++k)
+        {
+            filterbank[m * fft_bins + k] = triangle_weight(k, left, center, right);
+        }
 
-    // calculate mel spaced frequency points
-    for (uint16_t i = 0; i < n_mels + 2; ++i)
+        left = center;
+        center = right;
+    }
+}
+
+uint32_t sparse_mel_filterbank_size(uint16_t n_mels, uint16_t n_fft, float sample_rate,
+                                    float f_min, float f_max)
+{
+    uint16_t fft_bins = n_fft / 2 + 1;
+    uint32_t n_weights = 0;
+
+    MelCorners_t corners;
+    mel_corners_init(&corners, n_mels, n_fft, sample_rate, f_min, f_max);
+
+    uint16_t left = mel_corner_bin(&corners, 0);
+    uint16_t center = mel_corner_bin(&corners, 1);
+    for (uint16_t m = 0; m < n_mels; ++m)
     {
-        mel_points[i] = mel_min + i * mel_step;
-        float hz = mel_to_hz(mel_points[i]);
-        bin_points[i] = (hz / sample_rate) * n_fft;
+        uint16_t right = mel_corner_bin(&corners, m + 2);
+        uint16_t end = (right < fft_bins) ? right : fft_bins;
+
+        if (end > left)
+            n_weights += end - left;
+
+        left = center;
+        center = right;
     }
 
-    // create triangular filters
+    return n_weights;
+}
+
+uint32_t create_sparse_mel_filterbank(MelBand_t *bands, float *weights, uint16_t n_mels,
+                                      uint16_t n_fft, float sample_rate, float f_min, float f_max)
+{
+    uint16_t fft_bins = n_fft / 2 + 1;
+    uint32_t n_weights = 0;
+
+    MelCorners_t corners;
+    mel_corners_init(&corners, n_mels, n_fft, sample_rate, f_min, f_max);
+
+    uint16_t left = mel_corner_bin(&corners, 0);
+    uint16_t center = mel_corner_bin(&corners, 1);
     for (uint16_t m = 0; m < n_mels; ++m)
     {
-        uint16_t left = (uint16_t)bin_points[m];
-        uint16_t center = (uint16_t)bin_points[m + 1];
-        uint16_t right = (uint16_t)bin_points[m + 2];
+        uint16_t right = mel_corner_bin(&corners, m + 2);
+        uint16_t end = (right < fft_bins) ? right : fft_bins;
 
-        // denominators prevent division by zero
-        float denom_left = center - left + 1e-6f;
-        float denom_right = right - center + 1e-6f;
+        bands[m].first_bin = left;
+        bands[m].n_bins = (end > left) ? end - left : 0;
+        bands[m].offset = (uint16_t)n_weights;
 
-        // fill the filterbank for this mel band
-        for (uint16_t k = left; k < center && k < fft_bins; ++k)
-        {
-            filterbank[m * fft_bins + k] = (k - left) / denom_left;
-        }
-        for (uint16_t k = center; k < right && k < fft_bins; ++k)
+        // same values as the dense bank over [left, right), zeros outside are dropped
+        for (uint16_t k = left; k < end; ++k)
         {
-            filterbank[m * fft_bins + k] = (right - k) / denom_right;
+            weights[n_weights++] = triangle_weight(k, left, center, right);
         }
+
+        left = center;
+        center = right;
     }
+
+    return n_weights;
 }
@@ -0,0 +1,116 @@
+// mel_project.c
+#include "mel_project.h"
+#include "mem_placement.h"
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#endif
+
+// called once per batch from the ITCM mel path
+ITCM_FUNC void mel_project_f32(const MelBand_t *bands, const float *weights, uint16_t n_mels,
+                               const float *power, uint32_t power_stride, uint16_t n_frames,
+                               float *energy)
+{
+    for (uint16_t m = 0; m < n_mels; ++m)
+    {
+        const float *w = weights + bands[m].offset;
+        const float *span = power + bands[m].first_bin;
+        const uint16_t n_bins = bands[m].n_bins;
+        uint16_t f = 0;
+
+        // four frames per pass share every weight load
+        for (; f + 4 <= n_frames; f += 4)
+        {
+            const float *p0 = span + (uint32_t)f * power_stride;
+            const float *p1 = p0 + power_stride;
+            const float *p2 = p1 + power_stride;
+            const float *p3 = p2 + power_stride;
+            float e0 = 0.0f, e1 = 0.0f, e2 = 0.0f, e3 = 0.0f;
+            for (uint16_t k = 0; k < n_bins; ++k)
+            {
+                const float wk = w[k];
+                e0 += p0[k] * wk;
+                e1 += p1[k] * wk;
+                e2 += p2[k] * wk;
+                e3 += p3[k] * wk;
+            }
+            energy[(uint32_t)f * n_mels + m] = e0;
+            energy[(uint32_t)(f + 1) * n_mels + m] = e1;
+            energy[(uint32_t)(f + 2) * n_mels + m] = e2;
+            energy[(uint32_t)(f + 3) * n_mels + m] = e3;
+        }
+        for (; f < n_frames; ++f)
+        {
+            const float *p = span + (uint32_t)f * power_stride;
+            float e = 0.0f;
+            for (uint16_t k = 0; k < n_bins; ++k)
+                e += p[k] * w[k];
+            energy[(uint32_t)f * n_mels + m] = e;
+        }
+    }
+}
+
+void mel_weights_to_q15(const float *weights, int16_t *weights_q15, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        float q = weights[i] * 32768.0f;
+        if (q >= 32767.0f)
+            weights_q15[i] = 32767;
+        else if (q <= -32768.0f)
+            weights_q15[i] = -32768;
+        else
+            weights_q15[i] = (int16_t)(q >= 0.0f ? q + 0.5f : q - 0.5f);
+    }
+}
+
+// Q30 sum -> Q15, rounded and saturated to 32 bits
+static inline int32_t q30_to_q15(int64_t acc)
+{
+    acc = (acc + 0x4000) >> 15;
+    if (acc > INT32_MAX)
+        return INT32_MAX;
+    if (acc < INT32_MIN)
+        return INT32_MIN;
+    return (int32_t)acc;
+}
+
+static inline int64_t dot_q15(const int16_t *p, const int16_t *w, uint16_t n)
+{
+    int64_t acc = 0;
+    uint16_t k = 0;
+
+#if defined(__ARM_FEATURE_DSP)
+    // two bins per 32-bit load; the M7 takes unaligned word accesses to normal memory
+    for (; k + 4 <= n; k += 4)
+    {
+        uint32_t p01, p23, w01, w23;
+        memcpy(&p01, p + k, 4);
+        memcpy(&p23, p + k + 2, 4);
+        memcpy(&w01, w + k, 4);
+        memcpy(&w23, w + k + 2, 4);
+        acc = __smlald(p01, w01, acc);
+        acc = __smlald(p23, w23, acc);
+    }
+#endif
+    for (; k < n; ++k)
+        acc += (int32_t)p[k] * w[k];
+    return acc;
+}
+
+void mel_project_q15(const MelBand_t *bands, const int16_t *weights_q15, uint16_t n_mels,
+                     const int16_t *power_q15, uint32_t power_stride, uint16_t n_frames,
+                     int32_t *energy)
+{
+    for (uint16_t m = 0; m < n_mels; ++m)
+    {
+        const int16_t *w = weights_q15 + bands[m].offset;
+        const int16_t *span = power_q15 + bands[m].first_bin;
+
+        for (uint16_t f = 0; f < n_frames; ++f)
+            energy[(uint32_t)f * n_mels + m] =
+                q30_to_q15(dot_q15(span + (uint32_t)f * power_stride, w, bands[m].n_bins));
+    }
+}
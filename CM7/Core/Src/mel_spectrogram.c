@@ -1,7 +1,14 @@
 // mel_spectrogram.c
 #include "mel_spectrogram.h"
 #include "arm_math.h"
+#include "frame_prep.h"
 #include "mel_filterbank.h"
+#include "mel_project.h"
+#include "mem_placement.h"
+#include "mfcc.h"
+#include "noise_floor.h"
+#include "profiler.h"
+#include <math.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -12,113 +19,410 @@
 #define LOG10_OFFSET 1e-6f
 #define MIN_DB_LEVEL -80.0f // tune?
 
-static MelSpectrogramConfig_t cfg;
+// 1 gives every thread its own engine (host/CMakeLists.txt sets it for the threaded batch
+// extractor); the firmware build keeps the single instance
+#ifndef MEL_ENGINE_PER_THREAD
+#define MEL_ENGINE_PER_THREAD 0
+#endif
+
+#if MEL_ENGINE_PER_THREAD
+#define ENGINE_LOCAL _Thread_local
+#else
+#define ENGINE_LOCAL
+#endif
+
+static ENGINE_LOCAL MelSpectrogramConfig_t cfg;
 
 // USE FOR STM32
-static arm_rfft_fast_instance_f32 fft_instance;
-// internal buffers
-static float window_buffer[MAX_FFT_SIZE];
-// __attribute__((section(".sdram_data")))
-static float mel_filters[MAX_MEL_BANDS * (MAX_FFT_SIZE / 2 + 1)];
+static ENGINE_LOCAL arm_rfft_fast_instance_f32 fft_instance DTCM_BSS;
+// sparse filterbank band table, weights live in the caller's state buffer
+static ENGINE_LOCAL MelBand_t mel_bands[MAX_MEL_BANDS] DTCM_BSS;
+// internal buffers, sized from the config and owned by the caller (see tensor_arena.h)
+// nothing frame-sized lives on the stack
+static ENGINE_LOCAL float *window_buffer;
+static ENGINE_LOCAL float *mel_filters;
+static ENGINE_LOCAL float *fft_buffer;
+static ENGINE_LOCAL float *power_spectrum;
+
+// frames per mel projection, resolved from the config by mel_spectrogram_init
+static ENGINE_LOCAL uint16_t batch;
+// optional noise tracker on the band energies, caller-owned, detached by mel_spectrogram_init
+static ENGINE_LOCAL NoiseFloor_t *noise_floor;
+// optional per-frame capture gain in dB to take back out of the band energies, caller-owned
+static ENGINE_LOCAL const float *gain_db;
+static ENGINE_LOCAL uint16_t gain_frames;
+
+static ENGINE_LOCAL uint32_t state_size;
+static ENGINE_LOCAL uint32_t scratch_size;
+
+// frames per batch for a config, 0 if out of range
+// the batch's mel columns go to the FFT buffer, so at most fft_size / n_mels of them
+static uint16_t batch_frames(const MelSpectrogramConfig_t *config)
+{
+    uint16_t n_batch = config->batch ? config->batch : MEL_DEFAULT_BATCH;
+    if (n_batch > MEL_MAX_BATCH)
+        return 0;
+    if (config->n_mels && n_batch > config->fft_size / config->n_mels)
+        n_batch = config->fft_size / config->n_mels;
+    return n_batch;
+}
+
+int mel_spectrogram_workspace_size(const MelSpectrogramConfig_t *config, uint32_t *state_bytes,
+                                   uint32_t *scratch_bytes)
+{
+    if (!config || config->fft_size > MAX_FFT_SIZE || config->n_mels > MAX_MEL_BANDS ||
+        config->n_mels > config->fft_size)
+        return -1;
+
+    const uint16_t n_batch = batch_frames(config);
+    if (n_batch == 0)
+        return -1;
+
+    const uint32_t fft_bins = config->fft_size / 2 + 1;
+    const uint32_t weights = sparse_mel_filterbank_size(
+        config->n_mels, config->fft_size, config->sample_rate, config->f_min, config->f_max);
+
+    if (state_bytes)
+        *state_bytes = (config->fft_size + weights) * sizeof(float);
+    if (scratch_bytes)
+        *scratch_bytes = (config->fft_size + n_batch * fft_bins) * sizeof(float);
+    return 0;
+}
+
+void mel_spectrogram_set_memory(float *state, uint32_t state_bytes, float *scratch,
+                                uint32_t scratch_bytes)
+{
+    window_buffer = state;
+    state_size = state_bytes;
+    fft_buffer = scratch;
+    scratch_size = scratch_bytes;
+}
 
 int mel_spectrogram_init(MelSpectrogramConfig_t *config)
 {
-    if (!config)
+    uint32_t state_bytes, scratch_bytes;
+
+    if (!config || !window_buffer || !fft_buffer)
         return -1;
     memcpy(&cfg, config, sizeof(MelSpectrogramConfig_t));
 
-    if (cfg.fft_size > MAX_FFT_SIZE || cfg.n_mels > MAX_MEL_BANDS)
+    // the FFT buffer doubles as the batch's mel columns once the power spectra are taken
+    if (mel_spectrogram_workspace_size(&cfg, &state_bytes, &scratch_bytes) != 0)
+        return -1;
+
+    // the caller's buffers must hold exactly what this config needs
+    if (state_size < state_bytes || scratch_size < scratch_bytes)
         return -1;
 
     if (arm_rfft_fast_init_f32(&fft_instance, cfg.fft_size) != ARM_MATH_SUCCESS)
         return -2;
 
+    mel_filters = window_buffer + cfg.fft_size;
+    power_spectrum = fft_buffer + cfg.fft_size;
+    batch = batch_frames(&cfg);
+    noise_floor = NULL;
+    gain_db = NULL;
+    gain_frames = 0;
+
     // STM32 , called in mel_filterbank.c
     // arm_rfft_fast_init_f32(&fft_instance, cfg.fft_size);
 
-    // create Hann window
+    // create Hann window, pre-scaled by 1/32768 for the int16 input
     for (int i = 0; i < cfg.fft_size; ++i)
     {
         window_buffer[i] = 0.5f * (1.0f - arm_cos_f32(2.0f * PI * i / (cfg.fft_size - 1)));
     }
+    frame_prep_scale_window(window_buffer, cfg.fft_size);
 
-    // create Mel filterbank
-    create_mel_filterbank(mel_filters, cfg.n_mels, cfg.fft_size, cfg.sample_rate, cfg.f_min,
-                          cfg.f_max);
+    // create Mel filterbank, nonzero spans only
+    create_sparse_mel_filterbank(mel_bands, mel_filters, cfg.n_mels, cfg.fft_size,
+                                 cfg.sample_rate, cfg.f_min, cfg.f_max);
 
     return 0;
 }
 
-// run STFT + apply Mel filterbank
-// converts PCM data to mel spectrogram
-int calculate_mel_spectrogram(const int16_t *pcm_data, uint32_t pcm_size, float *spectrogram,
-                              uint16_t spec_cols_max)
+int mel_spectrogram_set_noise_floor(NoiseFloor_t *nf)
+{
+    if (nf && nf->config.n_bands != cfg.n_mels)
+        return -1;
+    noise_floor = nf;
+    return 0;
+}
+
+int mel_spectrogram_set_gain_db(const float *gain, uint16_t n_frames)
 {
-    if (!pcm_data || !spectrogram)
+    if (gain && n_frames == 0)
         return -1;
+    gain_db = gain;
+    gain_frames = gain ? n_frames : 0;
+    return 0;
+}
+
+// frames of the STFT for a PCM buffer, capped at spec_cols_max
+static uint16_t frame_count(uint32_t pcm_size, uint16_t spec_cols_max)
+{
+    if (pcm_size < cfg.fft_size)
+        return 0;
 
+    uint32_t n_frames = (pcm_size - cfg.fft_size) / cfg.hop_length + 1;
+    return (n_frames > spec_cols_max) ? spec_cols_max : (uint16_t)n_frames;
+}
+
+// window + FFT + power spectrum of one frame into power
+ITCM_FUNC static void power_frame(const int16_t *pcm_data, uint32_t pcm_size, uint32_t offset,
+                                  float *power)
+{
     const uint16_t n_fft = cfg.fft_size;
-    const uint16_t hop = cfg.hop_length;
     const uint16_t fft_bins = n_fft / 2 + 1;
-    uint16_t n_frames = (pcm_size - n_fft) / hop + 1;
 
-    if (n_frames > spec_cols_max)
-        n_frames = spec_cols_max;
+    // frame with window, zero-padded past the end of the buffer
+    PROF_BEGIN(PROF_WINDOW);
+    frame_prep_f32(pcm_data + offset, offset < pcm_size ? pcm_size - offset : 0, window_buffer,
+                   fft_buffer, n_fft);
+    PROF_END(PROF_WINDOW);
+
+    // real FFT using CMSIS-DSP
+    PROF_BEGIN(PROF_FFT);
+    arm_rfft_fast_f32(&fft_instance, fft_buffer, fft_buffer, 0);
+    PROF_END(PROF_FFT);
+
+    // power spectrum; the packed RFFT output carries the real DC and Nyquist terms in its
+    // first complex slot, bins 1 .. n_fft/2 - 1 follow as re, im pairs
+    PROF_BEGIN(PROF_POWER);
+    power[0] = fft_buffer[0] * fft_buffer[0];
+    power[fft_bins - 1] = fft_buffer[1] * fft_buffer[1];
+    arm_cmplx_mag_squared_f32(fft_buffer + 2, power + 1, fft_bins - 2);
+    PROF_END(PROF_POWER);
+}
+
+// STFT + mel projection of n_batch consecutive frames starting at first_frame
+// returns n_batch columns of n_mels linear band energies, stored in the (then free) FFT buffer
+ITCM_FUNC static const float *mel_batch(const int16_t *pcm_data, uint32_t pcm_size,
+                                        uint16_t first_frame, uint16_t n_batch)
+{
+    const uint16_t fft_bins = cfg.fft_size / 2 + 1;
+    const uint16_t n_mels = cfg.n_mels;
+
+    for (uint16_t b = 0; b < n_batch; ++b)
+        power_frame(pcm_data, pcm_size, (uint32_t)(first_frame + b) * cfg.hop_length,
+                    power_spectrum + (uint32_t)b * fft_bins);
+
+    // sparse filterbank x batch of spectra, each weight loaded once per four frames
+    PROF_BEGIN(PROF_MEL);
+    float *mel_energy = fft_buffer;
+    mel_project_f32(mel_bands, mel_filters, n_mels, power_spectrum, fft_bins, n_batch, mel_energy);
+    PROF_END(PROF_MEL);
+
+    // capture gain back out, so the floor and the dB range see the unamplified level
+    if (gain_db)
+    {
+        for (uint16_t b = 0; b < n_batch; ++b)
+        {
+            const uint16_t frame = first_frame + b;
+            const float g = gain_db[(frame < gain_frames) ? frame : gain_frames - 1];
+            const float scale = powf(10.0f, -0.1f * g);
+            float *column = mel_energy + (uint32_t)b * n_mels;
+            for (uint16_t m = 0; m < n_mels; ++m)
+                column[m] *= scale;
+        }
+    }
+
+    // floor tracking and subtraction in frame order, before any log
+    if (noise_floor)
+    {
+        PROF_BEGIN(PROF_NOISE);
+        noise_floor_update_f32(noise_floor, mel_energy, n_batch);
+        PROF_END(PROF_NOISE);
+    }
+
+    return mel_energy;
+}
+
+// run STFT + apply Mel filterbank
+// converts PCM data to mel spectrogram
+ITCM_FUNC int calculate_mel_spectrogram(const int16_t *pcm_data, uint32_t pcm_size,
+                                        float *spectrogram, uint16_t spec_cols_max)
+{
+    if (!pcm_data || !spectrogram || !mel_filters)
+        return -1;
 
-    // input to CMSIS FFT
-    float fft_buffer[MAX_FFT_SIZE];
-    float power_spectrum[MAX_FFT_SIZE / 2 + 1];
+    const uint16_t n_frames = frame_count(pcm_size, spec_cols_max);
 
-    for (uint16_t frame = 0; frame < n_frames; ++frame)
+    for (uint16_t first = 0; first < n_frames; first += batch)
     {
-        uint32_t offset = frame * hop;
+        const uint16_t n_batch = (n_frames - first < batch) ? n_frames - first : batch;
+        const float *mel_energy = mel_batch(pcm_data, pcm_size, first, n_batch);
 
-        // frame with window
-        for (uint16_t i = 0; i < n_fft; ++i)
+        PROF_BEGIN(PROF_LOG);
+        for (uint16_t b = 0; b < n_batch; ++b)
         {
-            if (offset + i < pcm_size)
-                fft_buffer[i] = (pcm_data[offset + i] / 32768.0f) * window_buffer[i];
-            else
-                fft_buffer[i] = 0.0f;
+            const uint16_t frame = first + b;
+            for (uint16_t m = 0; m < cfg.n_mels; ++m)
+            {
+                float log_energy = 10.0f * log10f(mel_energy[b * cfg.n_mels + m] + LOG10_OFFSET);
+                if (log_energy < MIN_DB_LEVEL)
+                    log_energy = MIN_DB_LEVEL;
+                spectrogram[m * n_frames + frame] = log_energy;
+            }
         }
+        PROF_END(PROF_LOG);
+    }
 
-        // real FFT using CMSIS-DSP
-        arm_rfft_fast_f32(&fft_instance, fft_buffer, fft_buffer, 0);
+    return n_frames;
+}
 
-        // power spectrum from real + imag
-        // DC comp
-        power_spectrum[0] = fft_buffer[0] * fft_buffer[0];
-        for (uint16_t i = 1; i < fft_bins - 1; ++i)
+// scatter one feature column into the [feature][frame] output
+static inline void store_column(const float *column, uint16_t n_features, float *features,
+                                uint16_t frame, uint16_t n_frames)
+{
+    for (uint16_t c = 0; c < n_features; ++c)
+        features[(uint32_t)c * n_frames + frame] = column[c];
+}
+
+// STFT + mel + log as in calculate_mel_spectrogram, then each dB column through the MFCC stage
+int calculate_mfcc(const int16_t *pcm_data, uint32_t pcm_size, Mfcc_t *mfcc, float *features,
+                   uint16_t spec_cols_max)
+{
+    if (!pcm_data || !mfcc || !features || !mel_filters || mfcc->config.n_mels != cfg.n_mels)
+        return -1;
+
+    const uint16_t n_frames = frame_count(pcm_size, spec_cols_max);
+    const uint16_t n_mels = cfg.n_mels;
+    const uint16_t n_features = mfcc_n_features(&mfcc->config);
+
+    // feature columns are staged in the power spectra, free once a batch is projected
+    if ((uint32_t)n_features > (uint32_t)batch * (cfg.fft_size / 2 + 1))
+        return -1;
+    float *column = power_spectrum;
+    uint16_t out = 0;
+
+    mfcc_reset(mfcc);
+    for (uint16_t first = 0; first < n_frames; first += batch)
+    {
+        const uint16_t n_batch = (n_frames - first < batch) ? n_frames - first : batch;
+        mel_batch(pcm_data, pcm_size, first, n_batch);
+
+        // dB in place over the batch's mel columns
+        PROF_BEGIN(PROF_LOG);
+        float *log_mel = fft_buffer;
+        for (uint32_t i = 0; i < (uint32_t)n_batch * n_mels; ++i)
         {
-            float re = fft_buffer[2 * i];
-            float im = fft_buffer[2 * i + 1];
-            power_spectrum[i] = re * re + im * im;
+            float log_energy = 10.0f * log10f(log_mel[i] + LOG10_OFFSET);
+            log_mel[i] = (log_energy < MIN_DB_LEVEL) ? MIN_DB_LEVEL : log_energy;
         }
-        // nyquist component
-        power_spectrum[fft_bins - 1] = fft_buffer[1] * fft_buffer[1]; // Nyquist
+        PROF_END(PROF_LOG);
+
+        PROF_BEGIN(PROF_MFCC);
+        for (uint16_t b = 0; b < n_batch; ++b)
+        {
+            if (mfcc_push(mfcc, log_mel + (uint32_t)b * n_mels, column))
+                store_column(column, n_features, features, out++, n_frames);
+        }
+        PROF_END(PROF_MFCC);
+    }
+
+    // columns held back by the delta window, last frame repeated past the end
+    PROF_BEGIN(PROF_MFCC);
+    while (mfcc_flush(mfcc, column))
+        store_column(column, n_features, features, out++, n_frames);
+    PROF_END(PROF_MFCC);
+
+    return n_frames;
+}
+
+// log2 from the float exponent plus a cubic fit of log2 on the mantissa
+// max error 1.3e-3 (0.004 dB), well below one int8 step of the model input
+static inline float fast_log2(float x)
+{
+    union
+    {
+        float f;
+        uint32_t i;
+    } v = {x};
+
+    float exponent = (float)((int32_t)((v.i >> 23) & 0xff) - 127);
+    v.i = (v.i & 0x007fffffu) | 0x3f800000u; // mantissa in [1, 2)
+    float m = v.f;
+
+    return exponent + ((0.15391848f * m - 1.0295219f) * m + 3.010784f) * m - 2.1338477f;
+}
+
+static inline int8_t quantize_db(float log2_energy, float gain, float bias, float q_lo, float q_hi)
+{
+    float q = gain * log2_energy + bias;
+    if (q < q_lo)
+        q = q_lo;
+    else if (q > q_hi)
+        q = q_hi;
+    return (int8_t)(q >= 0.0f ? q + 0.5f : q - 0.5f);
+}
+
+ITCM_FUNC int calculate_mel_spectrogram_q8(const int16_t *pcm_data, uint32_t pcm_size,
+                                           int8_t *output, uint16_t spec_cols_max,
+                                           const MelQuantParams_t *quant)
+{
+    if (!pcm_data || !output || !quant || !mel_filters || quant->scale <= 0.0f ||
+        quant->db_ceil <= quant->db_floor)
+        return -1;
 
-        // apply Mel filterbank
-        for (uint16_t m = 0; m < cfg.n_mels; ++m)
+    const uint16_t n_frames = frame_count(pcm_size, spec_cols_max);
+    const uint16_t n_mels = cfg.n_mels;
+
+    // dB -> [0, 1] -> int8 folded into one affine map of log2(energy)
+    // q = zp + (10 * log10(2) * log2(e) - floor) / ((ceil - floor) * scale)
+    const float inv_span = 1.0f / ((quant->db_ceil - quant->db_floor) * quant->scale);
+    const float gain = 3.0103f * inv_span;
+    const float bias = quant->zero_point - quant->db_floor * inv_span;
+
+    // clamping in the quantized domain equals clamping dB to [floor, ceil]
+    float q_lo = (float)quant->zero_point;
+    float q_hi = quant->zero_point + 1.0f / quant->scale;
+    if (q_lo < -128.0f)
+        q_lo = -128.0f;
+    if (q_hi > 127.0f)
+        q_hi = 127.0f;
+
+    for (uint16_t first = 0; first < n_frames; first += batch)
+    {
+        const uint16_t n_batch = (n_frames - first < batch) ? n_frames - first : batch;
+        const float *batch_energy = mel_batch(pcm_data, pcm_size, first, n_batch);
+
+        // log, normalize and quantize in one pass
+        PROF_BEGIN(PROF_QUANTIZE);
+        for (uint16_t b = 0; b < n_batch; ++b)
         {
-            float mel_energy = 0.0f;
-            for (uint16_t k = 0; k < fft_bins; ++k)
+            const float *mel_energy = batch_energy + (uint32_t)b * n_mels;
+            int8_t *out = output + first + b;
+            uint16_t m = 0;
+
+            // one pass per column, four bands per iteration
+            for (; m + 4 <= n_mels; m += 4)
             {
-                mel_energy += power_spectrum[k] * mel_filters[m * fft_bins + k];
+                float l0 = fast_log2(mel_energy[m] + LOG10_OFFSET);
+                float l1 = fast_log2(mel_energy[m + 1] + LOG10_OFFSET);
+                float l2 = fast_log2(mel_energy[m + 2] + LOG10_OFFSET);
+                float l3 = fast_log2(mel_energy[m + 3] + LOG10_OFFSET);
+                out[(uint32_t)m * n_frames] = quantize_db(l0, gain, bias, q_lo, q_hi);
+                out[(uint32_t)(m + 1) * n_frames] = quantize_db(l1, gain, bias, q_lo, q_hi);
+                out[(uint32_t)(m + 2) * n_frames] = quantize_db(l2, gain, bias, q_lo, q_hi);
+                out[(uint32_t)(m + 3) * n_frames] = quantize_db(l3, gain, bias, q_lo, q_hi);
+            }
+            for (; m < n_mels; ++m)
+            {
+                float l = fast_log2(mel_energy[m] + LOG10_OFFSET);
+                out[(uint32_t)m * n_frames] = quantize_db(l, gain, bias, q_lo, q_hi);
             }
-
-            float log_energy = 10.0f * log10f(mel_energy + LOG10_OFFSET);
-            if (log_energy < MIN_DB_LEVEL)
-                log_energy = MIN_DB_LEVEL;
-            spectrogram[m * n_frames + frame] = log_energy;
         }
+        PROF_END(PROF_QUANTIZE);
     }
 
     return n_frames;
 }
 
 // Finds min and max in mel matrix and scales to [0, 1]
-void normalize_spectrogram(float *spectrogram, uint16_t n_mels, uint16_t n_frames)
+ITCM_FUNC void normalize_spectrogram(float *spectrogram, uint16_t n_mels, uint16_t n_frames)
 {
+    PROF_BEGIN(PROF_NORMALIZE);
     float min = spectrogram[0], max = spectrogram[0];
 
     for (uint32_t i = 0; i < n_mels * n_frames; ++i)
@@ -133,11 +437,13 @@ void normalize_spectrogram(float *spectrogram, uint16_t n_mels, uint16_t n_frame
     if (range == 0.0f)
     {
         memset(spectrogram, 0, n_mels * n_frames * sizeof(float));
-        return;
     }
-
-    for (uint32_t i = 0; i < n_mels * n_frames; ++i)
+    else
     {
-        spectrogram[i] = (spectrogram[i] - min) / range;
+        for (uint32_t i = 0; i < n_mels * n_frames; ++i)
+        {
+            spectrogram[i] = (spectrogram[i] - min) / range;
+        }
     }
+    PROF_END(PROF_NORMALIZE);
 }
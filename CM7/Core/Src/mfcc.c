@@ -0,0 +1,167 @@
+// mfcc.c
+#include "mfcc.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#define MFCC_PI 3.14159265358979323846
+
+uint16_t mfcc_n_features(const MfccConfig_t *config)
+{
+    return (uint16_t)(config->n_mfcc * (config->delta_order + 1));
+}
+
+static uint16_t ring_length(const MfccConfig_t *config)
+{
+    return (uint16_t)(2u * config->delta_order * config->delta_width + 1u);
+}
+
+uint32_t mfcc_workspace_size(const MfccConfig_t *config)
+{
+    if (!config || config->n_mels == 0 || config->n_mfcc == 0 ||
+        config->n_mfcc > MFCC_MAX_COEFFS || config->n_mfcc > config->n_mels ||
+        config->delta_order > MFCC_MAX_DELTA_ORDER || config->lifter < 0.0f)
+        return 0;
+    if (config->delta_order &&
+        (config->delta_width == 0 || config->delta_width > MFCC_MAX_DELTA_WIDTH))
+        return 0;
+
+    return ((uint32_t)config->n_mfcc * config->n_mels +
+            (uint32_t)ring_length(config) * config->n_mfcc) *
+           sizeof(float);
+}
+
+int mfcc_init(Mfcc_t *mfcc, const MfccConfig_t *config, float *workspace,
+              uint32_t workspace_size)
+{
+    const uint32_t needed = mfcc_workspace_size(config);
+    if (!mfcc || !workspace || needed == 0 || workspace_size < needed)
+        return -1;
+
+    mfcc->config = *config;
+    mfcc->dct = workspace;
+    mfcc->ring = workspace + (uint32_t)config->n_mfcc * config->n_mels;
+    mfcc->ring_len = ring_length(config);
+    mfcc->latency = (uint16_t)(config->delta_order * config->delta_width);
+
+    // orthonormal DCT-II, row k scaled by the lifter; double precision, this runs once
+    const uint16_t n_mels = config->n_mels;
+    for (uint16_t k = 0; k < config->n_mfcc; ++k)
+    {
+        double scale = sqrt((k == 0 ? 1.0 : 2.0) / n_mels);
+        if (config->lifter > 0.0f)
+            scale *= 1.0 + 0.5 * config->lifter * sin(MFCC_PI * (k + 1) / config->lifter);
+        for (uint16_t m = 0; m < n_mels; ++m)
+            mfcc->dct[(uint32_t)k * n_mels + m] =
+                (float)(scale * cos(MFCC_PI * k * (2 * m + 1) / (2.0 * n_mels)));
+    }
+
+    mfcc_reset(mfcc);
+    return 0;
+}
+
+void mfcc_reset(Mfcc_t *mfcc)
+{
+    mfcc->pushed = 0;
+    mfcc->emitted = 0;
+}
+
+// cepstrum of column i, clamped to the columns seen so far [0, last]
+static inline const float *cepstrum(const Mfcc_t *mfcc, int32_t i, int32_t last)
+{
+    if (i < 0)
+        i = 0;
+    else if (i > last)
+        i = last;
+    return mfcc->ring + (uint32_t)(i % mfcc->ring_len) * mfcc->config.n_mfcc;
+}
+
+static inline int32_t clamp_column(int32_t i, int32_t last)
+{
+    return i < 0 ? 0 : (i > last ? last : i);
+}
+
+// coefficients, deltas and delta-deltas of column t; every index past either end repeats
+// the edge column, deltas of an edge column included
+static void emit(Mfcc_t *mfcc, int32_t t, int32_t last, float *features)
+{
+    const uint16_t n_mfcc = mfcc->config.n_mfcc;
+    const int32_t width = mfcc->config.delta_width;
+    float norm = 0.0f;
+    for (int32_t n = 1; n <= width; ++n)
+        norm += 2.0f * n * n;
+
+    memcpy(features, cepstrum(mfcc, t, last), n_mfcc * sizeof(float));
+
+    if (mfcc->config.delta_order >= 1)
+    {
+        float *d = features + n_mfcc;
+        memset(d, 0, n_mfcc * sizeof(float));
+        for (int32_t n = 1; n <= width; ++n)
+        {
+            const float *ahead = cepstrum(mfcc, t + n, last);
+            const float *behind = cepstrum(mfcc, t - n, last);
+            const float g = n / norm;
+            for (uint16_t k = 0; k < n_mfcc; ++k)
+                d[k] += g * (ahead[k] - behind[k]);
+        }
+    }
+
+    if (mfcc->config.delta_order >= 2)
+    {
+        // regression over the deltas of the neighbouring columns, expanded into cepstra
+        float *dd = features + 2 * n_mfcc;
+        memset(dd, 0, n_mfcc * sizeof(float));
+        for (int32_t n = 1; n <= width; ++n)
+        {
+            const int32_t a = clamp_column(t + n, last);
+            const int32_t b = clamp_column(t - n, last);
+            for (int32_t j = 1; j <= width; ++j)
+            {
+                const float *a_ahead = cepstrum(mfcc, a + j, last);
+                const float *a_behind = cepstrum(mfcc, a - j, last);
+                const float *b_ahead = cepstrum(mfcc, b + j, last);
+                const float *b_behind = cepstrum(mfcc, b - j, last);
+                const float g = (float)(n * j) / (norm * norm);
+                for (uint16_t k = 0; k < n_mfcc; ++k)
+                    dd[k] += g * ((a_ahead[k] - a_behind[k]) - (b_ahead[k] - b_behind[k]));
+            }
+        }
+    }
+    mfcc->emitted++;
+}
+
+int mfcc_push(Mfcc_t *mfcc, const float *log_mel, float *features)
+{
+    const uint16_t n_mels = mfcc->config.n_mels;
+    const float *row = mfcc->dct;
+    float *slot = mfcc->ring + (mfcc->pushed % mfcc->ring_len) * mfcc->config.n_mfcc;
+
+    for (uint16_t k = 0; k < mfcc->config.n_mfcc; ++k, row += n_mels)
+    {
+        float c0 = 0.0f, c1 = 0.0f;
+        uint16_t m = 0;
+        for (; m + 2 <= n_mels; m += 2)
+        {
+            c0 += row[m] * log_mel[m];
+            c1 += row[m + 1] * log_mel[m + 1];
+        }
+        if (m < n_mels)
+            c0 += row[m] * log_mel[m];
+        slot[k] = c0 + c1;
+    }
+    mfcc->pushed++;
+
+    if (mfcc->pushed <= mfcc->latency)
+        return 0;
+    emit(mfcc, (int32_t)mfcc->emitted, (int32_t)mfcc->pushed - 1, features);
+    return 1;
+}
+
+int mfcc_flush(Mfcc_t *mfcc, float *features)
+{
+    if (mfcc->emitted >= mfcc->pushed)
+        return 0;
+    emit(mfcc, (int32_t)mfcc->emitted, (int32_t)mfcc->pushed - 1, features);
+    return 1;
+}
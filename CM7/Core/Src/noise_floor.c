@@ -0,0 +1,260 @@
+// noise_floor.c
+#include "noise_floor.h"
+#include "mem_placement.h"
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+
+#define LOG10_OFFSET 1e-6f
+#define MIN_DB_LEVEL -80.0f
+
+uint32_t noise_floor_workspace_size(const NoiseFloorConfig_t *config)
+{
+    if (!config || config->n_bands == 0 || config->n_subwindows == 0 ||
+        config->n_subwindows > NOISE_MAX_SUBWINDOWS ||
+        config->window_frames < config->n_subwindows ||
+        config->window_frames % config->n_subwindows != 0)
+        return 0;
+    if (!(config->smoothing >= 0.0f && config->smoothing < 1.0f) || config->bias < 1.0f ||
+        config->over_subtraction < 0.0f || config->spectral_floor < 0.0f ||
+        config->spectral_floor > 1.0f)
+        return 0;
+
+    // smoothed, sub_min, past_min, floor + one row per sub-window
+    return (uint32_t)config->n_bands * (4u + config->n_subwindows) * sizeof(float);
+}
+
+int noise_floor_init(NoiseFloor_t *nf, const NoiseFloorConfig_t *config, float *workspace,
+                     uint32_t workspace_size)
+{
+    const uint32_t needed = noise_floor_workspace_size(config);
+    if (!nf || !workspace || needed == 0 || workspace_size < needed)
+        return -1;
+
+    const uint16_t n = config->n_bands;
+    nf->config = *config;
+    nf->smoothed = workspace;
+    nf->sub_min = workspace + n;
+    nf->past_min = workspace + 2 * n;
+    nf->floor = workspace + 3 * n;
+    nf->history = workspace + 4 * n;
+    nf->sub_len = config->window_frames / config->n_subwindows;
+    noise_floor_reset(nf);
+    return 0;
+}
+
+void noise_floor_reset(NoiseFloor_t *nf)
+{
+    const uint32_t n = nf->config.n_bands;
+    for (uint32_t i = 0; i < n * (4u + nf->config.n_subwindows); ++i)
+        nf->smoothed[i] = FLT_MAX;
+    for (uint32_t m = 0; m < n; ++m)
+        nf->floor[m] = 0.0f;
+    nf->sub_count = 0;
+    nf->sub_next = 0;
+    nf->frames = 0;
+}
+
+// closes a sub-window: its minima replace the oldest row and the window minimum is rebuilt
+static void close_subwindow_f32(NoiseFloor_t *nf)
+{
+    const uint16_t n = nf->config.n_bands;
+    const uint8_t n_sub = nf->config.n_subwindows;
+    float *row = nf->history + (uint32_t)nf->sub_next * n;
+
+    for (uint16_t m = 0; m < n; ++m)
+    {
+        row[m] = nf->sub_min[m];
+        nf->sub_min[m] = FLT_MAX;
+        float past = nf->history[m];
+        for (uint8_t u = 1; u < n_sub; ++u)
+        {
+            const float h = nf->history[(uint32_t)u * n + m];
+            past = (h < past) ? h : past;
+        }
+        nf->past_min[m] = past;
+    }
+    nf->sub_next = (uint8_t)((nf->sub_next + 1) % n_sub);
+    nf->sub_count = 0;
+}
+
+// one band of one column: smooth, minimum, floor, then the optional subtraction
+static inline void track_band_f32(NoiseFloor_t *nf, float *x, uint16_t m, float a, float bias,
+                                  float over, float beta)
+{
+    const float e = *x;
+    const float p = a * nf->smoothed[m] + (1.0f - a) * e;
+    const float sub_min = (p < nf->sub_min[m]) ? p : nf->sub_min[m];
+    const float min = (sub_min < nf->past_min[m]) ? sub_min : nf->past_min[m];
+    const float floor = bias * min;
+
+    nf->smoothed[m] = p;
+    nf->sub_min[m] = sub_min;
+    nf->floor[m] = floor;
+    if (over > 0.0f)
+    {
+        const float y = e - over * floor;
+        const float lo = beta * e;
+        *x = (y > lo) ? y : lo;
+    }
+}
+
+ITCM_FUNC void noise_floor_update_f32(NoiseFloor_t *nf, float *energy, uint16_t n_frames)
+{
+    const uint16_t n = nf->config.n_bands;
+    const float bias = nf->config.bias;
+    const float over = nf->config.over_subtraction;
+    const float beta = nf->config.spectral_floor;
+
+    for (uint16_t f = 0; f < n_frames; ++f)
+    {
+        float *column = energy + (uint32_t)f * n;
+        // the first column seeds the smoothing
+        const float a = nf->frames ? nf->config.smoothing : 0.0f;
+        uint16_t m = 0;
+
+        // four independent bands per pass keep the FPU pipeline full
+        for (; m + 4 <= n; m += 4)
+        {
+            track_band_f32(nf, column + m, m, a, bias, over, beta);
+            track_band_f32(nf, column + m + 1, m + 1, a, bias, over, beta);
+            track_band_f32(nf, column + m + 2, m + 2, a, bias, over, beta);
+            track_band_f32(nf, column + m + 3, m + 3, a, bias, over, beta);
+        }
+        for (; m < n; ++m)
+            track_band_f32(nf, column + m, m, a, bias, over, beta);
+
+        nf->frames++;
+        if (++nf->sub_count == nf->sub_len)
+            close_subwindow_f32(nf);
+    }
+}
+
+float noise_floor_level_db(const NoiseFloor_t *nf)
+{
+    float sum = 0.0f;
+    for (uint16_t m = 0; m < nf->config.n_bands; ++m)
+        sum += nf->floor[m];
+
+    float level = 10.0f * log10f(sum / nf->config.n_bands + LOG10_OFFSET);
+    return (level < MIN_DB_LEVEL) ? MIN_DB_LEVEL : level;
+}
+
+static int32_t to_q15(float v)
+{
+    return (int32_t)(v * 32768.0f + 0.5f);
+}
+
+int noise_floor_init_q15(NoiseFloorQ15_t *nf, const NoiseFloorConfig_t *config,
+                         int32_t *workspace, uint32_t workspace_size)
+{
+    const uint32_t needed = noise_floor_workspace_size(config);
+    if (!nf || !workspace || needed == 0 || workspace_size < needed)
+        return -1;
+    // gains above 2^16 would overflow the Q15 products
+    if (config->bias >= 65536.0f || config->over_subtraction >= 65536.0f)
+        return -1;
+
+    const uint16_t n = config->n_bands;
+    nf->config = *config;
+    nf->smoothed = workspace;
+    nf->sub_min = workspace + n;
+    nf->past_min = workspace + 2 * n;
+    nf->floor = workspace + 3 * n;
+    nf->history = workspace + 4 * n;
+    nf->sub_len = config->window_frames / config->n_subwindows;
+    nf->alpha_q15 = to_q15(config->smoothing);
+    nf->bias_q15 = to_q15(config->bias);
+    nf->over_q15 = to_q15(config->over_subtraction);
+    nf->beta_q15 = to_q15(config->spectral_floor);
+    noise_floor_reset_q15(nf);
+    return 0;
+}
+
+void noise_floor_reset_q15(NoiseFloorQ15_t *nf)
+{
+    const uint32_t n = nf->config.n_bands;
+    for (uint32_t i = 0; i < n * (4u + nf->config.n_subwindows); ++i)
+        nf->smoothed[i] = INT32_MAX;
+    for (uint32_t m = 0; m < n; ++m)
+        nf->floor[m] = 0;
+    nf->sub_count = 0;
+    nf->sub_next = 0;
+    nf->frames = 0;
+}
+
+static void close_subwindow_q15(NoiseFloorQ15_t *nf)
+{
+    const uint16_t n = nf->config.n_bands;
+    const uint8_t n_sub = nf->config.n_subwindows;
+    int32_t *row = nf->history + (uint32_t)nf->sub_next * n;
+
+    for (uint16_t m = 0; m < n; ++m)
+    {
+        row[m] = nf->sub_min[m];
+        nf->sub_min[m] = INT32_MAX;
+        int32_t past = nf->history[m];
+        for (uint8_t u = 1; u < n_sub; ++u)
+        {
+            const int32_t h = nf->history[(uint32_t)u * n + m];
+            past = (h < past) ? h : past;
+        }
+        nf->past_min[m] = past;
+    }
+    nf->sub_next = (uint8_t)((nf->sub_next + 1) % n_sub);
+    nf->sub_count = 0;
+}
+
+// Q15 x Q15 gain, rounded, saturated to the int32 energy range
+static inline int32_t mul_q15(int32_t x, int32_t gain_q15)
+{
+    int64_t r = ((int64_t)x * gain_q15 + 0x4000) >> 15;
+    return (r > INT32_MAX) ? INT32_MAX : (int32_t)r;
+}
+
+static inline void track_band_q15(NoiseFloorQ15_t *nf, int32_t *x, uint16_t m, int32_t a)
+{
+    const int32_t e = *x;
+    // a P + (1 - a) X in one 64-bit sum, the same rounding as mul_q15
+    const int32_t p =
+        (int32_t)(((int64_t)a * nf->smoothed[m] + (int64_t)(32768 - a) * e + 0x4000) >> 15);
+    const int32_t sub_min = (p < nf->sub_min[m]) ? p : nf->sub_min[m];
+    const int32_t min = (sub_min < nf->past_min[m]) ? sub_min : nf->past_min[m];
+    const int32_t floor = mul_q15(min, nf->bias_q15);
+
+    nf->smoothed[m] = p;
+    nf->sub_min[m] = sub_min;
+    nf->floor[m] = floor;
+    if (nf->over_q15 > 0)
+    {
+        const int64_t y = (int64_t)e - mul_q15(floor, nf->over_q15);
+        const int32_t lo = mul_q15(e, nf->beta_q15);
+        *x = (y > lo) ? (int32_t)y : lo;
+    }
+}
+
+void noise_floor_update_q15(NoiseFloorQ15_t *nf, int32_t *energy, uint16_t n_frames)
+{
+    const uint16_t n = nf->config.n_bands;
+
+    for (uint16_t f = 0; f < n_frames; ++f)
+    {
+        int32_t *column = energy + (uint32_t)f * n;
+        const int32_t a = nf->frames ? nf->alpha_q15 : 0;
+        uint16_t m = 0;
+
+        for (; m + 4 <= n; m += 4)
+        {
+            track_band_q15(nf, column + m, m, a);
+            track_band_q15(nf, column + m + 1, m + 1, a);
+            track_band_q15(nf, column + m + 2, m + 2, a);
+            track_band_q15(nf, column + m + 3, m + 3, a);
+        }
+        for (; m < n; ++m)
+            track_band_q15(nf, column + m, m, a);
+
+        nf->frames++;
+        if (++nf->sub_count == nf->sub_len)
+            close_subwindow_q15(nf);
+    }
+}
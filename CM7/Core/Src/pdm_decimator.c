@@ -0,0 +1,328 @@
+// pdm_decimator.c
+#include "pdm_decimator.h"
+#include "mem_placement.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#endif
+
+#define PDM_IDLE_BYTE 0x55 // alternating bits: a zero-valued PDM signal in either bit order
+#define FIR_HISTORY (PDM_FIR_TAPS - 2)
+#define FIR_DESIGN_POINTS 1024
+#define FIR_KAISER_BETA 7.0 // ~70 dB stopband, transition PDM_PASSBAND..PDM_STOPBAND with 48 taps
+#define FIR_MAX_SHIFT 24
+#define PI_D 3.14159265358979323846
+
+// bytes of one channel the next CIC window still needs from the previous call
+static uint32_t cic_history_bytes(const PdmDecimator_t *dec)
+{
+    return dec->cic_bytes - dec->cic_ratio / 8u;
+}
+
+static uint32_t bytes_stride(const PdmConfig_t *config, uint32_t cic_bytes)
+{
+    return cic_bytes - config->decimation / 16u +
+           (uint32_t)config->max_samples * (config->decimation / 8u);
+}
+
+static uint32_t mid_stride(const PdmConfig_t *config)
+{
+    return FIR_HISTORY + 2u * config->max_samples;
+}
+
+static uint32_t kernel_bytes(const PdmConfig_t *config)
+{
+    const uint32_t ratio = config->decimation / 2u;
+    return (config->cic_order * (ratio - 1u) + 1u + 7u) / 8u;
+}
+
+uint32_t pdm_workspace_size(const PdmConfig_t *config)
+{
+    if (!config || config->decimation < 16 || config->decimation > PDM_MAX_DECIMATION ||
+        config->decimation % 16 != 0 || config->channels == 0 ||
+        config->channels > PDM_MAX_CHANNELS || config->cic_order < PDM_MIN_CIC_ORDER ||
+        config->cic_order > PDM_MAX_CIC_ORDER || config->max_samples == 0)
+        return 0;
+    if (!(config->hp_alpha >= 0.0f && config->hp_alpha < 1.0f) || !(config->gain_db < 60.0f))
+        return 0;
+
+    const uint32_t cic_bytes = kernel_bytes(config);
+    // tables, taps, then the int16 and byte histories of every channel
+    return cic_bytes * 256u * sizeof(int32_t) + PDM_FIR_TAPS * sizeof(int16_t) +
+           config->channels * (mid_stride(config) * sizeof(int16_t) +
+                               bytes_stride(config, cic_bytes));
+}
+
+// sinc^N kernel coefficient: the ways to write t as a sum of order terms in [0, ratio - 1]
+static int32_t cic_coefficient(uint32_t t, uint16_t ratio, uint8_t order)
+{
+    int64_t sum = 0;
+    int64_t binom_k = 1; // C(order, k)
+    for (uint32_t k = 0; k <= order && k * ratio <= t; ++k)
+    {
+        // C(t - k ratio + order - 1, order - 1)
+        const int64_t m = (int64_t)(t - k * ratio) + order - 1;
+        int64_t c = 1;
+        for (uint32_t i = 1; i < order; ++i)
+            c = c * (m - order + 1 + i) / i;
+        sum += (k & 1u) ? -binom_k * c : binom_k * c;
+        binom_k = binom_k * (order - k) / (k + 1);
+    }
+    return (int32_t)sum;
+}
+
+// |CIC| at f cycles per CIC output, unity at DC
+static double cic_response(double f, uint16_t ratio, uint8_t order)
+{
+    if (f < 1e-12)
+        return 1.0;
+    return pow(fabs(sin(PI_D * f) / (ratio * sin(PI_D * f / ratio))), order);
+}
+
+static double bessel_i0(double x)
+{
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 32; ++k)
+    {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+// windowed low-pass at the CIC output rate: the inverse CIC droop up to the output Nyquist
+// frequency, frequency-sampled, then a Kaiser window whose transition spans PDM_PASSBAND to
+// PDM_STOPBAND; unity DC gain
+static void design_fir(double *h, uint16_t ratio, uint8_t order)
+{
+    const double cutoff = 0.25; // output Nyquist, in cycles per CIC output
+    const double df = cutoff / FIR_DESIGN_POINTS;
+    const double centre = (PDM_FIR_TAPS - 1) / 2.0;
+
+    for (int n = 0; n < PDM_FIR_TAPS; ++n)
+        h[n] = 0.0;
+    for (int k = 0; k < FIR_DESIGN_POINTS; ++k)
+    {
+        const double f = (k + 0.5) * df;
+        const double d = 1.0 / cic_response(f, ratio, order);
+        for (int n = 0; n < PDM_FIR_TAPS; ++n)
+            h[n] += 2.0 * d * cos(2.0 * PI_D * f * (n - centre)) * df;
+    }
+
+    double sum = 0.0;
+    for (int n = 0; n < PDM_FIR_TAPS; ++n)
+    {
+        const double x = 2.0 * n / (PDM_FIR_TAPS - 1) - 1.0;
+        h[n] *= bessel_i0(FIR_KAISER_BETA * sqrt(1.0 - x * x)) / bessel_i0(FIR_KAISER_BETA);
+        sum += h[n];
+    }
+    for (int n = 0; n < PDM_FIR_TAPS; ++n)
+        h[n] /= sum;
+}
+
+int pdm_init(PdmDecimator_t *dec, const PdmConfig_t *config, void *workspace,
+             uint32_t workspace_size)
+{
+    const uint32_t needed = pdm_workspace_size(config);
+    if (!dec || !workspace || ((uintptr_t)workspace & 3u) != 0 || needed == 0 ||
+        workspace_size < needed)
+        return -1;
+
+    dec->config = *config;
+    dec->cic_ratio = config->decimation / 2u;
+    dec->cic_len = (uint16_t)(config->cic_order * (dec->cic_ratio - 1u) + 1u);
+    dec->cic_bytes = (uint8_t)kernel_bytes(config);
+
+    uint8_t *p = workspace;
+    dec->lut = (int32_t *)p;
+    p += (uint32_t)dec->cic_bytes * 256u * sizeof(int32_t);
+    dec->fir = (int16_t *)p;
+    p += PDM_FIR_TAPS * sizeof(int16_t);
+    dec->mid = (int16_t *)p;
+    p += config->channels * mid_stride(config) * sizeof(int16_t);
+    dec->bytes = p;
+
+    // kernel sums per byte position and bit pattern, bit j of a pattern in stream order
+    for (uint32_t k = 0; k < dec->cic_bytes; ++k)
+    {
+        int32_t h[8];
+        for (uint32_t j = 0; j < 8; ++j)
+        {
+            const uint32_t t = 8u * k + j;
+            h[j] = (t < dec->cic_len) ? cic_coefficient(t, dec->cic_ratio, config->cic_order) : 0;
+        }
+        for (uint32_t v = 0; v < 256; ++v)
+        {
+            int32_t sum = 0;
+            for (uint32_t j = 0; j < 8; ++j)
+            {
+                const uint32_t bit = config->msb_first ? (v >> (7u - j)) & 1u : (v >> j) & 1u;
+                sum += bit ? h[j] : -h[j];
+            }
+            dec->lut[k * 256u + v] = sum;
+        }
+    }
+
+    // full scale out of the CIC is ratio^order; the shift brings it under 2^15
+    double cic_gain = pow((double)dec->cic_ratio, config->cic_order);
+    dec->cic_shift = 0;
+    while (cic_gain / (double)(1u << dec->cic_shift) > 32768.0)
+        dec->cic_shift++;
+
+    double h[PDM_FIR_TAPS];
+    design_fir(h, dec->cic_ratio, config->cic_order);
+    const double gain = pow(10.0, config->gain_db / 20.0) * 32768.0 *
+                        (double)(1u << dec->cic_shift) / cic_gain;
+    double peak = 0.0;
+    for (int n = 0; n < PDM_FIR_TAPS; ++n)
+        peak = (fabs(h[n] * gain) > peak) ? fabs(h[n] * gain) : peak;
+    if (peak > 32767.0) // gain_db too high for Q15 taps
+        return -1;
+    dec->fir_shift = 0;
+    while (dec->fir_shift < FIR_MAX_SHIFT && peak * (double)(1u << (dec->fir_shift + 1)) < 32767.0)
+        dec->fir_shift++;
+    for (int n = 0; n < PDM_FIR_TAPS; ++n)
+        dec->fir[n] = (int16_t)lrint(h[n] * gain * (double)(1u << dec->fir_shift));
+
+    dec->hp_alpha_q31 = (int32_t)lrint(config->hp_alpha * 2147483648.0);
+    pdm_reset(dec);
+    return 0;
+}
+
+void pdm_reset(PdmDecimator_t *dec)
+{
+    const PdmConfig_t *config = &dec->config;
+    memset(dec->mid, 0, config->channels * mid_stride(config) * sizeof(int16_t));
+    memset(dec->bytes, PDM_IDLE_BYTE, config->channels * bytes_stride(config, dec->cic_bytes));
+    for (uint32_t c = 0; c < PDM_MAX_CHANNELS; ++c)
+    {
+        dec->hp_in[c] = 0;
+        dec->hp_out[c] = 0;
+    }
+    dec->samples = 0;
+}
+
+static inline int16_t saturate16(int32_t v)
+{
+    return (int16_t)((v > 32767) ? 32767 : (v < -32768) ? -32768 : v);
+}
+
+// n_mid CIC outputs from the kernel windows at src, src + ratio / 8, ...
+static void cic_channel(const PdmDecimator_t *dec, const uint8_t *src, uint32_t n_mid,
+                        int16_t *out)
+{
+    const uint32_t step = dec->cic_ratio / 8u;
+    const uint32_t n_bytes = dec->cic_bytes;
+    const uint8_t shift = dec->cic_shift;
+
+    for (uint32_t j = 0; j < n_mid; ++j, src += step)
+    {
+        const int32_t *lut = dec->lut;
+        int32_t acc = 0;
+        uint32_t k = 0;
+        // four independent lookups per pass
+        for (; k + 4 <= n_bytes; k += 4, lut += 1024)
+            acc += lut[src[k]] + lut[256 + src[k + 1]] + lut[512 + src[k + 2]] +
+                   lut[768 + src[k + 3]];
+        for (; k < n_bytes; ++k, lut += 256)
+            acc += lut[src[k]];
+        out[j] = saturate16(acc >> shift);
+    }
+}
+
+static inline int64_t fir_sum(const int16_t *x, const int16_t *taps)
+{
+    int64_t acc = 0;
+#if defined(__ARM_FEATURE_DSP)
+    // two taps per __smlald; x sits at an even offset of the 4-byte aligned history
+    for (uint32_t k = 0; k < PDM_FIR_TAPS; k += 2)
+    {
+        int32_t x2, t2;
+        memcpy(&x2, x + k, 4);
+        memcpy(&t2, taps + k, 4);
+        acc = __smlald(x2, t2, acc);
+    }
+#else
+    for (uint32_t k = 0; k < PDM_FIR_TAPS; ++k)
+        acc += (int32_t)x[k] * taps[k];
+#endif
+    return acc;
+}
+
+ITCM_FUNC int pdm_process(PdmDecimator_t *dec, const uint8_t *pdm, uint16_t n_samples,
+                          int16_t *pcm)
+{
+    const PdmConfig_t *config = &dec->config;
+    if (n_samples > config->max_samples)
+        return -1;
+
+    const uint8_t channels = config->channels;
+    const uint32_t history = cic_history_bytes(dec);
+    const uint32_t in_bytes = (uint32_t)n_samples * (config->decimation / 8u);
+    const int64_t round = (dec->fir_shift > 0) ? (int64_t)1 << (dec->fir_shift - 1) : 0;
+
+    for (uint8_t c = 0; c < channels; ++c)
+    {
+        uint8_t *bytes = dec->bytes + c * bytes_stride(config, dec->cic_bytes);
+        int16_t *mid = dec->mid + c * mid_stride(config);
+
+        if (channels == 1)
+            memcpy(bytes + history, pdm, in_bytes);
+        else
+            for (uint32_t i = 0; i < in_bytes; ++i)
+                bytes[history + i] = pdm[i * channels + c];
+
+        cic_channel(dec, bytes, 2u * n_samples, mid + FIR_HISTORY);
+
+        int32_t hp_in = dec->hp_in[c], hp_out = dec->hp_out[c];
+        for (uint32_t i = 0; i < n_samples; ++i)
+        {
+            const int32_t x = (int32_t)((fir_sum(mid + 2 * i, dec->fir) + round) >> dec->fir_shift);
+            int32_t y = x;
+            if (dec->hp_alpha_q31 != 0)
+            {
+                // y[n] = alpha (y[n-1] + x[n] - x[n-1]), the library's high-pass
+                const int64_t z = (int64_t)hp_out + x - hp_in;
+                y = (int32_t)((z * dec->hp_alpha_q31 + ((int64_t)1 << 30)) >> 31);
+                hp_in = x;
+                hp_out = y;
+            }
+            pcm[i * channels + c] = saturate16(y);
+        }
+        dec->hp_in[c] = hp_in;
+        dec->hp_out[c] = hp_out;
+
+        memmove(bytes, bytes + in_bytes, history);
+        memmove(mid, mid + 2u * n_samples, FIR_HISTORY * sizeof(int16_t));
+    }
+    dec->samples += n_samples;
+    return 0;
+}
+
+void pdm_count_ones(const uint8_t *pdm, uint32_t n_bytes, uint8_t channels, uint32_t *ones)
+{
+    const uint32_t total = n_bytes * channels;
+    uint32_t i = 0;
+
+    for (uint8_t c = 0; c < channels; ++c)
+        ones[c] = 0;
+    if (8 % channels == 0)
+    {
+        // byte b of a little-endian 64-bit word belongs to channel b % channels
+        uint64_t mask[PDM_MAX_CHANNELS] = {0};
+        for (uint32_t b = 0; b < 8; ++b)
+            mask[b % channels] |= (uint64_t)0xFF << (8 * b);
+        for (; i + 8 <= total; i += 8)
+        {
+            uint64_t w;
+            memcpy(&w, pdm + i, 8);
+            for (uint8_t c = 0; c < channels; ++c)
+                ones[c] += (uint32_t)__builtin_popcountll(w & mask[c]);
+        }
+    }
+    for (; i < total; ++i)
+        ones[i % channels] += (uint32_t)__builtin_popcount(pdm[i]);
+}
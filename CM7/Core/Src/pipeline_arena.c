@@ -0,0 +1,27 @@
+// pipeline_arena.c
+#include "pipeline_arena.h"
+#include <stdint.h>
+
+uint32_t pipeline_arena_plan(const MelSpectrogramConfig_t *config, uint16_t n_frames,
+                             uint32_t cnn_workspace, uint8_t fused_quant,
+                             ArenaTensor_t *tensors)
+{
+    const uint32_t mel_cells = (uint32_t)config->n_mels * n_frames;
+    const uint32_t mel_output = fused_quant ? 0 : mel_cells * sizeof(float);
+
+    tensors[TENSOR_MEL_STATE] = (ArenaTensor_t){"mel_state",
+                                                MEL_STATE_BYTES(config->fft_size, config->n_mels),
+                                                STEP_INIT, STEP_INFERENCE, 0};
+    tensors[TENSOR_DSP_SCRATCH] = (ArenaTensor_t){
+        "dsp_scratch", MEL_SCRATCH_BYTES(config->fft_size), STEP_STFT, STEP_STFT, 0};
+    tensors[TENSOR_MEL_OUTPUT] =
+        (ArenaTensor_t){"mel_output", mel_output, STEP_STFT, STEP_QUANTIZE, 0};
+    // the fused path writes the model input while the STFT runs
+    tensors[TENSOR_MODEL_INPUT] =
+        (ArenaTensor_t){"model_input", mel_cells * sizeof(int8_t),
+                        fused_quant ? STEP_STFT : STEP_QUANTIZE, STEP_INFERENCE, 0};
+    tensors[TENSOR_CNN_WORKSPACE] = (ArenaTensor_t){"cnn_workspace", cnn_workspace,
+                                                    STEP_INFERENCE, STEP_INFERENCE, 0};
+
+    return arena_plan(tensors, PIPELINE_N_TENSORS);
+}
@@ -0,0 +1,172 @@
+// profiler.c
+#include "profiler.h"
+#include "trace.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__arm__)
+#include "main.h"
+#else
+#include <time.h>
+#endif
+
+static const char *stage_names[PROF_N_STAGES] = {
+    "pdm_decode", "window", "fft", "power", "mel", "log", "normalize", "quantize", "inference",
+    "mfcc", "noise", "beam", "pdm_library", "agc",
+};
+
+static ProfStats_t stats[PROF_N_STAGES];
+static uint32_t last_dump;
+static uint32_t dump_ticks;
+
+uint32_t profiler_now(void)
+{
+#if defined(__arm__)
+    return DWT->CYCCNT;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+#endif
+}
+
+uint32_t profiler_ticks_per_us(void)
+{
+#if defined(__arm__)
+    return SystemCoreClock / 1000000u;
+#else
+    return 1000u;
+#endif
+}
+
+void profiler_reset(void)
+{
+    memset(stats, 0, sizeof(stats));
+    for (uint8_t s = 0; s < PROF_N_STAGES; ++s)
+        stats[s].min = UINT32_MAX;
+}
+
+void profiler_init(void)
+{
+#if defined(__arm__)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = 0xC5ACCE55; // unlock on the M7
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    profiler_reset();
+    // host ns ticks wrap after 4.3 s, longer periods are clamped to stay measurable
+    uint64_t period = (uint64_t)PROFILER_DUMP_PERIOD_MS * 1000u * profiler_ticks_per_us();
+    dump_ticks = (period > 0x7fffffffu) ? 0x7fffffffu : (uint32_t)period;
+    last_dump = profiler_now();
+}
+
+// octave from the highest set bit, then PROF_SUB_BINS linear steps inside it
+static uint16_t hist_bin(uint32_t ticks)
+{
+    if (ticks < (1u << PROF_MIN_OCTAVE))
+        return 0;
+
+    uint8_t octave = 31 - __builtin_clz(ticks);
+    if (octave >= PROF_MIN_OCTAVE + PROF_OCTAVES)
+        return PROF_HIST_BINS - 1;
+
+    uint32_t sub = (ticks >> (octave - 2)) & (PROF_SUB_BINS - 1); // two bits below the top one
+    return (uint16_t)((octave - PROF_MIN_OCTAVE) * PROF_SUB_BINS + sub);
+}
+
+// upper edge of a bin, in ticks
+static uint32_t bin_edge(uint16_t bin)
+{
+    uint8_t octave = PROF_MIN_OCTAVE + bin / PROF_SUB_BINS;
+    uint32_t sub = bin % PROF_SUB_BINS;
+    return (1u << octave) + ((sub + 1) << (octave - 2)) - 1;
+}
+
+void profiler_record(ProfStage_t stage, uint32_t ticks)
+{
+    if ((unsigned)stage >= PROF_N_STAGES)
+        return;
+
+    ProfStats_t *s = &stats[stage];
+    s->count++;
+    s->total += ticks;
+    if (ticks < s->min)
+        s->min = ticks;
+    if (ticks > s->max)
+        s->max = ticks;
+
+    uint16_t *bin = &s->hist[hist_bin(ticks)];
+    if (*bin != UINT16_MAX)
+        (*bin)++;
+}
+
+void profiler_end(ProfStage_t stage, uint32_t start)
+{
+    uint32_t ticks = profiler_now() - start;
+
+    profiler_record(stage, ticks);
+#if USE_TRACE
+    trace_span((uint8_t)stage, start, ticks);
+#endif
+}
+
+const ProfStats_t *profiler_stats(ProfStage_t stage)
+{
+    return ((unsigned)stage < PROF_N_STAGES) ? &stats[stage] : NULL;
+}
+
+uint32_t profiler_percentile(ProfStage_t stage, uint16_t permille)
+{
+    const ProfStats_t *s = profiler_stats(stage);
+    if (!s || s->count == 0)
+        return 0;
+
+    uint32_t binned = 0;
+    for (uint16_t b = 0; b < PROF_HIST_BINS; ++b)
+        binned += s->hist[b];
+
+    uint32_t target = (uint32_t)(((uint64_t)binned * permille + 999) / 1000);
+    uint32_t seen = 0;
+    for (uint16_t b = 0; b < PROF_HIST_BINS; ++b)
+    {
+        seen += s->hist[b];
+        if (seen >= target && seen > 0)
+        {
+            uint32_t edge = bin_edge(b);
+            return (edge > s->max) ? s->max : edge;
+        }
+    }
+    return s->max;
+}
+
+void profiler_dump(void)
+{
+    const uint32_t tpu = profiler_ticks_per_us();
+
+    printf("stage          count      min     mean      max      p50      p90      p99 (us)\r\n");
+    for (uint8_t st = 0; st < PROF_N_STAGES; ++st)
+    {
+        const ProfStats_t *s = &stats[st];
+        if (s->count == 0)
+            continue;
+
+        printf("%-11s %8lu %8.1f %8.1f %8.1f %8.1f %8.1f %8.1f\r\n", stage_names[st],
+               (unsigned long)s->count, (float)s->min / tpu,
+               (float)((double)s->total / s->count) / tpu, (float)s->max / tpu,
+               (float)profiler_percentile(st, 500) / tpu,
+               (float)profiler_percentile(st, 900) / tpu,
+               (float)profiler_percentile(st, 990) / tpu);
+    }
+}
+
+void profiler_poll(void)
+{
+    uint32_t now = profiler_now();
+    if (now - last_dump < dump_ticks)
+        return;
+
+    last_dump = now;
+    profiler_dump();
+}
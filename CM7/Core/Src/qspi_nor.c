@@ -0,0 +1,107 @@
+// qspi_nor.c
+#include "qspi_nor.h"
+#include "main.h"
+#include <stdint.h>
+
+#define QSPI_INSTANCE 0
+
+// memory-mapped mode to restore after an indirect operation
+static uint8_t restore_mapped;
+static uint8_t indirect;
+// an erase was started and the flash has not reported ready since
+static uint8_t erasing;
+
+static int enter_indirect(void)
+{
+    if (restore_mapped && !indirect)
+    {
+        if (BSP_QSPI_DisableMemoryMappedMode(QSPI_INSTANCE) != BSP_ERROR_NONE)
+            return -1;
+        indirect = 1;
+    }
+    return 0;
+}
+
+static void leave_indirect(void)
+{
+    if (restore_mapped && indirect && !erasing &&
+        BSP_QSPI_EnableMemoryMappedMode(QSPI_INSTANCE) == BSP_ERROR_NONE)
+        indirect = 0;
+}
+
+static int nor_busy(void *ctx)
+{
+    (void)ctx;
+    if (!erasing)
+        return 0;
+    if (BSP_QSPI_GetStatus(QSPI_INSTANCE) == BSP_ERROR_BUSY)
+        return 1;
+    erasing = 0;
+    leave_indirect();
+    return 0;
+}
+
+static int nor_read(void *ctx, uint32_t addr, void *dst, uint32_t len)
+{
+    if (nor_busy(ctx) || enter_indirect() != 0)
+        return -1;
+    int ret = (BSP_QSPI_Read(QSPI_INSTANCE, dst, addr, len) == BSP_ERROR_NONE) ? 0 : -1;
+    leave_indirect();
+    return ret;
+}
+
+static int nor_program(void *ctx, uint32_t addr, const void *src, uint32_t len)
+{
+    if (nor_busy(ctx) || enter_indirect() != 0)
+        return -1;
+    // the BSP polls the status register until the page program completes
+    int ret =
+        (BSP_QSPI_Write(QSPI_INSTANCE, (uint8_t *)src, addr, len) == BSP_ERROR_NONE) ? 0 : -1;
+    leave_indirect();
+    return ret;
+}
+
+static int nor_erase(void *ctx, uint32_t addr)
+{
+    if (nor_busy(ctx) || enter_indirect() != 0)
+        return -1;
+    // returns once the command is issued; nor_busy polls for the end
+    if (BSP_QSPI_EraseBlock(QSPI_INSTANCE, addr, MT25TL01G_ERASE_64K) != BSP_ERROR_NONE)
+    {
+        leave_indirect();
+        return -1;
+    }
+    erasing = 1;
+    return 0;
+}
+
+int qspi_nor_init(NorFlash_t *flash, int memory_mapped)
+{
+    BSP_QSPI_Info_t info;
+
+    if (!memory_mapped)
+    {
+        BSP_QSPI_Init_t qspi_init;
+        qspi_init.InterfaceMode = MT25TL01G_QPI_MODE;
+        qspi_init.TransferRate = MT25TL01G_DTR_TRANSFER;
+        qspi_init.DualFlashMode = MT25TL01G_DUALFLASH_ENABLE;
+        if (BSP_QSPI_Init(QSPI_INSTANCE, &qspi_init) != BSP_ERROR_NONE)
+            return -1;
+    }
+    if (BSP_QSPI_GetInfo(QSPI_INSTANCE, &info) != BSP_ERROR_NONE)
+        return -1;
+
+    restore_mapped = memory_mapped ? 1u : 0u;
+    indirect = 0;
+    erasing = 0;
+
+    flash->page_size = info.ProgPageSize;
+    flash->sector_size = info.EraseSectorSize;
+    flash->size = info.FlashSize;
+    flash->ctx = NULL;
+    flash->read = nor_read;
+    flash->program = nor_program;
+    flash->erase = nor_erase;
+    flash->busy = nor_busy;
+    return 0;
+}
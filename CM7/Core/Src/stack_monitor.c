@@ -0,0 +1,131 @@
+// stack_monitor.c
+#include "stack_monitor.h"
+#include <stdint.h>
+
+#if defined(__arm__)
+
+#include "main.h"
+
+// linker script symbols, only their addresses are meaningful
+extern uint8_t _end;
+extern uint8_t _estack;
+extern uint8_t _Min_Heap_Size;
+extern uint8_t _Min_Stack_Size;
+
+// words just below the caller's frame that are left alone
+#define STACK_MONITOR_GUARD 64u
+
+static uint32_t *paint_bottom;
+
+void stack_monitor_paint(void)
+{
+    uint8_t *heap_top = &_end + (uint32_t)&_Min_Heap_Size;
+    uint8_t *bottom = &_estack - STACK_MONITOR_PAINT_BYTES;
+    if (bottom < heap_top)
+        bottom = heap_top;
+
+    paint_bottom = (uint32_t *)(((uint32_t)bottom + 3u) & ~3u);
+
+    uint32_t *top = (uint32_t *)((__get_MSP() - STACK_MONITOR_GUARD) & ~3u);
+    for (volatile uint32_t *p = paint_bottom; p < top; ++p)
+        *p = STACK_MONITOR_PAINT;
+}
+
+uint32_t stack_monitor_peak(void)
+{
+    if (!paint_bottom)
+        return 0;
+
+    const uint32_t *p = paint_bottom;
+    while (p < (const uint32_t *)&_estack && *p == STACK_MONITOR_PAINT)
+        ++p;
+    return (uint32_t)(&_estack - (const uint8_t *)p);
+}
+
+uint32_t stack_monitor_reserved(void) { return (uint32_t)&_Min_Stack_Size; }
+
+int stack_monitor_run(StackMonitorFn_t fn, void *arg, uint32_t stack_size, uint32_t *peak)
+{
+    (void)stack_size;
+    if (!fn)
+        return -1;
+
+    stack_monitor_paint();
+    fn(arg);
+    if (peak)
+        *peak = stack_monitor_peak();
+    return 0;
+}
+
+#else // host
+
+#include <pthread.h>
+#include <stdlib.h>
+
+typedef struct
+{
+    StackMonitorFn_t fn;
+    void *arg;
+} StackJob_t;
+
+static void *stack_job(void *p)
+{
+    StackJob_t *job = (StackJob_t *)p;
+    if (job->fn)
+        job->fn(job->arg);
+    return NULL;
+}
+
+static void idle_job(void *arg) { (void)arg; }
+
+// bytes used on a painted thread stack, including what the thread library keeps there
+static int measure(StackMonitorFn_t fn, void *arg, uint32_t stack_size, uint32_t *used)
+{
+    stack_size = (stack_size + 4095u) & ~4095u;
+    uint32_t *stack = (uint32_t *)aligned_alloc(4096, stack_size);
+    if (!stack)
+        return -1;
+
+    for (uint32_t i = 0; i < stack_size / 4; ++i)
+        stack[i] = STACK_MONITOR_PAINT;
+
+    pthread_attr_t attr;
+    pthread_t thread;
+    StackJob_t job = {fn, arg};
+    int ok = pthread_attr_init(&attr) == 0 &&
+             pthread_attr_setstack(&attr, stack, stack_size) == 0 &&
+             pthread_create(&thread, &attr, stack_job, &job) == 0 &&
+             pthread_join(thread, NULL) == 0;
+    pthread_attr_destroy(&attr);
+
+    // the stack grows down, the first overwritten word from the bottom is the high-water mark
+    uint32_t i = 0;
+    while (i < stack_size / 4 && stack[i] == STACK_MONITOR_PAINT)
+        ++i;
+    *used = stack_size - i * 4;
+
+    free(stack);
+    return ok ? 0 : -1;
+}
+
+void stack_monitor_paint(void) {}
+
+uint32_t stack_monitor_peak(void) { return 0; }
+
+uint32_t stack_monitor_reserved(void) { return 0; }
+
+int stack_monitor_run(StackMonitorFn_t fn, void *arg, uint32_t stack_size, uint32_t *peak)
+{
+    uint32_t used, baseline;
+
+    if (!fn || !peak)
+        return -1;
+    if (measure(idle_job, NULL, stack_size, &baseline) != 0 ||
+        measure(fn, arg, stack_size, &used) != 0)
+        return -1;
+
+    *peak = (used > baseline) ? used - baseline : 0;
+    return 0;
+}
+
+#endif
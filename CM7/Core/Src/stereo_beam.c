@@ -0,0 +1,317 @@
+// stereo_beam.c
+#include "stereo_beam.h"
+#include "mem_placement.h"
+#include "profiler.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#endif
+
+#define PHAT_EPSILON 1e-20f
+#define Q14_ONE 16384.0f
+
+// largest physical delay in samples, and the delays scanned for it
+static float max_lag_of(const BeamConfig_t *config)
+{
+    return config->mic_spacing / BEAM_SPEED_OF_SOUND * (float)config->sample_rate;
+}
+
+static uint16_t lag_count(const BeamConfig_t *config)
+{
+    return (uint16_t)(2u * (uint32_t)floorf(max_lag_of(config) * config->lag_steps) + 1u);
+}
+
+// the steering reads up to ceil(max_lag) + 2 samples around its base, which sits latency
+// samples back, so the history holds both reaches
+static uint16_t latency_of(const BeamConfig_t *config)
+{
+    return (uint16_t)ceilf(max_lag_of(config)) + 2u;
+}
+
+static uint16_t history_of(const BeamConfig_t *config)
+{
+    return (uint16_t)(2u * latency_of(config));
+}
+
+uint32_t beam_workspace_size(const BeamConfig_t *config)
+{
+    if (!config || config->sample_rate == 0 || config->block < 64 ||
+        config->block > BEAM_MAX_BLOCK || (config->block & (config->block - 1)) != 0)
+        return 0;
+    if (!(config->mic_spacing > 0.0f) || config->lag_steps == 0 ||
+        lag_count(config) > BEAM_MAX_LAGS || config->f_min < 0.0f ||
+        config->f_max <= config->f_min || config->min_confidence < 0.0f ||
+        config->smoothing < 0.0f || config->smoothing >= 1.0f)
+        return 0;
+
+    // window + two spectra, then two int16 sample rings
+    return 3u * config->block * sizeof(float) +
+           2u * (uint32_t)(history_of(config) + config->block) * sizeof(int16_t);
+}
+
+int beam_init(Beam_t *bf, const BeamConfig_t *config, void *workspace, uint32_t workspace_size)
+{
+    const uint32_t needed = beam_workspace_size(config);
+    if (!bf || !workspace || needed == 0 || workspace_size < needed)
+        return -1;
+
+    const uint16_t n = config->block;
+    int32_t lo = (int32_t)ceilf(config->f_min * n / config->sample_rate);
+    int32_t hi = (int32_t)floorf(config->f_max * n / config->sample_rate);
+    if (lo < 1)
+        lo = 1;
+    if (hi > n / 2 - 1)
+        hi = n / 2 - 1;
+    if (hi < lo)
+        return -1;
+
+    if (arm_rfft_fast_init_f32(&bf->fft, n) != ARM_MATH_SUCCESS)
+        return -1;
+
+    bf->config = *config;
+    bf->window = (float *)workspace;
+    bf->spectrum_l = bf->window + n;
+    bf->spectrum_r = bf->spectrum_l + n;
+    bf->history = history_of(config);
+    bf->latency = latency_of(config);
+    bf->left = (int16_t *)(bf->spectrum_r + n);
+    bf->right = bf->left + bf->history + n;
+    bf->n_lags = lag_count(config);
+    bf->bin_lo = (uint16_t)lo;
+    bf->bin_hi = (uint16_t)hi;
+    bf->max_lag = max_lag_of(config);
+
+    // periodic Hann; PHAT drops the scale
+    for (uint16_t i = 0; i < n; ++i)
+        bf->window[i] = 0.5f * (1.0f - arm_cos_f32(2.0f * PI * i / n));
+
+    beam_reset(bf);
+    return 0;
+}
+
+void beam_reset(Beam_t *bf)
+{
+    memset(bf->left, 0, 2u * (bf->history + bf->config.block) * sizeof(int16_t));
+    bf->delay = 0.0f;
+    bf->confidence = 0.0f;
+    bf->angle = 0.0f;
+    bf->blocks = 0;
+}
+
+ITCM_FUNC void beam_deinterleave(const int16_t *stereo, uint32_t n_frames, int16_t *left,
+                                 int16_t *right)
+{
+    uint32_t i = 0;
+
+#if defined(__ARM_FEATURE_DSP)
+    // (L0, R0), (L1, R1) -> (L0, L1), (R0, R1): one halfword pack per output word
+    for (; i + 2 <= n_frames; i += 2)
+    {
+        uint32_t f0, f1;
+        memcpy(&f0, stereo + 2 * i, 4);
+        memcpy(&f1, stereo + 2 * i + 2, 4);
+        const uint32_t l = __pkhbt(f0, f1, 16);
+        const uint32_t r = __pkhtb(f1, f0, 16);
+        memcpy(left + i, &l, 4);
+        memcpy(right + i, &r, 4);
+    }
+#endif
+    for (; i < n_frames; ++i)
+    {
+        left[i] = stereo[2 * i];
+        right[i] = stereo[2 * i + 1];
+    }
+}
+
+// phase-only cross spectrum sum at one delay: sum_k Re(C_k e^(-j 2 pi k tau / N)), with the
+// phasor advanced by one complex multiply per bin
+static float gcc_at(const float *cross, uint16_t lo, uint16_t hi, uint16_t n, float tau)
+{
+    const float step = -2.0f * PI * tau / n;
+    const float wr = arm_cos_f32(step), wi = arm_sin_f32(step);
+    float pr = arm_cos_f32(step * lo), pi = arm_sin_f32(step * lo);
+    float sum = 0.0f;
+
+    for (uint16_t k = lo; k <= hi; ++k)
+    {
+        sum += cross[2 * k] * pr - cross[2 * k + 1] * pi;
+        const float r = pr * wr - pi * wi;
+        pi = pr * wi + pi * wr;
+        pr = r;
+    }
+    return sum;
+}
+
+ITCM_FUNC float beam_estimate(Beam_t *bf, const int16_t *left, const int16_t *right)
+{
+    const uint16_t n = bf->config.block;
+    float *sl = bf->spectrum_l, *sr = bf->spectrum_r;
+
+    for (uint16_t i = 0; i < n; ++i)
+    {
+        sl[i] = (float)left[i] * bf->window[i];
+        sr[i] = (float)right[i] * bf->window[i];
+    }
+    arm_rfft_fast_f32(&bf->fft, sl, sl, 0);
+    arm_rfft_fast_f32(&bf->fft, sr, sr, 0);
+
+    // L conj(R) / |L conj(R)| over the band, in place of the left spectrum
+    for (uint16_t k = bf->bin_lo; k <= bf->bin_hi; ++k)
+    {
+        const float ar = sl[2 * k], ai = sl[2 * k + 1];
+        const float br = sr[2 * k], bi = sr[2 * k + 1];
+        const float cr = ar * br + ai * bi;
+        const float ci = ai * br - ar * bi;
+        const float inv = 1.0f / (sqrtf(cr * cr + ci * ci) + PHAT_EPSILON);
+        sl[2 * k] = cr * inv;
+        sl[2 * k + 1] = ci * inv;
+    }
+
+    // the inverse transform at the physical delays only, then a parabola through the peak
+    float gcc[BEAM_MAX_LAGS] = {0};
+    const int32_t center = (bf->n_lags - 1) / 2;
+    const float steps = (float)bf->config.lag_steps;
+    int32_t best_j = 0;
+    for (int32_t j = 0; j < bf->n_lags; ++j)
+    {
+        gcc[j] = gcc_at(sl, bf->bin_lo, bf->bin_hi, n, (j - center) / steps);
+        if (gcc[j] > gcc[best_j])
+            best_j = j;
+    }
+    const float best = gcc[best_j];
+    float offset = 0.0f;
+    if (best_j > 0 && best_j + 1 < bf->n_lags)
+    {
+        const float curvature = gcc[best_j - 1] - 2.0f * best + gcc[best_j + 1];
+        if (curvature < 0.0f)
+            offset = 0.5f * (gcc[best_j - 1] - gcc[best_j + 1]) / curvature;
+    }
+
+    float raw = (best_j - center + offset) / steps;
+    if (raw > bf->max_lag)
+        raw = bf->max_lag;
+    else if (raw < -bf->max_lag)
+        raw = -bf->max_lag;
+
+    bf->confidence = best / (float)(bf->bin_hi - bf->bin_lo + 1);
+    if (bf->confidence >= bf->config.min_confidence)
+    {
+        const float a = bf->config.smoothing;
+        bf->delay = a * bf->delay + (1.0f - a) * raw;
+        bf->angle = asinf(bf->delay / bf->max_lag) * (180.0f / PI);
+    }
+    return raw;
+}
+
+// cubic Lagrange taps for right[i - 1 .. i + 2] at i + mu, mu in [0, 1)
+static void lagrange_taps(float mu, float h[4])
+{
+    h[0] = -mu * (mu - 1.0f) * (mu - 2.0f) / 6.0f;
+    h[1] = (mu + 1.0f) * (mu - 1.0f) * (mu - 2.0f) / 2.0f;
+    h[2] = -(mu + 1.0f) * mu * (mu - 2.0f) / 2.0f;
+    h[3] = (mu + 1.0f) * mu * (mu - 1.0f) / 6.0f;
+}
+
+static inline int16_t tap_q14(float h)
+{
+    return (int16_t)lrintf(h * Q14_ONE);
+}
+
+static inline int16_t saturate_q15(int32_t v)
+{
+    return (int16_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+}
+
+ITCM_FUNC void beam_steer_q15(const int16_t *left, const int16_t *right, uint32_t n, float delay,
+                              int16_t *out)
+{
+    const int32_t whole = (int32_t)floorf(delay);
+    float h[4];
+    lagrange_taps(delay - (float)whole, h);
+    const int16_t h0 = tap_q14(h[0]), h1 = tap_q14(h[1]), h2 = tap_q14(h[2]),
+                  h3 = tap_q14(h[3]);
+    const int16_t *r = right + whole - 1;
+    uint32_t t = 0;
+
+#if defined(__ARM_FEATURE_DSP)
+    const uint32_t h01 = (uint16_t)h0 | ((uint32_t)(uint16_t)h1 << 16);
+    const uint32_t h23 = (uint16_t)h2 | ((uint32_t)(uint16_t)h3 << 16);
+    for (; t < n; ++t)
+    {
+        uint32_t r01, r23;
+        memcpy(&r01, r + t, 4);
+        memcpy(&r23, r + t + 2, 4);
+        int32_t acc = ((int32_t)left[t] << 14) + 0x4000;
+        acc = __smlad(r01, h01, acc);
+        acc = __smlad(r23, h23, acc);
+        out[t] = (int16_t)__ssat(acc >> 15, 16);
+    }
+#endif
+    for (; t < n; ++t)
+    {
+        int32_t acc = ((int32_t)left[t] << 14) + 0x4000;
+        acc += r[t] * h0 + r[t + 1] * h1 + r[t + 2] * h2 + r[t + 3] * h3;
+        out[t] = saturate_q15(acc >> 15);
+    }
+}
+
+ITCM_FUNC void beam_steer_f32(const int16_t *left, const int16_t *right, uint32_t n, float delay,
+                              float *out)
+{
+    const int32_t whole = (int32_t)floorf(delay);
+    float h[4];
+    lagrange_taps(delay - (float)whole, h);
+    const int16_t *r = right + whole - 1;
+
+    for (uint32_t t = 0; t < n; ++t)
+        out[t] = 0.5f * ((float)left[t] + h[0] * r[t] + h[1] * r[t + 1] + h[2] * r[t + 2] +
+                         h[3] * r[t + 3]);
+}
+
+// new block behind the history, then the direction estimate on it
+static void analyze(Beam_t *bf, const int16_t *stereo)
+{
+    const uint16_t n = bf->config.block;
+    beam_deinterleave(stereo, n, bf->left + bf->history, bf->right + bf->history);
+    beam_estimate(bf, bf->left + bf->history, bf->right + bf->history);
+}
+
+// the block's tail becomes the next history
+static void advance(Beam_t *bf)
+{
+    const uint16_t n = bf->config.block;
+    memmove(bf->left, bf->left + n, bf->history * sizeof(int16_t));
+    memmove(bf->right, bf->right + n, bf->history * sizeof(int16_t));
+    bf->blocks++;
+}
+
+ITCM_FUNC int beam_process_q15(Beam_t *bf, const int16_t *stereo, int16_t *mono)
+{
+    if (!bf || !stereo || !mono)
+        return -1;
+
+    PROF_BEGIN(PROF_BEAM);
+    analyze(bf, stereo);
+    const uint16_t base = bf->history - bf->latency;
+    beam_steer_q15(bf->left + base, bf->right + base, bf->config.block, bf->delay, mono);
+    advance(bf);
+    PROF_END(PROF_BEAM);
+    return 0;
+}
+
+ITCM_FUNC int beam_process_f32(Beam_t *bf, const int16_t *stereo, float *mono)
+{
+    if (!bf || !stereo || !mono)
+        return -1;
+
+    PROF_BEGIN(PROF_BEAM);
+    analyze(bf, stereo);
+    const uint16_t base = bf->history - bf->latency;
+    beam_steer_f32(bf->left + base, bf->right + base, bf->config.block, bf->delay, mono);
+    advance(bf);
+    PROF_END(PROF_BEAM);
+    return 0;
+}
@@ -199,3 +199,10 @@ void AUDIO_IN_SAI_PDMx_DMAx_IRQHandler(void)
 {
     BSP_AUDIO_IN_IRQHandler(1, AUDIO_IN_DEVICE_DIGITAL_MIC);
 }
+
+/**
+ * @brief  This function handles MDMA interrupt request (bulk transfer service).
+ * @param  None
+ * @retval None
+ */
+void MDMA_IRQHandler(void) { mdma_transfer_irq(); }
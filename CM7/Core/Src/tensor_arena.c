@@ -0,0 +1,94 @@
+// tensor_arena.c
+#include "tensor_arena.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#define ARENA_MAX_TENSORS 32
+
+static uint32_t align_up(uint32_t size)
+{
+    return (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+}
+
+static int lifetimes_overlap(const ArenaTensor_t *a, const ArenaTensor_t *b)
+{
+    return a->first <= b->last && b->first <= a->last;
+}
+
+uint32_t arena_plan(ArenaTensor_t *tensors, uint8_t n_tensors)
+{
+    uint8_t order[ARENA_MAX_TENSORS];
+    uint8_t placed = 0;
+    uint32_t peak = 0;
+
+    if (n_tensors > ARENA_MAX_TENSORS)
+        return 0;
+
+    // largest first, ties keep declaration order
+    for (uint8_t i = 0; i < n_tensors; ++i)
+    {
+        uint8_t j = i;
+        while (j > 0 && tensors[order[j - 1]].size < tensors[i].size)
+        {
+            order[j] = order[j - 1];
+            --j;
+        }
+        order[j] = i;
+    }
+
+    for (uint8_t i = 0; i < n_tensors; ++i)
+    {
+        ArenaTensor_t *t = &tensors[order[i]];
+        uint32_t size = align_up(t->size);
+        uint32_t offset = 0;
+
+        // bump past every live placed tensor we would collide with, until a gap fits
+        uint8_t moved = 1;
+        while (moved)
+        {
+            moved = 0;
+            for (uint8_t k = 0; k < placed; ++k)
+            {
+                const ArenaTensor_t *o = &tensors[order[k]];
+                uint32_t o_end = o->offset + align_up(o->size);
+
+                if (!lifetimes_overlap(t, o) || o->size == 0)
+                    continue;
+                if (offset < o_end && o->offset < offset + size)
+                {
+                    offset = o_end;
+                    moved = 1;
+                }
+            }
+        }
+
+        t->offset = offset;
+        placed++;
+        if (offset + size > peak)
+            peak = offset + size;
+    }
+
+    return peak;
+}
+
+uint32_t arena_unshared_size(const ArenaTensor_t *tensors, uint8_t n_tensors)
+{
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < n_tensors; ++i)
+        total += align_up(tensors[i].size);
+    return total;
+}
+
+void arena_print(const ArenaTensor_t *tensors, uint8_t n_tensors, uint32_t peak)
+{
+    uint32_t unshared = arena_unshared_size(tensors, n_tensors);
+
+    printf("tensor               offset      bytes  steps\n");
+    for (uint8_t i = 0; i < n_tensors; ++i)
+    {
+        printf("%-18s %8lu %10lu  %u-%u\n", tensors[i].name, (unsigned long)tensors[i].offset,
+               (unsigned long)tensors[i].size, tensors[i].first, tensors[i].last);
+    }
+    printf("arena peak: %lu bytes, unshared: %lu bytes, reclaimed: %lu bytes\n",
+           (unsigned long)peak, (unsigned long)unshared, (unsigned long)(unshared - peak));
+}
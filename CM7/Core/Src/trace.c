@@ -0,0 +1,97 @@
+// trace.c
+#include "trace.h"
+#include "profiler.h"
+#include <stdint.h>
+
+#if defined(__arm__)
+#include "main.h"
+#endif
+
+static uint8_t port_seq[32];
+static volatile uint32_t drop_count;
+
+#if defined(__arm__)
+
+static inline int port_enabled(uint8_t port)
+{
+    return (ITM->TCR & ITM_TCR_ITMENA_Msk) && (ITM->TER & (1u << port));
+}
+
+// waits a bounded number of polls for the stimulus FIFO, 0 on timeout
+static inline int port_ready(uint8_t port, uint32_t spins)
+{
+    do
+    {
+        if (ITM->PORT[port].u32 != 0)
+            return 1;
+    } while (spins--);
+    return 0;
+}
+
+static void write_record(uint8_t port, uint32_t header, uint32_t timestamp, uint32_t payload)
+{
+    if (!port_enabled(port))
+        return;
+
+    // one record at a time per port, interrupts would interleave their words
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    // every attempt takes a sequence number, so dropped records show up as gaps
+    header |= port_seq[port]++;
+    if (!port_ready(port, 0))
+    {
+        drop_count++;
+    }
+    else
+    {
+        ITM->PORT[port].u32 = header;
+        // a record cut short here is skipped by the decoder on the next magic byte
+        if (port_ready(port, TRACE_WORD_SPINS))
+        {
+            ITM->PORT[port].u32 = timestamp;
+            if (port_ready(port, TRACE_WORD_SPINS))
+                ITM->PORT[port].u32 = payload;
+            else
+                drop_count++;
+        }
+        else
+        {
+            drop_count++;
+        }
+    }
+
+    __set_PRIMASK(primask);
+}
+
+#else // host
+
+static void write_record(uint8_t port, uint32_t header, uint32_t timestamp, uint32_t payload)
+{
+    (void)header;
+    (void)timestamp;
+    (void)payload;
+    port_seq[port]++;
+}
+
+#endif
+
+// magic, type, id, sequence from the top byte down
+static inline uint32_t record_header(TraceType_t type, uint8_t id)
+{
+    return (TRACE_MAGIC << 24) | ((uint32_t)type << 16) | ((uint32_t)id << 8);
+}
+
+void trace_event(uint8_t port, TraceType_t type, uint8_t id, uint32_t payload)
+{
+    if (port >= 32)
+        return;
+    write_record(port, record_header(type, id), profiler_now(), payload);
+}
+
+void trace_span(uint8_t id, uint32_t start, uint32_t ticks)
+{
+    write_record(TRACE_PORT_STAGE, record_header(TRACE_TYPE_SPAN, id), start, ticks);
+}
+
+uint32_t trace_drops(void) { return drop_count; }
@@ -0,0 +1,157 @@
+// weight_plan.c
+#include "weight_plan.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *placement_names[] = {"qspi-xip", "sram", "mdma"};
+
+void weight_plan_default_params(WeightPlanParams_t *params, uint32_t sram_budget,
+                                uint32_t staging_size)
+{
+    params->sram_budget = sram_budget;
+    params->staging_size = staging_size;
+    params->xip_bytes_per_cycle = WEIGHT_PLAN_XIP_BYTES_PER_CYCLE;
+    params->dma_bytes_per_cycle = WEIGHT_PLAN_DMA_BYTES_PER_CYCLE;
+    params->dcache_bytes = WEIGHT_PLAN_DCACHE_BYTES;
+}
+
+int weight_plan_describe_model(const CnnModel_t *model, uint16_t window,
+                               WeightLayerInfo_t *layers)
+{
+    if (!model || !layers || model->n_layers == 0 || model->n_layers > CNN_MAX_LAYERS)
+        return -1;
+
+    uint16_t cols = window;
+    for (uint8_t l = 0; l < model->n_layers; ++l)
+    {
+        const CnnConvLayer_t *layer = &model->layers[l];
+        uint32_t per_col = (uint32_t)layer->k_h * layer->k_w * layer->in_ch;
+        uint32_t macs_col = cnn_layer_out_h(layer) * layer->out_ch * per_col;
+
+        // each output column streams through the full weight tensor once
+        uint32_t passes = 1;
+        if (window)
+        {
+            if (cols < layer->k_w)
+                return -1;
+            cols -= layer->k_w - 1;
+            passes = cols;
+        }
+
+        layers[l].size = layer->out_ch * per_col;
+        layers[l].passes = passes;
+        layers[l].compute_cycles = (uint32_t)(macs_col * passes * WEIGHT_PLAN_CYCLES_PER_MAC);
+    }
+    return model->n_layers;
+}
+
+// bytes that actually come from QSPI when a layer is read in place
+static uint32_t xip_miss_bytes(const WeightLayerInfo_t *layer, const WeightPlanParams_t *params)
+{
+    if (layer->size <= params->dcache_bytes)
+        return layer->size;
+    return layer->size * layer->passes;
+}
+
+int weight_plan_build(const WeightLayerInfo_t *layers, uint8_t n_layers,
+                      const WeightPlanParams_t *params, WeightPlan_t *plan)
+{
+    if (!layers || !params || !plan || n_layers == 0 || n_layers > CNN_MAX_LAYERS)
+        return -1;
+
+    memset(plan, 0, sizeof(WeightPlan_t));
+    plan->n_layers = n_layers;
+
+    // rank by QSPI bytes saved per SRAM byte, the hottest layers go resident first
+    uint8_t order[CNN_MAX_LAYERS];
+    for (uint8_t i = 0; i < n_layers; ++i)
+        order[i] = i;
+
+    for (uint8_t i = 1; i < n_layers; ++i)
+    {
+        uint8_t cur = order[i];
+        uint64_t cur_key = (uint64_t)xip_miss_bytes(&layers[cur], params) * 1024 /
+                           (layers[cur].size ? layers[cur].size : 1);
+        int8_t j = i - 1;
+        while (j >= 0)
+        {
+            const WeightLayerInfo_t *prev = &layers[order[j]];
+            uint64_t key =
+                (uint64_t)xip_miss_bytes(prev, params) * 1024 / (prev->size ? prev->size : 1);
+            if (key >= cur_key)
+                break;
+            order[j + 1] = order[j];
+            --j;
+        }
+        order[j + 1] = cur;
+    }
+
+    for (uint8_t i = 0; i < n_layers; ++i)
+    {
+        uint8_t l = order[i];
+        uint32_t aligned = (layers[l].size + 3u) & ~3u;
+
+        if (plan->sram_used + aligned <= params->sram_budget)
+        {
+            plan->placement[l] = WEIGHT_RESIDENT;
+            plan->sram_offset[l] = plan->sram_used;
+            plan->sram_used += aligned;
+        }
+        else if (layers[l].size <= params->staging_size)
+        {
+            plan->placement[l] = WEIGHT_STREAMED;
+        }
+        else
+        {
+            plan->placement[l] = WEIGHT_XIP;
+        }
+    }
+
+    // stall model in execution order; a streamed layer's copy overlaps the layer before it
+    // (the last layer of the previous inference for layer 0)
+    for (uint8_t l = 0; l < n_layers; ++l)
+    {
+        uint32_t stall = 0;
+
+        if (plan->placement[l] == WEIGHT_XIP)
+        {
+            stall = (uint32_t)(xip_miss_bytes(&layers[l], params) / params->xip_bytes_per_cycle);
+        }
+        else if (plan->placement[l] == WEIGHT_STREAMED)
+        {
+            uint32_t copy = (uint32_t)(layers[l].size / params->dma_bytes_per_cycle);
+            uint32_t overlap = (l > 0) ? layers[l - 1].compute_cycles + plan->stall_cycles[l - 1]
+                                       : layers[n_layers - 1].compute_cycles;
+            stall = (copy > overlap) ? copy - overlap : 0;
+        }
+
+        plan->stall_cycles[l] = stall;
+        plan->total_stall_cycles += stall;
+        plan->total_compute_cycles += layers[l].compute_cycles;
+    }
+
+    return 0;
+}
+
+void weight_plan_print(const WeightLayerInfo_t *layers, const WeightPlan_t *plan,
+                       uint32_t core_hz)
+{
+    printf("layer      bytes  passes  placement      compute        stall\n");
+    for (uint8_t l = 0; l < plan->n_layers; ++l)
+    {
+        printf("%5u %10lu %7lu  %-9s %12lu %12lu\n", l, (unsigned long)layers[l].size,
+               (unsigned long)layers[l].passes, placement_names[plan->placement[l]],
+               (unsigned long)layers[l].compute_cycles, (unsigned long)plan->stall_cycles[l]);
+    }
+
+    uint32_t total = plan->total_compute_cycles + plan->total_stall_cycles;
+    printf("resident sram: %lu bytes\n", (unsigned long)plan->sram_used);
+    printf("compute: %lu cycles, stall budget: %lu cycles (%.1f%% of %lu)\n",
+           (unsigned long)plan->total_compute_cycles, (unsigned long)plan->total_stall_cycles,
+           total ? 100.0f * plan->total_stall_cycles / total : 0.0f, (unsigned long)total);
+    if (core_hz)
+        printf("per inference: %.3f ms (%.3f ms stalled) at %lu MHz\n",
+               1000.0f * total / core_hz, 1000.0f * plan->total_stall_cycles / core_hz,
+               (unsigned long)(core_hz / 1000000u));
+}
@@ -0,0 +1,205 @@
+// weight_store.c
+#include "weight_store.h"
+#include "main.h"
+#include <stdint.h>
+#include <string.h>
+
+#define WEIGHT_DMA_TIMEOUT_MS 10
+
+static MDMA_HandleTypeDef hmdma_weights;
+
+static const CnnModel_t *store_model;
+static const WeightPlan_t *store_plan;
+static uint8_t *store_pool;
+static uint8_t *store_staging[2];
+static uint32_t store_staging_size;
+
+// prefetch bookkeeping: which layer sits (or is landing) in each staging buffer
+static int8_t staged_layer[2];
+static int8_t pending_buf;
+static uint32_t stall_count;
+static uint32_t fallback_count;
+
+static uint32_t layer_size(uint8_t l)
+{
+    const CnnConvLayer_t *layer = &store_model->layers[l];
+    return (uint32_t)layer->out_ch * layer->k_w * layer->k_h * layer->in_ch;
+}
+
+static int mdma_init(void)
+{
+    __HAL_RCC_MDMA_CLK_ENABLE();
+
+    hmdma_weights.Instance = MDMA_Channel0;
+    hmdma_weights.Init.Request = MDMA_REQUEST_SW;
+    hmdma_weights.Init.TransferTriggerMode = MDMA_FULL_TRANSFER;
+    hmdma_weights.Init.Priority = MDMA_PRIORITY_HIGH;
+    hmdma_weights.Init.Endianness = MDMA_LITTLE_ENDIANNESS_PRESERVE;
+    hmdma_weights.Init.SourceInc = MDMA_SRC_INC_WORD;
+    hmdma_weights.Init.DestinationInc = MDMA_DEST_INC_WORD;
+    hmdma_weights.Init.SourceDataSize = MDMA_SRC_DATASIZE_WORD;
+    hmdma_weights.Init.DestDataSize = MDMA_DEST_DATASIZE_WORD;
+    hmdma_weights.Init.DataAlignment = MDMA_DATAALIGN_PACKENABLE;
+    hmdma_weights.Init.BufferTransferLength = 128;
+    hmdma_weights.Init.SourceBurst = MDMA_SOURCE_BURST_32BEATS;
+    hmdma_weights.Init.DestBurst = MDMA_DEST_BURST_32BEATS;
+    hmdma_weights.Init.SourceBlockAddressOffset = 0;
+    hmdma_weights.Init.DestBlockAddressOffset = 0;
+
+    return (HAL_MDMA_Init(&hmdma_weights) == HAL_OK) ? 0 : -1;
+}
+
+// next layer after l (wrapping into the next inference) that the plan streams
+static int8_t next_streamed(uint8_t l)
+{
+    for (uint8_t i = 1; i <= store_plan->n_layers; ++i)
+    {
+        uint8_t n = (l + i) % store_plan->n_layers;
+        if (store_plan->placement[n] == WEIGHT_STREAMED)
+            return (int8_t)n;
+    }
+    return -1;
+}
+
+static void prefetch(uint8_t l, uint8_t buf)
+{
+    uint32_t words = (layer_size(l) + 3u) / 4u;
+
+    if (HAL_MDMA_Start(&hmdma_weights, (uint32_t)store_model->layers[l].weights,
+                       (uint32_t)store_staging[buf], words * 4u, 1) != HAL_OK)
+    {
+        staged_layer[buf] = -1;
+        return;
+    }
+    staged_layer[buf] = (int8_t)l;
+    pending_buf = (int8_t)buf;
+}
+
+// 0 once the pending copy has landed, -1 if it failed and its buffer holds no whole layer
+static int wait_prefetch(void)
+{
+    if (pending_buf < 0)
+        return 0;
+
+    const int8_t buf = pending_buf;
+    pending_buf = -1;
+
+    // a poll with a zero timeout aborts a running transfer, so the stall is read off CTCIF
+    if (__HAL_MDMA_GET_FLAG(&hmdma_weights, MDMA_FLAG_CTC) == 0U)
+        stall_count++;
+    // a timeout aborts the copy part way
+    if (HAL_MDMA_PollForTransfer(&hmdma_weights, HAL_MDMA_FULL_TRANSFER, WEIGHT_DMA_TIMEOUT_MS) !=
+        HAL_OK)
+    {
+        staged_layer[buf] = -1;
+        return -1;
+    }
+
+    // the core may hold stale lines of a staging buffer placed in cacheable AXI SRAM
+    SCB_InvalidateDCache_by_Addr((uint32_t *)store_staging[buf], store_staging_size);
+    return 0;
+}
+
+int weight_store_init(const CnnModel_t *model, const WeightPlan_t *plan, uint8_t *sram_pool,
+                      uint8_t *staging, uint32_t staging_size)
+{
+    if (!model || !plan || plan->n_layers != model->n_layers)
+        return -1;
+
+    BSP_QSPI_Init_t qspi_init;
+    qspi_init.InterfaceMode = MT25TL01G_QPI_MODE;
+    qspi_init.TransferRate = MT25TL01G_DTR_TRANSFER;
+    qspi_init.DualFlashMode = MT25TL01G_DUALFLASH_ENABLE;
+
+    if (BSP_QSPI_Init(0, &qspi_init) != BSP_ERROR_NONE ||
+        BSP_QSPI_EnableMemoryMappedMode(0) != BSP_ERROR_NONE)
+        return -1;
+
+    if (mdma_init() != 0)
+        return -1;
+
+    store_model = model;
+    store_plan = plan;
+    store_pool = sram_pool;
+    store_staging[0] = staging;
+    store_staging[1] = staging + staging_size;
+    store_staging_size = staging_size;
+    staged_layer[0] = staged_layer[1] = -1;
+    pending_buf = -1;
+    stall_count = 0;
+    fallback_count = 0;
+
+    // hot layers are copied once at boot
+    for (uint8_t l = 0; l < plan->n_layers; ++l)
+    {
+        if (plan->placement[l] != WEIGHT_RESIDENT)
+            continue;
+        if (!sram_pool)
+            return -1;
+        memcpy(sram_pool + plan->sram_offset[l], model->layers[l].weights, layer_size(l));
+    }
+
+    // the first streamed layer is staged before the first inference
+    int8_t first = next_streamed(plan->n_layers - 1);
+    if (first >= 0)
+    {
+        if (!staging)
+            return -1;
+        prefetch((uint8_t)first, 0);
+    }
+
+    cnn_set_weight_fetch(weight_store_fetch);
+    return 0;
+}
+
+const int8_t *weight_store_fetch(uint8_t layer, const int8_t *weights, uint32_t size)
+{
+    if (!store_plan || layer >= store_plan->n_layers)
+        return weights;
+
+    switch (store_plan->placement[layer])
+    {
+    case WEIGHT_RESIDENT:
+        return (const int8_t *)(store_pool + store_plan->sram_offset[layer]);
+
+    case WEIGHT_STREAMED:
+    {
+        // a failed prefetch unstages its buffer and is retried below
+        wait_prefetch();
+
+        uint8_t buf;
+        if (staged_layer[0] == (int8_t)layer)
+            buf = 0;
+        else if (staged_layer[1] == (int8_t)layer)
+            buf = 1;
+        else
+        {
+            // out-of-order request, copy synchronously
+            buf = 0;
+            stall_count++;
+            prefetch(layer, buf);
+            if (wait_prefetch() != 0 || staged_layer[buf] != (int8_t)layer)
+            {
+                // the layer reads its weights straight from the memory-mapped flash
+                fallback_count++;
+                return weights;
+            }
+        }
+
+        // overlap the next streamed layer's copy with this layer's compute
+        int8_t next = next_streamed(layer);
+        if (next >= 0 && next != (int8_t)layer)
+            prefetch((uint8_t)next, buf ^ 1u);
+
+        return (const int8_t *)store_staging[buf];
+    }
+
+    default:
+        (void)size;
+        return weights;
+    }
+}
+
+uint32_t weight_store_stalls(void) { return stall_count; }
+
+uint32_t weight_store_fallbacks(void) { return fallback_count; }
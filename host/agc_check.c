@@ -0,0 +1,402 @@
+// agc_check.c
+// Checks the capture AGC with the firmware's configuration (1 ms blocks of 16 stereo frames):
+//   math      agc_power_dbfs_q16 and agc_db_to_linear_q16 against double over their ranges
+//   config    out-of-range configs are rejected
+//   step      tone steps up and down: the gain settles on target - level without overshooting
+//             it and then holds within AGC_MAX_RIPPLE_DB (a feed-forward loop has nothing to
+//             oscillate; what is left is the block RMS of the rounded tone)
+//   bursts    random levels held 20 ms to 3 s: gain inside [min, max], per-block moves within the
+//             attack/release rates unless the peak guard cut, output peaks under limit_dbfs
+//   gate      after settling, silence and sub-gate noise leave the gain where it was
+//   log       output level - logged gain = input level, the compensation the mel stage applies
+//   perf      ns per block on the ramp and peak-guard paths, both well inside the 1 ms period
+//
+// usage: agc_check [--seed S]   (exit status 1 if any check failed)
+#include "agc.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CHANNELS 2
+#define BLOCK_FRAMES 16 // 1 ms at 16 kHz
+#define BLOCK_RATE 1000
+#define BLOCK_SAMPLES (CHANNELS * BLOCK_FRAMES)
+#define PI_D 3.14159265358979323846
+
+#define AGC_MAX_MATH_ERROR_DB 0.005
+#define AGC_MAX_SETTLE_ERROR_DB 0.05
+#define AGC_MAX_RIPPLE_DB 0.05 // block RMS of a rounded -50 dBFS tone moves by ~0.03 dB
+#define AGC_MAX_BLOCK_NS 10000.0 // 1 % of the block period
+#define AGC_PERF_BLOCKS 20000
+
+static const AgcConfig_t firmware_config = {.channels = CHANNELS,
+                                            .block_rate = BLOCK_RATE,
+                                            .target_dbfs = -30.0f,
+                                            .limit_dbfs = -1.0f,
+                                            .gate_dbfs = -70.0f,
+                                            .min_gain_db = -12.0f,
+                                            .max_gain_db = 30.0f,
+                                            .initial_gain_db = 0.0f,
+                                            .attack_db_per_s = 30.0f,
+                                            .release_db_per_s = 6.0f};
+
+static int16_t block[BLOCK_SAMPLES];
+static uint32_t rng_state;
+static double phase;
+
+static uint32_t next_random(void)
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+static double uniform(void)
+{
+    return (next_random() & 0xFFFFFF) / 16777216.0;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int16_t round16(double v)
+{
+    v = floor(v + 0.5);
+    return (int16_t)((v > 32767.0) ? 32767.0 : (v < -32768.0) ? -32768.0 : v);
+}
+
+// one block of a 1 kHz tone (one period per 16 frames, so every block has the same RMS) at an
+// RMS of rms_dbfs, the right channel 3 dB under the left
+static void tone_block(double rms_dbfs)
+{
+    const double amplitude = 32768.0 * sqrt(2.0) * pow(10.0, rms_dbfs / 20.0);
+    for (uint32_t t = 0; t < BLOCK_FRAMES; ++t)
+    {
+        const double s = sin(phase + 2.0 * PI_D * t / 16.0);
+        block[CHANNELS * t] = round16(amplitude * s);
+        block[CHANNELS * t + 1] = round16(amplitude * 0.7071 * s);
+    }
+    phase += 0.37; // the block boundary moves through the period
+}
+
+// one block of uniform noise of peak amplitude 10^(peak_dbfs / 20)
+static void noise_block(double peak_dbfs)
+{
+    const double amplitude = 32767.0 * pow(10.0, peak_dbfs / 20.0);
+    for (uint32_t i = 0; i < BLOCK_SAMPLES; ++i)
+        block[i] = round16(amplitude * (2.0 * uniform() - 1.0));
+}
+
+static double rms_dbfs(const int16_t *x, uint32_t n)
+{
+    double e = 0.0;
+    for (uint32_t i = 0; i < n; ++i)
+        e += (double)x[i] * x[i];
+    return (e > 0.0) ? 10.0 * log10(e / n / (32768.0 * 32768.0)) : -200.0;
+}
+
+static double peak_dbfs(const int16_t *x, uint32_t n)
+{
+    int peak = 0;
+    for (uint32_t i = 0; i < n; ++i)
+        peak = (abs(x[i]) > peak) ? abs(x[i]) : peak;
+    return peak ? 20.0 * log10(peak / 32768.0) : -200.0;
+}
+
+static double q16_db(int32_t v)
+{
+    return v / 65536.0;
+}
+
+static int init(Agc_t *agc, const AgcConfig_t *config)
+{
+    if (agc_init(agc, config) != 0)
+    {
+        printf("agc_init failed\n");
+        return 1;
+    }
+    return 0;
+}
+
+static int check_math(void)
+{
+    double worst_power = 0.0, worst_linear = 0.0;
+    for (uint32_t i = 0; i < 200000; ++i)
+    {
+        const uint32_t n = 1 + next_random() % 4096;
+        // energies from one LSB to full scale per sample, log-uniform
+        const double mean = pow(2.0, 30.0 * uniform());
+        const uint64_t energy = (uint64_t)(mean * n) + 1;
+        const double expect = 10.0 * log10((double)energy / n / (32768.0 * 32768.0));
+        const double err = fabs(q16_db(agc_power_dbfs_q16(energy, n)) - expect);
+        worst_power = (err > worst_power) ? err : worst_power;
+    }
+    for (int32_t g = (int32_t)(AGC_MIN_GAIN_DB * 65536); g <= (int32_t)(AGC_MAX_GAIN_DB * 65536);
+         g += 997)
+    {
+        const double err = fabs(20.0 * log10(agc_db_to_linear_q16(g) / 65536.0) - q16_db(g));
+        worst_linear = (err > worst_linear) ? err : worst_linear;
+    }
+
+    const int fail = worst_power > AGC_MAX_MATH_ERROR_DB || worst_linear > AGC_MAX_MATH_ERROR_DB ||
+                     q16_db(agc_power_dbfs_q16(0, 16)) != AGC_SILENCE_DBFS;
+    printf("agc math           power %.4f dB, dB->linear %.4f dB worst  %s\n", worst_power,
+           worst_linear, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+static int check_config(void)
+{
+    Agc_t agc;
+    int fail = 0;
+    for (int i = 0; i < 7; ++i)
+    {
+        AgcConfig_t c = firmware_config;
+        switch (i)
+        {
+        case 0: c.channels = 0; break;
+        case 1: c.block_rate = 0; break;
+        case 2: c.max_gain_db = AGC_MAX_GAIN_DB + 1.0f; break;
+        case 3: c.initial_gain_db = c.max_gain_db + 1.0f; break;
+        case 4: c.attack_db_per_s = 0.0f; break;
+        case 5: c.target_dbfs = c.limit_dbfs; break;
+        case 6: c.limit_dbfs = 1.0f; break;
+        }
+        fail |= agc_init(&agc, &c) == 0;
+    }
+    fail |= agc_init(&agc, &firmware_config) != 0;
+    printf("agc config         %s\n", fail ? "FAIL" : "ok");
+    return fail;
+}
+
+// runs n_blocks of a tone at level and returns how far the gain went past where it ended, in
+// the direction it travelled (overshoot); *ripple is the spread over the last quarter, where
+// it has settled
+static double run_step(Agc_t *agc, double level, uint32_t n_blocks, double *ripple,
+                       double *gain_db)
+{
+    const double start = q16_db(agc->gain_q16);
+    double lo = 1e9, hi = -1e9, settled_lo = 1e9, settled_hi = -1e9;
+    for (uint32_t b = 0; b < n_blocks; ++b)
+    {
+        tone_block(level);
+        agc_process(agc, block, BLOCK_FRAMES);
+        const double g = q16_db(agc->gain_q16);
+        lo = (g < lo) ? g : lo;
+        hi = (g > hi) ? g : hi;
+        if (b >= 3 * n_blocks / 4)
+        {
+            settled_lo = (g < settled_lo) ? g : settled_lo;
+            settled_hi = (g > settled_hi) ? g : settled_hi;
+        }
+    }
+    *ripple = settled_hi - settled_lo;
+    *gain_db = q16_db(agc->gain_q16);
+    return (*gain_db >= start) ? hi - *gain_db : *gain_db - lo;
+}
+
+static int check_step(void)
+{
+    Agc_t agc;
+    if (init(&agc, &firmware_config))
+        return 1;
+
+    int fail = 0;
+    // quiet to loud and back: 30 dB of rise at 6 dB/s, 33 dB of fall at 30 dB/s, 24 dB of rise
+    const double levels[] = {-66.0, -26.0, -50.0};
+    for (int s = 0; s < 3; ++s)
+    {
+        double ripple, gain;
+        const double overshoot = run_step(&agc, levels[s], 8 * BLOCK_RATE, &ripple, &gain);
+        tone_block(levels[s]);
+        const double want = fmin(fmax(firmware_config.target_dbfs - rms_dbfs(block, BLOCK_SAMPLES),
+                                      firmware_config.min_gain_db),
+                                 firmware_config.max_gain_db);
+        const int bad = fabs(gain - want) > AGC_MAX_SETTLE_ERROR_DB ||
+                        overshoot > AGC_MAX_RIPPLE_DB || ripple > AGC_MAX_RIPPLE_DB;
+        printf("agc step %5.0f dB   gain %6.2f dB (want %6.2f), overshoot %.3f dB, "
+               "ripple %.3f dB  %s\n",
+               levels[s], gain, want, overshoot, ripple, bad ? "FAIL" : "ok");
+        fail |= bad;
+    }
+    return fail;
+}
+
+static int check_bursts(void)
+{
+    Agc_t agc;
+    if (init(&agc, &firmware_config))
+        return 1;
+
+    const double attack = firmware_config.attack_db_per_s / BLOCK_RATE;
+    const double release = firmware_config.release_db_per_s / BLOCK_RATE;
+    const double slack = 2.0 / 65536.0;
+    uint32_t bad_rate = 0, bad_range = 0, bad_peak = 0, guarded = 0;
+    double worst_peak = -200.0, level = -60.0;
+    int noise = 0;
+    uint32_t next_change = 0;
+    for (uint32_t b = 0; b < 120 * BLOCK_RATE; ++b)
+    {
+        if (b == next_change)
+        {
+            level = -80.0 + 80.0 * uniform();
+            noise = next_random() & 1;
+            next_change += 20 + next_random() % (3 * BLOCK_RATE);
+        }
+        noise ? noise_block(level) : tone_block(level - 3.0);
+        const double in_peak = peak_dbfs(block, BLOCK_SAMPLES);
+        const double before = q16_db(agc.gain_q16);
+        const uint32_t limited = agc.limited;
+        agc_process(&agc, block, BLOCK_FRAMES);
+        const double after = q16_db(agc.gain_q16), move = after - before;
+
+        bad_range += after < firmware_config.min_gain_db - slack ||
+                     after > firmware_config.max_gain_db + slack;
+        if (agc.limited != limited)
+            guarded++;
+        else
+            bad_rate += move > release + slack || -move > attack + slack;
+        // the guard can only hold the limit while the minimum gain leaves room for it
+        if (in_peak + firmware_config.min_gain_db <= firmware_config.limit_dbfs)
+        {
+            const double out_peak = peak_dbfs(block, BLOCK_SAMPLES);
+            worst_peak = (out_peak > worst_peak) ? out_peak : worst_peak;
+            bad_peak += out_peak > firmware_config.limit_dbfs + 0.01;
+        }
+    }
+
+    const int fail = bad_rate || bad_range || bad_peak;
+    printf("agc bursts         %u blocks over rate, %u out of range, %u over limit "
+           "(worst peak %.2f dBFS), %u guarded  %s\n",
+           bad_rate, bad_range, bad_peak, worst_peak, guarded, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+static int check_gate(void)
+{
+    Agc_t agc;
+    if (init(&agc, &firmware_config))
+        return 1;
+
+    double ripple, gain;
+    run_step(&agc, -45.0, 5 * BLOCK_RATE, &ripple, &gain);
+    const int32_t held = agc.gain_q16;
+    uint32_t moved = 0;
+    for (uint32_t b = 0; b < 2 * BLOCK_RATE; ++b)
+    {
+        if (b < BLOCK_RATE)
+            memset(block, 0, sizeof(block));
+        else
+            noise_block(firmware_config.gate_dbfs - 10.0);
+        agc_process(&agc, block, BLOCK_FRAMES);
+        moved += agc.gain_q16 != held;
+    }
+
+    const int fail = moved != 0;
+    printf("agc gate           gain %.2f dB held through 2 s of silence and noise, %u moves  %s\n",
+           q16_db(held), moved, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+static int check_log(void)
+{
+    Agc_t agc;
+    if (init(&agc, &firmware_config))
+        return 1;
+
+    // settled blocks only: inside a ramp the logged end-of-block gain leads the applied one
+    double ripple, gain, worst = 0.0;
+    const double levels[] = {-60.0, -45.0, -35.0, -20.0};
+    for (int s = 0; s < 4; ++s)
+    {
+        run_step(&agc, levels[s], 8 * BLOCK_RATE, &ripple, &gain);
+        tone_block(levels[s]);
+        const double in = rms_dbfs(block, BLOCK_SAMPLES);
+        const double logged = agc_process(&agc, block, BLOCK_FRAMES) / 256.0;
+        const double err = fabs(rms_dbfs(block, BLOCK_SAMPLES) - logged - in);
+        worst = (err > worst) ? err : worst;
+    }
+
+    const int fail = worst > AGC_MAX_SETTLE_ERROR_DB;
+    printf("agc log            output - logged gain vs input %.3f dB worst  %s\n", worst,
+           fail ? "FAIL" : "ok");
+    return fail;
+}
+
+static double time_blocks(Agc_t *agc, double level)
+{
+    static int16_t blocks[64][BLOCK_SAMPLES];
+    for (int b = 0; b < 64; ++b)
+    {
+        tone_block(level);
+        memcpy(blocks[b], block, sizeof(block));
+    }
+
+    double best = 1e18;
+    for (int rep = 0; rep < 5; ++rep)
+    {
+        const double start = now_ns();
+        for (uint32_t b = 0; b < AGC_PERF_BLOCKS; ++b)
+        {
+            memcpy(block, blocks[b % 64], sizeof(block));
+            agc_process(agc, block, BLOCK_FRAMES);
+        }
+        const double ns = (now_ns() - start) / AGC_PERF_BLOCKS;
+        best = (ns < best) ? ns : best;
+    }
+    return best;
+}
+
+static int check_perf(void)
+{
+    Agc_t agc;
+    if (init(&agc, &firmware_config))
+        return 1;
+
+    // the ramp path at a level above the gate, then a level the peak guard cuts every block
+    const double ramp = time_blocks(&agc, -50.0);
+    AgcConfig_t loud = firmware_config;
+    loud.initial_gain_db = loud.max_gain_db;
+    loud.attack_db_per_s = 0.001f;
+    if (init(&agc, &loud))
+        return 1;
+    const double cut = time_blocks(&agc, -3.0);
+
+    const int fail = ramp > AGC_MAX_BLOCK_NS || cut > AGC_MAX_BLOCK_NS || agc.limited == 0;
+    printf("agc perf           %.0f ns per ramped block, %.0f ns per cut block, budget %.0f ns  "
+           "%s\n",
+           ramp, cut, AGC_MAX_BLOCK_NS, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seed = 1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else
+        {
+            fprintf(stderr, "usage: %s [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    rng_state = seed;
+
+    int failed = 0;
+    failed |= check_math();
+    failed |= check_config();
+    failed |= check_step();
+    failed |= check_bursts();
+    failed |= check_gate();
+    failed |= check_log();
+    failed |= check_perf();
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,66 @@
+// arena_report.c
+// Prints the liveness plan of the pipeline arena for a mel configuration and the memory it
+// reclaims compared with one buffer per tensor and, for the feature buffers, with the old
+// static/stack layout.
+//
+// usage: arena_report [fft_size n_mels n_frames cnn_workspace_bytes [fused]]
+#include "pipeline_arena.h"
+#include "tensor_arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char **argv)
+{
+    MelSpectrogramConfig_t config = {.sample_rate = 16000,
+                                     .fft_size = 512,
+                                     .hop_length = 256,
+                                     .n_mels = 64,
+                                     .f_min = 0.0f,
+                                     .f_max = 8000.0f};
+    uint16_t n_frames = 64;
+    uint32_t cnn_workspace = 32 * 1024;
+    uint8_t fused = 0;
+
+    if (argc == 5 || argc == 6)
+    {
+        config.fft_size = (uint16_t)atoi(argv[1]);
+        config.n_mels = (uint16_t)atoi(argv[2]);
+        n_frames = (uint16_t)atoi(argv[3]);
+        cnn_workspace = (uint32_t)atol(argv[4]);
+        fused = (argc == 6) && atoi(argv[5]);
+    }
+    else if (argc != 1)
+    {
+        fprintf(stderr, "usage: %s [fft_size n_mels n_frames cnn_workspace_bytes [fused]]\n",
+                argv[0]);
+        return 2;
+    }
+
+    ArenaTensor_t tensors[PIPELINE_N_TENSORS];
+    uint32_t peak = pipeline_arena_plan(&config, n_frames, cnn_workspace, fused, tensors);
+
+    printf("fft %u, mels %u, frames %u, cnn workspace %lu, %s features\n", config.fft_size,
+           config.n_mels, n_frames, (unsigned long)cnn_workspace, fused ? "fused int8" : "float");
+    arena_print(tensors, PIPELINE_N_TENSORS, peak);
+
+    // the baseline's feature buffers: Hann window and dense filterbank statics sized for MAX_*,
+    // one frame of FFT input and power spectrum on the stack, and audio_record.c's mel_spec;
+    // it had no int8 model input or CNN workspace, so the arena side leaves those out too (the
+    // fused path's model input is its feature output and stays)
+    const uint32_t legacy = (MAX_FFT_SIZE + MAX_MEL_BANDS * (MAX_FFT_SIZE / 2 + 1)) *
+                                sizeof(float) +
+                            (MAX_FFT_SIZE + MAX_FFT_SIZE / 2 + 1) * sizeof(float) +
+                            64 * 64 * sizeof(float);
+    ArenaTensor_t features[PIPELINE_N_TENSORS];
+    pipeline_arena_plan(&config, n_frames, 0, fused, features);
+    if (!fused)
+        features[TENSOR_MODEL_INPUT].size = 0;
+    const uint32_t feature_peak = arena_plan(features, PIPELINE_N_TENSORS);
+    printf("previous static layout: %lu bytes, feature buffers in the arena: %lu bytes, "
+           "reclaimed: %ld bytes\n",
+           (unsigned long)legacy, (unsigned long)feature_peak, (long)legacy - (long)feature_peak);
+    printf("fits PIPELINE_ARENA_SIZE (%u): %s\n", PIPELINE_ARENA_SIZE,
+           peak <= PIPELINE_ARENA_SIZE ? "yes" : "NO");
+
+    return peak <= PIPELINE_ARENA_SIZE ? 0 : 1;
+}
@@ -0,0 +1,350 @@
+// beam_check.c
+// Checks the stereo front end on synthetic two-microphone recordings, where the right channel
+// is the left one delayed by an exact (fractional) number of samples and each microphone adds
+// its own noise:
+//   deinterleave  both kernels against the plain split
+//   latency       identical channels come out unchanged, latency samples late
+//   kernels       Q15 steering within BEAM_Q15_TOLERANCE LSB of the float steering
+//   doa           GCC-PHAT delay after BEAM_SETTLE_BLOCKS blocks within BEAM_DOA_TOLERANCE samples,
+//                 broadband source, board spacing (2 cm) and a 10 cm pair
+//   snr           delay-and-sum gain over one microphone for a distant owl (400 Hz hoots in
+//                 0 dB microphone noise), at least BEAM_MIN_GAIN_DB
+//   perf          beam_process_q15 per block against BEAM_BUDGET_TICKS_PER_BLOCK
+//
+// usage: beam_check [--seed S]   (exit status 1 if any check failed)
+#include "profiler.h"
+#include "stereo_beam.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SAMPLE_RATE 16000
+#define BLOCK 512
+#define N_BLOCKS 48
+#define N_SAMPLES (N_BLOCKS * BLOCK)
+#define MARGIN 64 // samples before and after each signal for the steering reach
+#define N_TONES 48
+
+#define BEAM_SETTLE_BLOCKS 16
+#define BEAM_DOA_TOLERANCE 0.1f
+#define BEAM_Q15_TOLERANCE 2
+#define BEAM_MIN_GAIN_DB 2.5
+#define BEAM_PERF_RUNS 8
+
+static uint8_t workspace[64 * 1024];
+static float left_f[N_SAMPLES + 2 * MARGIN];
+static float right_f[N_SAMPLES + 2 * MARGIN];
+static int16_t left[N_SAMPLES + 2 * MARGIN];
+static int16_t right[N_SAMPLES + 2 * MARGIN];
+static int16_t noise_l[N_SAMPLES + 2 * MARGIN];
+static int16_t noise_r[N_SAMPLES + 2 * MARGIN];
+static int16_t stereo[2 * N_SAMPLES];
+static int16_t mono[N_SAMPLES];
+static int16_t split_l[N_SAMPLES], split_r[N_SAMPLES];
+static int16_t out_q15[N_SAMPLES], out_noise[N_SAMPLES];
+static float out_f32[N_SAMPLES];
+
+static uint32_t rng_state;
+
+static uint32_t next_random(void)
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+static float uniform(void)
+{
+    return (next_random() & 0xFFFF) / 65535.0f;
+}
+
+static float gaussian(void)
+{
+    float s = 0.0f;
+    for (int i = 0; i < 4; ++i)
+        s += uniform();
+    return (s - 2.0f) * 1.7320508f;
+}
+
+static int16_t saturate(float v)
+{
+    return (int16_t)(v > 32767.0f ? 32767 : (v < -32768.0f ? -32768 : (int)lrintf(v)));
+}
+
+typedef enum
+{
+    SOURCE_BROADBAND, // random tones over the GCC band
+    SOURCE_OWL,       // 400 Hz hoots with two harmonics, 0.4 s on every second
+} Source_t;
+
+// source sampled at t and at t - delay, so the right channel is an exact fractional delay
+static void synth_pair(Source_t source, float delay, float amplitude)
+{
+    float freq[N_TONES], phase[N_TONES];
+    for (int k = 0; k < N_TONES; ++k)
+    {
+        freq[k] = 300.0f + uniform() * 6500.0f;
+        phase[k] = 2.0f * (float)M_PI * uniform();
+    }
+
+    for (int i = 0; i < N_SAMPLES + 2 * MARGIN; ++i)
+    {
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            const double t = (double)(i - MARGIN - (ch ? delay : 0.0f)) / SAMPLE_RATE;
+            double v = 0.0;
+            if (source == SOURCE_BROADBAND)
+            {
+                for (int k = 0; k < N_TONES; ++k)
+                    v += sin(2.0 * M_PI * freq[k] * t + phase[k]);
+                v /= sqrt(N_TONES / 2.0);
+            }
+            else
+            {
+                const double cycle = fmod(t + 10.0, 1.0);
+                const double envelope = (cycle < 0.4) ? sin(M_PI * cycle / 0.4) : 0.0;
+                v = envelope * (sin(2.0 * M_PI * 400.0 * t) + 0.5 * sin(2.0 * M_PI * 800.0 * t) +
+                                0.25 * sin(2.0 * M_PI * 1200.0 * t));
+            }
+            (ch ? right_f : left_f)[i] = (float)(amplitude * v);
+        }
+    }
+}
+
+static void add_noise(float rms)
+{
+    for (int i = 0; i < N_SAMPLES + 2 * MARGIN; ++i)
+    {
+        noise_l[i] = saturate(rms * gaussian());
+        noise_r[i] = saturate(rms * gaussian());
+        left[i] = saturate(left_f[i] + noise_l[i]);
+        right[i] = saturate(right_f[i] + noise_r[i]);
+    }
+}
+
+static void interleave(void)
+{
+    for (int i = 0; i < N_SAMPLES; ++i)
+    {
+        stereo[2 * i] = left[MARGIN + i];
+        stereo[2 * i + 1] = right[MARGIN + i];
+    }
+}
+
+static BeamConfig_t board_config(float spacing, uint8_t lag_steps)
+{
+    BeamConfig_t config = {.sample_rate = SAMPLE_RATE,
+                           .block = BLOCK,
+                           .mic_spacing = spacing,
+                           .lag_steps = lag_steps,
+                           .f_min = 300.0f,
+                           .f_max = 7000.0f,
+                           .min_confidence = 0.05f,
+                           .smoothing = 0.5f};
+    return config;
+}
+
+static int init(Beam_t *bf, const BeamConfig_t *config)
+{
+    if (beam_init(bf, config, workspace, sizeof(workspace)) != 0)
+    {
+        fprintf(stderr, "beam_check: init failed (spacing %g)\n", config->mic_spacing);
+        return -1;
+    }
+    return 0;
+}
+
+static int check_deinterleave(void)
+{
+    for (int i = 0; i < 2 * N_SAMPLES; ++i)
+        stereo[i] = (int16_t)(next_random() & 0xFFFF);
+    for (uint32_t n = 1; n <= 9; n += 8)
+    {
+        const uint32_t count = N_SAMPLES - n; // odd and even lengths
+        beam_deinterleave(stereo, count, split_l, split_r);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (split_l[i] != stereo[2 * i] || split_r[i] != stereo[2 * i + 1])
+            {
+                printf("beam deinterleave  frame %lu of %lu differs  FAIL\n", (unsigned long)i,
+                       (unsigned long)count);
+                return 1;
+            }
+        }
+    }
+    printf("beam deinterleave  ok\n");
+    return 0;
+}
+
+static int check_latency(void)
+{
+    Beam_t bf;
+    BeamConfig_t config = board_config(0.02f, 16);
+    if (init(&bf, &config) != 0)
+        return 1;
+
+    for (int i = 0; i < N_SAMPLES; ++i)
+        stereo[2 * i] = stereo[2 * i + 1] = (int16_t)(next_random() & 0xFFFF);
+    for (int b = 0; b < N_BLOCKS; ++b)
+        beam_process_q15(&bf, stereo + 2 * b * BLOCK, mono + b * BLOCK);
+
+    // identical channels steer to zero delay, where the taps are exact
+    for (int i = bf.latency; i < N_SAMPLES; ++i)
+    {
+        if (mono[i] != stereo[2 * (i - bf.latency)])
+        {
+            printf("beam latency       sample %d: %d, expected %d (delay %.3f)  FAIL\n", i,
+                   mono[i], stereo[2 * (i - bf.latency)], bf.delay);
+            return 1;
+        }
+    }
+    printf("beam latency       %u samples, output exact  ok\n", bf.latency);
+    return 0;
+}
+
+static int check_kernels(void)
+{
+    int worst = 0;
+    for (int i = 0; i < N_SAMPLES + 2 * MARGIN; ++i)
+    {
+        left[i] = (int16_t)(next_random() & 0xFFFF);
+        right[i] = (int16_t)(next_random() & 0xFFFF);
+    }
+    for (int trial = 0; trial < 64; ++trial)
+    {
+        const float delay = (uniform() - 0.5f) * 2.0f * 8.0f;
+        beam_steer_q15(left + MARGIN, right + MARGIN, N_SAMPLES, delay, out_q15);
+        beam_steer_f32(left + MARGIN, right + MARGIN, N_SAMPLES, delay, out_f32);
+        for (int i = 0; i < N_SAMPLES; ++i)
+        {
+            const float clipped = fmaxf(-32768.0f, fminf(32767.0f, out_f32[i]));
+            const int err = abs(out_q15[i] - (int)lrintf(clipped));
+            if (err > worst)
+                worst = err;
+        }
+    }
+    const int fail = worst > BEAM_Q15_TOLERANCE;
+    printf("beam kernels       q15 within %d LSB of f32, tolerance %d  %s\n", worst,
+           BEAM_Q15_TOLERANCE, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+static int check_doa(float spacing, uint8_t lag_steps)
+{
+    const float fractions[] = {-0.9f, -0.55f, -0.2f, 0.0f, 0.35f, 0.8f};
+    BeamConfig_t config = board_config(spacing, lag_steps);
+    Beam_t bf;
+    if (init(&bf, &config) != 0)
+        return 1;
+
+    float worst = 0.0f;
+    for (size_t f = 0; f < sizeof(fractions) / sizeof(fractions[0]); ++f)
+    {
+        const float delay = fractions[f] * bf.max_lag;
+        synth_pair(SOURCE_BROADBAND, delay, 3000.0f);
+        add_noise(950.0f); // 10 dB SNR at each microphone
+        interleave();
+
+        beam_reset(&bf);
+        for (int b = 0; b < BEAM_SETTLE_BLOCKS; ++b)
+            beam_process_q15(&bf, stereo + 2 * b * BLOCK, mono + b * BLOCK);
+        worst = fmaxf(worst, fabsf(bf.delay - delay));
+    }
+    const int fail = worst > BEAM_DOA_TOLERANCE;
+    printf("beam doa %4.0f mm   max |error| %.3f samples of %.2f, tolerance %.2f  %s\n",
+           spacing * 1000.0f, worst, bf.max_lag, BEAM_DOA_TOLERANCE, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+static double energy(const int16_t *x, int n)
+{
+    double e = 0.0;
+    for (int i = 0; i < n; ++i)
+        e += (double)x[i] * x[i];
+    return e;
+}
+
+static int check_snr(void)
+{
+    BeamConfig_t config = board_config(0.02f, 16);
+    config.f_max = 2000.0f; // the owl band
+    Beam_t bf;
+    if (init(&bf, &config) != 0)
+        return 1;
+
+    const float delay = 0.6f * bf.max_lag;
+    synth_pair(SOURCE_OWL, delay, 2000.0f);
+    add_noise(1000.0f);
+    interleave();
+    for (int b = 0; b < N_BLOCKS; ++b)
+        beam_process_q15(&bf, stereo + 2 * b * BLOCK, mono + b * BLOCK);
+
+    // steering is linear: the call and the noise go through the converged beam separately
+    static int16_t clean_l[N_SAMPLES + 2 * MARGIN], clean_r[N_SAMPLES + 2 * MARGIN];
+    for (int i = 0; i < N_SAMPLES + 2 * MARGIN; ++i)
+    {
+        clean_l[i] = saturate(left_f[i]);
+        clean_r[i] = saturate(right_f[i]);
+    }
+    beam_steer_q15(clean_l + MARGIN, clean_r + MARGIN, N_SAMPLES, bf.delay, out_q15);
+    beam_steer_q15(noise_l + MARGIN, noise_r + MARGIN, N_SAMPLES, bf.delay, out_noise);
+
+    const double snr_in = 10.0 * log10(energy(clean_l + MARGIN, N_SAMPLES) /
+                                       energy(noise_l + MARGIN, N_SAMPLES));
+    const double snr_out = 10.0 * log10(energy(out_q15, N_SAMPLES) / energy(out_noise, N_SAMPLES));
+    const int fail = snr_out - snr_in < BEAM_MIN_GAIN_DB;
+    printf("beam snr           owl %.1f dB -> %.1f dB, gain %.2f dB (delay %.3f of %.3f), "
+           "min %.1f  %s\n",
+           snr_in, snr_out, snr_out - snr_in, bf.delay, delay, BEAM_MIN_GAIN_DB,
+           fail ? "FAIL" : "ok");
+    return fail;
+}
+
+static int check_perf(void)
+{
+    BeamConfig_t config = board_config(0.02f, 16);
+    Beam_t bf;
+    if (init(&bf, &config) != 0)
+        return 1;
+
+    uint32_t best = UINT32_MAX;
+    for (int run = 0; run < BEAM_PERF_RUNS; ++run)
+    {
+        const uint32_t start = profiler_now();
+        beam_process_q15(&bf, stereo + 2 * (run % N_BLOCKS) * BLOCK, mono);
+        const uint32_t ticks = profiler_now() - start;
+        if (ticks < best)
+            best = ticks;
+    }
+    const int fail = best > BEAM_BUDGET_TICKS_PER_BLOCK;
+    printf("beam perf          %lu ticks/block of %d, budget %lu  %s\n", (unsigned long)best,
+           BLOCK, (unsigned long)BEAM_BUDGET_TICKS_PER_BLOCK, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seed = 1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else
+        {
+            fprintf(stderr, "usage: %s [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    rng_state = seed;
+
+    int failed = 0;
+    failed |= check_deinterleave();
+    failed |= check_latency();
+    failed |= check_kernels();
+    failed |= check_doa(0.02f, 16);
+    failed |= check_doa(0.10f, 8);
+    failed |= check_snr();
+    failed |= check_perf();
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,217 @@
+// cnn_stream_check.c
+// Checks streaming inference against the whole-window path on random int8 models: every layer
+// count up to CHECK_MAX_LAYERS, kernel shapes, frequency strides, channel counts, ReLU and
+// bias on or off, and window lengths down to the receptive field. Each model gets window + N
+// random columns through cnn_stream_push, and every classification must equal cnn_infer_window
+// on the last window columns bit for bit. Some runs reset the stream part way, as after a gap
+// in the audio, and must match again once the window has refilled.
+//
+// usage: cnn_stream_check [--seed S]   (exit status 1 if any check failed)
+#include "cnn_inference.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define N_MODELS 300
+#define CHECK_MAX_LAYERS 4
+#define MAX_IN_H 40
+#define MAX_CH 8
+#define MAX_K_H 5
+#define MAX_EXTRA_WINDOW 24 // window columns beyond the receptive field
+#define MAX_EXTRA_PUSHES 64 // columns pushed after the first full window
+#define MAX_WINDOW (1 + CHECK_MAX_LAYERS * (CNN_MAX_KERNEL_W - 1) + MAX_EXTRA_WINDOW)
+#define MAX_COLUMNS (MAX_WINDOW + MAX_EXTRA_PUSHES)
+#define MAX_FEATURES (MAX_IN_H * MAX_CH)
+
+static int8_t weights[CHECK_MAX_LAYERS][MAX_CH * CNN_MAX_KERNEL_W * MAX_K_H * MAX_CH];
+static int32_t bias[CHECK_MAX_LAYERS][MAX_CH];
+static int8_t fc_weights[CNN_MAX_CLASSES * MAX_FEATURES];
+static int32_t fc_bias[CNN_MAX_CLASSES];
+static int8_t columns[MAX_COLUMNS][MAX_IN_H]; // pushed columns since the last reset
+static int8_t window_input[MAX_IN_H * MAX_WINDOW];
+
+static uint32_t rng_state;
+
+static uint32_t next_random(void)
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+// uniform in [lo, hi]
+static uint32_t random_range(uint32_t lo, uint32_t hi)
+{
+    return lo + next_random() % (hi - lo + 1);
+}
+
+static int8_t random_int8(void)
+{
+    return (int8_t)(next_random() & 0xFF);
+}
+
+static uint8_t bit_length(uint32_t x)
+{
+    uint8_t n = 0;
+    while (x)
+    {
+        n++;
+        x >>= 1;
+    }
+    return n;
+}
+
+// random layer stack; the requantization keeps typical activations inside int8 so the
+// comparison does not degenerate into saturated columns
+static uint16_t make_model(CnnModel_t *model)
+{
+    memset(model, 0, sizeof(*model));
+    model->n_layers = (uint8_t)random_range(1, CHECK_MAX_LAYERS);
+    model->n_classes = (uint16_t)random_range(1, CNN_MAX_CLASSES);
+
+    uint16_t in_h = (uint16_t)random_range(1, MAX_IN_H);
+    uint16_t in_ch = 1;
+    uint16_t receptive = 1;
+    for (uint8_t l = 0; l < model->n_layers; ++l)
+    {
+        CnnConvLayer_t *layer = &model->layers[l];
+        layer->in_h = in_h;
+        layer->in_ch = in_ch;
+        layer->out_ch = (uint16_t)random_range(1, MAX_CH);
+        layer->k_h = (uint8_t)random_range(1, MAX_K_H);
+        layer->k_w = (uint8_t)random_range(1, CNN_MAX_KERNEL_W);
+        layer->stride_h = (uint8_t)random_range(1, 2);
+        layer->relu = (uint8_t)(next_random() & 1);
+
+        const uint32_t fan_in = (uint32_t)layer->k_w * layer->k_h * layer->in_ch;
+        for (uint32_t i = 0; i < fan_in * layer->out_ch; ++i)
+            weights[l][i] = random_int8();
+        for (uint16_t oc = 0; oc < layer->out_ch; ++oc)
+            bias[l][oc] = (int32_t)random_range(0, 1u << 16) - (1 << 15);
+        layer->weights = weights[l];
+        layer->bias = (next_random() & 3) ? bias[l] : NULL;
+        layer->out_multiplier = (int32_t)random_range(1u << 13, 1u << 15);
+        layer->out_shift = (uint8_t)(21 + bit_length(fan_in) / 2);
+
+        receptive += layer->k_w - 1;
+        in_h = cnn_layer_out_h(layer);
+        in_ch = layer->out_ch;
+    }
+
+    const uint32_t features = (uint32_t)in_h * in_ch;
+    for (uint32_t i = 0; i < model->n_classes * features; ++i)
+        fc_weights[i] = random_int8();
+    for (uint16_t c = 0; c < model->n_classes; ++c)
+        fc_bias[c] = (int32_t)random_range(0, 1u << 20) - (1 << 19);
+    model->fc_weights = fc_weights;
+    model->fc_bias = (next_random() & 1) ? fc_bias : NULL;
+    return receptive;
+}
+
+static void describe(const CnnModel_t *model, uint16_t window)
+{
+    fprintf(stderr, "  window %u, %u classes, layers (in_h x in_ch -> out_ch, k_h x k_w /stride):",
+            window, model->n_classes);
+    for (uint8_t l = 0; l < model->n_layers; ++l)
+    {
+        const CnnConvLayer_t *layer = &model->layers[l];
+        fprintf(stderr, " %ux%u->%u %ux%u/%u%s", layer->in_h, layer->in_ch, layer->out_ch,
+                layer->k_h, layer->k_w, layer->stride_h, layer->relu ? " relu" : "");
+    }
+    fprintf(stderr, "\n");
+}
+
+// one model: window + N pushes, optionally with a reset part way; returns 1 on mismatch
+static int check_model(unsigned index, unsigned *classified)
+{
+    CnnModel_t model;
+    const uint16_t receptive = make_model(&model);
+    const uint16_t window = (uint16_t)(receptive + random_range(0, MAX_EXTRA_WINDOW));
+    const uint16_t in_h = model.layers[0].in_h;
+    const uint32_t n_push = window + random_range(1, MAX_EXTRA_PUSHES);
+    // early enough that the window refills before the last push
+    const uint32_t reset_at = (next_random() & 3) ? 0 : random_range(1, n_push - window);
+
+    const uint32_t stream_size = cnn_stream_workspace_size(&model, window);
+    const uint32_t window_size = cnn_window_workspace_size(&model, window);
+    if (stream_size == 0 || window_size == 0)
+    {
+        fprintf(stderr, "cnn_stream_check: model %u rejected\n", index);
+        describe(&model, window);
+        return 1;
+    }
+    void *stream_ws = malloc(stream_size);
+    void *window_ws = malloc(window_size);
+    CnnStream_t stream;
+    int failed = cnn_stream_init(&stream, &model, window, stream_ws, stream_size) != 0;
+
+    uint32_t filled = 0; // columns pushed since the last reset
+    for (uint32_t t = 0; t < n_push && !failed; ++t)
+    {
+        if (reset_at && t == reset_at)
+        {
+            cnn_stream_reset(&stream);
+            filled = 0;
+        }
+        for (uint16_t h = 0; h < in_h; ++h)
+            columns[filled][h] = random_int8();
+        int32_t logits[CNN_MAX_CLASSES];
+        const int ret = cnn_stream_push(&stream, columns[filled], logits);
+        filled++;
+
+        if (ret != (filled >= window))
+        {
+            fprintf(stderr, "cnn_stream_check: model %u push %lu returned %d with %lu columns\n",
+                    index, (unsigned long)t, ret, (unsigned long)filled);
+            failed = 1;
+            break;
+        }
+        if (ret != 1)
+            continue;
+
+        const uint32_t first = filled - window;
+        for (uint16_t h = 0; h < in_h; ++h)
+            for (uint16_t w = 0; w < window; ++w)
+                window_input[(uint32_t)h * window + w] = columns[first + w][h];
+        int32_t expect[CNN_MAX_CLASSES];
+        if (cnn_infer_window(&model, window_input, window, window_ws, expect) != 0 ||
+            memcmp(logits, expect, model.n_classes * sizeof(int32_t)) != 0)
+        {
+            fprintf(stderr, "cnn_stream_check: model %u push %lu differs from the window path\n",
+                    index, (unsigned long)t);
+            failed = 1;
+        }
+        (*classified)++;
+    }
+
+    if (failed)
+        describe(&model, window);
+    free(stream_ws);
+    free(window_ws);
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seed = 1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else
+        {
+            fprintf(stderr, "usage: %s [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    rng_state = seed;
+
+    int failed = 0;
+    unsigned classified = 0;
+    for (unsigned m = 0; m < N_MODELS; ++m)
+        failed |= check_model(m, &classified);
+
+    printf("%u models, %u streamed classifications against cnn_infer_window: %s\n", N_MODELS,
+           classified, failed ? "FAIL" : "ok");
+    return failed ? 1 : 0;
+}
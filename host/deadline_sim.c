@@ -0,0 +1,651 @@
+// deadline_sim.c
+// Replays a recording through the firmware's feature and inference code on a simulated single
+// core and reports whether a configuration keeps up with 16 kHz capture.
+//
+// The BDMA half/full callbacks of audio_record.c are emulated on a virtual clock: every
+// AUDIO_IN_PDM_BUFFER_SIZE / 2 PDM words (1 ms) deliver 16 samples and cost --isr-us of CPU,
+// preempting the main loop. Once a feature window's last sample has arrived it is queued for the
+// main loop, which runs the real calculate_mel_spectrogram, normalize_spectrogram,
+// cnn_quantize_input and cnn_infer_window on it. Each stage's host time, multiplied by --scale,
+// is how long it occupies the simulated core. A window misses its deadline when capture wraps
+// the PCM ring over its first sample before inference is done.
+//
+// With --cascade the inference stage is cascade_classify instead: a one-layer gate model screens
+// every window and the full model only runs when the gate's score reaches the threshold. The
+// report then adds the gate score range, how often stage 2 woke and the compute per second of
+// audio, against running the full model on every window.
+//
+// usage: deadline_sim [options] [WAV]   (no WAV: 30 s of synthetic audio)
+//   --fft N --hop N --mels N --frames N   feature config (512, 256, 64, 64)
+//   --stride N      frames between window starts (= --frames, the firmware's back-to-back windows)
+//   --ring-ms MS    PCM ring length (default: one window plus one stride)
+//   --fused         calculate_mel_spectrogram_q8 instead of the float path
+//   --no-model      features only
+//   --cascade T     two-stage inference, waking the full model at gate scores >= T
+//   --isr-us US     target time of one PDM decode callback (0: PDM filter not modelled)
+//   --scale F       target time / host time of the DSP code (1: host speed)
+//   --calibrate C   derive --scale from the target's printed cycles/frame of the feature pass
+//   --cpu-mhz MHZ   core clock for the cycle figures (400)
+//   --speed S       replay pacing against the wall clock, 1 = real time (0: as fast as possible)
+// Exits with 1 when any window missed its deadline.
+#include "cascade.h"
+#include "cnn_inference.h"
+#include "mel_spectrogram.h"
+#include "wav_file.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// capture cadence, as audio_record.c
+#define AUDIO_FREQUENCY 16000U
+#define AUDIO_IN_PDM_BUFFER_SIZE (uint32_t)(128 * AUDIO_FREQUENCY / 16000 * 2)
+#define SAMPLES_PER_CALLBACK (AUDIO_IN_PDM_BUFFER_SIZE / 4 / 2)
+#define MODEL_INPUT_SCALE (1.0f / 255.0f)
+#define MODEL_INPUT_ZERO_POINT (-128)
+#define MODEL_INPUT_DB_FLOOR (-80.0f)
+#define MODEL_INPUT_DB_CEIL (60.0f)
+
+#define SYNTHETIC_SECONDS 30
+#define MAX_QUEUE 64
+
+typedef enum
+{
+    SIM_ISR = 0,
+    SIM_FEATURES,
+    SIM_NORMALIZE,
+    SIM_QUANTIZE,
+    SIM_INFERENCE,
+    SIM_N_STAGES
+} SimStage_t;
+
+static const char *const stage_names[SIM_N_STAGES] = {"pdm isr", "features", "normalize",
+                                                      "quantize", "inference"};
+
+typedef struct
+{
+    uint32_t count;
+    double busy_ns; // simulated core time
+    double max_ns;  // longest single run
+} StageStats_t;
+
+// a window waiting for, or being processed by, the main loop
+typedef struct
+{
+    uint32_t index;
+    double ready_ns;    // callback that delivered its last sample
+    double deadline_ns; // callback that overwrites its first sample
+    double stage_ns[SIM_N_STAGES];
+    uint8_t stage;
+    double left_ns; // of the current stage
+} Job_t;
+
+static MelSpectrogramConfig_t config = {.sample_rate = AUDIO_FREQUENCY, .fft_size = 512,
+                                        .hop_length = 256, .n_mels = 64, .f_min = 0.0f,
+                                        .f_max = 8000.0f};
+static uint16_t n_frames = 64;
+static uint16_t stride = 0;
+static int fused;
+static int use_model = 1;
+static int use_cascade;
+static int32_t gate_threshold;
+static double isr_ns;
+static double scale = 1.0;
+static double cpu_mhz = 400.0;
+static double speed;
+
+// two conv layers with the shapes of the owl classifier front end
+static int8_t conv0_weights[8 * 3 * 3 * 1];
+static int8_t conv1_weights[16 * 3 * 3 * 8];
+static int32_t conv0_bias[8];
+static int32_t conv1_bias[16];
+static int8_t fc_weights[2 * 16 * MAX_MEL_BANDS];
+static int32_t fc_bias[2];
+static CnnModel_t model;
+
+// the cascade's gate: one coarse conv layer, a small fraction of the full model's MACs
+static int8_t gate_weights[4 * 3 * 3 * 1];
+static int8_t gate_fc_weights[2 * 4 * MAX_MEL_BANDS];
+static CnnModel_t gate;
+static Cascade_t cascade;
+static int32_t gate_min = INT32_MAX, gate_max = INT32_MIN;
+static double gate_sum;
+
+static int16_t *pcm;
+static uint64_t n_samples;
+
+static StageStats_t stats[SIM_N_STAGES];
+static double *latencies;
+static uint32_t n_latencies;
+static uint32_t depth_hist[MAX_QUEUE + 1];
+static uint32_t windows_done, windows_missed, windows_dropped, isr_overruns;
+
+static double host_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static uint32_t window_samples(void)
+{
+    return (uint32_t)(n_frames - 1) * config.hop_length + config.fft_size;
+}
+
+static void build_model(void)
+{
+    uint32_t lcg = 7;
+
+    for (uint32_t i = 0; i < sizeof(conv0_weights); ++i)
+        conv0_weights[i] = (int8_t)((lcg = lcg * 1664525u + 1013904223u) >> 25);
+    for (uint32_t i = 0; i < sizeof(conv1_weights); ++i)
+        conv1_weights[i] = (int8_t)((lcg = lcg * 1664525u + 1013904223u) >> 25);
+
+    model = (CnnModel_t){
+        .n_layers = 2,
+        .layers = {{config.n_mels, 1, 8, 3, 3, 2, 1, conv0_weights, conv0_bias, 1 << 20, 24},
+                   {0, 8, 16, 3, 3, 2, 1, conv1_weights, conv1_bias, 1 << 20, 24}},
+        .n_classes = 2,
+        .fc_weights = fc_weights,
+        .fc_bias = fc_bias,
+    };
+    model.layers[1].in_h = cnn_layer_out_h(&model.layers[0]);
+
+    // signed dense weights, so the gate score follows the features instead of only growing
+    for (uint32_t i = 0; i < sizeof(gate_weights); ++i)
+        gate_weights[i] = (int8_t)((lcg = lcg * 1664525u + 1013904223u) >> 25);
+    for (uint32_t i = 0; i < sizeof(gate_fc_weights); ++i)
+        gate_fc_weights[i] = (int8_t)((lcg = lcg * 1664525u + 1013904223u) >> 24);
+
+    gate = (CnnModel_t){
+        .n_layers = 1,
+        .layers = {{config.n_mels, 1, 4, 3, 3, 8, 1, gate_weights, NULL, 1 << 20, 24}},
+        .n_classes = 2,
+        .fc_weights = gate_fc_weights,
+    };
+}
+
+// the main loop's work for one window, run for real; fills the simulated stage times
+typedef struct
+{
+    float *spectrogram;
+    int8_t *input;
+    void *cnn_workspace;
+} PassBuffers_t;
+
+static int run_pass(PassBuffers_t *b, const int16_t *window, double *stage_ns)
+{
+    static const MelQuantParams_t quant = {.scale = MODEL_INPUT_SCALE,
+                                           .zero_point = MODEL_INPUT_ZERO_POINT,
+                                           .db_floor = MODEL_INPUT_DB_FLOOR,
+                                           .db_ceil = MODEL_INPUT_DB_CEIL};
+    const uint32_t elements = (uint32_t)config.n_mels * n_frames;
+    int32_t logits[CNN_MAX_CLASSES];
+    double t0 = host_ns(), t1, t2, t3;
+
+    if (fused)
+    {
+        if (calculate_mel_spectrogram_q8(window, window_samples(), b->input, n_frames, &quant) !=
+            n_frames)
+            return -1;
+        t1 = t2 = t3 = host_ns();
+    }
+    else
+    {
+        if (calculate_mel_spectrogram(window, window_samples(), b->spectrogram, n_frames) !=
+            n_frames)
+            return -1;
+        t1 = host_ns();
+        normalize_spectrogram(b->spectrogram, config.n_mels, n_frames);
+        t2 = host_ns();
+        cnn_quantize_input(b->spectrogram, b->input, elements, MODEL_INPUT_SCALE,
+                           MODEL_INPUT_ZERO_POINT);
+        t3 = host_ns();
+    }
+
+    if (use_model && use_cascade)
+    {
+        const float hop_s = (float)stride * config.hop_length / config.sample_rate;
+        int32_t score;
+        if (cascade_classify(&cascade, b->input, n_frames, hop_s, logits, &score) < 0)
+            return -1;
+        gate_min = (score < gate_min) ? score : gate_min;
+        gate_max = (score > gate_max) ? score : gate_max;
+        gate_sum += score;
+    }
+    else if (use_model && cnn_infer_window(&model, b->input, n_frames, b->cnn_workspace, logits))
+        return -1;
+
+    stage_ns[SIM_FEATURES] = (t1 - t0) * scale;
+    stage_ns[SIM_NORMALIZE] = (t2 - t1) * scale;
+    stage_ns[SIM_QUANTIZE] = (t3 - t2) * scale;
+    stage_ns[SIM_INFERENCE] = use_model ? (host_ns() - t3) * scale : 0.0;
+    return 0;
+}
+
+static void stage_busy(SimStage_t stage, double ns)
+{
+    stats[stage].busy_ns += ns;
+}
+
+static void stage_run(SimStage_t stage, double ns)
+{
+    stats[stage].count++;
+    if (ns > stats[stage].max_ns)
+        stats[stage].max_ns = ns;
+}
+
+// window queue, FIFO
+static Job_t queue[MAX_QUEUE];
+static uint32_t q_head, q_len;
+static Job_t active;
+static Job_t *current; // &active while a window is in progress
+static double main_ns; // how far the main loop has got on the virtual clock
+
+static int start_job(PassBuffers_t *b, Job_t *job)
+{
+    const uint64_t first = (uint64_t)job->index * stride * config.hop_length;
+
+    // a window the capture already wrapped over would be computed from corrupt samples
+    if (main_ns > job->deadline_ns)
+    {
+        windows_dropped++;
+        windows_missed++;
+        return 0;
+    }
+    if (run_pass(b, pcm + first, job->stage_ns) != 0)
+        return -1;
+    for (int s = SIM_FEATURES; s < SIM_N_STAGES; ++s)
+        stage_run((SimStage_t)s, job->stage_ns[s]);
+    job->stage = SIM_FEATURES;
+    job->left_ns = job->stage_ns[SIM_FEATURES];
+    return 1;
+}
+
+// advances the main loop until the virtual time limit, preemption happens between calls
+static int run_main(PassBuffers_t *b, double limit_ns)
+{
+    while (main_ns < limit_ns)
+    {
+        if (!current)
+        {
+            if (q_len == 0)
+            {
+                main_ns = limit_ns; // idle until the next interrupt
+                break;
+            }
+            active = queue[q_head];
+            current = &active;
+            q_head = (q_head + 1) % MAX_QUEUE;
+            q_len--;
+
+            int started = start_job(b, current);
+            if (started < 0)
+                return -1;
+            if (started == 0)
+            {
+                current = NULL;
+                continue;
+            }
+        }
+
+        double slice = limit_ns - main_ns;
+        if (current->left_ns > slice)
+        {
+            current->left_ns -= slice;
+            stage_busy((SimStage_t)current->stage, slice);
+            main_ns = limit_ns;
+            break;
+        }
+
+        main_ns += current->left_ns;
+        stage_busy((SimStage_t)current->stage, current->left_ns);
+        while (++current->stage < SIM_N_STAGES && current->stage_ns[current->stage] == 0.0)
+            ;
+        if (current->stage < SIM_N_STAGES)
+        {
+            current->left_ns = current->stage_ns[current->stage];
+            continue;
+        }
+
+        if (main_ns > current->deadline_ns)
+            windows_missed++;
+        latencies[n_latencies++] = main_ns - current->ready_ns;
+        windows_done++;
+        current = NULL;
+    }
+    return 0;
+}
+
+static void pace(double sim_ns, double wall_start)
+{
+    if (speed <= 0.0)
+        return;
+    double wait = wall_start + sim_ns / speed - host_ns();
+    if (wait > 0.0)
+    {
+        struct timespec ts = {(time_t)(wait / 1e9), (long)fmod(wait, 1e9)};
+        nanosleep(&ts, NULL);
+    }
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const double *sorted, uint32_t n, double p)
+{
+    if (n == 0)
+        return 0.0;
+    uint32_t i = (uint32_t)(p * (n - 1) + 0.5);
+    return sorted[i];
+}
+
+static void synthesize(void)
+{
+    uint32_t lcg = 12345;
+
+    n_samples = (uint64_t)SYNTHETIC_SECONDS * config.sample_rate;
+    pcm = malloc(n_samples * sizeof(int16_t));
+    for (uint64_t i = 0; pcm && i < n_samples; ++i)
+    {
+        lcg = lcg * 1664525u + 1013904223u;
+        pcm[i] = (int16_t)(4000.0 * sin(0.0002 * (double)i * (double)(i % 16000)) +
+                           (int32_t)(lcg >> 22) - 512);
+    }
+}
+
+static int load(const char *path)
+{
+    WavFile_t wav;
+    int ret = wav_open(path, &wav);
+
+    if (ret != 0 || wav.sample_rate != config.sample_rate)
+    {
+        fprintf(stderr, "deadline_sim: %s: %s\n", path,
+                ret == -1 ? "cannot open"
+                          : ret == -2 ? "not a 16-bit PCM WAV" : "sample rate is not 16000 Hz");
+        if (ret == 0)
+            wav_close(&wav);
+        return -1;
+    }
+    n_samples = wav.n_samples;
+    pcm = malloc(n_samples * sizeof(int16_t));
+    if (pcm)
+        wav_read_mono(&wav, 0, (uint32_t)n_samples, pcm);
+    wav_close(&wav);
+    return pcm ? 0 : -1;
+}
+
+static int usage(const char *argv0)
+{
+    fprintf(stderr,
+            "usage: %s [--fft N] [--hop N] [--mels N] [--frames N] [--stride N] [--ring-ms MS]\n"
+            "       [--fused] [--no-model | --cascade T] [--isr-us US]\n"
+            "       [--scale F | --calibrate CYCLES]\n"
+            "       [--cpu-mhz MHZ] [--speed S] [WAV]\n",
+            argv0);
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = NULL;
+    double ring_ms = 0.0;
+    double calibrate = 0.0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *opt = argv[i];
+        const char *val = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (!strcmp(opt, "--fused"))
+            fused = 1;
+        else if (!strcmp(opt, "--no-model"))
+            use_model = 0;
+        else if (opt[0] != '-')
+            path = opt;
+        else if (!val)
+            return usage(argv[0]);
+        else
+        {
+            if (!strcmp(opt, "--fft"))
+                config.fft_size = (uint16_t)atoi(val);
+            else if (!strcmp(opt, "--hop"))
+                config.hop_length = (uint16_t)atoi(val);
+            else if (!strcmp(opt, "--mels"))
+                config.n_mels = (uint16_t)atoi(val);
+            else if (!strcmp(opt, "--frames"))
+                n_frames = (uint16_t)atoi(val);
+            else if (!strcmp(opt, "--stride"))
+                stride = (uint16_t)atoi(val);
+            else if (!strcmp(opt, "--ring-ms"))
+                ring_ms = atof(val);
+            else if (!strcmp(opt, "--isr-us"))
+                isr_ns = atof(val) * 1e3;
+            else if (!strcmp(opt, "--scale"))
+                scale = atof(val);
+            else if (!strcmp(opt, "--calibrate"))
+                calibrate = atof(val);
+            else if (!strcmp(opt, "--cpu-mhz"))
+                cpu_mhz = atof(val);
+            else if (!strcmp(opt, "--speed"))
+                speed = atof(val);
+            else if (!strcmp(opt, "--cascade"))
+            {
+                use_cascade = 1;
+                gate_threshold = (int32_t)strtol(val, NULL, 0);
+            }
+            else
+                return usage(argv[0]);
+            ++i;
+        }
+    }
+    if (stride == 0)
+        stride = n_frames;
+    if (n_frames == 0 || config.hop_length == 0 || scale <= 0.0 || cpu_mhz <= 0.0 ||
+        (use_cascade && !use_model) || mel_spectrogram_workspace_size(&config, NULL, NULL) != 0)
+        return usage(argv[0]);
+
+    if (path ? load(path) != 0 : (synthesize(), pcm == NULL))
+        return 1;
+
+    // engine and window buffers, sized like the firmware's arena
+    uint32_t state_bytes, scratch_bytes;
+    mel_spectrogram_workspace_size(&config, &state_bytes, &scratch_bytes);
+    float *state = malloc(state_bytes);
+    float *scratch = malloc(scratch_bytes);
+    PassBuffers_t buffers = {malloc((size_t)config.n_mels * n_frames * sizeof(float)),
+                             malloc((size_t)config.n_mels * n_frames), NULL};
+    build_model();
+    if (use_model)
+    {
+        uint32_t ws = cnn_window_workspace_size(&model, n_frames);
+        if (ws == 0)
+        {
+            fprintf(stderr, "deadline_sim: %u frames are shorter than the model\n", n_frames);
+            return 1;
+        }
+        buffers.cnn_workspace = malloc(ws);
+    }
+    if (use_cascade)
+    {
+        void *gate_ws = malloc(cascade_gate_workspace_size(&gate, n_frames));
+        if (!gate_ws || !buffers.cnn_workspace ||
+            cascade_init(&cascade, &gate, &model, gate_ws, buffers.cnn_workspace, 1,
+                         gate_threshold) != 0)
+        {
+            fprintf(stderr, "deadline_sim: cascade init failed\n");
+            return 1;
+        }
+    }
+    mel_spectrogram_set_memory(state, state_bytes, scratch, scratch_bytes);
+    if (!state || !scratch || !buffers.spectrogram || !buffers.input ||
+        (use_model && !buffers.cnn_workspace) || mel_spectrogram_init(&config) != 0)
+    {
+        fprintf(stderr, "deadline_sim: engine init failed\n");
+        return 1;
+    }
+    if (n_samples < window_samples())
+    {
+        fprintf(stderr, "deadline_sim: recording shorter than one window\n");
+        return 1;
+    }
+
+    // target cycles/frame of the feature pass -> host-to-target time ratio, from one warm pass
+    if (calibrate > 0.0)
+    {
+        double stage_ns[SIM_N_STAGES];
+        scale = 1.0;
+        run_pass(&buffers, pcm, stage_ns);
+        run_pass(&buffers, pcm, stage_ns);
+        double feature_ns =
+            stage_ns[SIM_FEATURES] + stage_ns[SIM_NORMALIZE] + stage_ns[SIM_QUANTIZE];
+        scale = calibrate * n_frames / cpu_mhz * 1e3 / feature_ns;
+
+        // the warm-up windows are not part of the recording's statistics
+        cascade_reset_stats(&cascade);
+        gate_min = INT32_MAX;
+        gate_max = INT32_MIN;
+        gate_sum = 0.0;
+    }
+
+    const double period_ns = 1e9 * SAMPLES_PER_CALLBACK / config.sample_rate;
+    const uint64_t window_step = (uint64_t)stride * config.hop_length;
+    const uint64_t ring_samples =
+        ring_ms > 0.0 ? (uint64_t)(ring_ms * config.sample_rate / 1000.0)
+                      : window_samples() + window_step;
+    const uint64_t n_callbacks = n_samples / SAMPLES_PER_CALLBACK;
+    const uint32_t n_windows = (uint32_t)((n_samples - window_samples()) / window_step + 1);
+
+    if (ring_samples < window_samples())
+    {
+        fprintf(stderr, "deadline_sim: the ring must hold at least one window (%.0f ms)\n",
+                1e3 * window_samples() / config.sample_rate);
+        return 1;
+    }
+    latencies = malloc(n_windows * sizeof(double));
+    if (!latencies)
+        return 1;
+
+    printf("fft %u, hop %u, mels %u, %u frames every %u, %s%s, ring %.0f ms, scale %.3f\n",
+           config.fft_size, config.hop_length, config.n_mels, n_frames, stride,
+           fused ? "fused int8" : "float",
+           use_cascade ? " + cascade" : use_model ? " + model" : "",
+           1e3 * ring_samples / config.sample_rate, scale);
+
+    double wall_start = host_ns();
+    uint32_t next_window = 0;
+    uint32_t max_depth = 0;
+
+    for (uint64_t k = 1; k <= n_callbacks; ++k)
+    {
+        const double t = k * period_ns;
+        const uint64_t captured = k * SAMPLES_PER_CALLBACK;
+
+        if (run_main(&buffers, t) != 0)
+        {
+            fprintf(stderr, "deadline_sim: pipeline failed\n");
+            return 1;
+        }
+        pace(t, wall_start);
+
+        // the half/full transfer callback preempts the main loop
+        stage_busy(SIM_ISR, isr_ns);
+        stage_run(SIM_ISR, isr_ns);
+        if (isr_ns > period_ns)
+            isr_overruns++;
+        main_ns = (main_ns > t ? main_ns : t) + isr_ns;
+
+        while (next_window < n_windows &&
+               (uint64_t)next_window * window_step + window_samples() <= captured)
+        {
+            uint64_t first = (uint64_t)next_window * window_step;
+            uint64_t wrap_cb = (first + ring_samples + SAMPLES_PER_CALLBACK - 1) /
+                               SAMPLES_PER_CALLBACK;
+            if (q_len == MAX_QUEUE)
+            {
+                windows_dropped++;
+                windows_missed++;
+            }
+            else
+            {
+                Job_t *job = &queue[(q_head + q_len++) % MAX_QUEUE];
+                memset(job, 0, sizeof(*job));
+                job->index = next_window;
+                job->ready_ns = main_ns;
+                job->deadline_ns = wrap_cb * period_ns;
+            }
+            next_window++;
+
+            uint32_t depth = q_len + (current != NULL);
+            depth_hist[depth > MAX_QUEUE ? MAX_QUEUE : depth]++;
+            if (depth > max_depth)
+                max_depth = depth;
+        }
+    }
+
+    // capture has ended, let the main loop drain what is queued
+    const double capture_ns = n_callbacks * period_ns;
+    while (current || q_len)
+    {
+        if (run_main(&buffers, main_ns + 1e9) != 0)
+            return 1;
+    }
+
+    // report
+    printf("%.1f s of audio, %lu callbacks, %u windows: %u done, %u missed deadline, "
+           "%u dropped\n",
+           capture_ns / 1e9, (unsigned long)n_callbacks, n_windows, windows_done,
+           windows_missed, windows_dropped);
+    if (isr_overruns)
+        printf("isr longer than its %.0f us period %u times\n", period_ns / 1e3, isr_overruns);
+
+    printf("stage          runs    mean us     max us   mean Mcyc     cpu %%\n");
+    double busy = 0.0;
+    for (int s = 0; s < SIM_N_STAGES; ++s)
+    {
+        if (!stats[s].count)
+            continue;
+        double mean = stats[s].busy_ns / stats[s].count;
+        busy += stats[s].busy_ns;
+        printf("%-10s %8u %10.1f %10.1f %11.3f %9.2f\n", stage_names[s], stats[s].count,
+               mean / 1e3, stats[s].max_ns / 1e3, mean * cpu_mhz / 1e9,
+               100.0 * stats[s].busy_ns / capture_ns);
+    }
+    printf("%-10s %8s %10s %10s %11s %9.2f\n", "total", "", "", "", "", 100.0 * busy / capture_ns);
+
+    if (use_cascade && cascade.windows)
+    {
+        const uint64_t gate_macs = (uint64_t)cnn_window_macs(&gate, n_frames) * cascade.windows;
+        const double always_on = (double)cnn_window_macs(&model, n_frames) * cascade.windows;
+        printf("cascade threshold %ld, gate score min %ld  mean %.1f  max %ld\n",
+               (long)gate_threshold, (long)gate_min, gate_sum / cascade.windows, (long)gate_max);
+        printf("stage 2 woke on %u of %u windows (%.1f %%)\n", cascade.full_runs, cascade.windows,
+               100.0 * cascade.full_runs / cascade.windows);
+        printf("per second of audio: %.3f MMAC (gate %.3f, stage 2 %.3f; %.3f with the full model "
+               "on every window), inference %.3f ms\n",
+               cascade_macs_per_second(&cascade) / 1e6, gate_macs / cascade.audio_seconds / 1e6,
+               (cascade.macs - gate_macs) / cascade.audio_seconds / 1e6,
+               always_on / cascade.audio_seconds / 1e6,
+               1e3 * stats[SIM_INFERENCE].busy_ns / capture_ns);
+    }
+
+    qsort(latencies, n_latencies, sizeof(double), compare_double);
+    printf("latency, last sample to result (ms): min %.1f  p50 %.1f  p90 %.1f  p99 %.1f  "
+           "max %.1f\n",
+           n_latencies ? latencies[0] / 1e6 : 0.0, percentile(latencies, n_latencies, 0.5) / 1e6,
+           percentile(latencies, n_latencies, 0.9) / 1e6,
+           percentile(latencies, n_latencies, 0.99) / 1e6,
+           n_latencies ? latencies[n_latencies - 1] / 1e6 : 0.0);
+
+    printf("queue depth at window arrival:");
+    for (uint32_t d = 0; d <= max_depth; ++d)
+        printf(" %u:%u", d, depth_hist[d]);
+    printf("\n");
+
+    return windows_missed ? 1 : 0;
+}
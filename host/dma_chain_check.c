@@ -0,0 +1,294 @@
+// dma_chain_check.c
+// Checks the MDMA chain builder (dma_chain.c) through its software stand-in,
+// dma_chain_run_software, on host buffers standing in for D3 SRAM, AXI SRAM and SDRAM:
+//   split     copies up to the chain's capacity split into DMA_CHAIN_MAX_BLOCK blocks that tile
+//             the copy exactly; a copy that does not fit or is empty is rejected and leaves the
+//             chain as it was
+//   width     every block's beat width is the widest of 4/2/1 dividing source, destination and
+//             length, over all alignment combinations
+//   callback  only the last block of a copy carries its callback, and it fires once, in chain
+//             order, after that copy's bytes have landed
+//   chain     D3 -> AXI -> SDRAM, the second copy reading what the first wrote, plus the
+//             archive pattern of the capture callbacks (PDM and PCM blocks into two rings):
+//             destination bytes equal to a reference memmove, guard bytes untouched
+//
+// usage: dma_chain_check [--seed S]   (exit status 1 if any check failed)
+#include "dma_chain.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GUARD 64
+#define REGION_BYTES (DMA_CHAIN_MAX_SEGMENTS * DMA_CHAIN_MAX_BLOCK + 2 * GUARD)
+#define RANDOM_CHAINS 500
+
+static uint8_t d3_sram[REGION_BYTES];
+static uint8_t axi_sram[REGION_BYTES];
+static uint8_t sdram[REGION_BYTES];
+static uint8_t expect_axi[REGION_BYTES];
+static uint8_t expect_sdram[REGION_BYTES];
+
+static uint32_t rng_state;
+
+static uint32_t next_random(void)
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+static void fill_random(uint8_t *p, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i)
+        p[i] = (uint8_t)next_random();
+}
+
+static uint8_t widest_beat(uintptr_t src, uintptr_t dst, uint32_t len)
+{
+    for (uint8_t w = 4; w > 1; w /= 2)
+        if (src % w == 0 && dst % w == 0 && len % w == 0)
+            return w;
+    return 1;
+}
+
+// segments [first, last) tile src/dst/len in order, blocks full-size but the last
+static int tiles(const DmaChain_t *chain, uint8_t first, uint8_t last, const void *src,
+                 const void *dst, uint32_t len)
+{
+    uintptr_t s = (uintptr_t)src, d = (uintptr_t)dst;
+    for (uint8_t i = first; i < last; ++i)
+    {
+        const DmaSegment_t *seg = &chain->segments[i];
+        const uint32_t want = (len > DMA_CHAIN_MAX_BLOCK) ? DMA_CHAIN_MAX_BLOCK : len;
+        if (seg->src != s || seg->dst != d || seg->len != want)
+            return 0;
+        s += want;
+        d += want;
+        len -= want;
+    }
+    return len == 0;
+}
+
+static int check_split(void)
+{
+    uint32_t bad = 0, copies = 0;
+    DmaChain_t chain;
+
+    // lengths around the block size and up to a full chain
+    const uint32_t lengths[] = {1,
+                                3,
+                                DMA_CHAIN_MAX_BLOCK - 1,
+                                DMA_CHAIN_MAX_BLOCK,
+                                DMA_CHAIN_MAX_BLOCK + 1,
+                                3 * DMA_CHAIN_MAX_BLOCK + 4,
+                                DMA_CHAIN_MAX_SEGMENTS * DMA_CHAIN_MAX_BLOCK};
+    for (uint32_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); ++i)
+    {
+        const uint32_t len = lengths[i];
+        const uint32_t blocks = (len + DMA_CHAIN_MAX_BLOCK - 1) / DMA_CHAIN_MAX_BLOCK;
+        dma_chain_reset(&chain);
+        bad += dma_chain_add(&chain, d3_sram + GUARD, sdram + GUARD, len, NULL, NULL) != 0 ||
+               chain.n_segments != blocks || dma_chain_bytes(&chain) != len ||
+               !tiles(&chain, 0, chain.n_segments, d3_sram + GUARD, sdram + GUARD, len);
+        copies++;
+    }
+
+    // no room: a copy one block too long, after a partial chain, and an empty copy
+    dma_chain_reset(&chain);
+    bad += dma_chain_add(&chain, d3_sram, sdram, DMA_CHAIN_MAX_SEGMENTS * DMA_CHAIN_MAX_BLOCK + 1,
+                         NULL, NULL) != -1 ||
+           chain.n_segments != 0;
+    bad += dma_chain_add(&chain, d3_sram, sdram, 3 * DMA_CHAIN_MAX_BLOCK, NULL, NULL) != 0;
+    const uint32_t too_long = (DMA_CHAIN_MAX_SEGMENTS - 2) * DMA_CHAIN_MAX_BLOCK;
+    bad += dma_chain_add(&chain, axi_sram, sdram, too_long, NULL, NULL) != -1 ||
+           chain.n_segments != 3;
+    bad += dma_chain_add(&chain, axi_sram, sdram, 0, NULL, NULL) != -1 || chain.n_segments != 3;
+    copies += 4;
+
+    const int fail = bad != 0;
+    printf("dma split          %u of %u copies wrong  %s\n", bad, copies, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+static int check_width(void)
+{
+    uint32_t bad = 0, blocks = 0;
+    DmaChain_t chain;
+    for (uint32_t so = 0; so < 4; ++so)
+        for (uint32_t d = 0; d < 4; ++d)
+            for (uint32_t lo = 0; lo < 4; ++lo)
+            {
+                // a multi-block copy: 64 KB blocks keep the copy's alignment, the tail its own
+                const uint32_t len = 2 * DMA_CHAIN_MAX_BLOCK + 1024 + lo;
+                dma_chain_reset(&chain);
+                dma_chain_add(&chain, d3_sram + GUARD + so, sdram + GUARD + d, len, NULL, NULL);
+                for (uint8_t i = 0; i < chain.n_segments; ++i, ++blocks)
+                {
+                    const DmaSegment_t *seg = &chain.segments[i];
+                    bad += seg->width != widest_beat(seg->src, seg->dst, seg->len);
+                }
+            }
+
+    const int fail = bad != 0;
+    printf("dma width          %u of %u blocks with a narrower or wider beat than alignment "
+           "allows  %s\n",
+           bad, blocks, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+typedef struct
+{
+    const uint8_t *dst; // the copy's bytes must be in place when the callback runs
+    const uint8_t *expect;
+    uint32_t len;
+    uint32_t id;
+} CopyCheck_t;
+
+static uint32_t fired[DMA_CHAIN_MAX_SEGMENTS];
+static uint32_t n_fired;
+static uint32_t landed_late;
+
+static void copy_done(void *ctx)
+{
+    const CopyCheck_t *c = ctx;
+    if (n_fired < DMA_CHAIN_MAX_SEGMENTS)
+        fired[n_fired] = c->id;
+    n_fired++;
+    landed_late += memcmp(c->dst, c->expect, c->len) != 0;
+}
+
+static int check_callback(void)
+{
+    uint32_t bad = 0;
+    DmaChain_t chain;
+    CopyCheck_t copies[3];
+
+    // 2 + 1 + 3 blocks, callbacks on each copy
+    const uint32_t lengths[3] = {DMA_CHAIN_MAX_BLOCK + 100, 512, 2 * DMA_CHAIN_MAX_BLOCK + 2};
+    fill_random(d3_sram, REGION_BYTES);
+    memset(sdram, 0, REGION_BYTES);
+    dma_chain_reset(&chain);
+    uint32_t offset = GUARD;
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        copies[i] = (CopyCheck_t){sdram + offset, d3_sram + offset, lengths[i], i};
+        bad += dma_chain_add(&chain, d3_sram + offset, sdram + offset, lengths[i], copy_done,
+                             &copies[i]) != 0;
+        offset += lengths[i];
+    }
+
+    // the callback sits on the last block of each copy only
+    const uint8_t last[3] = {1, 2, 5};
+    for (uint8_t i = 0, c = 0; i < chain.n_segments; ++i)
+    {
+        const DmaSegment_t *seg = &chain.segments[i];
+        const int is_last = c < 3 && i == last[c];
+        bad += is_last ? (seg->done != copy_done || seg->ctx != &copies[c]) : (seg->done != NULL);
+        c += is_last;
+    }
+
+    n_fired = 0;
+    landed_late = 0;
+    dma_chain_run_software(&chain);
+    bad += n_fired != 3 || fired[0] != 0 || fired[1] != 1 || fired[2] != 2 || landed_late != 0;
+
+    const int fail = bad != 0;
+    printf("dma callback       %u fired of 3, in order, %u before their bytes landed  %s\n",
+           n_fired, landed_late, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+// D3 -> AXI staging -> SDRAM, the second hop reading the first hop's output; random alignment
+static int run_staged(uint32_t *blocks)
+{
+    DmaChain_t chain;
+    const uint32_t len = 1 + next_random() % (3 * DMA_CHAIN_MAX_BLOCK);
+    const uint32_t src = GUARD + next_random() % 8, mid = GUARD + next_random() % 8,
+                   dst = GUARD + next_random() % 8;
+    const uint32_t span = len + 2 * GUARD + 8; // the copy and the guard bytes around it
+
+    fill_random(d3_sram, span);
+    fill_random(axi_sram, span);
+    fill_random(sdram, span);
+    memcpy(expect_axi, axi_sram, span);
+    memcpy(expect_sdram, sdram, span);
+    memmove(expect_axi + mid, d3_sram + src, len);
+    memmove(expect_sdram + dst, expect_axi + mid, len);
+
+    dma_chain_reset(&chain);
+    if (dma_chain_add(&chain, d3_sram + src, axi_sram + mid, len, NULL, NULL) != 0 ||
+        dma_chain_add(&chain, axi_sram + mid, sdram + dst, len, NULL, NULL) != 0)
+        return 1;
+    *blocks += chain.n_segments;
+    dma_chain_run_software(&chain);
+    return memcmp(axi_sram, expect_axi, span) != 0 || memcmp(sdram, expect_sdram, span) != 0;
+}
+
+// what archive_block queues per capture block: D3 PDM and AXI PCM into two SDRAM rings
+static int run_archive(uint32_t *blocks)
+{
+    DmaChain_t chain;
+    const uint32_t pdm_bytes = 512, pcm_bytes = 64, ring = REGION_BYTES / 2;
+    uint32_t pdm_offset = 0, pcm_offset = 0;
+    int bad = 0;
+
+    memset(sdram, 0, REGION_BYTES);
+    memset(expect_sdram, 0, REGION_BYTES);
+    for (uint32_t b = 0; b < 3 * ring / pdm_bytes; ++b)
+    {
+        fill_random(d3_sram, pdm_bytes);
+        fill_random(axi_sram, pcm_bytes);
+        if (pdm_offset + pdm_bytes > ring)
+            pdm_offset = 0;
+        if (pcm_offset + pcm_bytes > ring)
+            pcm_offset = 0;
+        memcpy(expect_sdram + pdm_offset, d3_sram, pdm_bytes);
+        memcpy(expect_sdram + ring + pcm_offset, axi_sram, pcm_bytes);
+
+        dma_chain_reset(&chain);
+        bad |= dma_chain_add(&chain, d3_sram, sdram + pdm_offset, pdm_bytes, NULL, NULL) != 0;
+        bad |= dma_chain_add(&chain, axi_sram, sdram + ring + pcm_offset, pcm_bytes, NULL, NULL);
+        *blocks += chain.n_segments;
+        dma_chain_run_software(&chain);
+        pdm_offset += pdm_bytes;
+        pcm_offset += pcm_bytes;
+    }
+    return bad || memcmp(sdram, expect_sdram, REGION_BYTES) != 0;
+}
+
+static int check_chain(void)
+{
+    uint32_t bad = 0, blocks = 0;
+    for (uint32_t i = 0; i < RANDOM_CHAINS; ++i)
+        bad += run_staged(&blocks);
+    const uint32_t archive_bad = run_archive(&blocks);
+
+    const int fail = bad != 0 || archive_bad != 0;
+    printf("dma chain          %u of %u staged D3->AXI->SDRAM chains, archive rings %s, "
+           "%u blocks  %s\n",
+           bad, RANDOM_CHAINS, archive_bad ? "differ" : "exact", blocks, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seed = 1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else
+        {
+            fprintf(stderr, "usage: %s [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    rng_state = seed;
+
+    int failed = 0;
+    failed |= check_split();
+    failed |= check_width();
+    failed |= check_callback();
+    failed |= check_chain();
+    return failed ? 1 : 0;
+}
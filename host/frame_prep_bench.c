@@ -0,0 +1,169 @@
+// frame_prep_bench.c
+// Times the frame-preparation kernels against the per-sample loop they replace (bounds check,
+// divide by 32768, window multiply): ns per frame for the float and the Q15 kernel over the FFT
+// sizes, for a full frame and for one that runs half a frame past the end of the buffer.
+// Also checks that frame_prep_f32 matches the old loop bit for bit and that frame_prep_q15
+// stays within one LSB of the float result.
+//
+// usage: frame_prep_bench [--seconds S]   (exit status 1 if a check failed)
+#include "frame_prep.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_N 2048
+#define MIN_REPEATS 3
+
+static const uint32_t sizes[] = {256, 512, 1024, 2048};
+
+static int16_t pcm[MAX_N];
+static float hann[MAX_N];
+static float scaled[MAX_N];
+static int16_t hann_q15[MAX_N];
+static float frame_f32[MAX_N];
+static int16_t frame_q15[MAX_N];
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// the loop calculate_mel_spectrogram ran before, kept as the reference
+static void reference_frame(const int16_t *pcm_data, uint32_t pcm_size, uint32_t offset,
+                            const float *window, float *out, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        if (offset + i < pcm_size)
+            out[i] = (pcm_data[offset + i] / 32768.0f) * window[i];
+        else
+            out[i] = 0.0f;
+    }
+}
+
+typedef enum
+{
+    KERNEL_REFERENCE,
+    KERNEL_F32,
+    KERNEL_Q15
+} Kernel_t;
+
+static void run(Kernel_t kernel, uint32_t available, uint32_t n)
+{
+    switch (kernel)
+    {
+    case KERNEL_REFERENCE:
+        reference_frame(pcm, available, 0, hann, frame_f32, n);
+        break;
+    case KERNEL_F32:
+        frame_prep_f32(pcm, available, scaled, frame_f32, n);
+        break;
+    case KERNEL_Q15:
+        frame_prep_q15(pcm, available, hann_q15, frame_q15, n);
+        break;
+    }
+}
+
+// ns per frame, repeated for at least min_seconds
+static double time_kernel(Kernel_t kernel, uint32_t available, uint32_t n, double min_seconds)
+{
+    uint32_t repeats = 0;
+    double start = now_ns();
+    double elapsed;
+
+    do
+    {
+        for (int i = 0; i < 64; ++i)
+            run(kernel, available, n);
+        repeats += 64;
+        elapsed = now_ns() - start;
+    } while (repeats < MIN_REPEATS * 64 || elapsed < min_seconds * 1e9);
+
+    return elapsed / repeats;
+}
+
+static int check(uint32_t available, uint32_t n)
+{
+    static float expect[MAX_N];
+    int failed = 0;
+
+    reference_frame(pcm, available, 0, hann, expect, n);
+    frame_prep_f32(pcm, available, scaled, frame_f32, n);
+    if (memcmp(expect, frame_f32, n * sizeof(float)) != 0)
+    {
+        fprintf(stderr, "frame_prep_bench: f32 differs from the reference (n=%lu, available=%lu)\n",
+                (unsigned long)n, (unsigned long)available);
+        failed = 1;
+    }
+
+    frame_prep_q15(pcm, available, hann_q15, frame_q15, n);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        if (fabsf(frame_q15[i] - expect[i] * 32768.0f) > 1.0f)
+        {
+            fprintf(stderr, "frame_prep_bench: q15 sample %lu off by more than 1 LSB (n=%lu)\n",
+                    (unsigned long)i, (unsigned long)n);
+            failed = 1;
+            break;
+        }
+    }
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = 0.2;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--seconds") && i + 1 < argc)
+            seconds = atof(argv[++i]);
+        else
+        {
+            fprintf(stderr, "usage: %s [--seconds S]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // full-scale noise including both extremes
+    uint32_t lcg = 12345;
+    for (uint32_t i = 0; i < MAX_N; ++i)
+    {
+        lcg = lcg * 1664525u + 1013904223u;
+        pcm[i] = (int16_t)(lcg >> 16);
+    }
+    pcm[1] = -32768;
+    pcm[2] = 32767;
+
+    int failed = 0;
+    printf("%6s %9s %12s %12s %12s %9s %9s\n", "n", "available", "ref ns", "f32 ns", "q15 ns",
+           "f32 x", "q15 x");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+    {
+        const uint32_t n = sizes[s];
+        for (uint32_t i = 0; i < n; ++i)
+            hann[i] = 0.5f * (1.0f - cosf(2.0f * 3.14159265f * i / (n - 1)));
+        memcpy(scaled, hann, n * sizeof(float));
+        frame_prep_scale_window(scaled, n);
+        frame_prep_window_q15(scaled, hann_q15, n);
+
+        // a full frame, and the last frame of a buffer that ends half way in
+        const uint32_t cases[] = {n, n / 2 + 3};
+        for (int c = 0; c < 2; ++c)
+        {
+            failed |= check(cases[c], n);
+            double ref = time_kernel(KERNEL_REFERENCE, cases[c], n, seconds);
+            double f32 = time_kernel(KERNEL_F32, cases[c], n, seconds);
+            double q15 = time_kernel(KERNEL_Q15, cases[c], n, seconds);
+            printf("%6lu %9lu %12.1f %12.1f %12.1f %9.2f %9.2f\n", (unsigned long)n,
+                   (unsigned long)cases[c], ref, f32, q15, ref / f32, ref / q15);
+        }
+    }
+
+    printf("%s\n", failed ? "FAIL" : "ok");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,9 @@
+// golden_run.c
+// Checks the DSP path against the golden vectors of tools/golden_gen.py: band layout, mel dB,
+// normalized and fused int8 outputs within their tolerances, and the feature pass within
+// GOLDEN_BUDGET_TICKS_PER_FRAME ns per frame (-DGOLDEN_BUDGET_TICKS_PER_FRAME=... to override).
+//
+// usage: golden_run   (exit status 1 if any check failed)
+#include "golden_check.h"
+
+int main(void) { return golden_check_run() ? 1 : 0; }
@@ -0,0 +1,255 @@
+// log_sim.c
+// Drives the QSPI detection log (detection_log.c) on the RAM NOR simulator: bursts of detections
+// with detection_log_service between them, power cut at a random program or erase, remount,
+// then checks that every record programmed before the cut reads back intact and in order.
+// Reports flash operations, mount cost, write amplification and the erase-count spread.
+//
+// usage: log_sim [--sectors N] [--sector-kb K] [--page B] [--records N] [--cuts N]
+//                [--erase-polls N] [--seed S]   (exit status 1 if any check failed)
+#include "detection_log.h"
+#include "nor_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct
+{
+    uint16_t sectors;
+    uint32_t sector_kb;
+    uint32_t page;
+    uint32_t records;
+    uint32_t cuts;
+    uint32_t erase_polls;
+    uint32_t seed;
+} SimOptions_t;
+
+static uint32_t rng_state;
+
+static uint32_t next_random(void)
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+// fields derived from the sequence number, so a read-back record can be checked on its own
+static void make_record(uint32_t seq, DetectionRecord_t *r)
+{
+    memset(r, 0, sizeof(*r));
+    r->timestamp = seq * 250u;
+    r->clip_ref = seq * 4096u;
+    r->spl_cdb = (int16_t)(3000 + seq % 6000);
+    for (int i = 0; i < DETECTION_LOG_N_SCORES; ++i)
+        r->scores[i] = (int8_t)((seq * 7u + (uint32_t)i * 31u) & 0xFF);
+}
+
+static int record_matches(const DetectionRecord_t *r)
+{
+    DetectionRecord_t expect;
+    make_record(r->sequence, &expect);
+    return r->timestamp == expect.timestamp && r->clip_ref == expect.clip_ref &&
+           r->spl_cdb == expect.spl_cdb && !memcmp(r->scores, expect.scores, sizeof(r->scores));
+}
+
+// walks the log; every record intact, sequences increasing, none missing below durable
+static int verify(DetectionLog_t *log, uint32_t durable, uint32_t *n_records)
+{
+    DetectionLogIter_t it;
+    DetectionRecord_t r;
+    uint32_t prev = 0, count = 0;
+    int ret, first = 1;
+
+    detection_log_iter_begin(log, &it);
+    while ((ret = detection_log_iter_next(log, &it, &r)) == 1)
+    {
+        if (!record_matches(&r) || (!first && r.sequence <= prev))
+        {
+            fprintf(stderr, "log_sim: record %lu out of order or corrupt\n",
+                    (unsigned long)r.sequence);
+            return -1;
+        }
+        if (!first && r.sequence != prev + 1 && prev + 1 < durable)
+        {
+            fprintf(stderr, "log_sim: durable records %lu..%lu missing\n",
+                    (unsigned long)(prev + 1), (unsigned long)(r.sequence - 1));
+            return -1;
+        }
+        prev = r.sequence;
+        first = 0;
+        count++;
+    }
+    if (ret < 0)
+    {
+        fprintf(stderr, "log_sim: flash error during the walk\n");
+        return -1;
+    }
+    if ((count && prev + 1 < durable) || log->next_record_seq < durable)
+    {
+        fprintf(stderr, "log_sim: durable records up to %lu lost (newest %lu)\n",
+                (unsigned long)durable, (unsigned long)(count ? prev : 0));
+        return -1;
+    }
+    *n_records = count;
+    return 0;
+}
+
+static int parse_options(int argc, char **argv, SimOptions_t *o)
+{
+    o->sectors = 16;
+    o->sector_kb = 64;
+    o->page = 512;
+    o->records = 100000;
+    o->cuts = 40;
+    o->erase_polls = 24;
+    o->seed = 1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (i + 1 >= argc)
+            return -1;
+        unsigned long v = strtoul(argv[i + 1], NULL, 0);
+        if (!strcmp(argv[i], "--sectors"))
+            o->sectors = (uint16_t)v;
+        else if (!strcmp(argv[i], "--sector-kb"))
+            o->sector_kb = (uint32_t)v;
+        else if (!strcmp(argv[i], "--page"))
+            o->page = (uint32_t)v;
+        else if (!strcmp(argv[i], "--records"))
+            o->records = (uint32_t)v;
+        else if (!strcmp(argv[i], "--cuts"))
+            o->cuts = (uint32_t)v;
+        else if (!strcmp(argv[i], "--erase-polls"))
+            o->erase_polls = (uint32_t)v;
+        else if (!strcmp(argv[i], "--seed"))
+            o->seed = (uint32_t)v;
+        else
+            return -1;
+        i++;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    SimOptions_t o;
+    if (parse_options(argc, argv, &o) != 0)
+    {
+        fprintf(stderr,
+                "usage: %s [--sectors N] [--sector-kb K] [--page B] [--records N] [--cuts N]\n"
+                "       [--erase-polls N] [--seed S]\n",
+                argv[0]);
+        return 2;
+    }
+
+    NorSim_t sim;
+    NorFlash_t flash;
+    if (nor_sim_init(&sim, &flash, (uint32_t)o.sectors * o.sector_kb * 1024u, o.sector_kb * 1024u,
+                     o.page, o.erase_polls) != 0)
+    {
+        fprintf(stderr, "log_sim: bad geometry\n");
+        return 2;
+    }
+
+    static DetectionLog_t log;
+    rng_state = o.seed;
+    uint32_t records_per_cut = o.records / (o.cuts + 1) + 1;
+    uint32_t durable = 0, appended = 0, dropped = 0, reclaimed = 0, torn = 0, n_records = 0;
+    uint32_t max_mount_reads = 0, mounts = 0;
+    int failed = 0;
+
+    while (appended < o.records && !failed)
+    {
+        if (detection_log_mount(&log, &flash, 0, o.sectors) != 0)
+        {
+            fprintf(stderr, "log_sim: mount failed\n");
+            failed = 1;
+            break;
+        }
+        mounts++;
+        if (log.stats.reads > max_mount_reads)
+            max_mount_reads = log.stats.reads;
+        torn += log.stats.torn_records;
+        if (verify(&log, durable, &n_records) != 0)
+        {
+            failed = 1;
+            break;
+        }
+
+        // the cut lands on a random flash operation of this session, if the session gets there
+        int cut = mounts <= o.cuts;
+        if (cut)
+            nor_sim_cut_power(&sim, 1 + next_random() % (records_per_cut / 8 + 2),
+                              next_random());
+
+        uint32_t session = 0;
+        while (appended < o.records && !sim.powered_off && (!cut || session < 4 * records_per_cut))
+        {
+            // a burst of detections, then a few main-loop passes
+            uint32_t burst = 1 + next_random() % 8;
+            for (uint32_t i = 0; i < burst && appended < o.records; ++i)
+            {
+                DetectionRecord_t r;
+                make_record(log.next_record_seq, &r);
+                if (detection_log_append(&log, &r) == 0)
+                    appended++;
+                session++;
+            }
+            for (uint32_t i = 0; i < 1 + next_random() % 8 && !sim.powered_off; ++i)
+                detection_log_service(&log);
+            if (next_random() % 64 == 0 && !sim.powered_off)
+                detection_log_flush(&log);
+        }
+        if (!sim.powered_off && detection_log_flush(&log) != 0)
+            failed = 1;
+
+        durable = log.durable_seq;
+        dropped += log.stats.dropped;
+        reclaimed += log.stats.reclaimed;
+        nor_sim_power_on(&sim);
+    }
+
+    if (!failed)
+    {
+        failed = detection_log_mount(&log, &flash, 0, o.sectors) != 0;
+        if (log.stats.reads > max_mount_reads)
+            max_mount_reads = log.stats.reads;
+        failed = failed || verify(&log, durable, &n_records) != 0;
+    }
+
+    uint32_t wear_min = UINT32_MAX, wear_max = 0;
+    for (uint16_t s = 0; s < o.sectors; ++s)
+    {
+        if (sim.sector_erases[s] < wear_min)
+            wear_min = sim.sector_erases[s];
+        if (sim.sector_erases[s] > wear_max)
+            wear_max = sim.sector_erases[s];
+    }
+
+    uint32_t pages = o.sector_kb * 1024u / o.page;
+    printf("geometry:  %u sectors x %lu KB, %lu B pages, %lu records per sector\n", o.sectors,
+           (unsigned long)o.sector_kb, (unsigned long)o.page,
+           (unsigned long)(o.sector_kb * 1024u / DETECTION_LOG_SLOT - 1));
+    printf("records:   %lu appended, %lu dropped, %lu on flash, %lu sectors reclaimed\n",
+           (unsigned long)appended, (unsigned long)dropped, (unsigned long)n_records,
+           (unsigned long)reclaimed);
+    printf("power:     %lu mounts, %lu torn slots skipped, mount reads max %lu (%u headers + "
+           "page search over %lu pages)\n",
+           (unsigned long)mounts, (unsigned long)torn, (unsigned long)max_mount_reads, o.sectors,
+           (unsigned long)pages);
+    printf("flash ops: %llu programs (%llu B), %llu erases, %llu reads (%llu B)\n",
+           (unsigned long long)sim.programs, (unsigned long long)sim.program_bytes,
+           (unsigned long long)sim.erases, (unsigned long long)sim.reads,
+           (unsigned long long)sim.read_bytes);
+    printf("write amp: %.3f programmed bytes per record byte, %.1f records per program\n",
+           appended ? (double)sim.program_bytes / ((double)appended * DETECTION_LOG_SLOT) : 0.0,
+           sim.programs ? (double)appended / sim.programs : 0.0);
+    printf("wear:      erases per sector %lu..%lu\n", (unsigned long)wear_min,
+           (unsigned long)wear_max);
+    printf("semantics: %lu program violations, %lu operations rejected while busy\n",
+           (unsigned long)sim.violations, (unsigned long)sim.busy_rejects);
+
+    if (sim.violations)
+        failed = 1;
+    printf("%s\n", failed ? "FAIL" : "ok");
+    nor_sim_free(&sim);
+    return failed ? 1 : 0;
+}
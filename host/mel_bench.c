@@ -0,0 +1,360 @@
+// mel_bench.c
+// Times the mel front end over an fft_size/hop/n_mels sweep: frames per second, ns per frame for
+// the float and the fused int8 path, real-time factor and the engine's memory. A second sweep
+// varies the frames per mel projection (config.batch) at each FFT size. Host figures come from
+// the portable CMSIS-DSP C kernels, so compare runs with each other, not with the target.
+//
+// A third table sets the fused int8 path against the three passes it replaces
+// (calculate_mel_spectrogram, normalize_spectrogram, cnn_quantize_input): ns per frame of both,
+// the float spectrogram bytes it no longer needs for the second of audio, and its drift in int8
+// LSBs. The fused path maps a fixed dB range instead of each window's min/max, so the drift is
+// taken against the float dB clamped to that same range, normalized and quantized with
+// cnn_quantize_input.
+//
+// usage: mel_bench [--json FILE] [--seconds S]
+//   (exit status 1 if a config fails or the fused path drifts more than MAX_LSB_DRIFT)
+#include "cnn_inference.h"
+#include "mel_spectrogram.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SAMPLE_RATE 16000
+#define AUDIO_SECONDS 1
+#define N_SAMPLES (SAMPLE_RATE * AUDIO_SECONDS)
+#define MIN_REPEATS 3
+#define MAX_LSB_DRIFT 1 // fast_log2 against log10f, plus the rounding either side of a half
+
+typedef struct
+{
+    uint16_t fft_size;
+    uint16_t hop_length;
+    uint16_t n_mels;
+    uint16_t batch;
+    uint16_t n_frames;
+    uint32_t state_bytes;
+    uint32_t scratch_bytes;
+    uint32_t output_bytes;
+    double ns_per_frame;
+    double ns_per_frame_q8;
+    double ns_per_frame_3pass; // float, normalize_spectrogram, cnn_quantize_input
+    uint32_t max_lsb_drift;    // fused int8 against the float reference
+    double mean_lsb_drift;
+} BenchResult_t;
+
+// the model input the fused path is benchmarked with: [-80, 0] dB onto the full int8 range
+static const MelQuantParams_t quant = {1.0f / 255.0f, -128, -80.0f, 0.0f};
+
+static const uint16_t fft_sizes[] = {256, 512, 1024, 2048};
+static const uint16_t hop_divs[] = {4, 2};
+static const uint16_t mel_counts[] = {32, 64, 128};
+// batch sweep at hop fft/2 and 64 bands; sizes above MEL_MAX_BATCH are skipped
+static const uint16_t batch_sizes[] = {1, 2, 4, 8, 16};
+#define BATCH_SWEEP_MELS 64
+
+static int16_t pcm[N_SAMPLES];
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// rising tone over low-level noise, the same samples on every run
+static void make_signal(void)
+{
+    uint32_t lcg = 12345;
+    uint32_t phase = 0;
+
+    for (uint32_t i = 0; i < N_SAMPLES; ++i)
+    {
+        lcg = lcg * 1664525u + 1013904223u;
+        phase += 400u + (i >> 2); // fixed-point phase step, 16 bits per turn
+        int32_t tone = ((phase >> 4) & 0x1000) ? 6000 : -6000;
+        pcm[i] = (int16_t)(tone + (int32_t)(lcg >> 22) - 512);
+    }
+}
+
+// ns per frame of fn, repeated for at least min_seconds
+static double time_path(int (*fn)(void *), void *arg, uint16_t n_frames, double min_seconds)
+{
+    uint32_t repeats = 0;
+    double start = now_ns();
+    double elapsed;
+
+    do
+    {
+        if (fn(arg) != n_frames)
+            return -1.0;
+        repeats++;
+        elapsed = now_ns() - start;
+    } while (repeats < MIN_REPEATS || elapsed < min_seconds * 1e9);
+
+    return elapsed / ((double)repeats * n_frames);
+}
+
+typedef struct
+{
+    float *spectrogram;
+    int8_t *quantized;
+    int8_t *reference;
+    uint16_t n_mels;
+    uint16_t cols;
+} BenchBuffers_t;
+
+static int run_float(void *arg)
+{
+    BenchBuffers_t *b = arg;
+    return calculate_mel_spectrogram(pcm, N_SAMPLES, b->spectrogram, b->cols);
+}
+
+static int run_q8(void *arg)
+{
+    BenchBuffers_t *b = arg;
+    return calculate_mel_spectrogram_q8(pcm, N_SAMPLES, b->quantized, b->cols, &quant);
+}
+
+// the deployed float path the fused one replaces
+static int run_3pass(void *arg)
+{
+    BenchBuffers_t *b = arg;
+    const int n = calculate_mel_spectrogram(pcm, N_SAMPLES, b->spectrogram, b->cols);
+    if (n != b->cols)
+        return -1;
+    normalize_spectrogram(b->spectrogram, b->n_mels, b->cols);
+    cnn_quantize_input(b->spectrogram, b->reference, (uint32_t)b->n_mels * b->cols, quant.scale,
+                       quant.zero_point);
+    return n;
+}
+
+// fused int8 against float dB -> the fused path's fixed range -> cnn_quantize_input
+static int measure_drift(BenchBuffers_t *b, BenchResult_t *r)
+{
+    const uint32_t n = (uint32_t)b->n_mels * b->cols;
+    const float span = quant.db_ceil - quant.db_floor;
+
+    if (run_q8(b) != b->cols || run_float(b) != b->cols)
+        return -1;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        float db = b->spectrogram[i];
+        db = (db < quant.db_floor) ? quant.db_floor : (db > quant.db_ceil) ? quant.db_ceil : db;
+        b->spectrogram[i] = (db - quant.db_floor) / span;
+    }
+    cnn_quantize_input(b->spectrogram, b->reference, n, quant.scale, quant.zero_point);
+
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        const int32_t d = b->quantized[i] - b->reference[i];
+        const uint32_t a = (uint32_t)((d < 0) ? -d : d);
+        r->max_lsb_drift = (a > r->max_lsb_drift) ? a : r->max_lsb_drift;
+        sum += a;
+    }
+    r->mean_lsb_drift = (double)sum / n;
+    return 0;
+}
+
+static int bench(uint16_t fft_size, uint16_t hop, uint16_t n_mels, uint16_t batch,
+                 double min_seconds, BenchResult_t *r)
+{
+    MelSpectrogramConfig_t config = {.sample_rate = SAMPLE_RATE, .fft_size = fft_size,
+                                     .hop_length = hop, .n_mels = n_mels, .f_min = 0.0f,
+                                     .f_max = SAMPLE_RATE / 2, .batch = batch};
+    BenchBuffers_t b;
+    int ret = -1;
+
+    memset(r, 0, sizeof(*r));
+    r->fft_size = fft_size;
+    r->hop_length = hop;
+    r->n_mels = n_mels;
+    r->batch = batch ? batch : MEL_DEFAULT_BATCH;
+    if (mel_spectrogram_workspace_size(&config, &r->state_bytes, &r->scratch_bytes) != 0)
+        return -1;
+    r->n_frames = (uint16_t)((N_SAMPLES - fft_size) / hop + 1);
+    r->output_bytes = (uint32_t)n_mels * r->n_frames * sizeof(float);
+
+    float *state = malloc(r->state_bytes);
+    float *scratch = malloc(r->scratch_bytes);
+    b.spectrogram = malloc(r->output_bytes);
+    b.quantized = malloc((size_t)n_mels * r->n_frames);
+    b.reference = malloc((size_t)n_mels * r->n_frames);
+    b.n_mels = n_mels;
+    b.cols = r->n_frames;
+
+    if (state && scratch && b.spectrogram && b.quantized && b.reference)
+    {
+        mel_spectrogram_set_memory(state, r->state_bytes, scratch, r->scratch_bytes);
+        if (mel_spectrogram_init(&config) == 0)
+        {
+            r->ns_per_frame = time_path(run_float, &b, r->n_frames, min_seconds);
+            r->ns_per_frame_q8 = time_path(run_q8, &b, r->n_frames, min_seconds);
+            r->ns_per_frame_3pass = time_path(run_3pass, &b, r->n_frames, min_seconds);
+            ret = (r->ns_per_frame > 0.0 && r->ns_per_frame_q8 > 0.0 &&
+                   r->ns_per_frame_3pass > 0.0)
+                      ? measure_drift(&b, r)
+                      : -1;
+        }
+    }
+
+    free(state);
+    free(scratch);
+    free(b.spectrogram);
+    free(b.quantized);
+    free(b.reference);
+    return ret;
+}
+
+static void write_results(FILE *f, const char *name, const BenchResult_t *results, unsigned n)
+{
+    fprintf(f, "  \"%s\": [\n", name);
+    for (unsigned i = 0; i < n; ++i)
+    {
+        const BenchResult_t *r = &results[i];
+        fprintf(f,
+                "    {\"fft_size\": %u, \"hop_length\": %u, \"n_mels\": %u, \"batch\": %u, "
+                "\"n_frames\": %u, "
+                "\"frames_per_second\": %.1f, \"ns_per_frame\": %.1f, "
+                "\"frames_per_second_q8\": %.1f, \"ns_per_frame_q8\": %.1f, "
+                "\"ns_per_frame_3pass\": %.1f, \"max_lsb_drift\": %lu, \"mean_lsb_drift\": %.4f, "
+                "\"realtime_factor\": %.1f, \"state_bytes\": %lu, \"scratch_bytes\": %lu, "
+                "\"output_bytes\": %lu}%s\n",
+                r->fft_size, r->hop_length, r->n_mels, r->batch, r->n_frames, 1e9 / r->ns_per_frame,
+                r->ns_per_frame, 1e9 / r->ns_per_frame_q8, r->ns_per_frame_q8,
+                r->ns_per_frame_3pass, (unsigned long)r->max_lsb_drift, r->mean_lsb_drift,
+                1e9 / r->ns_per_frame * r->hop_length / SAMPLE_RATE,
+                (unsigned long)r->state_bytes, (unsigned long)r->scratch_bytes,
+                (unsigned long)r->output_bytes, i + 1 < n ? "," : "");
+    }
+    fprintf(f, "  ]");
+}
+
+static void write_json(FILE *f, const BenchResult_t *results, unsigned n,
+                       const BenchResult_t *batches, unsigned n_batches, double min_seconds)
+{
+    fprintf(f, "{\n  \"benchmark\": \"mel_spectrogram\",\n");
+#ifdef __VERSION__
+    fprintf(f, "  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+    fprintf(f, "  \"sample_rate\": %d,\n  \"audio_seconds\": %d,\n  \"min_seconds\": %g,\n",
+            SAMPLE_RATE, AUDIO_SECONDS, min_seconds);
+    write_results(f, "results", results, n);
+    fprintf(f, ",\n");
+    write_results(f, "batch_results", batches, n_batches);
+    fprintf(f, "\n}\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *json_path = NULL;
+    double min_seconds = 0.2;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--json") && i + 1 < argc)
+            json_path = argv[++i];
+        else if (!strcmp(argv[i], "--seconds") && i + 1 < argc)
+            min_seconds = atof(argv[++i]);
+        else
+        {
+            fprintf(stderr, "usage: %s [--json FILE] [--seconds S]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    BenchResult_t results[sizeof(fft_sizes) / sizeof(fft_sizes[0]) *
+                          sizeof(hop_divs) / sizeof(hop_divs[0]) *
+                          sizeof(mel_counts) / sizeof(mel_counts[0])];
+    unsigned n = 0;
+
+    make_signal();
+
+    printf("  fft   hop  mels frames     frames/s   ns/frame  ns/frame q8   x realtime"
+           "   state B scratch B\n");
+    for (unsigned f = 0; f < sizeof(fft_sizes) / sizeof(fft_sizes[0]); ++f)
+    {
+        for (unsigned h = 0; h < sizeof(hop_divs) / sizeof(hop_divs[0]); ++h)
+        {
+            for (unsigned m = 0; m < sizeof(mel_counts) / sizeof(mel_counts[0]); ++m)
+            {
+                BenchResult_t *r = &results[n];
+                if (bench(fft_sizes[f], fft_sizes[f] / hop_divs[h], mel_counts[m], 0, min_seconds,
+                          r) != 0)
+                {
+                    fprintf(stderr, "mel_bench: fft %u hop %u mels %u failed\n", fft_sizes[f],
+                            fft_sizes[f] / hop_divs[h], mel_counts[m]);
+                    return 1;
+                }
+                printf("%5u %5u %5u %6u %12.0f %10.0f %12.0f %12.1f %9lu %9lu\n", r->fft_size,
+                       r->hop_length, r->n_mels, r->n_frames, 1e9 / r->ns_per_frame,
+                       r->ns_per_frame, r->ns_per_frame_q8,
+                       1e9 / r->ns_per_frame * r->hop_length / SAMPLE_RATE,
+                       (unsigned long)r->state_bytes, (unsigned long)r->scratch_bytes);
+                n++;
+            }
+        }
+    }
+
+    // the fused path against the three passes it replaces
+    int drifted = 0;
+    printf("\n  fft   hop  mels  ns/frame 3-pass  ns/frame q8  speedup  float B saved  max LSB"
+           "  mean LSB\n");
+    for (unsigned i = 0; i < n; ++i)
+    {
+        const BenchResult_t *r = &results[i];
+        printf("%5u %5u %5u %16.0f %12.0f %8.2f %14lu %8lu %9.4f\n", r->fft_size, r->hop_length,
+               r->n_mels, r->ns_per_frame_3pass, r->ns_per_frame_q8,
+               r->ns_per_frame_3pass / r->ns_per_frame_q8, (unsigned long)r->output_bytes,
+               (unsigned long)r->max_lsb_drift, r->mean_lsb_drift);
+        drifted |= r->max_lsb_drift > MAX_LSB_DRIFT;
+    }
+
+    // frames per mel projection
+    BenchResult_t batches[sizeof(fft_sizes) / sizeof(fft_sizes[0]) *
+                          sizeof(batch_sizes) / sizeof(batch_sizes[0])];
+    unsigned n_batches = 0;
+
+    printf("\n  fft   hop  mels batch   ns/frame  ns/frame q8  x batch 1 scratch B\n");
+    for (unsigned f = 0; f < sizeof(fft_sizes) / sizeof(fft_sizes[0]); ++f)
+    {
+        const BenchResult_t *single = NULL;
+        for (unsigned k = 0; k < sizeof(batch_sizes) / sizeof(batch_sizes[0]); ++k)
+        {
+            // the engine also caps the batch at fft_size / n_mels columns
+            if (batch_sizes[k] > MEL_MAX_BATCH ||
+                batch_sizes[k] > fft_sizes[f] / BATCH_SWEEP_MELS)
+                continue;
+            BenchResult_t *r = &batches[n_batches];
+            if (bench(fft_sizes[f], fft_sizes[f] / 2, BATCH_SWEEP_MELS, batch_sizes[k],
+                      min_seconds, r) != 0)
+            {
+                fprintf(stderr, "mel_bench: fft %u batch %u failed\n", fft_sizes[f],
+                        batch_sizes[k]);
+                return 1;
+            }
+            if (!single)
+                single = r;
+            printf("%5u %5u %5u %5u %10.0f %12.0f %10.2f %9lu\n", r->fft_size, r->hop_length,
+                   r->n_mels, r->batch, r->ns_per_frame, r->ns_per_frame_q8,
+                   single->ns_per_frame / r->ns_per_frame, (unsigned long)r->scratch_bytes);
+            n_batches++;
+        }
+    }
+
+    if (json_path)
+    {
+        FILE *f = fopen(json_path, "w");
+        if (!f)
+        {
+            fprintf(stderr, "mel_bench: cannot write %s\n", json_path);
+            return 1;
+        }
+        write_json(f, results, n, batches, n_batches, min_seconds);
+        fclose(f);
+    }
+    if (drifted)
+        fprintf(stderr, "mel_bench: fused int8 path drifts more than %d LSB\n", MAX_LSB_DRIFT);
+    return drifted ? 1 : 0;
+}
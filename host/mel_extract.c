@@ -0,0 +1,581 @@
+// mel_extract.c
+// Batch feature extraction for model validation: runs the firmware's own feature pipeline over
+// WAV recordings and writes one feature file per recording, so training sees the features the
+// device computes. Each window is what AudioRecord() hands the model: MEL_FRAMES columns from
+// calculate_mel_spectrogram, normalized to [0, 1], optionally quantized to the int8 model input.
+//
+// Recordings are memory-mapped and cut into units of consecutive windows. Every worker owns a
+// deque of units, pops from its front and steals from the back of another worker's deque once
+// its own runs dry. Windows are written in place with pwrite, so no file is ever held in memory
+// and recordings larger than RAM stream through the page cache.
+//
+// usage: mel_extract [options] OUT_DIR WAV... ("-" reads paths from stdin, one per line)
+//   -j N         worker threads (default: online CPUs)
+//   --frames N   columns per window (64), --fft N (512), --hop N (256), --mels N (64)
+//   --fmin F     (0), --fmax F (8000), --rate HZ (16000, recordings must match)
+//   --raw        skip the per-window normalization, float dB output
+//   --int8       int8 model input as cnn_quantize_input produces it
+//   --fused      int8 model input from calculate_mel_spectrogram_q8 (fixed dB range)
+//
+// Output OUT_DIR/<name>.mel: MelFileHeader_t, then n_windows tensors of n_mels x n_frames
+// (mel-major, the layout of the model input), float32 or int8. tools/mel_features.py reads it.
+#include "cnn_inference.h"
+#include "mel_spectrogram.h"
+#include "wav_file.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MEL_FILE_MAGIC "MELF"
+#define MEL_FILE_VERSION 1
+#define WINDOWS_PER_UNIT 4
+#define MAX_WORKERS 256
+
+// model input quantization, as audio_record.c
+#define MODEL_INPUT_SCALE (1.0f / 255.0f)
+#define MODEL_INPUT_ZERO_POINT (-128)
+#define MODEL_INPUT_DB_FLOOR (-80.0f)
+#define MODEL_INPUT_DB_CEIL (60.0f)
+
+enum
+{
+    DTYPE_F32 = 0,
+    DTYPE_I8 = 1,
+};
+
+typedef enum
+{
+    OUTPUT_NORMALIZED, // float [0, 1], the input of cnn_quantize_input
+    OUTPUT_RAW,        // float dB, calculate_mel_spectrogram alone
+    OUTPUT_INT8,       // normalize + cnn_quantize_input
+    OUTPUT_FUSED,      // calculate_mel_spectrogram_q8
+} OutputMode_t;
+
+// little-endian on disk, 48 bytes
+typedef struct
+{
+    char magic[4];
+    uint16_t version;
+    uint8_t dtype;      // DTYPE_*
+    uint8_t normalized; // 1 if every window was scaled to [0, 1] before storing/quantizing
+    uint32_t sample_rate;
+    uint16_t fft_size;
+    uint16_t hop_length;
+    uint16_t n_mels;
+    uint16_t n_frames; // columns per window
+    float f_min;
+    float f_max;
+    float q_scale;       // int8 only: real = (q - zero_point) * scale
+    int32_t q_zero_point;
+    uint32_t n_windows;
+    uint64_t n_samples; // samples of the recording (one channel)
+} MelFileHeader_t;
+
+_Static_assert(sizeof(MelFileHeader_t) == 48, "feature file header layout");
+
+typedef struct
+{
+    const char *path;
+    char *out_path;
+    WavFile_t wav;
+    uint32_t n_windows;
+    volatile int failed;
+} Recording_t;
+
+typedef struct
+{
+    uint32_t recording;
+    uint32_t first_window;
+    uint32_t n_windows;
+} Unit_t;
+
+// a worker's share of the unit list, [head, tail) still to do
+typedef struct
+{
+    pthread_mutex_t lock;
+    uint32_t head;
+    uint32_t tail;
+} Deque_t;
+
+typedef struct
+{
+    unsigned id;
+    uint32_t windows_done;
+    uint32_t units_stolen;
+} Worker_t;
+
+static MelSpectrogramConfig_t config = {.sample_rate = 16000, .fft_size = 512, .hop_length = 256,
+                                        .n_mels = 64, .f_min = 0.0f, .f_max = 8000.0f};
+static uint16_t n_frames = 64;
+static OutputMode_t mode = OUTPUT_NORMALIZED;
+
+static Recording_t *recordings;
+static uint32_t n_recordings;
+static Unit_t *units;
+static uint32_t n_units;
+static Deque_t deques[MAX_WORKERS];
+static unsigned n_workers;
+
+static uint32_t window_samples(void)
+{
+    return (uint32_t)(n_frames - 1) * config.hop_length + config.fft_size;
+}
+
+static uint32_t window_bytes(void)
+{
+    uint32_t elements = (uint32_t)config.n_mels * n_frames;
+    return (mode == OUTPUT_INT8 || mode == OUTPUT_FUSED) ? elements : elements * sizeof(float);
+}
+
+static char *output_path(const char *out_dir, const char *path)
+{
+    const char *base = strrchr(path, '/');
+    base = base ? base + 1 : path;
+    size_t len = strlen(base);
+    if (len > 4 && (!strcasecmp(base + len - 4, ".wav")))
+        len -= 4;
+
+    char *out = malloc(strlen(out_dir) + len + 6);
+    if (out)
+        sprintf(out, "%s/%.*s.mel", out_dir, (int)len, base);
+    return out;
+}
+
+// maps the recording, sizes its output and writes the header
+static int open_recording(Recording_t *r, const char *out_dir)
+{
+    int fd;
+    int ret = wav_open(r->path, &r->wav);
+
+    if (ret == 0 && r->wav.sample_rate != config.sample_rate)
+        ret = -3;
+    if (ret != 0)
+    {
+        fprintf(stderr, "mel_extract: %s: %s\n", r->path,
+                ret == -1   ? "cannot open"
+                : ret == -2 ? "not a 16-bit PCM WAV"
+                            : "sample rate differs from --rate");
+        return -1;
+    }
+
+    // whole windows only, advancing by n_frames hops like consecutive recording buffers
+    uint64_t advance = (uint64_t)n_frames * config.hop_length;
+    r->n_windows = r->wav.n_samples < window_samples()
+                       ? 0
+                       : (uint32_t)((r->wav.n_samples - window_samples()) / advance + 1);
+
+    MelFileHeader_t header = {
+        .magic = MEL_FILE_MAGIC,
+        .version = MEL_FILE_VERSION,
+        .dtype = (mode == OUTPUT_INT8 || mode == OUTPUT_FUSED) ? DTYPE_I8 : DTYPE_F32,
+        .normalized = (mode == OUTPUT_NORMALIZED || mode == OUTPUT_INT8),
+        .sample_rate = config.sample_rate,
+        .fft_size = config.fft_size,
+        .hop_length = config.hop_length,
+        .n_mels = config.n_mels,
+        .n_frames = n_frames,
+        .f_min = config.f_min,
+        .f_max = config.f_max,
+        .q_scale = (mode == OUTPUT_INT8 || mode == OUTPUT_FUSED) ? MODEL_INPUT_SCALE : 0.0f,
+        .q_zero_point = (mode == OUTPUT_INT8 || mode == OUTPUT_FUSED) ? MODEL_INPUT_ZERO_POINT : 0,
+        .n_windows = r->n_windows,
+        .n_samples = r->wav.n_samples,
+    };
+
+    r->out_path = output_path(out_dir, r->path);
+    fd = r->out_path ? open(r->out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644) : -1;
+    if (fd < 0 || write(fd, &header, sizeof(header)) != sizeof(header) ||
+        ftruncate(fd, sizeof(header) + (off_t)r->n_windows * window_bytes()) != 0)
+    {
+        fprintf(stderr, "mel_extract: %s: cannot write %s\n", r->path,
+                r->out_path ? r->out_path : "output");
+        if (fd >= 0)
+            close(fd);
+        return -1;
+    }
+    close(fd);
+    return 0;
+}
+
+// per-thread engine memory and window buffers
+typedef struct
+{
+    float *state;
+    float *scratch;
+    float *spectrogram;
+    int8_t *quantized;
+    int16_t *mono; // channel 0 of interleaved recordings
+} WorkerBuffers_t;
+
+static int worker_engine_init(WorkerBuffers_t *b)
+{
+    uint32_t state_bytes, scratch_bytes;
+    uint32_t elements = (uint32_t)config.n_mels * n_frames;
+
+    memset(b, 0, sizeof(*b));
+    if (mel_spectrogram_workspace_size(&config, &state_bytes, &scratch_bytes) != 0)
+        return -1;
+    b->state = malloc(state_bytes);
+    b->scratch = malloc(scratch_bytes);
+    b->spectrogram = malloc(elements * sizeof(float));
+    b->quantized = malloc(elements);
+    b->mono = malloc(window_samples() * sizeof(int16_t));
+    if (!b->state || !b->scratch || !b->spectrogram || !b->quantized || !b->mono)
+        return -1;
+
+    mel_spectrogram_set_memory(b->state, state_bytes, b->scratch, scratch_bytes);
+    return mel_spectrogram_init(&config);
+}
+
+static void worker_engine_free(WorkerBuffers_t *b)
+{
+    free(b->state);
+    free(b->scratch);
+    free(b->spectrogram);
+    free(b->quantized);
+    free(b->mono);
+}
+
+// the firmware's feature pass for one window; returns the bytes to store
+static const void *extract_window(WorkerBuffers_t *b, const int16_t *pcm)
+{
+    static const MelQuantParams_t quant = {.scale = MODEL_INPUT_SCALE,
+                                           .zero_point = MODEL_INPUT_ZERO_POINT,
+                                           .db_floor = MODEL_INPUT_DB_FLOOR,
+                                           .db_ceil = MODEL_INPUT_DB_CEIL};
+
+    if (mode == OUTPUT_FUSED)
+    {
+        if (calculate_mel_spectrogram_q8(pcm, window_samples(), b->quantized, n_frames,
+                                         &quant) != n_frames)
+            return NULL;
+        return b->quantized;
+    }
+
+    if (calculate_mel_spectrogram(pcm, window_samples(), b->spectrogram, n_frames) != n_frames)
+        return NULL;
+    if (mode == OUTPUT_RAW)
+        return b->spectrogram;
+
+    normalize_spectrogram(b->spectrogram, config.n_mels, n_frames);
+    if (mode == OUTPUT_NORMALIZED)
+        return b->spectrogram;
+
+    cnn_quantize_input(b->spectrogram, b->quantized, (uint32_t)config.n_mels * n_frames,
+                       MODEL_INPUT_SCALE, MODEL_INPUT_ZERO_POINT);
+    return b->quantized;
+}
+
+static int run_unit(WorkerBuffers_t *b, const Unit_t *u)
+{
+    Recording_t *r = &recordings[u->recording];
+    const uint64_t advance = (uint64_t)n_frames * config.hop_length;
+    const uint32_t bytes = window_bytes();
+    int fd = open(r->out_path, O_WRONLY);
+    int ret = 0;
+
+    if (fd < 0)
+        return -1;
+
+    for (uint32_t w = u->first_window; w < u->first_window + u->n_windows && ret == 0; ++w)
+    {
+        const int16_t *pcm = r->wav.samples + w * advance;
+
+        if (r->wav.channels > 1)
+        {
+            wav_read_mono(&r->wav, w * advance, window_samples(), b->mono);
+            pcm = b->mono;
+        }
+
+        const void *features = extract_window(b, pcm);
+        off_t offset = sizeof(MelFileHeader_t) + (off_t)w * bytes;
+        if (!features || pwrite(fd, features, bytes, offset) != (ssize_t)bytes)
+            ret = -1;
+    }
+    close(fd);
+
+    // done with these pages; the window overlap with the next unit is simply faulted in again
+    uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t begin = (uintptr_t)(r->wav.samples + u->first_window * advance * r->wav.channels);
+    uintptr_t end = (uintptr_t)(r->wav.samples +
+                                (u->first_window + u->n_windows) * advance * r->wav.channels);
+    begin = (begin + page - 1) & ~(page - 1);
+    end &= ~(page - 1);
+    if (end > begin)
+        madvise((void *)begin, end - begin, MADV_DONTNEED);
+
+    return ret;
+}
+
+// own deque from the front, keeps reading each recording in order
+static int pop_own(unsigned id, Unit_t *out)
+{
+    Deque_t *d = &deques[id];
+    int found = 0;
+
+    pthread_mutex_lock(&d->lock);
+    if (d->head < d->tail)
+    {
+        *out = units[d->head++];
+        found = 1;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return found;
+}
+
+// another worker's deque from the back, as far from its owner's position as possible
+static int steal(unsigned id, Unit_t *out)
+{
+    for (unsigned k = 1; k < n_workers; ++k)
+    {
+        Deque_t *d = &deques[(id + k) % n_workers];
+        int found = 0;
+
+        pthread_mutex_lock(&d->lock);
+        if (d->head < d->tail)
+        {
+            *out = units[--d->tail];
+            found = 1;
+        }
+        pthread_mutex_unlock(&d->lock);
+        if (found)
+            return 1;
+    }
+    return 0;
+}
+
+static void *worker_main(void *arg)
+{
+    Worker_t *worker = arg;
+    WorkerBuffers_t buffers;
+    Unit_t unit;
+
+    if (worker_engine_init(&buffers) != 0)
+    {
+        fprintf(stderr, "mel_extract: worker %u: engine init failed\n", worker->id);
+        worker_engine_free(&buffers);
+        return NULL;
+    }
+
+    for (;;)
+    {
+        if (!pop_own(worker->id, &unit))
+        {
+            if (!steal(worker->id, &unit))
+                break;
+            worker->units_stolen++;
+        }
+        if (run_unit(&buffers, &unit) != 0)
+            recordings[unit.recording].failed = 1;
+        else
+            worker->windows_done += unit.n_windows;
+    }
+
+    worker_engine_free(&buffers);
+    return NULL;
+}
+
+// splits every recording into units and hands each worker a contiguous share
+static int plan_units(void)
+{
+    uint32_t total = 0;
+
+    for (uint32_t i = 0; i < n_recordings; ++i)
+        total += (recordings[i].n_windows + WINDOWS_PER_UNIT - 1) / WINDOWS_PER_UNIT;
+
+    units = malloc((total ? total : 1) * sizeof(Unit_t));
+    if (!units)
+        return -1;
+
+    for (uint32_t i = 0; i < n_recordings; ++i)
+    {
+        for (uint32_t w = 0; w < recordings[i].n_windows; w += WINDOWS_PER_UNIT)
+        {
+            uint32_t left = recordings[i].n_windows - w;
+            units[n_units++] =
+                (Unit_t){i, w, left < WINDOWS_PER_UNIT ? left : WINDOWS_PER_UNIT};
+        }
+    }
+
+    for (unsigned k = 0; k < n_workers; ++k)
+    {
+        pthread_mutex_init(&deques[k].lock, NULL);
+        deques[k].head = (uint32_t)((uint64_t)n_units * k / n_workers);
+        deques[k].tail = (uint32_t)((uint64_t)n_units * (k + 1) / n_workers);
+    }
+    return 0;
+}
+
+static int add_recording(const char *path, uint32_t *capacity)
+{
+    if (n_recordings == *capacity)
+    {
+        uint32_t grown = *capacity ? 2 * *capacity : 64;
+        Recording_t *r = realloc(recordings, grown * sizeof(Recording_t));
+        if (!r)
+            return -1;
+        recordings = r;
+        *capacity = grown;
+    }
+    memset(&recordings[n_recordings], 0, sizeof(Recording_t));
+    recordings[n_recordings].path = path;
+    n_recordings++;
+    return 0;
+}
+
+static int usage(const char *argv0)
+{
+    fprintf(stderr,
+            "usage: %s [-j N] [--frames N] [--fft N] [--hop N] [--mels N] [--fmin F] [--fmax F]\n"
+            "       [--rate HZ] [--raw | --int8 | --fused] OUT_DIR WAV... (- reads stdin)\n",
+            argv0);
+    return 2;
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t capacity = 0;
+    const char *out_dir = NULL;
+    int i;
+
+    n_workers = cpus > 0 ? (unsigned)cpus : 1;
+
+    for (i = 1; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; ++i)
+    {
+        const char *opt = argv[i];
+        const char *val = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (!strcmp(opt, "--raw"))
+            mode = OUTPUT_RAW;
+        else if (!strcmp(opt, "--int8"))
+            mode = OUTPUT_INT8;
+        else if (!strcmp(opt, "--fused"))
+            mode = OUTPUT_FUSED;
+        else if (!val)
+            return usage(argv[0]);
+        else
+        {
+            if (!strcmp(opt, "-j"))
+                n_workers = (unsigned)atoi(val);
+            else if (!strcmp(opt, "--frames"))
+                n_frames = (uint16_t)atoi(val);
+            else if (!strcmp(opt, "--fft"))
+                config.fft_size = (uint16_t)atoi(val);
+            else if (!strcmp(opt, "--hop"))
+                config.hop_length = (uint16_t)atoi(val);
+            else if (!strcmp(opt, "--mels"))
+                config.n_mels = (uint16_t)atoi(val);
+            else if (!strcmp(opt, "--fmin"))
+                config.f_min = (float)atof(val);
+            else if (!strcmp(opt, "--fmax"))
+                config.f_max = (float)atof(val);
+            else if (!strcmp(opt, "--rate"))
+                config.sample_rate = (uint32_t)atol(val);
+            else
+                return usage(argv[0]);
+            ++i;
+        }
+    }
+    if (i + 2 > argc || n_workers == 0 || n_frames == 0 || config.hop_length == 0 ||
+        mel_spectrogram_workspace_size(&config, NULL, NULL) != 0)
+        return usage(argv[0]);
+    if (n_workers > MAX_WORKERS)
+        n_workers = MAX_WORKERS;
+
+    out_dir = argv[i++];
+    if (mkdir(out_dir, 0755) != 0 && errno != EEXIST)
+    {
+        fprintf(stderr, "mel_extract: cannot create %s\n", out_dir);
+        return 1;
+    }
+
+    for (; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-") != 0)
+        {
+            if (add_recording(argv[i], &capacity) != 0)
+                return 1;
+            continue;
+        }
+        char line[4096];
+        while (fgets(line, sizeof(line), stdin))
+        {
+            line[strcspn(line, "\r\n")] = '\0';
+            if (line[0] && add_recording(strdup(line), &capacity) != 0)
+                return 1;
+        }
+    }
+
+    double start = now_s();
+    uint64_t total_samples = 0;
+    uint32_t failed = 0;
+
+    for (uint32_t k = 0; k < n_recordings; ++k)
+    {
+        if (open_recording(&recordings[k], out_dir) != 0)
+        {
+            recordings[k].failed = 1;
+            recordings[k].n_windows = 0;
+        }
+        total_samples += recordings[k].wav.n_samples;
+    }
+    if (plan_units() != 0)
+        return 1;
+
+    pthread_t threads[MAX_WORKERS];
+    Worker_t workers[MAX_WORKERS];
+    for (unsigned k = 0; k < n_workers; ++k)
+    {
+        workers[k] = (Worker_t){k, 0, 0};
+        if (pthread_create(&threads[k], NULL, worker_main, &workers[k]) != 0)
+        {
+            fprintf(stderr, "mel_extract: cannot start worker %u\n", k);
+            return 1;
+        }
+    }
+
+    uint64_t windows = 0;
+    uint32_t stolen = 0;
+    for (unsigned k = 0; k < n_workers; ++k)
+    {
+        pthread_join(threads[k], NULL);
+        windows += workers[k].windows_done;
+        stolen += workers[k].units_stolen;
+    }
+    double elapsed = now_s() - start;
+
+    for (uint32_t k = 0; k < n_recordings; ++k)
+    {
+        if (recordings[k].failed)
+        {
+            fprintf(stderr, "mel_extract: %s: extraction failed\n", recordings[k].path);
+            failed++;
+        }
+        wav_close(&recordings[k].wav);
+        free(recordings[k].out_path);
+    }
+
+    double audio_s = (double)total_samples / config.sample_rate;
+    printf("%lu recordings, %llu windows, %.1f s of audio in %.2f s (%.0fx realtime), "
+           "%u workers, %u units of %u stolen, %lu failed\n",
+           (unsigned long)n_recordings, (unsigned long long)windows, audio_s, elapsed,
+           elapsed > 0.0 ? audio_s / elapsed : 0.0, n_workers, stolen, n_units,
+           (unsigned long)failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,195 @@
+// mel_project_check.c
+// Checks the mel projection kernels against the per-band scalar loop they replace, over
+// FFT sizes, band counts and batch widths with random spectra: mel_project_f32 must match bit
+// for bit, mel_project_q15 must match an exact integer reference and stay within the Q15
+// quantization error of the float result. Prints ns per frame for the scalar loop and both
+// kernels.
+//
+// usage: mel_project_check [--seed S]   (exit status 1 if any check failed)
+#include "mel_project.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_FFT 2048
+#define MAX_BINS (MAX_FFT / 2 + 1)
+#define MAX_MELS 128
+#define MAX_FRAMES 9
+#define TIMING_REPEATS 200
+
+static const uint16_t fft_sizes[] = {256, 512, 1024, 2048};
+static const uint16_t mel_counts[] = {32, 64, 128};
+static const uint16_t frame_counts[] = {1, 3, 4, 5, 8, 9};
+
+static MelBand_t bands[MAX_MELS];
+static float weights[2 * MAX_BINS];
+static int16_t weights_q15[2 * MAX_BINS];
+static float power[MAX_FRAMES * MAX_BINS];
+static int16_t power_q15[MAX_FRAMES * MAX_BINS];
+static float expect[MAX_FRAMES * MAX_MELS];
+static float energy[MAX_FRAMES * MAX_MELS];
+static int32_t energy_q15[MAX_FRAMES * MAX_MELS];
+
+static uint32_t rng_state;
+
+static uint32_t next_random(void)
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// overlapping triangles with centers spread over the bins, the layout of
+// create_sparse_mel_filterbank: consecutive bands share the bins between their centers
+static uint32_t make_bank(uint16_t n_mels, uint16_t fft_bins)
+{
+    uint32_t n_weights = 0;
+    for (uint16_t m = 0; m < n_mels; ++m)
+    {
+        uint16_t left = (uint16_t)((uint32_t)m * (fft_bins - 1) / (n_mels + 1));
+        uint16_t center = (uint16_t)((uint32_t)(m + 1) * (fft_bins - 1) / (n_mels + 1));
+        uint16_t right = (uint16_t)((uint32_t)(m + 2) * (fft_bins - 1) / (n_mels + 1));
+        if (right <= left)
+            right = left + 1;
+        bands[m].first_bin = left;
+        bands[m].n_bins = right - left;
+        bands[m].offset = (uint16_t)n_weights;
+        for (uint16_t k = left; k < right; ++k)
+        {
+            float w = (k <= center) ? (float)(k - left + 1) / (center - left + 1)
+                                    : (float)(right - k) / (right - center);
+            weights[n_weights++] = w;
+        }
+    }
+    mel_weights_to_q15(weights, weights_q15, n_weights);
+    return n_weights;
+}
+
+// the loop mel_frame ran per frame before the kernels
+static void reference_f32(uint16_t n_mels, uint16_t fft_bins, uint16_t n_frames)
+{
+    for (uint16_t f = 0; f < n_frames; ++f)
+    {
+        for (uint16_t m = 0; m < n_mels; ++m)
+        {
+            const float *p = power + (uint32_t)f * fft_bins + bands[m].first_bin;
+            const float *w = weights + bands[m].offset;
+            float e = 0.0f;
+            for (uint16_t k = 0; k < bands[m].n_bins; ++k)
+            {
+                e += p[k] * w[k];
+            }
+            expect[(uint32_t)f * n_mels + m] = e;
+        }
+    }
+}
+
+static int check(uint16_t n_fft, uint16_t n_mels, uint16_t n_frames)
+{
+    const uint16_t fft_bins = n_fft / 2 + 1;
+
+    for (uint32_t i = 0; i < (uint32_t)n_frames * fft_bins; ++i)
+    {
+        power_q15[i] = (int16_t)(next_random() & 0x7FFF);
+        power[i] = power_q15[i] / 32768.0f;
+    }
+
+    reference_f32(n_mels, fft_bins, n_frames);
+    mel_project_f32(bands, weights, n_mels, power, fft_bins, n_frames, energy);
+    if (memcmp(expect, energy, (size_t)n_frames * n_mels * sizeof(float)) != 0)
+    {
+        fprintf(stderr, "mel_project_check: f32 differs (fft %u, mels %u, frames %u)\n", n_fft,
+                n_mels, n_frames);
+        return 1;
+    }
+
+    mel_project_q15(bands, weights_q15, n_mels, power_q15, fft_bins, n_frames, energy_q15);
+    for (uint16_t f = 0; f < n_frames; ++f)
+    {
+        for (uint16_t m = 0; m < n_mels; ++m)
+        {
+            const int16_t *p = power_q15 + (uint32_t)f * fft_bins + bands[m].first_bin;
+            const int16_t *w = weights_q15 + bands[m].offset;
+            int64_t acc = 0;
+            for (uint16_t k = 0; k < bands[m].n_bins; ++k)
+                acc += (int32_t)p[k] * w[k];
+            int32_t exact = (int32_t)((acc + 0x4000) >> 15);
+            int32_t got = energy_q15[(uint32_t)f * n_mels + m];
+
+            // weight rounding: half an LSB per bin, plus the final rounding
+            float tolerance = 0.5f * bands[m].n_bins / 32768.0f + 1.0f / 32768.0f;
+            float err = fabsf(got / 32768.0f - expect[(uint32_t)f * n_mels + m]);
+            if (got != exact || err > tolerance)
+            {
+                fprintf(stderr,
+                        "mel_project_check: q15 band %u frame %u: %ld, exact %ld, float err %g "
+                        "(fft %u, mels %u)\n",
+                        m, f, (long)got, (long)exact, err, n_fft, n_mels);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seed = 1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else
+        {
+            fprintf(stderr, "usage: %s [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    rng_state = seed;
+
+    int failed = 0;
+    unsigned checks = 0;
+    printf("  fft  mels  frames   scalar ns/frame   f32 ns/frame   q15 ns/frame\n");
+    for (size_t s = 0; s < sizeof(fft_sizes) / sizeof(fft_sizes[0]); ++s)
+    {
+        for (size_t m = 0; m < sizeof(mel_counts) / sizeof(mel_counts[0]); ++m)
+        {
+            const uint16_t fft_bins = fft_sizes[s] / 2 + 1;
+            make_bank(mel_counts[m], fft_bins);
+            for (size_t f = 0; f < sizeof(frame_counts) / sizeof(frame_counts[0]); ++f)
+            {
+                failed |= check(fft_sizes[s], mel_counts[m], frame_counts[f]);
+                checks++;
+            }
+
+            // timing at a batch of eight
+            const uint16_t n_frames = 8;
+            double t0 = now_ns();
+            for (int r = 0; r < TIMING_REPEATS; ++r)
+                reference_f32(mel_counts[m], fft_bins, n_frames);
+            double t1 = now_ns();
+            for (int r = 0; r < TIMING_REPEATS; ++r)
+                mel_project_f32(bands, weights, mel_counts[m], power, fft_bins, n_frames, energy);
+            double t2 = now_ns();
+            for (int r = 0; r < TIMING_REPEATS; ++r)
+                mel_project_q15(bands, weights_q15, mel_counts[m], power_q15, fft_bins, n_frames,
+                                energy_q15);
+            double t3 = now_ns();
+            const double per_frame = 1.0 / ((double)TIMING_REPEATS * n_frames);
+            printf("%5u %5u %7u %17.1f %14.1f %14.1f\n", fft_sizes[s], mel_counts[m], n_frames,
+                   (t1 - t0) * per_frame, (t2 - t1) * per_frame, (t3 - t2) * per_frame);
+        }
+    }
+
+    printf("%u shapes checked: %s\n", checks, failed ? "FAIL" : "ok");
+    return failed ? 1 : 0;
+}
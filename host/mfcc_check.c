@@ -0,0 +1,261 @@
+// mfcc_check.c
+// Checks the streaming MFCC stage against an offline double-precision reference: DCT-II with
+// orthonormal scaling, sinusoidal lifter, and HTK regression deltas over the whole sequence with
+// the first and last column repeated past the ends. Random log-mel sequences of several lengths
+// (shorter than the delta latency included) go through mfcc_push + mfcc_flush for each band
+// count, coefficient count, delta order and width; every feature must match within a relative
+// 1e-4 of the sequence's dynamic range. Prints ns per column for the configurations the
+// pipeline would use.
+//
+// usage: mfcc_check [--seed S]   (exit status 1 if any check failed)
+#include "mfcc.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_MELS 128
+#define MAX_COLUMNS 64
+#define TIMING_COLUMNS 4000
+#define TOLERANCE 1e-4
+
+static const uint16_t mel_counts[] = {20, 40, 64, 128};
+static const uint16_t mfcc_counts[] = {1, 13, 20, 40};
+static const uint16_t lengths[] = {1, 2, 3, 5, 8, 17, 64};
+static const float lifters[] = {0.0f, 22.0f};
+
+static float workspace[MFCC_MAX_COEFFS * MAX_MELS +
+                       (4 * MFCC_MAX_DELTA_WIDTH + 1) * MFCC_MAX_COEFFS];
+static float log_mel[MAX_COLUMNS * MAX_MELS];
+static float features[MAX_COLUMNS * MFCC_MAX_FEATURES];
+static double cep[MAX_COLUMNS * MFCC_MAX_COEFFS];
+static double delta[MAX_COLUMNS * MFCC_MAX_COEFFS];
+static double expect[MAX_COLUMNS * MFCC_MAX_FEATURES];
+
+static uint32_t rng_state;
+
+static uint32_t next_random(void)
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int clamp(int i, int n)
+{
+    return i < 0 ? 0 : (i >= n ? n - 1 : i);
+}
+
+// HTK regression over a whole sequence of n columns of width values
+static void regress(const double *in, double *out, int n, int width, int n_coeffs)
+{
+    double norm = 0.0;
+    for (int k = 1; k <= width; ++k)
+        norm += 2.0 * k * k;
+    for (int t = 0; t < n; ++t)
+    {
+        for (int c = 0; c < n_coeffs; ++c)
+        {
+            double sum = 0.0;
+            for (int k = 1; k <= width; ++k)
+                sum += k * (in[clamp(t + k, n) * n_coeffs + c] -
+                            in[clamp(t - k, n) * n_coeffs + c]);
+            out[t * n_coeffs + c] = sum / norm;
+        }
+    }
+}
+
+static void reference(const MfccConfig_t *config, int n)
+{
+    const int n_mels = config->n_mels, n_mfcc = config->n_mfcc;
+    const int n_features = n_mfcc * (config->delta_order + 1);
+
+    for (int t = 0; t < n; ++t)
+    {
+        for (int k = 0; k < n_mfcc; ++k)
+        {
+            double sum = 0.0;
+            for (int m = 0; m < n_mels; ++m)
+                sum += log_mel[t * n_mels + m] * cos(M_PI * k * (2 * m + 1) / (2.0 * n_mels));
+            sum *= sqrt((k == 0 ? 1.0 : 2.0) / n_mels);
+            if (config->lifter > 0.0f)
+                sum *= 1.0 + 0.5 * config->lifter * sin(M_PI * (k + 1) / config->lifter);
+            cep[t * n_mfcc + k] = sum;
+        }
+    }
+    for (int t = 0; t < n; ++t)
+        for (int k = 0; k < n_mfcc; ++k)
+            expect[t * n_features + k] = cep[t * n_mfcc + k];
+
+    if (config->delta_order >= 1)
+    {
+        regress(cep, delta, n, config->delta_width, n_mfcc);
+        for (int t = 0; t < n; ++t)
+            for (int k = 0; k < n_mfcc; ++k)
+                expect[t * n_features + n_mfcc + k] = delta[t * n_mfcc + k];
+    }
+    if (config->delta_order >= 2)
+    {
+        // second pass over the deltas, the cepstrum buffer is free by now
+        regress(delta, cep, n, config->delta_width, n_mfcc);
+        for (int t = 0; t < n; ++t)
+            for (int k = 0; k < n_mfcc; ++k)
+                expect[t * n_features + 2 * n_mfcc + k] = cep[t * n_mfcc + k];
+    }
+}
+
+// pushes n columns then flushes, features land column by column
+static int stream(Mfcc_t *mfcc, int n)
+{
+    const int n_features = mfcc_n_features(&mfcc->config);
+    int out = 0;
+
+    mfcc_reset(mfcc);
+    for (int t = 0; t < n; ++t)
+        out += mfcc_push(mfcc, log_mel + t * mfcc->config.n_mels, features + out * n_features);
+    while (mfcc_flush(mfcc, features + out * n_features))
+        out++;
+    return out;
+}
+
+static int check(const MfccConfig_t *config)
+{
+    Mfcc_t mfcc;
+    if (mfcc_init(&mfcc, config, workspace, sizeof(workspace)) != 0)
+    {
+        fprintf(stderr, "mfcc_check: init failed (mels %u, mfcc %u, order %u, width %u)\n",
+                config->n_mels, config->n_mfcc, config->delta_order, config->delta_width);
+        return 1;
+    }
+    const int n_features = mfcc_n_features(config);
+
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); ++l)
+    {
+        const int n = lengths[l];
+        // dB columns in [-80, 0], the range of the log step
+        for (int i = 0; i < n * config->n_mels; ++i)
+            log_mel[i] = -80.0f * (next_random() & 0xFFFF) / 65535.0f;
+
+        reference(config, n);
+        const int got = stream(&mfcc, n);
+        if (got != n)
+        {
+            fprintf(stderr, "mfcc_check: %d of %d columns out (order %u, width %u)\n", got, n,
+                    config->delta_order, config->delta_width);
+            return 1;
+        }
+
+        // error relative to the largest feature magnitude of the sequence
+        double scale = 1.0;
+        for (int i = 0; i < n * n_features; ++i)
+            scale = fmax(scale, fabs(expect[i]));
+        for (int i = 0; i < n * n_features; ++i)
+        {
+            double err = fabs(features[i] - expect[i]) / scale;
+            if (err > TOLERANCE)
+            {
+                fprintf(stderr,
+                        "mfcc_check: column %d feature %d: %g, expected %g (mels %u, mfcc %u, "
+                        "order %u, width %u, lifter %g, length %d)\n",
+                        i / n_features, i % n_features, features[i], expect[i], config->n_mels,
+                        config->n_mfcc, config->delta_order, config->delta_width,
+                        config->lifter, n);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static void timing(uint16_t n_mels, uint16_t n_mfcc, uint8_t order, uint8_t width)
+{
+    MfccConfig_t config = {n_mels, n_mfcc, order, width, 22.0f};
+    Mfcc_t mfcc;
+    mfcc_init(&mfcc, &config, workspace, sizeof(workspace));
+
+    for (int i = 0; i < n_mels; ++i)
+        log_mel[i] = -80.0f * (next_random() & 0xFFFF) / 65535.0f;
+
+    double t0 = now_ns();
+    for (int t = 0; t < TIMING_COLUMNS; ++t)
+        mfcc_push(&mfcc, log_mel, features);
+    double t1 = now_ns();
+    printf("%5u %5u %6u %6u %13.1f\n", n_mels, n_mfcc, order, width,
+           (t1 - t0) / TIMING_COLUMNS);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seed = 1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else
+        {
+            fprintf(stderr, "usage: %s [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    rng_state = seed;
+
+    int failed = 0;
+    unsigned checks = 0;
+    for (size_t m = 0; m < sizeof(mel_counts) / sizeof(mel_counts[0]); ++m)
+    {
+        for (size_t c = 0; c < sizeof(mfcc_counts) / sizeof(mfcc_counts[0]); ++c)
+        {
+            if (mfcc_counts[c] > mel_counts[m])
+                continue;
+            for (uint8_t order = 0; order <= MFCC_MAX_DELTA_ORDER; ++order)
+            {
+                for (uint8_t width = 1; width <= MFCC_MAX_DELTA_WIDTH; ++width)
+                {
+                    for (size_t l = 0; l < sizeof(lifters) / sizeof(lifters[0]); ++l)
+                    {
+                        MfccConfig_t config = {mel_counts[m], mfcc_counts[c], order, width,
+                                               lifters[l]};
+                        failed |= check(&config);
+                        checks++;
+                    }
+                    if (order == 0)
+                        break; // width unused without deltas
+                }
+            }
+        }
+    }
+
+    // out-of-range configs must be refused
+    const MfccConfig_t bad[] = {
+        {40, 0, 0, 0, 0.0f},  {40, 41, 0, 0, 0.0f}, {20, 40, 0, 0, 0.0f},
+        {40, 13, 3, 2, 0.0f}, {40, 13, 1, 0, 0.0f}, {40, 13, 1, 5, 0.0f},
+        {40, 13, 0, 0, -1.0f}, {0, 13, 0, 0, 0.0f},
+    };
+    for (size_t b = 0; b < sizeof(bad) / sizeof(bad[0]); ++b)
+    {
+        Mfcc_t mfcc;
+        if (mfcc_workspace_size(&bad[b]) != 0 ||
+            mfcc_init(&mfcc, &bad[b], workspace, sizeof(workspace)) != -1)
+        {
+            fprintf(stderr, "mfcc_check: invalid config %zu accepted\n", b);
+            failed = 1;
+        }
+    }
+
+    printf(" mels  mfcc  order  width  ns/column\n");
+    timing(40, 13, 0, 0);
+    timing(40, 13, 2, 2);
+    timing(64, 20, 2, 2);
+    timing(128, 40, 2, 4);
+
+    printf("%u configs checked: %s\n", checks, failed ? "FAIL" : "ok");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,428 @@
+// noise_floor_eval.c
+// Evaluates the noise-floor stage on noisy clips through the firmware mel path (the config of
+// audio_record.c). A clip is a noise bed plus bird-like chirps every 1.5 s: the bed is gusting
+// wind with a +10 dB stretch and an insect chorus, or channel 0 of a recording looped (--noise).
+// Noise and calls also go through the mel path alone, which gives the true noise level and the
+// cells each one dominates. Reported:
+//   floor    error of the tracked floor against the 1 s mean of the noise alone, in dB
+//   q15      difference of the fixed-point floor from the float one, in dB
+//   subtract noise removed from noise cells and call energy lost from call cells, in dB
+//   gate     call frames and noise frames whose peak band is 10 dB over the floor
+//   attach   calculate_mel_spectrogram with the stage attached against the offline result,
+//            relative to the input energy
+// plus ns per column of both update kernels.
+//
+// usage: noise_floor_eval [--noise FILE.wav] [--seconds S] [--seed S]
+//        (exit status 1 if the floor, q15 or attach check fails or subtraction loses SNR)
+#include "mel_spectrogram.h"
+#include "noise_floor.h"
+#include "wav_file.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SAMPLE_RATE 16000
+#define FFT_SIZE 512
+#define HOP_LENGTH 256
+#define N_MELS 64
+#define WINDOW_FRAMES 64
+#define MAX_SECONDS 120
+#define MAX_SAMPLES (MAX_SECONDS * SAMPLE_RATE)
+#define MAX_COLUMNS (MAX_SAMPLES / HOP_LENGTH)
+#define MEAN_HALF_WIDTH 31 // frames each side of the 1 s noise mean
+#define GATE_DB 10.0f
+#define LOG10_OFFSET 1e-6f // of the log step
+#define TIMING_REPEATS 200
+
+// pass limits
+#define FLOOR_MEDIAN_DB 3.0
+#define Q15_MEDIAN_DB 0.5
+#define ATTACH_RELATIVE 1e-4
+
+static const NoiseFloorConfig_t tracker = {.n_bands = N_MELS,
+                                           .window_frames = 96,
+                                           .n_subwindows = 4,
+                                           .smoothing = 0.9f,
+                                           .bias = 1.5f,
+                                           .over_subtraction = 1.0f,
+                                           .spectral_floor = 0.05f};
+
+static float mel_state[8192];
+static float mel_scratch[8192];
+static float window_out[N_MELS * WINDOW_FRAMES];
+
+static int16_t noise_pcm[MAX_SAMPLES];
+static int16_t call_pcm[MAX_SAMPLES];
+static int16_t mix_pcm[MAX_SAMPLES];
+
+// linear band energies, column-major energy[f * N_MELS + m]
+static float noise_e[MAX_COLUMNS * N_MELS];
+static float call_e[MAX_COLUMNS * N_MELS];
+static float mix_e[MAX_COLUMNS * N_MELS];
+static float noise_mean[MAX_COLUMNS * N_MELS];
+static float sub_e[MAX_COLUMNS * N_MELS];
+static float floor_f32[MAX_COLUMNS * N_MELS];
+static int32_t work_q15[MAX_COLUMNS * N_MELS];
+static int32_t floor_q15[MAX_COLUMNS * N_MELS];
+static float attach_db[MAX_COLUMNS * N_MELS];
+static double errors[MAX_COLUMNS * N_MELS];
+
+static float nf_workspace[N_MELS * (4 + NOISE_MAX_SUBWINDOWS)];
+static int32_t nf_workspace_q15[N_MELS * (4 + NOISE_MAX_SUBWINDOWS)];
+
+static uint32_t rng_state;
+
+static uint32_t next_random(void)
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+// approximately unit-variance Gaussian, sum of four uniforms
+static float gaussian(void)
+{
+    float s = 0.0f;
+    for (int i = 0; i < 4; ++i)
+        s += (next_random() & 0xFFFF) / 65535.0f;
+    return (s - 2.0f) * 1.7320508f;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int16_t saturate(float v)
+{
+    return (int16_t)(v > 32767.0f ? 32767 : (v < -32768.0f ? -32768 : (int)lrintf(v)));
+}
+
+// gusting low-passed wind, 10 dB louder over the middle fifth, and a 35 Hz insect chorus
+static void synth_noise(uint32_t n)
+{
+    const float insects[] = {4100.0f, 4380.0f, 4650.0f, 4930.0f, 5200.0f, 5470.0f};
+    float wind = 0.0f;
+
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        const float t = (float)i / SAMPLE_RATE;
+        const float seconds = (float)n / SAMPLE_RATE;
+        float gust = 1.0f + 0.5f * sinf(2.0f * (float)M_PI * t / 7.0f);
+        if (t > 0.4f * seconds && t < 0.6f * seconds)
+            gust *= 3.1623f;
+        wind = 0.98f * wind + gaussian() * 60.0f;
+
+        float chorus = 0.0f;
+        for (size_t k = 0; k < sizeof(insects) / sizeof(insects[0]); ++k)
+            chorus += sinf(2.0f * (float)M_PI * insects[k] * t + k);
+        chorus *= 60.0f * (0.6f + 0.4f * sinf(2.0f * (float)M_PI * 35.0f * t));
+
+        noise_pcm[i] = saturate(gust * wind + chorus + 20.0f * gaussian());
+    }
+}
+
+static int load_noise(const char *path, uint32_t n)
+{
+    WavFile_t wav;
+    if (wav_open(path, &wav) != 0 || wav.n_samples == 0)
+    {
+        fprintf(stderr, "noise_floor_eval: cannot read %s\n", path);
+        return -1;
+    }
+    if (wav.sample_rate != SAMPLE_RATE)
+    {
+        fprintf(stderr, "noise_floor_eval: %s is %lu Hz, need %d\n", path,
+                (unsigned long)wav.sample_rate, SAMPLE_RATE);
+        wav_close(&wav);
+        return -1;
+    }
+    for (uint32_t done = 0; done < n;)
+    {
+        uint32_t chunk = (uint32_t)((n - done < wav.n_samples) ? n - done : wav.n_samples);
+        wav_read_mono(&wav, 0, chunk, noise_pcm + done);
+        done += chunk;
+    }
+    wav_close(&wav);
+    return 0;
+}
+
+// 250 ms chirps from 2 to 3.5 kHz under a Hann envelope, every 1.5 s
+static void synth_calls(uint32_t n)
+{
+    const uint32_t period = SAMPLE_RATE * 3 / 2, length = SAMPLE_RATE / 4;
+    memset(call_pcm, 0, n * sizeof(int16_t));
+    for (uint32_t start = SAMPLE_RATE / 2; start + length <= n; start += period)
+    {
+        for (uint32_t i = 0; i < length; ++i)
+        {
+            const float t = (float)i / SAMPLE_RATE;
+            const float phase = 2.0f * (float)M_PI * (2000.0f * t + 3000.0f * t * t);
+            const float envelope = 0.5f - 0.5f * cosf(2.0f * (float)M_PI * i / (length - 1));
+            call_pcm[start + i] = saturate(1500.0f * envelope * sinf(phase));
+        }
+    }
+}
+
+// inverse of the log step, 10 log10(e + 1e-6), above its -80 dB clamp
+static float from_db(float db)
+{
+    float e = powf(10.0f, db / 10.0f) - LOG10_OFFSET;
+    return (e > 0.0f) ? e : 0.0f;
+}
+
+// mel path over consecutive windows of WINDOW_FRAMES hops, dB back to linear energy
+static uint32_t mel_columns(const int16_t *pcm, uint32_t n, float *energy, float *db_out)
+{
+    const uint32_t window_samples = (WINDOW_FRAMES - 1) * HOP_LENGTH + FFT_SIZE;
+    uint32_t columns = 0;
+
+    for (uint32_t first = 0; first + window_samples <= n; first += WINDOW_FRAMES * HOP_LENGTH)
+    {
+        int got = calculate_mel_spectrogram(pcm + first, window_samples, window_out,
+                                            WINDOW_FRAMES);
+        for (int f = 0; f < got; ++f)
+        {
+            for (int m = 0; m < N_MELS; ++m)
+            {
+                const float db = window_out[m * got + f];
+                if (energy)
+                    energy[(columns + f) * N_MELS + m] = from_db(db);
+                if (db_out)
+                    db_out[(columns + f) * N_MELS + m] = db;
+            }
+        }
+        columns += got;
+    }
+    return columns;
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// sorts in place
+static double percentile(double *v, uint32_t n, double p)
+{
+    if (n == 0)
+        return 0.0;
+    qsort(v, n, sizeof(double), compare_double);
+    return v[(uint32_t)(p * (n - 1))];
+}
+
+static double db(double x)
+{
+    return 10.0 * log10(x + 1e-6);
+}
+
+int main(int argc, char **argv)
+{
+    const char *noise_path = NULL;
+    float seconds = 30.0f;
+    uint32_t seed = 1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--noise") && i + 1 < argc)
+            noise_path = argv[++i];
+        else if (!strcmp(argv[i], "--seconds") && i + 1 < argc)
+            seconds = strtof(argv[++i], NULL);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else
+        {
+            fprintf(stderr, "usage: %s [--noise FILE.wav] [--seconds S] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (seconds < 5.0f || seconds > MAX_SECONDS)
+    {
+        fprintf(stderr, "noise_floor_eval: --seconds must be 5..%d\n", MAX_SECONDS);
+        return 2;
+    }
+    rng_state = seed;
+
+    const uint32_t n = (uint32_t)(seconds * SAMPLE_RATE);
+    if (noise_path ? load_noise(noise_path, n) != 0 : (synth_noise(n), 0))
+        return 2;
+    synth_calls(n);
+    for (uint32_t i = 0; i < n; ++i)
+        mix_pcm[i] = saturate((float)noise_pcm[i] + call_pcm[i]);
+
+    MelSpectrogramConfig_t config = {.sample_rate = SAMPLE_RATE,
+                                     .fft_size = FFT_SIZE,
+                                     .hop_length = HOP_LENGTH,
+                                     .n_mels = N_MELS,
+                                     .f_min = 0.0f,
+                                     .f_max = 8000.0f};
+    mel_spectrogram_set_memory(mel_state, sizeof(mel_state), mel_scratch, sizeof(mel_scratch));
+    if (mel_spectrogram_init(&config) != 0)
+    {
+        fprintf(stderr, "noise_floor_eval: mel init failed\n");
+        return 2;
+    }
+
+    const uint32_t cols = mel_columns(noise_pcm, n, noise_e, NULL);
+    mel_columns(call_pcm, n, call_e, NULL);
+    mel_columns(mix_pcm, n, mix_e, NULL);
+    const uint32_t cells = cols * N_MELS;
+
+    // true noise level: centered 1 s mean of the noise alone
+    for (uint32_t f = 0; f < cols; ++f)
+    {
+        const uint32_t lo = (f > MEAN_HALF_WIDTH) ? f - MEAN_HALF_WIDTH : 0;
+        const uint32_t hi = (f + MEAN_HALF_WIDTH < cols) ? f + MEAN_HALF_WIDTH : cols - 1;
+        for (uint32_t m = 0; m < N_MELS; ++m)
+        {
+            double sum = 0.0;
+            for (uint32_t g = lo; g <= hi; ++g)
+                sum += noise_e[g * N_MELS + m];
+            noise_mean[f * N_MELS + m] = (float)(sum / (hi - lo + 1));
+        }
+    }
+
+    // float tracker, column by column so every column's floor is kept
+    NoiseFloor_t nf;
+    NoiseFloorQ15_t nf_q15;
+    if (noise_floor_init(&nf, &tracker, nf_workspace, sizeof(nf_workspace)) != 0 ||
+        noise_floor_init_q15(&nf_q15, &tracker, nf_workspace_q15, sizeof(nf_workspace_q15)) != 0)
+    {
+        fprintf(stderr, "noise_floor_eval: tracker init failed\n");
+        return 2;
+    }
+    memcpy(sub_e, mix_e, cells * sizeof(float));
+    for (uint32_t f = 0; f < cols; ++f)
+    {
+        noise_floor_update_f32(&nf, sub_e + f * N_MELS, 1);
+        memcpy(floor_f32 + f * N_MELS, nf.floor, N_MELS * sizeof(float));
+    }
+
+    // Q15 tracker on the same energies; the clip levels keep them inside the int32 Q15 range
+    for (uint32_t i = 0; i < cells; ++i)
+    {
+        double q = mix_e[i] * 32768.0;
+        work_q15[i] = (int32_t)(q > INT32_MAX ? INT32_MAX : q + 0.5);
+    }
+    for (uint32_t f = 0; f < cols; ++f)
+    {
+        noise_floor_update_q15(&nf_q15, work_q15 + f * N_MELS, 1);
+        memcpy(floor_q15 + f * N_MELS, nf_q15.floor, N_MELS * sizeof(int32_t));
+    }
+
+    // floor accuracy once the first search window has filled
+    const uint32_t warmup = tracker.window_frames + tracker.window_frames / tracker.n_subwindows;
+    uint32_t n_err = 0;
+    double bias_sum = 0.0;
+    for (uint32_t i = warmup * N_MELS; i < cells; ++i)
+    {
+        double e = db(floor_f32[i]) - db(noise_mean[i]);
+        bias_sum += e;
+        errors[n_err++] = fabs(e);
+    }
+    const double floor_bias = n_err ? bias_sum / n_err : 0.0;
+    const double floor_median = percentile(errors, n_err, 0.5);
+    const double floor_p90 = percentile(errors, n_err, 0.9);
+
+    // fixed point against float where the floor is well above one Q15 LSB
+    uint32_t n_q15 = 0;
+    for (uint32_t i = 0; i < cells; ++i)
+        if (floor_f32[i] * 32768.0f > 16.0f)
+            errors[n_q15++] = fabs(db(floor_q15[i] / 32768.0) - db(floor_f32[i]));
+    const double q15_median = percentile(errors, n_q15, 0.5);
+    const double q15_max = percentile(errors, n_q15, 1.0);
+
+    // subtraction: noise cells hold no call energy, call cells are 6 dB above the noise
+    double noise_before = 0.0, noise_after = 0.0, call_before = 0.0, call_after = 0.0;
+    uint32_t n_noise = 0, n_call = 0;
+    for (uint32_t i = warmup * N_MELS; i < cells; ++i)
+    {
+        if (call_e[i] < 0.01f * noise_mean[i])
+        {
+            noise_before += db(mix_e[i]);
+            noise_after += db(sub_e[i]);
+            n_noise++;
+        }
+        else if (call_e[i] > 4.0f * noise_mean[i])
+        {
+            call_before += db(mix_e[i]);
+            call_after += db(sub_e[i]);
+            n_call++;
+        }
+    }
+    const double removed = n_noise ? (noise_before - noise_after) / n_noise : 0.0;
+    const double lost = n_call ? (call_before - call_after) / n_call : 0.0;
+
+    // relative gate: a frame fires if any band is GATE_DB over its floor
+    uint32_t call_frames = 0, call_hits = 0, noise_frames = 0, noise_hits = 0;
+    for (uint32_t f = warmup; f < cols; ++f)
+    {
+        int has_call = 0, quiet = 1, fires = 0;
+        for (uint32_t m = 0; m < N_MELS; ++m)
+        {
+            const uint32_t i = f * N_MELS + m;
+            has_call |= call_e[i] > 4.0f * noise_mean[i];
+            quiet &= call_e[i] < 0.01f * noise_mean[i];
+            fires |= db(mix_e[i]) > db(floor_f32[i]) + GATE_DB;
+        }
+        if (has_call)
+        {
+            call_frames++;
+            call_hits += fires;
+        }
+        else if (quiet)
+        {
+            noise_frames++;
+            noise_hits += fires;
+        }
+    }
+
+    // the stage attached to the engine must reproduce the offline subtraction
+    noise_floor_reset(&nf);
+    mel_spectrogram_set_noise_floor(&nf);
+    mel_columns(mix_pcm, n, NULL, attach_db);
+    mel_spectrogram_set_noise_floor(NULL);
+    // relative to the input energy plus the log offset, the resolution of the dB output:
+    // where the floor cancels most of a cell, the dB of the remainder magnifies any rounding
+    double attach_max = 0.0;
+    for (uint32_t i = 0; i < cells; ++i)
+    {
+        const double err = fabs(from_db(attach_db[i]) - sub_e[i]) / (mix_e[i] + LOG10_OFFSET);
+        attach_max = fmax(attach_max, err);
+    }
+
+    // kernel cost per column over one window
+    double t0 = now_ns();
+    for (int r = 0; r < TIMING_REPEATS; ++r)
+        noise_floor_update_f32(&nf, sub_e, WINDOW_FRAMES);
+    double t1 = now_ns();
+    for (int r = 0; r < TIMING_REPEATS; ++r)
+        noise_floor_update_q15(&nf_q15, work_q15, WINDOW_FRAMES);
+    double t2 = now_ns();
+    const double per_column = 1.0 / ((double)TIMING_REPEATS * WINDOW_FRAMES);
+
+    const int floor_ok = floor_median <= FLOOR_MEDIAN_DB;
+    const int q15_ok = q15_median <= Q15_MEDIAN_DB;
+    const int subtract_ok = removed > lost;
+    const int attach_ok = attach_max <= ATTACH_RELATIVE;
+
+    printf("clip: %.1f s, %s noise, %u columns, %u bands\n", seconds,
+           noise_path ? noise_path : "synthetic", cols, N_MELS);
+    printf("floor:    median |err| %.2f dB, p90 %.2f dB, mean %+.2f dB  %s\n", floor_median,
+           floor_p90, floor_bias, floor_ok ? "ok" : "FAIL");
+    printf("q15:      median %.3f dB, max %.3f dB from float  %s\n", q15_median, q15_max,
+           q15_ok ? "ok" : "FAIL");
+    printf("subtract: %.2f dB removed from %u noise cells, %.2f dB lost from %u call cells  %s\n",
+           removed, n_noise, lost, n_call, subtract_ok ? "ok" : "FAIL");
+    printf("gate:     %u/%u call frames, %u/%u noise frames over floor + %.0f dB\n", call_hits,
+           call_frames, noise_hits, noise_frames, GATE_DB);
+    printf("attach:   max %.2g of the input energy from offline  %s\n", attach_max, attach_ok ? "ok" : "FAIL");
+    printf("cost:     f32 %.1f ns/column, q15 %.1f ns/column\n", (t1 - t0) * per_column,
+           (t2 - t1) * per_column);
+
+    return (floor_ok && q15_ok && subtract_ok && attach_ok) ? 0 : 1;
+}
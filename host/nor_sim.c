@@ -0,0 +1,175 @@
+// nor_sim.c
+#include "nor_sim.h"
+#include <stdlib.h>
+#include <string.h>
+
+static uint32_t next_random(NorSim_t *sim)
+{
+    sim->rng = sim->rng * 1664525u + 1013904223u;
+    return sim->rng >> 8;
+}
+
+// counts an operation; 1 if this one is torn by the armed power cut
+static int torn(NorSim_t *sim)
+{
+    sim->ops++;
+    if (sim->cut_at && sim->ops == sim->cut_at)
+    {
+        sim->powered_off = 1;
+        sim->cut_at = 0;
+        sim->busy_left = 0;
+        return 1;
+    }
+    return 0;
+}
+
+static int sim_busy(void *ctx)
+{
+    NorSim_t *sim = ctx;
+
+    if (sim->busy_left == 0)
+        return 0;
+    sim->busy_left--;
+    return 1;
+}
+
+static int sim_read(void *ctx, uint32_t addr, void *dst, uint32_t len)
+{
+    NorSim_t *sim = ctx;
+
+    if (sim->powered_off || addr > sim->size || len > sim->size - addr)
+        return -1;
+    if (sim->busy_left)
+    {
+        sim->busy_rejects++;
+        return -1;
+    }
+    memcpy(dst, sim->mem + addr, len);
+    sim->reads++;
+    sim->read_bytes += len;
+    return 0;
+}
+
+static int sim_program(void *ctx, uint32_t addr, const void *src, uint32_t len)
+{
+    NorSim_t *sim = ctx;
+    const uint8_t *data = src;
+
+    if (sim->powered_off || addr > sim->size || len > sim->size - addr)
+        return -1;
+    if (sim->busy_left)
+    {
+        sim->busy_rejects++;
+        return -1;
+    }
+    if (len == 0 || addr % sim->page_size + len > sim->page_size)
+    {
+        sim->violations++;
+        return -1;
+    }
+    for (uint32_t i = 0; i < len; ++i)
+    {
+        if (data[i] & ~sim->mem[addr + i])
+        {
+            sim->violations++;
+            return -1;
+        }
+    }
+
+    if (torn(sim))
+    {
+        // cells are programmed in parallel, any subset may have landed
+        for (uint32_t i = 0; i < len; ++i)
+            if (next_random(sim) & 1u)
+                sim->mem[addr + i] &= data[i];
+        return -1;
+    }
+    for (uint32_t i = 0; i < len; ++i)
+        sim->mem[addr + i] &= data[i];
+    sim->programs++;
+    sim->program_bytes += len;
+    return 0;
+}
+
+static int sim_erase(void *ctx, uint32_t addr)
+{
+    NorSim_t *sim = ctx;
+
+    if (sim->powered_off || addr >= sim->size)
+        return -1;
+    if (sim->busy_left)
+    {
+        sim->busy_rejects++;
+        return -1;
+    }
+
+    uint32_t sector = addr / sim->sector_size;
+    uint8_t *mem = sim->mem + sector * sim->sector_size;
+    if (torn(sim))
+    {
+        // an interrupted erase leaves some bytes erased and the rest unchanged
+        for (uint32_t i = 0; i < sim->sector_size; ++i)
+            if (next_random(sim) & 1u)
+                mem[i] = 0xFF;
+        return -1;
+    }
+    memset(mem, 0xFF, sim->sector_size);
+    sim->erases++;
+    sim->sector_erases[sector]++;
+    sim->busy_left = sim->erase_polls;
+    return 0;
+}
+
+int nor_sim_init(NorSim_t *sim, NorFlash_t *flash, uint32_t size, uint32_t sector_size,
+                 uint32_t page_size, uint32_t erase_polls)
+{
+    memset(sim, 0, sizeof(*sim));
+    if (!page_size || (page_size & (page_size - 1u)) || !sector_size ||
+        sector_size % page_size || !size || size % sector_size)
+        return -1;
+
+    sim->mem = malloc(size);
+    sim->sector_erases = calloc(size / sector_size, sizeof(uint32_t));
+    if (!sim->mem || !sim->sector_erases)
+    {
+        nor_sim_free(sim);
+        return -1;
+    }
+    memset(sim->mem, 0xFF, size);
+    sim->size = size;
+    sim->page_size = page_size;
+    sim->sector_size = sector_size;
+    sim->erase_polls = erase_polls;
+    sim->rng = 1;
+
+    flash->page_size = page_size;
+    flash->sector_size = sector_size;
+    flash->size = size;
+    flash->ctx = sim;
+    flash->read = sim_read;
+    flash->program = sim_program;
+    flash->erase = sim_erase;
+    flash->busy = sim_busy;
+    return 0;
+}
+
+void nor_sim_free(NorSim_t *sim)
+{
+    free(sim->mem);
+    free(sim->sector_erases);
+    sim->mem = NULL;
+    sim->sector_erases = NULL;
+}
+
+void nor_sim_cut_power(NorSim_t *sim, uint64_t after_ops, uint32_t seed)
+{
+    sim->cut_at = sim->ops + (after_ops ? after_ops : 1);
+    sim->rng = seed ? seed : 1;
+}
+
+void nor_sim_power_on(NorSim_t *sim)
+{
+    sim->powered_off = 0;
+    sim->cut_at = 0;
+    sim->busy_left = 0;
+}
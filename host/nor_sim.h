@@ -0,0 +1,68 @@
+// nor_sim.h
+#ifndef NOR_SIM_H
+#define NOR_SIM_H
+
+#include "nor_flash.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief RAM-backed NOR flash behind a NorFlash_t. Enforces what the hardware does: erase
+     *        works on whole sectors and stays busy for erase_polls busy() calls, a program may
+     *        only clear bits and must stay inside one page, nothing but busy() is accepted while
+     *        an erase runs. Every operation is counted.
+     * A power cut can be armed: the chosen program or erase is torn (a random subset of its
+     * bytes lands) and every operation fails until nor_sim_power_on.
+     */
+    typedef struct
+    {
+        uint8_t *mem;
+        uint32_t size;
+        uint32_t page_size;
+        uint32_t sector_size;
+        uint32_t erase_polls;
+        uint32_t busy_left;
+
+        uint64_t reads;
+        uint64_t read_bytes;
+        uint64_t programs;
+        uint64_t program_bytes;
+        uint64_t erases;
+        uint32_t violations;   // programs that tried to set a bit or cross a page
+        uint32_t busy_rejects; // reads and programs issued during an erase
+        uint32_t *sector_erases;
+
+        uint64_t ops;    // programs and erases issued, torn or not
+        uint64_t cut_at; // op index that is torn, 0 when no cut is armed
+        uint8_t powered_off;
+        uint32_t rng;
+    } NorSim_t;
+
+    /**
+     * @brief Allocates an erased device and fills in flash to drive it.
+     * @return 0 if successful, -1 on a bad geometry or no memory
+     */
+    int nor_sim_init(NorSim_t *sim, NorFlash_t *flash, uint32_t size, uint32_t sector_size,
+                     uint32_t page_size, uint32_t erase_polls);
+
+    void nor_sim_free(NorSim_t *sim);
+
+    /**
+     * @brief Tears the after_ops-th program or erase from now and powers the device off.
+     */
+    void nor_sim_cut_power(NorSim_t *sim, uint64_t after_ops, uint32_t seed);
+
+    /**
+     * @brief Powers the device back on; an erase that was running is lost, the contents stay.
+     */
+    void nor_sim_power_on(NorSim_t *sim);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NOR_SIM_H
@@ -0,0 +1,488 @@
+// pdm_check.c
+// Checks the open PDM decoder on bit streams from a second-order sigma-delta modulator, the
+// stand-in for the microphones:
+//   bit-true  pdm_process against a textbook decoder (Hogenauer integrator/comb CIC run bit
+//             by bit, direct-form FIR, the same DC blocker) over every decimation, CIC order,
+//             bit order and channel count, random streams and tones, random call sizes
+//   ones      pdm_count_ones against a per-bit count
+//   snr       -6 dBFS 1 kHz tone, signal to noise + distortion over the output band at
+//             8/16/32/48 kHz, within PDM_MAX_SNR_LOSS_DB of an ideal double-precision decoder
+//             of the same bits (the modulator's own noise sets the absolute figure)
+//   response  tones up to PDM_PASSBAND of the output rate within PDM_MAX_RIPPLE_DB of the
+//             input level
+//   alias     tones past PDM_STOPBAND of the output rate attenuated by PDM_MIN_ALIAS_DB where
+//             they fold into the band
+//   perf      ns per 1 ms of stereo audio at 16 kHz, table CIC against the reference decoder
+//
+// The FIR taps are the decoder's own (pdm_init designs them); the reference checks the
+// arithmetic around them. On target the FIR runs on __smlald, here on the plain C loop.
+//
+// usage: pdm_check [--seed S]   (exit status 1 if any check failed)
+#include "pdm_decimator.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_SAMPLES 64                   // per call
+#define STREAM_SAMPLES 4096              // per channel, bit-true streams
+#define TONE_SAMPLES 8192                // per channel, measured after TONE_SETTLE
+#define TONE_SETTLE 256
+#define TONE_TAIL 64                     // samples the ideal decoder's window reaches ahead
+#define IDEAL_TAPS_PER_SAMPLE 64
+#define MAX_BYTES (TONE_SAMPLES * PDM_MAX_DECIMATION / 8)
+#define PI_D 3.14159265358979323846
+
+#define PDM_MAX_SNR_LOSS_DB 1.5
+#define PDM_MAX_RIPPLE_DB 0.25
+#define PDM_MIN_ALIAS_DB 60.0
+#define PDM_PERF_RUNS 200
+
+static uint8_t workspace[64 * 1024] __attribute__((aligned(4)));
+static uint8_t stream[PDM_MAX_CHANNELS * MAX_BYTES];
+static uint8_t channel_bits[MAX_BYTES];
+static int16_t pcm[PDM_MAX_CHANNELS * TONE_SAMPLES];
+static int16_t reference[TONE_SAMPLES];
+
+static uint32_t rng_state;
+
+static uint32_t next_random(void)
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// second-order error-feedback modulator, NTF (1 - z^-1)^2 and unity STF: one channel of
+// n_bytes bytes of a tone of amplitude (full scale 1) at frequency (cycles per bit)
+static void modulate(uint8_t *out, uint32_t n_bytes, uint32_t stride, double amplitude,
+                     double frequency, double phase, int msb_first)
+{
+    double e1 = 0.0, e2 = 0.0;
+    for (uint32_t i = 0; i < n_bytes; ++i)
+    {
+        uint8_t byte = 0;
+        for (uint32_t j = 0; j < 8; ++j)
+        {
+            const double x = amplitude * sin(2.0 * PI_D * frequency * (8.0 * i + j) + phase);
+            const double w = x - 2.0 * e1 + e2;
+            const double y = (w >= 0.0) ? 1.0 : -1.0;
+            e2 = e1;
+            e1 = y - w;
+            if (y > 0.0)
+                byte |= (uint8_t)(msb_first ? 0x80u >> j : 1u << j);
+        }
+        out[i * stride] = byte;
+    }
+}
+
+static int16_t saturate16(int64_t v)
+{
+    return (int16_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+}
+
+// textbook decoder of one channel: idle history bytes, then the stream
+static void reference_decode(const PdmDecimator_t *dec, const uint8_t *bytes, uint32_t n_samples,
+                             int16_t *out)
+{
+    const PdmConfig_t *config = &dec->config;
+    const uint32_t ratio = dec->cic_ratio, order = config->cic_order;
+    const uint32_t history = dec->cic_bytes - ratio / 8;
+    const uint32_t n_bits = 8 * (history + n_samples * config->decimation / 8);
+    static int16_t mid[2 * TONE_SAMPLES + PDM_FIR_TAPS];
+    uint32_t integ[PDM_MAX_CIC_ORDER] = {0}, comb[PDM_MAX_CIC_ORDER] = {0};
+    uint32_t n_mid = 0;
+
+    for (uint32_t i = 0; i < PDM_FIR_TAPS - 2; ++i)
+        mid[n_mid++] = 0;
+    for (uint32_t m = 0; m < n_bits; ++m)
+    {
+        const uint32_t byte = (m < 8 * history) ? 0x55 : bytes[m / 8 - history];
+        const uint32_t bit =
+            config->msb_first ? (byte >> (7 - m % 8)) & 1u : (byte >> (m % 8)) & 1u;
+        // modulo-2^32 registers: the output is exact whenever it fits in 32 bits
+        uint32_t v = bit ? 1u : (uint32_t)-1;
+        for (uint32_t k = 0; k < order; ++k)
+            v = integ[k] += v;
+        // the CIC output that closes the kernel window of intermediate sample j
+        if ((m + 1) % ratio == dec->cic_len % ratio)
+        {
+            for (uint32_t k = 0; k < order; ++k)
+            {
+                const uint32_t prev = comb[k];
+                comb[k] = v;
+                v -= prev;
+            }
+            if (m + 1 >= dec->cic_len)
+                mid[n_mid++] = saturate16((int32_t)v >> dec->cic_shift);
+        }
+    }
+
+    int64_t hp_in = 0, hp_out = 0;
+    for (uint32_t i = 0; i < n_samples; ++i)
+    {
+        int64_t acc = 0;
+        for (uint32_t k = 0; k < PDM_FIR_TAPS; ++k)
+            acc += (int64_t)dec->fir[k] * mid[2 * i + k];
+        const int64_t round = dec->fir_shift ? (int64_t)1 << (dec->fir_shift - 1) : 0;
+        const int64_t x = (acc + round) >> dec->fir_shift;
+        int64_t y = x;
+        if (dec->hp_alpha_q31)
+        {
+            y = ((hp_out + x - hp_in) * dec->hp_alpha_q31 + ((int64_t)1 << 30)) >> 31;
+            hp_in = x;
+            hp_out = y;
+        }
+        out[i] = saturate16(y);
+    }
+}
+
+static PdmConfig_t make_config(uint16_t decimation, uint8_t channels, uint8_t order,
+                               uint8_t msb_first, float hp_alpha)
+{
+    PdmConfig_t config = {.decimation = decimation,
+                          .channels = channels,
+                          .cic_order = order,
+                          .msb_first = msb_first,
+                          .max_samples = MAX_SAMPLES,
+                          .gain_db = 0.0f,
+                          .hp_alpha = hp_alpha};
+    return config;
+}
+
+static int init(PdmDecimator_t *dec, const PdmConfig_t *config)
+{
+    const uint32_t size = pdm_workspace_size(config);
+    if (size == 0 || size > sizeof(workspace) || pdm_init(dec, config, workspace, size) != 0)
+    {
+        printf("pdm init           decimation %u order %u failed  FAIL\n", config->decimation,
+               config->cic_order);
+        return 1;
+    }
+    return 0;
+}
+
+// decodes n_samples per channel in random call sizes
+static void decode(PdmDecimator_t *dec, const uint8_t *in, uint32_t n_samples, int16_t *out)
+{
+    const uint32_t bytes_per_sample = dec->config.decimation / 8 * dec->config.channels;
+    uint32_t done = 0;
+    while (done < n_samples)
+    {
+        uint32_t n = 1 + next_random() % MAX_SAMPLES;
+        n = (n > n_samples - done) ? n_samples - done : n;
+        pdm_process(dec, in + done * bytes_per_sample, (uint16_t)n,
+                    out + done * dec->config.channels);
+        done += n;
+    }
+}
+
+static int check_bit_true(void)
+{
+    static const uint16_t decimations[] = {16, 32, 48, 64, 80, 96, 128};
+    uint32_t configs = 0, mismatches = 0;
+
+    for (uint32_t d = 0; d < sizeof(decimations) / sizeof(decimations[0]); ++d)
+        for (uint8_t order = PDM_MIN_CIC_ORDER; order <= PDM_MAX_CIC_ORDER; ++order)
+            for (uint8_t channels = 1; channels <= PDM_MAX_CHANNELS; ++channels)
+            {
+                const uint8_t msb_first = (uint8_t)(next_random() & 1);
+                const float hp = (channels & 1) ? PDM_HP_ALPHA_LIBRARY : 0.0f;
+                const PdmConfig_t config =
+                    make_config(decimations[d], channels, order, msb_first, hp);
+                PdmDecimator_t dec;
+                if (init(&dec, &config))
+                    return 1;
+
+                const uint32_t n_bytes = STREAM_SAMPLES * decimations[d] / 8;
+                for (uint8_t c = 0; c < channels; ++c)
+                {
+                    if (c & 1) // random bits, a worst case for the CIC range
+                        for (uint32_t i = 0; i < n_bytes; ++i)
+                            stream[i * channels + c] = (uint8_t)next_random();
+                    else
+                        modulate(stream + c, n_bytes, channels, 0.3 + 0.2 * c,
+                                 (1 + next_random() % 200) / (16.0 * n_bytes), 0.1 * c,
+                                 msb_first);
+                }
+                decode(&dec, stream, STREAM_SAMPLES, pcm);
+
+                for (uint8_t c = 0; c < channels; ++c)
+                {
+                    for (uint32_t i = 0; i < n_bytes; ++i)
+                        channel_bits[i] = stream[i * channels + c];
+                    reference_decode(&dec, channel_bits, STREAM_SAMPLES, reference);
+                    for (uint32_t i = 0; i < STREAM_SAMPLES; ++i)
+                        mismatches += pcm[i * channels + c] != reference[i];
+                }
+                configs++;
+            }
+
+    const int fail = mismatches != 0;
+    printf("pdm bit-true       %lu configs, %lu mismatched samples  %s\n", (unsigned long)configs,
+           (unsigned long)mismatches, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+static int check_count_ones(void)
+{
+    int fail = 0;
+    for (uint8_t channels = 1; channels <= PDM_MAX_CHANNELS; ++channels)
+    {
+        const uint32_t n_bytes = 1000 + next_random() % 37;
+        for (uint32_t i = 0; i < n_bytes * channels; ++i)
+            stream[i] = (uint8_t)next_random();
+        uint32_t ones[PDM_MAX_CHANNELS], expected[PDM_MAX_CHANNELS] = {0};
+        pdm_count_ones(stream, n_bytes, channels, ones);
+        for (uint32_t i = 0; i < n_bytes * channels; ++i)
+            for (uint32_t j = 0; j < 8; ++j)
+                expected[i % channels] += (stream[i] >> j) & 1u;
+        for (uint8_t c = 0; c < channels; ++c)
+            fail |= ones[c] != expected[c];
+    }
+    printf("pdm ones           1..%d channels  %s\n", PDM_MAX_CHANNELS, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+// least-squares amplitude at frequency (cycles per sample), and the residual power after
+// removing it and the mean
+static double fit_tone(const double *x, uint32_t n, double frequency, double *residual)
+{
+    double ss = 0, sc = 0, cc = 0, ys = 0, yc = 0, mean = 0;
+    for (uint32_t i = 0; i < n; ++i)
+        mean += x[i];
+    mean /= n;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        const double s = sin(2.0 * PI_D * frequency * i), c = cos(2.0 * PI_D * frequency * i);
+        const double y = x[i] - mean;
+        ss += s * s;
+        sc += s * c;
+        cc += c * c;
+        ys += y * s;
+        yc += y * c;
+    }
+    const double det = ss * cc - sc * sc;
+    const double a = (ys * cc - yc * sc) / det, b = (yc * ss - ys * sc) / det;
+    if (residual)
+    {
+        double r = 0.0;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            const double e = x[i] - mean - a * sin(2.0 * PI_D * frequency * i) -
+                             b * cos(2.0 * PI_D * frequency * i);
+            r += e * e;
+        }
+        *residual = r / n;
+    }
+    return sqrt(a * a + b * b);
+}
+
+// the folded frequency in the output band, cycles per sample
+static double folded_frequency(double frequency, uint32_t rate)
+{
+    const double f = fmod(frequency / rate, 1.0);
+    return (f > 0.5) ? 1.0 - f : f;
+}
+
+// decodes a -6 dBFS tone at frequency Hz for an output rate, returns the output amplitude
+static double tone_level(PdmDecimator_t *dec, uint32_t rate, double frequency, double *residual)
+{
+    static double x[TONE_SAMPLES];
+    const uint32_t decimation = dec->config.decimation;
+    const uint32_t n_bytes = TONE_SAMPLES * decimation / 8;
+    modulate(stream, n_bytes, 1, 0.5, frequency / ((double)rate * decimation), 0.3, 0);
+    pdm_reset(dec);
+    decode(dec, stream, TONE_SAMPLES, pcm);
+
+    for (uint32_t i = TONE_SETTLE; i < TONE_SAMPLES - TONE_TAIL; ++i)
+        x[i] = pcm[i];
+    return fit_tone(x + TONE_SETTLE, TONE_SAMPLES - TONE_SETTLE - TONE_TAIL,
+                    folded_frequency(frequency, rate), residual);
+}
+
+// what any decoder of the last tone_level stream could reach: a double-precision low-pass at
+// the output Nyquist frequency (IDEAL_TAPS_PER_SAMPLE output periods long, Kaiser-windowed
+// for ~120 dB of stopband) straight from the bits
+static double ideal_level(uint32_t decimation, uint32_t rate, double frequency, double *residual)
+{
+    static double x[TONE_SAMPLES], taps[IDEAL_TAPS_PER_SAMPLE * PDM_MAX_DECIMATION + 1];
+    const int32_t half = IDEAL_TAPS_PER_SAMPLE * decimation / 2;
+    const double beta = 12.0;
+    double i0_beta = 1.0, term = 1.0;
+    for (int k = 1; k < 40; ++k)
+    {
+        term *= (beta / (2.0 * k)) * (beta / (2.0 * k));
+        i0_beta += term;
+    }
+    for (int32_t t = -half; t <= half; ++t)
+    {
+        const double u = beta * sqrt(1.0 - ((double)t / half) * ((double)t / half));
+        double i0 = 1.0;
+        term = 1.0;
+        for (int k = 1; k < 40; ++k)
+        {
+            term *= (u / (2.0 * k)) * (u / (2.0 * k));
+            i0 += term;
+        }
+        const double fc = 0.5 / decimation; // cycles per bit
+        const double sinc = t ? sin(2.0 * PI_D * fc * t) / (PI_D * t) : 2.0 * fc;
+        taps[t + half] = sinc * i0 / i0_beta;
+    }
+
+    for (uint32_t i = TONE_SETTLE; i < TONE_SAMPLES - TONE_TAIL; ++i)
+    {
+        double acc = 0.0;
+        for (int32_t t = -half; t <= half; ++t)
+        {
+            const uint32_t m = i * decimation + t;
+            acc += taps[t + half] * (((stream[m / 8] >> (m % 8)) & 1u) ? 1.0 : -1.0);
+        }
+        x[i] = acc * 32768.0;
+    }
+    return fit_tone(x + TONE_SETTLE, TONE_SAMPLES - TONE_SETTLE - TONE_TAIL,
+                    folded_frequency(frequency, rate), residual);
+}
+
+static int check_snr(void)
+{
+    // output rate and PDM bits per sample: 1.024 MHz clock, 48 kHz from 3.072 MHz
+    static const uint32_t rates[][2] = {{8000, 128}, {16000, 64}, {32000, 32}, {48000, 64}};
+    int fail = 0;
+    for (uint32_t r = 0; r < 4; ++r)
+    {
+        const PdmConfig_t config = make_config((uint16_t)rates[r][1], 1, 5, 0, 0.0f);
+        PdmDecimator_t dec;
+        if (init(&dec, &config))
+            return 1;
+        double residual, ideal_residual;
+        const double level = tone_level(&dec, rates[r][0], 1000.0, &residual);
+        const double ideal = ideal_level(rates[r][1], rates[r][0], 1000.0, &ideal_residual);
+        const double snr = 10.0 * log10(level * level / 2.0 / residual);
+        const double ideal_snr = 10.0 * log10(ideal * ideal / 2.0 / ideal_residual);
+        const int bad = ideal_snr - snr > PDM_MAX_SNR_LOSS_DB;
+        printf("pdm snr   %2lu kHz   1 kHz at -6 dBFS, %.1f dB, ideal decoder %.1f dB, "
+               "max loss %.1f  %s\n",
+               (unsigned long)rates[r][0] / 1000, snr, ideal_snr, PDM_MAX_SNR_LOSS_DB,
+               bad ? "FAIL" : "ok");
+        fail |= bad;
+    }
+    return fail;
+}
+
+static int check_response(void)
+{
+    const PdmConfig_t config = make_config(64, 1, 5, 0, 0.0f);
+    PdmDecimator_t dec;
+    if (init(&dec, &config))
+        return 1;
+
+    double worst = 0.0;
+    for (double f = 100.0; f <= PDM_PASSBAND * 16000.0 + 1.0; f += 300.0)
+    {
+        const double db = 20.0 * log10(tone_level(&dec, 16000, f, NULL) / 16384.0);
+        worst = (fabs(db) > fabs(worst)) ? db : worst;
+    }
+    const int fail = fabs(worst) > PDM_MAX_RIPPLE_DB;
+    printf("pdm response       100 Hz..%.1f kHz, worst %+.3f dB, max %.2f  %s\n",
+           PDM_PASSBAND * 16.0, worst, PDM_MAX_RIPPLE_DB, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+static int check_alias(void)
+{
+    const PdmConfig_t config = make_config(64, 1, 5, 0, 0.0f);
+    PdmDecimator_t dec;
+    if (init(&dec, &config))
+        return 1;
+
+    double worst = 1e9, worst_f = 0.0;
+    for (double f = PDM_STOPBAND * 16000.0 + 100.0; f < 100000.0; f *= 1.07)
+    {
+        double folded = fmod(f / 16000.0, 1.0);
+        folded = (folded > 0.5) ? 1.0 - folded : folded;
+        if (folded * 16000.0 < 50.0 || folded * 16000.0 > PDM_PASSBAND * 16000.0)
+            continue; // lands at DC or in the transition band
+        const double db = 20.0 * log10(16384.0 / tone_level(&dec, 16000, f, NULL));
+        if (db < worst)
+        {
+            worst = db;
+            worst_f = f;
+        }
+    }
+    const int fail = worst < PDM_MIN_ALIAS_DB;
+    printf("pdm alias          %.1f..100 kHz into the band, worst %.1f dB at %.1f kHz, min %.0f  "
+           "%s\n",
+           PDM_STOPBAND * 16.0, worst, worst_f / 1000.0, PDM_MIN_ALIAS_DB, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+static int check_perf(void)
+{
+    // the firmware's capture: two microphones, 1.024 MHz, 16 samples per channel per call
+    const PdmConfig_t config = make_config(64, 2, 5, 0, PDM_HP_ALPHA_LIBRARY);
+    PdmDecimator_t dec;
+    if (init(&dec, &config))
+        return 1;
+    const uint32_t n = 16, block_bytes = n * 8 * 2;
+    for (uint32_t i = 0; i < PDM_PERF_RUNS * block_bytes; ++i)
+        stream[i] = (uint8_t)next_random();
+
+    double best = 1e18;
+    for (int rep = 0; rep < 5; ++rep)
+    {
+        const double start = now_ns();
+        for (uint32_t run = 0; run < PDM_PERF_RUNS; ++run)
+            pdm_process(&dec, stream + run * block_bytes, (uint16_t)n, pcm);
+        const double ns = (now_ns() - start) / PDM_PERF_RUNS;
+        best = (ns < best) ? ns : best;
+    }
+
+    double best_ref = 1e18;
+    for (int rep = 0; rep < 5; ++rep)
+    {
+        const double start = now_ns();
+        for (uint32_t c = 0; c < 2; ++c)
+            reference_decode(&dec, stream, PDM_PERF_RUNS * n, reference);
+        const double ns = (now_ns() - start) / PDM_PERF_RUNS;
+        best_ref = (ns < best_ref) ? ns : best_ref;
+    }
+
+    const int fail = best >= best_ref;
+    printf("pdm perf           %.0f ns per ms of stereo audio, reference %.0f ns (%.1fx)  %s\n",
+           best, best_ref, best_ref / best, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seed = 1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else
+        {
+            fprintf(stderr, "usage: %s [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    rng_state = seed;
+
+    int failed = 0;
+    failed |= check_bit_true();
+    failed |= check_count_ones();
+    failed |= check_snr();
+    failed |= check_response();
+    failed |= check_alias();
+    failed |= check_perf();
+    return failed ? 1 : 0;
+}
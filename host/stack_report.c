@@ -0,0 +1,127 @@
+// stack_report.c
+// Measures the peak stack depth of the portable pipeline stages on a painted host thread.
+// Host figures are for x86-64/arm64 code generation; the target prints its own high-water mark
+// (stack_monitor_peak) after the first feature pass.
+//
+// usage: stack_report
+#include "cnn_inference.h"
+#ifdef HAVE_MEL_DSP
+#include "mel_spectrogram.h"
+#endif
+#include "pipeline_arena.h"
+#include "stack_monitor.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define THREAD_STACK_BYTES (256 * 1024)
+#define WINDOW 64
+#define N_MELS 64
+
+// a two-layer model with the shapes of the owl classifier front end, all-zero weights
+static int8_t conv0_weights[8 * 3 * 3 * 1];
+static int8_t conv1_weights[16 * 3 * 3 * 8];
+static int32_t conv0_bias[8];
+static int32_t conv1_bias[16];
+static int8_t fc_weights[2 * 16];
+static int32_t fc_bias[2];
+
+static const CnnModel_t model = {
+    .n_layers = 2,
+    .layers = {{N_MELS, 1, 8, 3, 3, 2, 1, conv0_weights, conv0_bias, 1 << 20, 24},
+               {N_MELS / 2, 8, 16, 3, 3, 2, 1, conv1_weights, conv1_bias, 1 << 20, 24}},
+    .n_classes = 2,
+    .fc_weights = fc_weights,
+    .fc_bias = fc_bias,
+};
+
+static int8_t input[N_MELS * WINDOW];
+
+static void run_window(void *arg)
+{
+    (void)arg;
+    int32_t logits[CNN_MAX_CLASSES];
+    void *workspace = malloc(cnn_window_workspace_size(&model, WINDOW));
+    cnn_infer_window(&model, input, WINDOW, workspace, logits);
+    free(workspace);
+}
+
+static void run_stream(void *arg)
+{
+    (void)arg;
+    int32_t logits[CNN_MAX_CLASSES];
+    int8_t column[N_MELS] = {0};
+    CnnStream_t stream;
+    uint32_t size = cnn_stream_workspace_size(&model, WINDOW);
+    void *workspace = malloc(size);
+
+    cnn_stream_init(&stream, &model, WINDOW, workspace, size);
+    for (uint16_t t = 0; t < 2 * WINDOW; ++t)
+        cnn_stream_push(&stream, column, logits);
+    free(workspace);
+}
+
+static void run_arena_plan(void *arg)
+{
+    (void)arg;
+    MelSpectrogramConfig_t config = {.sample_rate = 16000, .fft_size = 512, .hop_length = 256,
+                                     .n_mels = N_MELS, .f_min = 0.0f, .f_max = 8000.0f};
+    ArenaTensor_t tensors[PIPELINE_N_TENSORS];
+    pipeline_arena_plan(&config, WINDOW, 32 * 1024, 0, tensors);
+}
+
+#ifdef HAVE_MEL_DSP
+// one 64-frame feature window through the float path, engine memory from the heap like the arena
+static void run_mel(void *arg)
+{
+    (void)arg;
+    MelSpectrogramConfig_t config = {.sample_rate = 16000, .fft_size = 512, .hop_length = 256,
+                                     .n_mels = N_MELS, .f_min = 0.0f, .f_max = 8000.0f};
+    uint32_t state_bytes, scratch_bytes;
+    uint32_t n_samples = (WINDOW - 1) * 256 + 512;
+    int16_t *pcm = calloc(n_samples, sizeof(int16_t));
+    float *spectrogram = malloc(N_MELS * WINDOW * sizeof(float));
+    float *state, *scratch;
+
+    mel_spectrogram_workspace_size(&config, &state_bytes, &scratch_bytes);
+    state = malloc(state_bytes);
+    scratch = malloc(scratch_bytes);
+    mel_spectrogram_set_memory(state, state_bytes, scratch, scratch_bytes);
+    if (mel_spectrogram_init(&config) == 0)
+        calculate_mel_spectrogram(pcm, n_samples, spectrogram, WINDOW);
+
+    free(pcm);
+    free(spectrogram);
+    free(state);
+    free(scratch);
+}
+#endif
+
+int main(void)
+{
+    static const struct
+    {
+        const char *name;
+        StackMonitorFn_t fn;
+    } stages[] = {
+        {"cnn_infer_window", run_window},
+        {"cnn_stream_push", run_stream},
+        {"pipeline_arena_plan", run_arena_plan},
+#ifdef HAVE_MEL_DSP
+        {"calculate_mel_spectrogram", run_mel},
+#endif
+    };
+
+    printf("stage                     peak stack\n");
+    for (unsigned i = 0; i < sizeof(stages) / sizeof(stages[0]); ++i)
+    {
+        uint32_t peak;
+        if (stack_monitor_run(stages[i].fn, NULL, THREAD_STACK_BYTES, &peak) != 0)
+        {
+            fprintf(stderr, "stack_report: could not run %s\n", stages[i].name);
+            return 1;
+        }
+        printf("%-24s %8lu bytes\n", stages[i].name, (unsigned long)peak);
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+// wav_file.c
+#include "wav_file.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static uint16_t le16(const uint8_t *p) { return (uint16_t)(p[0] | p[1] << 8); }
+
+static uint32_t le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+// finds the fmt and data chunks of a 16-bit PCM RIFF/WAVE image
+static int parse_wav(WavFile_t *wav)
+{
+    const uint8_t *p = wav->map;
+    size_t size = wav->map_size;
+    size_t pos = 12;
+    int have_fmt = 0;
+
+    if (size < 12 || memcmp(p, "RIFF", 4) || memcmp(p + 8, "WAVE", 4))
+        return -2;
+
+    while (pos + 8 <= size)
+    {
+        uint32_t chunk = le32(p + pos + 4);
+        const uint8_t *body = p + pos + 8;
+        size_t avail = size - pos - 8;
+
+        if (!memcmp(p + pos, "fmt ", 4) && chunk >= 16 && avail >= 16)
+        {
+            uint16_t format = le16(body);
+            // WAVE_FORMAT_EXTENSIBLE carries the real format in its sub-format GUID
+            if (format == 0xFFFE && chunk >= 40 && avail >= 40)
+                format = le16(body + 24);
+            wav->channels = le16(body + 2);
+            wav->sample_rate = le32(body + 4);
+            if (format != 1 || le16(body + 14) != 16 || wav->channels == 0)
+                return -2;
+            have_fmt = 1;
+        }
+        else if (!memcmp(p + pos, "data", 4) && have_fmt)
+        {
+            size_t bytes = chunk < avail ? chunk : avail;
+            if ((uintptr_t)body & 1)
+                return -2;
+            wav->samples = (const int16_t *)body;
+            wav->n_samples = bytes / (2u * wav->channels);
+            return 0;
+        }
+        pos += 8 + (size_t)chunk + (chunk & 1);
+    }
+    return -2;
+}
+
+int wav_open(const char *path, WavFile_t *wav)
+{
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+
+    memset(wav, 0, sizeof(*wav));
+    if (fd < 0)
+        return -1;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return -1;
+    wav->map = map;
+    wav->map_size = (size_t)st.st_size;
+    madvise(map, wav->map_size, MADV_SEQUENTIAL);
+
+    int ret = parse_wav(wav);
+    if (ret != 0)
+        wav_close(wav);
+    return ret;
+}
+
+void wav_close(WavFile_t *wav)
+{
+    if (wav->map)
+        munmap((void *)wav->map, wav->map_size);
+    memset(wav, 0, sizeof(*wav));
+}
+
+void wav_read_mono(const WavFile_t *wav, uint64_t first, uint32_t n, int16_t *out)
+{
+    const int16_t *src = wav->samples + first * wav->channels;
+
+    if (wav->channels == 1)
+    {
+        memcpy(out, src, n * sizeof(int16_t));
+        return;
+    }
+    for (uint32_t i = 0; i < n; ++i)
+        out[i] = src[(size_t)i * wav->channels];
+}
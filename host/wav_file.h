@@ -0,0 +1,48 @@
+// wav_file.h
+#ifndef WAV_FILE_H
+#define WAV_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief A memory-mapped 16-bit PCM WAV recording. Pages are read on demand, so recordings
+     *        larger than RAM can be walked through.
+     */
+    typedef struct
+    {
+        const uint8_t *map;
+        size_t map_size;
+        const int16_t *samples; // first sample of channel 0, channels interleaved
+        uint64_t n_samples;     // samples per channel
+        uint16_t channels;
+        uint32_t sample_rate;
+    } WavFile_t;
+
+    /**
+     * @brief Maps a RIFF/WAVE file and locates its fmt and data chunks. A data chunk cut short
+     *        on disk keeps the samples that made it.
+     * @return 0 if successful, -1 if it cannot be opened or mapped, -2 if it is not 16-bit PCM
+     */
+    int wav_open(const char *path, WavFile_t *wav);
+
+    /**
+     * @brief Unmaps the recording.
+     */
+    void wav_close(WavFile_t *wav);
+
+    /**
+     * @brief Copies n samples of channel 0 starting at sample first.
+     */
+    void wav_read_mono(const WavFile_t *wav, uint64_t first, uint32_t n, int16_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WAV_FILE_H
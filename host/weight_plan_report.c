@@ -0,0 +1,102 @@
+// weight_plan_report.c
+// Runs the weight placement planner on a model description and prints the expected stall
+// budget per inference.
+//
+// usage: weight_plan_report [-w window] [-s sram_bytes] [-b staging_bytes] [-c classes] layers.txt
+// each line of layers.txt is one conv layer: in_h in_ch out_ch k_h k_w stride_h
+#include "cnn_inference.h"
+#include "weight_plan.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define CORE_HZ 400000000u
+
+static int load_layers(const char *path, CnnModel_t *model)
+{
+    static const int8_t placeholder = 0; // sizes are all the planner needs
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return -1;
+
+    char line[256];
+    while (fgets(line, sizeof(line), f))
+    {
+        unsigned in_h, in_ch, out_ch, k_h, k_w, stride_h;
+        if (line[0] == '#' ||
+            sscanf(line, "%u %u %u %u %u %u", &in_h, &in_ch, &out_ch, &k_h, &k_w, &stride_h) != 6)
+            continue;
+        if (model->n_layers == CNN_MAX_LAYERS)
+            break;
+
+        CnnConvLayer_t *layer = &model->layers[model->n_layers++];
+        layer->in_h = in_h;
+        layer->in_ch = in_ch;
+        layer->out_ch = out_ch;
+        layer->k_h = k_h;
+        layer->k_w = k_w;
+        layer->stride_h = stride_h;
+        layer->weights = &placeholder;
+    }
+    fclose(f);
+    return model->n_layers > 0 ? 0 : -1;
+}
+
+int main(int argc, char **argv)
+{
+    uint16_t window = 64;
+    uint32_t sram_budget = 64 * 1024;
+    uint32_t staging_size = 16 * 1024;
+    CnnModel_t model = {0};
+    model.n_classes = 2;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "w:s:b:c:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'w':
+            window = (uint16_t)atoi(optarg);
+            break;
+        case 's':
+            sram_budget = (uint32_t)atol(optarg);
+            break;
+        case 'b':
+            staging_size = (uint32_t)atol(optarg);
+            break;
+        case 'c':
+            model.n_classes = (uint16_t)atoi(optarg);
+            break;
+        default:
+            fprintf(stderr,
+                    "usage: %s [-w window|0 for streaming] [-s sram_bytes] [-b staging_bytes] "
+                    "[-c classes] layers.txt\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if (optind >= argc || load_layers(argv[optind], &model) != 0)
+    {
+        fprintf(stderr, "could not read layers from %s\n", optind < argc ? argv[optind] : "-");
+        return 2;
+    }
+
+    WeightLayerInfo_t layers[CNN_MAX_LAYERS];
+    WeightPlanParams_t params;
+    WeightPlan_t plan;
+
+    if (weight_plan_describe_model(&model, window, layers) < 0)
+    {
+        fprintf(stderr, "window of %u columns is shorter than the receptive field\n", window);
+        return 1;
+    }
+
+    weight_plan_default_params(&params, sram_budget, staging_size);
+    if (weight_plan_build(layers, model.n_layers, &params, &plan) != 0)
+        return 1;
+
+    printf("%s: window %u, sram budget %lu, staging 2 x %lu\n", argv[optind], window,
+           (unsigned long)sram_budget, (unsigned long)staging_size);
+    weight_plan_print(layers, &plan, CORE_HZ);
+    return 0;
+}
@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+"""Compares the CM7 build profiles: memory per region and, from SWO captures, cycles per stage.
+
+Run by "make report" in CM7/ after every profile is built; map files come labelled by profile:
+
+    python3 tools/build_report.py debug=CM7/build/debug/decible_meter_CM7.map \\
+        release=CM7/build/release/decible_meter_CM7.map [--swo release=capture.swo ...]
+
+Cycles come from what every profile prints on ITM port 0 ("features: N frames, C cycles/frame"
+and, in the profile build, the "golden perf" budget lines), plus per-stage spans where the trace
+is compiled in. The first profile is the baseline of the speedup column.
+"""
+
+import argparse
+import re
+import statistics
+import sys
+
+import placement_report
+import swo_decode
+
+FEATURES_RE = re.compile(r"features: \d+ frames, (\d+) cycles/frame")
+GOLDEN_RE = re.compile(r"golden perf\s+(\S+)\s+(\d+) ticks/frame")
+
+
+def labelled(items, what):
+    out = []
+    for item in items:
+        label, sep, path = item.partition("=")
+        if not sep or not label or not path:
+            raise SystemExit("build_report: %s must be PROFILE=PATH, got %r" % (what, item))
+        out.append((label, path))
+    return out
+
+
+def memory(path):
+    with open(path, encoding="utf-8", errors="replace") as f:
+        regions, sections = placement_report.parse_map(f.readlines())
+    if not regions:
+        raise SystemExit("build_report: no memory configuration in %s" % path)
+    return regions, placement_report.region_usage(regions, sections)
+
+
+def cycles(path):
+    """metric -> cycles (median over the capture)."""
+    with open(path, "rb") as f:
+        records, text, _ = swo_decode.decode(f.read())
+    text = text.decode("ascii", errors="replace")
+
+    samples = {}
+    for m in FEATURES_RE.finditer(text):
+        samples.setdefault("feature pass / frame", []).append(int(m.group(1)))
+    for m in GOLDEN_RE.finditer(text):
+        samples.setdefault("golden %s / frame" % m.group(1), []).append(int(m.group(2)))
+    for r in records:
+        if r["type"] == 1:
+            samples.setdefault("stage %s" % swo_decode.record_name(r), []).append(r["payload"])
+    return {k: statistics.median(v) for k, v in samples.items()}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("maps", nargs="+", help="PROFILE=linker map file")
+    parser.add_argument("--swo", action="append", default=[],
+                        help="PROFILE=raw SWO capture of that build running, repeatable")
+    args = parser.parse_args()
+
+    maps = labelled(args.maps, "map")
+    labels = [label for label, _ in maps]
+    usage = {}
+    regions = []
+    for label, path in maps:
+        regions, usage[label] = memory(path)
+
+    print("memory (bytes)   " + "".join("%12s" % l for l in labels) + "    region size")
+    for name, _, length in regions:
+        row = [usage[l].get(name, 0) for l in labels]
+        if not any(row):
+            continue
+        cells = "".join("%12d" % v for v in row)
+        delta = ", ".join("%s %+d" % (l, usage[l].get(name, 0) - row[0]) for l in labels[1:])
+        print("%-16s %s %14d   %s" % (name, cells, length, delta))
+
+    captures = labelled(args.swo, "--swo")
+    if not captures:
+        return 0
+
+    measured = {label: cycles(path) for label, path in captures}
+    cols = [l for l in labels if l in measured] + [l for l in measured if l not in labels]
+    metrics = sorted({m for c in measured.values() for m in c})
+    base = cols[0]
+    print()
+    print("cycles (median)          " + "".join("%12s" % l for l in cols) +
+          "".join("%10s" % ("x " + l) for l in cols[1:]))
+    for metric in metrics:
+        values = [measured[l].get(metric) for l in cols]
+        cells = "".join("%12s" % ("-" if v is None else "%d" % v) for v in values)
+        ref = measured[base].get(metric)
+        speedups = "".join(
+            "%10s" % ("-" if not ref or v is None or not v else "%.2f" % (ref / v))
+            for v in values[1:])
+        print("%-24s %s%s" % (metric, cells, speedups))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
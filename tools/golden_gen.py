@@ -0,0 +1,235 @@
+#!/usr/bin/env python3
+"""Generates the golden vectors of the DSP path (CM7/Core/Inc/golden_vectors.h).
+
+A float64 reference of the feature pipeline, written independently of the C code, computes the
+expected output of every stage for a few fixed PCM inputs:
+
+    filterbank   band edges, weight sums and peaks of the triangular mel bands
+    mel_db       10 * log10(energy + 1e-6), floored at -80 dB  (calculate_mel_spectrogram)
+    normalized   per-window min/max scaling to [0, 1]           (normalize_spectrogram)
+    q8           dB clamped to [floor, ceil], scaled, quantized (calculate_mel_spectrogram_q8)
+
+Only the mel corner bins are computed in float32 arithmetic like the firmware: they are integer
+truncations, and a float64 rounding difference would move a whole band edge. Regenerate when the
+intended features change, never to make a failing check pass:
+
+    python3 tools/golden_gen.py [-o CM7/Core/Inc/golden_vectors.h]
+"""
+
+import argparse
+import cmath
+import math
+import os
+import struct
+
+SAMPLE_RATE = 16000
+FFT_SIZE = 512
+HOP_LENGTH = 256
+N_MELS = 64
+N_FRAMES = 8
+F_MIN = 0.0
+F_MAX = 8000.0
+N_SAMPLES = (N_FRAMES - 1) * HOP_LENGTH + FFT_SIZE
+
+LOG10_OFFSET = 1e-6
+MIN_DB_LEVEL = -80.0
+# model input quantization, as audio_record.c
+Q_SCALE = 1.0 / 255.0
+Q_ZERO_POINT = -128
+DB_FLOOR = -80.0
+DB_CEIL = 60.0
+
+
+def f32(x):
+    return struct.unpack("<f", struct.pack("<f", x))[0]
+
+
+def corner_bins():
+    """mel_corner_bin() of mel_filterbank.c, every operation rounded to float32."""
+    def hz_to_mel(hz):
+        return f32(2595.0 * f32(math.log10(f32(1.0 + f32(hz / 700.0)))))
+
+    mel_min = hz_to_mel(F_MIN)
+    mel_max = hz_to_mel(F_MAX)
+    step = f32(f32(mel_max - mel_min) / (N_MELS + 1))
+    bins = []
+    for i in range(N_MELS + 2):
+        mel = f32(mel_min + f32(i * step))
+        hz = f32(700.0 * f32(f32(10.0 ** f32(mel / 2595.0)) - 1.0))
+        bins.append(int(f32(f32(hz / SAMPLE_RATE) * FFT_SIZE)))
+    return bins
+
+
+def filterbank():
+    """Dense (n_mels x fft_bins) triangular bank over the corner bins."""
+    fft_bins = FFT_SIZE // 2 + 1
+    corners = corner_bins()
+    bank = []
+    for m in range(N_MELS):
+        left, center, right = corners[m], corners[m + 1], corners[m + 2]
+        row = [0.0] * fft_bins
+        for k in range(left, min(right, fft_bins)):
+            if k < center:
+                row[k] = (k - left) / (center - left + 1e-6)
+            else:
+                row[k] = (right - k) / (right - center + 1e-6)
+        bank.append(row)
+    return bank
+
+
+def band_outline(row):
+    nonzero = [k for k, w in enumerate(row) if w != 0.0]
+    if not nonzero:
+        return (0, 0, 0.0, 0.0)
+    return (nonzero[0], nonzero[-1], sum(row), max(row))
+
+
+def fft(x):
+    n = len(x)
+    if n == 1:
+        return list(x)
+    even = fft(x[0::2])
+    odd = fft(x[1::2])
+    out = [0j] * n
+    for k in range(n // 2):
+        t = cmath.exp(-2j * math.pi * k / n) * odd[k]
+        out[k] = even[k] + t
+        out[k + n // 2] = even[k] - t
+    return out
+
+
+def mel_db(pcm, bank):
+    """n_mels x n_frames, row-major like the firmware's spectrogram."""
+    window = [0.5 * (1.0 - math.cos(2.0 * math.pi * i / (FFT_SIZE - 1))) for i in range(FFT_SIZE)]
+    out = [[0.0] * N_FRAMES for _ in range(N_MELS)]
+    energies = [[0.0] * N_FRAMES for _ in range(N_MELS)]
+    for t in range(N_FRAMES):
+        frame = [pcm[t * HOP_LENGTH + i] / 32768.0 * window[i] for i in range(FFT_SIZE)]
+        spectrum = fft(frame)[:FFT_SIZE // 2 + 1]
+        power = [abs(c) ** 2 for c in spectrum]
+        for m in range(N_MELS):
+            e = sum(w * p for w, p in zip(bank[m], power))
+            energies[m][t] = e
+            out[m][t] = max(10.0 * math.log10(e + LOG10_OFFSET), MIN_DB_LEVEL)
+    return out, energies
+
+
+def normalized(db):
+    flat = [v for row in db for v in row]
+    lo, hi = min(flat), max(flat)
+    if hi == lo:
+        return [[0.0] * N_FRAMES for _ in range(N_MELS)]
+    return [[(v - lo) / (hi - lo) for v in row] for row in db]
+
+
+def quantized(energies):
+    out = []
+    for row in energies:
+        q_row = []
+        for e in row:
+            x = (10.0 * math.log10(e + LOG10_OFFSET) - DB_FLOOR) / (DB_CEIL - DB_FLOOR)
+            x = min(max(x, 0.0), 1.0)
+            q = math.floor(x / Q_SCALE + 0.5) + Q_ZERO_POINT
+            q_row.append(max(-128, min(127, q)))
+        out.append(q_row)
+    return out
+
+
+class Lcg:
+    def __init__(self, seed):
+        self.state = seed
+
+    def next(self):
+        self.state = (self.state * 1664525 + 1013904223) & 0xFFFFFFFF
+        return self.state
+
+
+def signals():
+    noise = Lcg(1)
+    faint = Lcg(2)
+    tone = [int(round(8000 * math.sin(2 * math.pi * 1000 * i / SAMPLE_RATE)))
+            for i in range(N_SAMPLES)]
+    chirp = []
+    for i in range(N_SAMPLES):
+        t = i / SAMPLE_RATE
+        phase = 2 * math.pi * (200 * t + 0.5 * 40000 * t * t)  # 200 Hz rising 40 kHz/s
+        chirp.append(int(round(6000 * math.sin(phase))) + (noise.next() >> 22) - 512)
+    # a few LSBs of noise, sits on the log offset and the bottom of the q8 range
+    quiet = [(faint.next() >> 29) - 4 for _ in range(N_SAMPLES)]
+    return [("tone_1k", tone), ("chirp_noise", chirp), ("quiet", quiet)]
+
+
+def c_array(ctype, name, values, fmt, per_line):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("    " + ", ".join(fmt(v) for v in values[i:i + per_line]) + ",")
+    return "static const %s %s[%d] = {\n%s\n};\n" % (ctype, name, len(values), "\n".join(lines))
+
+
+def c_float(v):
+    s = "%.9g" % v
+    if "e" not in s and "." not in s:
+        s += ".0"
+    return s + "f"
+
+
+def main():
+    root = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-o", "--output",
+                        default=os.path.join(root, "CM7", "Core", "Inc", "golden_vectors.h"))
+    args = parser.parse_args()
+
+    bank = filterbank()
+    out = ["// golden_vectors.h",
+           "// generated by tools/golden_gen.py from its float64 reference, do not edit",
+           "#ifndef GOLDEN_VECTORS_H", "#define GOLDEN_VECTORS_H", "",
+           '#include "golden_check.h"', "#include <stdint.h>", "",
+           "#define GOLDEN_SAMPLE_RATE %d" % SAMPLE_RATE,
+           "#define GOLDEN_FFT_SIZE %d" % FFT_SIZE,
+           "#define GOLDEN_HOP_LENGTH %d" % HOP_LENGTH,
+           "#define GOLDEN_N_MELS %d" % N_MELS,
+           "#define GOLDEN_N_FRAMES %d" % N_FRAMES,
+           "#define GOLDEN_N_SAMPLES %d" % N_SAMPLES,
+           "#define GOLDEN_F_MIN %s" % c_float(F_MIN),
+           "#define GOLDEN_F_MAX %s" % c_float(F_MAX),
+           "#define GOLDEN_Q_SCALE (1.0f / 255.0f)",
+           "#define GOLDEN_Q_ZERO_POINT (%d)" % Q_ZERO_POINT,
+           "#define GOLDEN_DB_FLOOR (%s)" % c_float(DB_FLOOR),
+           "#define GOLDEN_DB_CEIL (%s)" % c_float(DB_CEIL), ""]
+
+    out.append("static const GoldenBand_t golden_bands[GOLDEN_N_MELS] = {")
+    for row in bank:
+        first, last, total, peak = band_outline(row)
+        out.append("    {%d, %d, %s, %s}," % (first, last, c_float(total), c_float(peak)))
+    out.append("};")
+    out.append("")
+
+    entries = []
+    for name, pcm in signals():
+        db, energies = mel_db(pcm, bank)
+        norm = normalized(db)
+        q8 = quantized(energies)
+        flat = lambda rows: [v for row in rows for v in row]
+        out.append(c_array("int16_t", "golden_pcm_%s" % name, pcm, str, 16))
+        out.append(c_array("float", "golden_mel_db_%s" % name, flat(db), c_float, 8))
+        out.append(c_array("float", "golden_normalized_%s" % name, flat(norm), c_float, 8))
+        out.append(c_array("int8_t", "golden_q8_%s" % name, flat(q8), str, 16))
+        entries.append('    {"%s", golden_pcm_%s, golden_mel_db_%s, golden_normalized_%s, '
+                       'golden_q8_%s},' % ((name,) * 5))
+
+    out.append("#define GOLDEN_N_VECTORS %d" % len(entries))
+    out.append("static const GoldenVector_t golden_vectors[GOLDEN_N_VECTORS] = {")
+    out.extend(entries)
+    out.append("};")
+    out.append("")
+    out.append("#endif // GOLDEN_VECTORS_H")
+
+    with open(args.output, "w") as f:
+        f.write("\n".join(out) + "\n")
+    print("wrote %s: %d vectors of %d samples" % (args.output, len(entries), N_SAMPLES))
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+"""Reads the feature files written by host/mel_extract (OUT_DIR/<name>.mel).
+
+    from mel_features import load
+    header, windows = load("features/owl_0001.mel")  # windows: (n_windows, n_mels, n_frames)
+
+Run as a script it prints the header and value range of each file given.
+"""
+
+import struct
+import sys
+
+import numpy as np
+
+HEADER = struct.Struct("<4sHBBIHHHHfffiIQ")  # MelFileHeader_t, 48 bytes
+FIELDS = ("magic", "version", "dtype", "normalized", "sample_rate", "fft_size", "hop_length",
+          "n_mels", "n_frames", "f_min", "f_max", "q_scale", "q_zero_point", "n_windows",
+          "n_samples")
+DTYPES = {0: np.float32, 1: np.int8}
+
+
+def load(path, mmap=True):
+    """Returns (header dict, array of n_windows x n_mels x n_frames) in the stored dtype."""
+    with open(path, "rb") as f:
+        header = dict(zip(FIELDS, HEADER.unpack(f.read(HEADER.size))))
+    if header["magic"] != b"MELF" or header["version"] != 1:
+        raise ValueError("%s: not a version 1 feature file" % path)
+
+    shape = (header["n_windows"], header["n_mels"], header["n_frames"])
+    dtype = DTYPES[header["dtype"]]
+    if mmap:
+        windows = np.memmap(path, dtype=dtype, mode="r", offset=HEADER.size, shape=shape)
+    else:
+        windows = np.fromfile(path, dtype=dtype, offset=HEADER.size).reshape(shape)
+    return header, windows
+
+
+def dequantize(header, windows):
+    """int8 model input back to the [0, 1] features it encodes."""
+    if header["dtype"] != 1:
+        return windows
+    return (windows.astype(np.float32) - header["q_zero_point"]) * header["q_scale"]
+
+
+def main():
+    for path in sys.argv[1:]:
+        header, windows = load(path)
+        print("%s: %d windows of %d x %d, %s%s, fft %d hop %d @ %d Hz" %
+              (path, header["n_windows"], header["n_mels"], header["n_frames"],
+               np.dtype(DTYPES[header["dtype"]]).name,
+               " normalized" if header["normalized"] else "", header["fft_size"],
+               header["hop_length"], header["sample_rate"]))
+        if windows.size:
+            print("  range %g .. %g" % (windows.min(), windows.max()))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
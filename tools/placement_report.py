@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""Reports what the linker placed in ITCM/DTCM and how full each memory region is.
+
+Reads the GNU ld map file written by the CM7 build (-Wl,-Map=...), run as a post-build step:
+
+    python3 tools/placement_report.py CM7/Debug/decible_meter_CM7.map [--all]
+"""
+
+import argparse
+import re
+import sys
+
+# output sections listed input-section by input-section
+TCM_SECTIONS = (".itcm_text", ".dtcm_data", ".dtcm_bss")
+# not allocated on the target, linked at address 0
+NON_ALLOC_PREFIXES = (".debug", ".comment", ".ARM.attributes", ".stab", ".gnu")
+
+OUTPUT_RE = re.compile(r"^(\.\S+)\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)(?:\s+load address 0x([0-9a-f]+))?",
+                       re.I)
+OUTPUT_NAME_RE = re.compile(r"^(\.\S+)\s*$")
+INPUT_RE = re.compile(r"^ (\.\S+|COMMON)\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(.+)$", re.I)
+INPUT_NAME_RE = re.compile(r"^ (\.\S+|COMMON)\s*$")
+ADDR_RE = re.compile(r"^\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(.+)$", re.I)
+REGION_RE = re.compile(r"^(\S+)\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)", re.I)
+
+
+def parse_map(lines):
+    regions = []
+    sections = []  # (name, addr, size, load, [(input, addr, size, object)])
+    i = 0
+
+    # memory regions
+    while i < len(lines) and not lines[i].startswith("Memory Configuration"):
+        i += 1
+    i += 1
+    while i < len(lines) and not lines[i].startswith("Linker script and memory map"):
+        m = REGION_RE.match(lines[i])
+        if m and m.group(1) not in ("Name", "*default*"):
+            regions.append((m.group(1), int(m.group(2), 16), int(m.group(3), 16)))
+        i += 1
+
+    current = None
+    pending_input = None
+    pending_output = None
+    for line in lines[i:]:
+        line = line.rstrip("\n")
+
+        if pending_output:
+            m = re.match(r"^\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)(?:\s+load address 0x([0-9a-f]+))?",
+                         line, re.I)
+            if m:
+                current = (pending_output, int(m.group(1), 16), int(m.group(2), 16),
+                           int(m.group(3), 16) if m.group(3) else None, [])
+                sections.append(current)
+            pending_output = None
+            continue
+
+        m = OUTPUT_RE.match(line)
+        if m and m.group(1).startswith(NON_ALLOC_PREFIXES):
+            current = None
+            continue
+        if m:
+            current = (m.group(1), int(m.group(2), 16), int(m.group(3), 16),
+                       int(m.group(4), 16) if m.group(4) else None, [])
+            sections.append(current)
+            continue
+        m = OUTPUT_NAME_RE.match(line)
+        if m and not m.group(1).startswith(NON_ALLOC_PREFIXES):
+            pending_output = m.group(1)
+            continue
+
+        if current is None:
+            continue
+
+        if pending_input:
+            m = ADDR_RE.match(line)
+            if m:
+                current[4].append(
+                    (pending_input, int(m.group(1), 16), int(m.group(2), 16), m.group(3).strip()))
+            pending_input = None
+            continue
+
+        m = INPUT_RE.match(line)
+        if m:
+            current[4].append(
+                (m.group(1), int(m.group(2), 16), int(m.group(3), 16), m.group(4).strip()))
+            continue
+        m = INPUT_NAME_RE.match(line)
+        if m:
+            pending_input = m.group(1)
+
+    return regions, sections
+
+
+def region_of(regions, addr):
+    for name, origin, length in regions:
+        if origin <= addr < origin + length:
+            return name
+    return None
+
+
+def region_usage(regions, sections):
+    """Bytes used per memory region."""
+    used = {}
+    for name, addr, size, load, _ in sections:
+        # sections copied at boot occupy their load region too (ld prints one for .bss as well)
+        copied = load is not None and load != addr and not any(
+            hint in name for hint in ("bss", "heap", "stack"))
+        for a in (addr, load) if copied else (addr,):
+            region = region_of(regions, a)
+            if region and size:
+                used[region] = used.get(region, 0) + size
+    return used
+
+
+def short_object(path):
+    # "../Libraries/.../arm_cfft_f32.o" -> "arm_cfft_f32.o", "lib.a(member.o)" kept as is
+    return path.replace("\\", "/").rsplit("/", 1)[-1]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("map", help="linker map file")
+    parser.add_argument("--all", action="store_true",
+                        help="also list the inputs of every other allocated section")
+    args = parser.parse_args()
+
+    with open(args.map, encoding="utf-8", errors="replace") as f:
+        regions, sections = parse_map(f.readlines())
+
+    if not regions:
+        print("placement_report: no memory configuration in %s" % args.map, file=sys.stderr)
+        return 1
+
+    shown = TCM_SECTIONS if not args.all else [s[0] for s in sections]
+    for name, addr, size, _, inputs in sections:
+        if name not in shown or size == 0:
+            continue
+        print("%s @ 0x%08x, %d bytes (%s)" % (name, addr, size, region_of(regions, addr)))
+        for sec, _, isize, obj in sorted(inputs, key=lambda x: -x[2]):
+            if isize:
+                print("  %8d  %-40s %s" % (isize, sec, short_object(obj)))
+
+    used = region_usage(regions, sections)
+    print("region        used       size    use")
+    for name, origin, length in regions:
+        u = used.get(name, 0)
+        print("%-8s %9d %10d %6.1f%%" % (name, u, length, 100.0 * u / length if length else 0.0))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,363 @@
+#!/usr/bin/env python3
+"""Checks the CM7 image's worst-case stack depth and RAM use against the linker script.
+
+Combines the compiler's -fstack-usage (.su) frames, the call graph read from the disassembly and
+the linker map:
+
+    python3 tools/stack_budget.py --map CM7/build/release/decible_meter_CM7.map \\
+        --elf CM7/build/release/decible_meter_CM7.elf --su CM7/build/release
+    python3 tools/stack_budget.py --map CM7/Debug/decible_meter_CM7.map \\
+        --list CM7/Debug/decible_meter_CM7.list --su CM7/Debug
+
+The thread entry is Reset_Handler (main and everything it calls). Every exception handler that
+no other function calls is an interrupt entry. Handlers at the same preemption priority cannot
+nest, so the main stack worst case is the thread path plus, for each priority level in use, the
+deepest handler of that level and an FPU exception frame. The total is checked against
+_Min_Stack_Size and each region's usage against its LENGTH. The exit status is 1 when either is
+exceeded, or when an entry reaches recursion or a frame with dynamic (unbounded) size.
+
+Functions without a .su entry (startup code, libc, libgcc) are sized from their prologue.
+Function-pointer calls are resolved from INDIRECT_CALLS and --call. Any other indirect call is
+listed and, with --strict, fails the check.
+"""
+
+import argparse
+import fnmatch
+import os
+import re
+import subprocess
+import sys
+
+import placement_report
+
+# exception frame with the FP context (lazy stacking still reserves it) plus alignment padding
+EXC_FRAME = 26 * 4 + 4
+
+CORE_EXCEPTIONS = ("NMI_Handler", "HardFault_Handler", "MemManage_Handler", "BusFault_Handler",
+                   "UsageFault_Handler", "SVC_Handler", "DebugMon_Handler", "PendSV_Handler",
+                   "SysTick_Handler")
+
+# preemption priorities (NVIC_PRIORITYGROUP_4) as the firmware configures them; anything not
+# listed keeps the reset value 0, the highest configurable priority
+PRIORITIES = {
+    "NMI_Handler": -2,
+    "HardFault_Handler": -1,
+    "SysTick_Handler": 15,           # TICK_INT_PRIORITY, stm32h7xx_hal_conf.h
+    "BDMA_Channel1_IRQHandler": 15,  # BSP_AUDIO_IN_IT_PRIORITY, stm32h747i_discovery_conf.h
+    "MDMA_IRQHandler": 15,           # MDMA_TRANSFER_IRQ_PRIORITY, mdma_transfer.h
+}
+
+# function-pointer calls: caller name patterns -> the functions the pointer can hold
+INDIRECT_CALLS = [
+    # HAL DMA/BDMA completion callbacks set up by HAL_SAI_Receive_DMA for the PDM capture
+    (("HAL_DMA_IRQHandler",), ("SAI_DMARxCplt", "SAI_DMARxHalfCplt", "SAI_DMAError")),
+    # mdma_transfer.c registers these on its MDMA handle
+    (("HAL_MDMA_IRQHandler",), ("block_done", "chain_done", "chain_error")),
+    # NorFlash_t operations, bound to the QSPI driver by qspi_nor_init
+    (("detection_log_*", "wait_idle", "flash_read", "program_range", "finish_erase",
+      "start_erase", "program_pending", "program_fill"),
+     ("nor_read", "nor_program", "nor_erase", "nor_busy")),
+]
+
+FUNC_RE = re.compile(r"^([0-9a-f]{8}) <(\S+)>:$")
+INSN_RE = re.compile(r"^\s+[0-9a-f]+:\t[0-9a-f ]+\t(\S+)\s*(.*)$")
+TARGET_RE = re.compile(r"<([^>+]+)(\+0x[0-9a-f]+)?>")
+REGLIST_RE = re.compile(r"\{([^}]*)\}")
+SUB_SP_RE = re.compile(r"^sp, (?:sp, )?#(\d+)")
+
+BRANCHES = ("b", "b.n", "b.w") + tuple(
+    "b%s%s" % (cc, w) for cc in ("eq", "ne", "cs", "cc", "hs", "lo", "mi", "pl", "vs", "vc",
+                                 "hi", "ls", "ge", "lt", "gt", "le") for w in ("", ".n", ".w"))
+
+
+def parse_su(root):
+    """name -> (bytes, qualifier, source) from every .su under root; the largest of same-named
+    static functions wins."""
+    frames = {}
+    for dirpath, _, files in os.walk(root):
+        for fname in files:
+            if not fname.endswith(".su"):
+                continue
+            with open(os.path.join(dirpath, fname), encoding="utf-8", errors="replace") as f:
+                for line in f:
+                    fields = line.rstrip("\n").split("\t")
+                    if len(fields) < 3 or not fields[1].isdigit():
+                        continue
+                    source, name = fields[0].rsplit(":", 1)
+                    size = int(fields[1])
+                    if name not in frames or size > frames[name][0]:
+                        frames[name] = (size, fields[2], source.rsplit(":", 2)[0])
+    return frames
+
+
+def parse_cyclo(root):
+    """name -> cyclomatic complexity from the .cyclo files the ST toolchain writes."""
+    cyclo = {}
+    for dirpath, _, files in os.walk(root):
+        for fname in files:
+            if not fname.endswith(".cyclo"):
+                continue
+            with open(os.path.join(dirpath, fname), encoding="utf-8", errors="replace") as f:
+                for line in f:
+                    fields = line.rstrip("\n").split("\t")
+                    if len(fields) >= 2 and fields[1].isdigit():
+                        name = fields[0].rsplit(":", 1)[-1]
+                        cyclo[name] = max(cyclo.get(name, 0), int(fields[1]))
+    return cyclo
+
+
+def reglist_bytes(operands, width):
+    m = REGLIST_RE.search(operands)
+    if not m:
+        return 0
+    count = 0
+    for reg in m.group(1).split(","):
+        lo, _, hi = reg.strip().partition("-")
+        count += int(hi[1:]) - int(lo[1:]) + 1 if hi else 1
+    return count * width
+
+
+def parse_disasm(lines):
+    """name -> {"calls": set, "indirect": bool, "prologue": bytes} from objdump -d output."""
+    funcs = {}
+    cur = None
+    for line in lines:
+        m = FUNC_RE.match(line)
+        if m:
+            cur = funcs.setdefault(m.group(2), {"calls": set(), "indirect": False,
+                                                "prologue": 0, "insns": 0})
+            continue
+        m = INSN_RE.match(line)
+        if not m or cur is None:
+            continue
+        op, operands = m.group(1), m.group(2).split(";")[0].split("@")[0].strip()
+        cur["insns"] += 1
+
+        # frame of a function the compiler did not report: its first few stack adjustments
+        if cur["insns"] <= 8:
+            if op in ("push", "push.w") or (op.startswith("stmdb") and operands.startswith("sp!")):
+                cur["prologue"] += reglist_bytes(operands, 4)
+            elif op == "vpush":
+                cur["prologue"] += reglist_bytes(operands, 8 if "{d" in operands else 4)
+            elif op in ("sub", "sub.w", "subw"):
+                s = SUB_SP_RE.match(operands)
+                if s:
+                    cur["prologue"] += int(s.group(1))
+
+        t = TARGET_RE.search(operands)
+        if op in ("bl", "blx") and t:
+            cur["calls"].add(t.group(1))
+        elif op == "blx" or (op == "bx" and operands != "lr"):
+            cur["indirect"] = True
+        elif op in BRANCHES and t and not t.group(2):
+            # a branch to the start of another function is a tail call
+            cur["calls"].add(t.group(1))
+    for name, f in funcs.items():
+        f["calls"].discard(name)
+    return funcs
+
+
+def read_disasm(args):
+    if args.list:
+        with open(args.list, encoding="utf-8", errors="replace") as f:
+            return f.readlines()
+    out = subprocess.run([args.objdump, "-d", args.elf], check=True, capture_output=True,
+                         text=True)
+    return out.stdout.splitlines()
+
+
+def map_symbol(lines, name):
+    sym = re.compile(r"^\s+0x([0-9a-f]+)\s+%s = " % re.escape(name), re.I)
+    for line in lines:
+        m = sym.match(line)
+        if m:
+            return int(m.group(1), 16)
+    return None
+
+
+class CallGraph:
+    def __init__(self, funcs, frames, extra_calls):
+        self.funcs = funcs
+        self.frames = frames
+        self.unresolved = set()
+        self.estimated = set()
+        self.cycles = []
+        self.unbounded = set()
+        self.memo = {}
+
+        for name, f in funcs.items():
+            if not f["indirect"]:
+                continue
+            targets = [t for callers, tgts in INDIRECT_CALLS + extra_calls
+                       if any(fnmatch.fnmatchcase(name, c) for c in callers) for t in tgts]
+            resolved = [t for t in targets if t in funcs]
+            f["calls"].update(resolved)
+            if not targets:
+                self.unresolved.add(name)
+
+    def frame(self, name):
+        if name in self.frames:
+            size, qualifier, _ = self.frames[name]
+            if "dynamic" in qualifier and "bounded" not in qualifier:
+                self.unbounded.add(name)
+            return size
+        self.estimated.add(name)
+        return self.funcs.get(name, {}).get("prologue", 0)
+
+    def worst(self, name, stack=()):
+        """(deepest bytes, path) from name down; recursion cuts the walk and is recorded."""
+        if name in self.memo:
+            return self.memo[name]
+        if name in stack:
+            self.cycles.append(stack[stack.index(name):] + (name,))
+            return 0, [name]
+        best, best_path = 0, []
+        for callee in sorted(self.funcs.get(name, {}).get("calls", ())):
+            depth, path = self.worst(callee, stack + (name,))
+            if depth > best:
+                best, best_path = depth, path
+        result = (self.frame(name) + best, [name] + best_path)
+        self.memo[name] = result
+        return result
+
+    def reachable(self, name):
+        seen, todo = set(), [name]
+        while todo:
+            n = todo.pop()
+            if n not in seen:
+                seen.add(n)
+                todo.extend(self.funcs.get(n, {}).get("calls", ()))
+        return seen
+
+
+def parse_pairs(items, what, value=str):
+    out = {}
+    for item in items:
+        key, sep, val = item.partition("=")
+        if not sep or not key or not val:
+            raise SystemExit("stack_budget: %s must be NAME=VALUE, got %r" % (what, item))
+        out[key] = value(val)
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--map", required=True, help="linker map file")
+    src = parser.add_mutually_exclusive_group(required=True)
+    src.add_argument("--elf", help="image to disassemble with --objdump")
+    src.add_argument("--list", help="existing objdump -d/-S listing (the IDE's .list)")
+    parser.add_argument("--su", required=True, help="directory searched for .su/.cyclo files")
+    parser.add_argument("--objdump", default="arm-none-eabi-objdump")
+    parser.add_argument("--priority", action="append", default=[],
+                        help="HANDLER=PREEMPTION_PRIORITY, overrides the built-in table")
+    parser.add_argument("--call", action="append", default=[],
+                        help="CALLER=CALLEE[,CALLEE...] for a function-pointer call")
+    parser.add_argument("--stack", type=lambda s: int(s, 0),
+                        help="main stack budget in bytes (default: _Min_Stack_Size)")
+    parser.add_argument("--region", action="append", default=[],
+                        help="REGION=BYTES budget below the region's LENGTH")
+    parser.add_argument("--strict", action="store_true",
+                        help="fail on unresolved function-pointer calls too")
+    parser.add_argument("--top", type=int, default=10, help="largest frames to list")
+    args = parser.parse_args()
+
+    with open(args.map, encoding="utf-8", errors="replace") as f:
+        map_lines = f.readlines()
+    regions, sections = placement_report.parse_map(map_lines)
+    if not regions:
+        raise SystemExit("stack_budget: no memory configuration in %s" % args.map)
+
+    frames = parse_su(args.su)
+    if not frames:
+        raise SystemExit("stack_budget: no .su files under %s (build with -fstack-usage)"
+                         % args.su)
+    cyclo = parse_cyclo(args.su)
+    funcs = parse_disasm(read_disasm(args))
+    extra = [((caller,), tuple(callees.split(",")))
+             for caller, callees in parse_pairs(args.call, "--call").items()]
+    graph = CallGraph(funcs, frames, extra)
+
+    priorities = dict(PRIORITIES)
+    priorities.update(parse_pairs(args.priority, "--priority", int))
+    called = set().union(*(f["calls"] for f in funcs.values()))
+    handlers = sorted(n for n in funcs if n not in called and
+                      (n in CORE_EXCEPTIONS or n.endswith("_IRQHandler")))
+    thread = "Reset_Handler" if "Reset_Handler" in funcs else "main"
+    failed = False
+
+    # per-entry depth, then the nesting worst case
+    print("%-28s %5s %7s  %s" % ("entry", "prio", "bytes", "deepest path"))
+    depth, path = graph.worst(thread)
+    print("%-28s %5s %7d  %s" % (thread, "-", depth, " > ".join(path)))
+    levels = {}
+    for h in handlers:
+        d, p = graph.worst(h)
+        prio = priorities.get(h, 0)
+        print("%-28s %5d %7d  %s" % (h, prio, d, " > ".join(p)))
+        if d > levels.get(prio, (0, None))[0]:
+            levels[prio] = (d, h)
+    total = depth + sum(d + EXC_FRAME for d, _ in levels.values())
+
+    budget = args.stack
+    budget_name = "--stack"
+    if budget is None:
+        budget = map_symbol(map_lines, "_Min_Stack_Size")
+        budget_name = "_Min_Stack_Size"
+    print()
+    print("main stack worst case: thread %d" % depth + "".join(
+        " + prio %d %s %d+%d" % (prio, levels[prio][1], levels[prio][0], EXC_FRAME)
+        for prio in sorted(levels)) + " = %d bytes" % total)
+    if budget is None:
+        print("  no _Min_Stack_Size in the map and no --stack: budget not checked")
+    else:
+        over = total > budget
+        failed = failed or over
+        print("  %s %d bytes: %s" % (budget_name, budget,
+                                     "EXCEEDED by %d" % (total - budget) if over else
+                                     "%d spare" % (budget - total)))
+
+    entries = [thread] + handlers
+    reach = set().union(*(graph.reachable(e) for e in entries))
+    if graph.cycles:
+        failed = True
+        print("recursion (depth unbounded):")
+        for cycle in sorted(set(graph.cycles)):
+            print("  " + " > ".join(cycle))
+    unbounded = sorted(graph.unbounded & reach)
+    if unbounded:
+        failed = True
+        print("dynamic frames (alloca/VLA, size unbounded): " + ", ".join(unbounded))
+    unresolved = sorted(graph.unresolved & reach)
+    if unresolved:
+        failed = failed or args.strict
+        print("unresolved function-pointer calls (add --call): " + ", ".join(unresolved))
+    estimated = sorted(graph.estimated & reach)
+    if estimated:
+        print("%d reachable functions without .su, sized from their prologue" % len(estimated))
+
+    # RAM regions against the linker script
+    budgets = parse_pairs(args.region, "--region", lambda s: int(s, 0))
+    usage = placement_report.region_usage(regions, sections)
+    print()
+    print("%-10s %10s %10s" % ("region", "used", "budget"))
+    for name, _, length in regions:
+        used = usage.get(name, 0)
+        limit = budgets.get(name, length)
+        over = used > limit
+        failed = failed or over
+        print("%-10s %10d %10d%s" % (name, used, limit, "  EXCEEDED" if over else ""))
+
+    print()
+    print("largest reachable frames:")
+    for size, name in sorted(((graph.frame(n), n) for n in reach if n in frames),
+                             reverse=True)[:args.top]:
+        print("  %7d  %-32s %-28s%s" % (size, name, placement_report.short_object(frames[name][2]),
+                                     "  (cyclomatic %d)" % cyclo[name] if name in cyclo else ""))
+
+    print()
+    print("FAIL" if failed else "ok")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+"""Decodes a captured SWO/ITM byte stream into trace records, a stage timeline and CSV.
+
+The firmware (CM7/Core/Src/trace.c) writes 3-word records to ITM stimulus ports 1-3:
+header (0xA5, type, id, sequence), timestamp (CYCCNT), payload. Port 0 carries printf text.
+
+    python3 tools/swo_decode.py capture.swo [--csv out.csv] [--hz 400e6] [--text]
+
+The capture is the raw SWO byte stream (UART/NRZ mode), e.g. from OpenOCD
+"itm ports on" + "tpiu config ... swo_output.bin" or an ST-LINK SWV raw dump.
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+TRACE_MAGIC = 0xA5
+TRACE_RECORD_WORDS = 3
+PORT_TEXT = 0
+PORT_NAMES = {1: "stage", 2: "value", 3: "mark"}
+TYPE_NAMES = {1: "span", 2: "value", 3: "mark"}
+
+# ProfStage_t in profiler.h
+STAGE_NAMES = ["pdm_decode", "window", "fft", "power", "mel", "log", "normalize", "quantize",
+               "inference", "mfcc", "noise", "beam", "pdm_library", "agc"]
+# value/mark ids in trace.h
+EVENT_NAMES = ["archive_drop", "n_frames", "gate_score", "agc_gain"]
+
+
+def itm_packets(data, stats):
+    """Yields (port, payload) of software source packets, skipping protocol packets."""
+    i = 0
+    n = len(data)
+    while i < n:
+        h = data[i]
+        i += 1
+        if h == 0x00 or h == 0x80:
+            # synchronization: zeros terminated by 0x80
+            continue
+        if h == 0x70:
+            stats["overflow"] += 1
+            continue
+        if h & 0x0F == 0x00 or h & 0x0B == 0x08 or h in (0x94, 0xB4):
+            # local timestamp, extension or global timestamp, continued while bit 7 is set
+            if h & 0x80:
+                while i < n and data[i] & 0x80:
+                    i += 1
+                i += 1
+            continue
+        size = (0, 1, 2, 4)[h & 0x03]
+        if size == 0:
+            stats["skipped"] += 1
+            continue
+        payload = data[i:i + size]
+        i += size
+        if h & 0x04:
+            continue  # hardware source (DWT) packet
+        yield h >> 3, payload
+
+
+def is_header(word):
+    return (word >> 24) == TRACE_MAGIC and ((word >> 16) & 0xFF) in TYPE_NAMES
+
+
+def decode(data):
+    stats = {"overflow": 0, "skipped": 0, "resync": 0}
+    text = bytearray()
+    words = {}  # port -> words of the record being assembled
+    records = []
+
+    for port, payload in itm_packets(data, stats):
+        if port == PORT_TEXT:
+            text += payload
+            continue
+        if len(payload) != 4:
+            continue
+        word = struct.unpack("<I", payload)[0]
+        w = words.setdefault(port, [])
+
+        if not w:
+            if is_header(word):
+                w.append(word)
+            else:
+                stats["resync"] += 1
+            continue
+        # a record cut short on the target: the next header arrives in the timestamp or
+        # payload slot, recognised by its sequence number following the pending one
+        if is_header(word) and (word & 0xFF) == ((w[0] + 1) & 0xFF):
+            stats["resync"] += 1
+            w[:] = [word]
+            continue
+        w.append(word)
+        if len(w) == TRACE_RECORD_WORDS:
+            header, timestamp, value = w
+            records.append({
+                "port": port,
+                "type": (header >> 16) & 0xFF,
+                "id": (header >> 8) & 0xFF,
+                "seq": header & 0xFF,
+                "timestamp": timestamp,
+                "payload": value,
+            })
+            w.clear()
+
+    return records, bytes(text), stats
+
+
+def record_name(rec):
+    names = STAGE_NAMES if rec["type"] == 1 else EVENT_NAMES
+    return names[rec["id"]] if rec["id"] < len(names) else "id%d" % rec["id"]
+
+
+def count_gaps(records):
+    last = {}
+    gaps = 0
+    for rec in records:
+        port = rec["port"]
+        if port in last:
+            gaps += (rec["seq"] - last[port] - 1) & 0xFF
+        last[port] = rec["seq"]
+    return gaps
+
+
+def unwrap(records):
+    """Adds a monotonic 'time' in ticks, undoing 32-bit CYCCNT wraps in arrival order."""
+    base = 0
+    prev = None
+    for rec in records:
+        ts = rec["timestamp"]
+        if prev is not None and ts < prev and prev - ts > 0x80000000:
+            base += 1 << 32
+        prev = ts
+        rec["time"] = base + ts
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", help="raw SWO byte stream")
+    parser.add_argument("--csv", help="write every record to this CSV file")
+    parser.add_argument("--hz", type=float, default=400e6, help="CYCCNT rate (core clock)")
+    parser.add_argument("--text", action="store_true", help="also print port 0 text")
+    parser.add_argument("--limit", type=int, default=40, help="timeline rows to print")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as f:
+        records, text, stats = decode(f.read())
+    unwrap(records)
+
+    to_us = 1e6 / args.hz
+    t0 = min((r["time"] for r in records), default=0)
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            out = csv.writer(f)
+            out.writerow(["port", "seq", "type", "name", "time_us", "duration_us", "value"])
+            for r in records:
+                span = r["type"] == 1
+                out.writerow([PORT_NAMES.get(r["port"], r["port"]), r["seq"],
+                              TYPE_NAMES.get(r["type"], r["type"]), record_name(r),
+                              "%.3f" % ((r["time"] - t0) * to_us),
+                              "%.3f" % (r["payload"] * to_us) if span else "",
+                              "" if span else r["payload"]])
+
+    spans = sorted((r for r in records if r["type"] == 1), key=lambda r: r["time"])
+    print("timeline (us from first record)")
+    for r in spans[:args.limit]:
+        start = (r["time"] - t0) * to_us
+        print("%12.2f %10.2f  %s" % (start, r["payload"] * to_us, record_name(r)))
+    if len(spans) > args.limit:
+        print("  ... %d more spans" % (len(spans) - args.limit))
+
+    totals = {}
+    for r in spans:
+        t = totals.setdefault(record_name(r), [0, 0])
+        t[0] += 1
+        t[1] += r["payload"]
+    if totals:
+        print("stage          count   total us    mean us")
+        for name, (count, ticks) in sorted(totals.items(), key=lambda x: -x[1][1]):
+            print("%-11s %8d %10.1f %10.2f" % (name, count, ticks * to_us, ticks * to_us / count))
+
+    for r in records:
+        if r["type"] != 1:
+            print("%12.2f  %-6s %s = %d" % ((r["time"] - t0) * to_us,
+                                           TYPE_NAMES.get(r["type"], "?"), record_name(r),
+                                           r["payload"]))
+
+    print("records: %d, dropped (sequence gaps): %d, ITM overflows: %d, resyncs: %d" %
+          (len(records), count_gaps(records), stats["overflow"], stats["resync"]))
+
+    if args.text and text:
+        print("--- port 0 text ---")
+        sys.stdout.write(text.decode("ascii", errors="replace"))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())